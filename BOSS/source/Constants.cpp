@@ -3,6 +3,24 @@
 
 namespace BOSS
 {
+    namespace Constants
+    {
+        namespace
+        {
+            size_t mineralsPerWorkerPerFrame = MPWPF;
+        }
+
+        size_t MineralsPerWorkerPerFrame()
+        {
+            return mineralsPerWorkerPerFrame;
+        }
+
+        void SetMineralsPerWorkerPerFrame(size_t mpwpf)
+        {
+            mineralsPerWorkerPerFrame = mpwpf;
+        }
+    }
+
     namespace Races
     {
         RaceID GetRaceID(BWAPI::Race r)
@@ -26,7 +26,7 @@ namespace BOSS
 
         const size_t NUM_HASHES             = 2;
 
-        const size_t MPWPF                  = 45;
+        const size_t MPWPF                  = 45;      // default minerals per worker per frame, scaled by RESOURCE_SCALE
 
         const size_t GPWPF                  = 70;
 
@@ -36,6 +36,10 @@ namespace BOSS
 
         const size_t ZERG_LARVA_ID          = 255;
 
+        // minerals per worker per frame used by the income model, scaled by RESOURCE_SCALE
+        // starts as MPWPF; the bot replaces it with the income its workers have been gathering
+        size_t MineralsPerWorkerPerFrame();
+        void SetMineralsPerWorkerPerFrame(size_t mpwpf);
     }
     
     namespace Races
@@ -729,7 +729,7 @@ const FrameCountType GameState::whenMineralsReady(const ActionType & action) con
 
         // the time elapsed and the current minerals per frame
         FrameCountType elapsed = _units.getFinishTimeByIndex(progressIndex) - lastActionFinishFrame;
-        ResourceCountType mineralsPerFrame = (currentMineralWorkers * Constants::MPWPF);
+        ResourceCountType mineralsPerFrame = (currentMineralWorkers * Constants::MineralsPerWorkerPerFrame());
 
         // the amount of minerals that would be added this time step
         ResourceCountType tempAdd = elapsed * mineralsPerFrame;
@@ -779,20 +779,20 @@ const FrameCountType GameState::whenMineralsReady(const ActionType & action) con
        FrameCountType finalTimeToAdd;
 	   if (currentMineralWorkers != 0)
 		{
-			finalTimeToAdd = (difference - addedMinerals) / (currentMineralWorkers * Constants::MPWPF);
+			finalTimeToAdd = (difference - addedMinerals) / (currentMineralWorkers * Constants::MineralsPerWorkerPerFrame());
 		}
 		else
 		{
 			finalTimeToAdd = 1000000;
 		}
-        addedMinerals += finalTimeToAdd * currentMineralWorkers * Constants::MPWPF;
+        addedMinerals += finalTimeToAdd * currentMineralWorkers * Constants::MineralsPerWorkerPerFrame();
         addedTime     += finalTimeToAdd;
 
         // the last operation could have added one frame too little due to integer division so we need to check
         if (addedMinerals < difference)
         {
             addedTime += 1;
-            addedMinerals += currentMineralWorkers * Constants::MPWPF;
+            addedMinerals += currentMineralWorkers * Constants::MineralsPerWorkerPerFrame();
         }
     }
     
@@ -922,7 +922,7 @@ bool GameState::canAffordMinerals(const ActionType & action) const
 // getter methods for the internal variables
 size_t GameState::getMineralsPerFrame() const
 {
-    return Constants::MPWPF * _units.getNumMineralWorkers();
+    return Constants::MineralsPerWorkerPerFrame() * _units.getNumMineralWorkers();
 }
 
 size_t GameState::getGasPerFrame() const
@@ -114,6 +114,8 @@ public:
 private:
 	template<class Context>
 	void								ComputeChokePointDistances(const Context * pContext);
+	template<class Context>
+	void								ApplyChokePointDistances(const Context * pContext, const ChokePoint * pStart, const vector<const ChokePoint *> & Targets, const vector<int> & DistanceToTargets);
 	vector<int>							ComputeDistances(const ChokePoint * pStartCP, const vector<const ChokePoint *> & TargetCPs) const;
 	void								SetDistance(const ChokePoint * cpA, const ChokePoint * cpB, int value);
 	void								UpdateGroupIds();
@@ -62,6 +62,15 @@ public:
 	// A good place to do this is in ExampleAIModule::onStart()
 	virtual void						Initialize(BWAPI::Game *game) = 0;
 
+	// Provides the MiniTile altitudes computed by a previous Initialize() on the same map, as returned by ExportAltitudes().
+	// Must be called before Initialize(), which then skips its altitude computation.
+	// Ignored if the size doesn't match the map.
+	virtual void						SetPrecomputedAltitudes(std::vector<altitude_t> altitudes) = 0;
+
+	// Returns the altitude of each MiniTile, in row-major order.
+	// The result can be saved and passed to SetPrecomputedAltitudes() in a later game on the same map.
+	virtual std::vector<altitude_t>		ExportAltitudes() const = 0;
+
 	// Will return true once Initialize() has been called.
 	bool								Initialized() const			{ return m_size != 0; }
 
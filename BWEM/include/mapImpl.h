@@ -56,6 +56,9 @@ public:
 
 	void						Initialize(BWAPI::Game *) override;
 
+	void						SetPrecomputedAltitudes(vector<altitude_t> altitudes) override	{ m_precomputedAltitudes = move(altitudes); }
+	vector<altitude_t>			ExportAltitudes() const override;
+
 	bool						AutomaticPathUpdate() const override					{ return m_automaticPathUpdate; }
 	void						EnableAutomaticPathAnalysis() const override			{ m_automaticPathUpdate = true; }
 
@@ -117,6 +120,7 @@ private:
 	void						LoadData(BWAPI::Game *);
 	void						DecideSeasOrLakes();
 	void						ComputeAltitude();
+	bool						LoadAltitude(const vector<altitude_t> & altitudes);
 	void						ProcessBlockingNeutrals();
 	void						ComputeAreas();
 	vector<pair<BWAPI::WalkPosition, MiniTile *>>
@@ -129,6 +133,7 @@ private:
 
 
 	altitude_t							m_maxAltitude;
+	vector<altitude_t>					m_precomputedAltitudes;
 
 	mutable bool						m_automaticPathUpdate = false;
 
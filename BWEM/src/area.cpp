@@ -131,12 +131,17 @@ vector<int> Area::ComputeDistances(const ChokePoint * pStartCP, const vector<con
 
 // Returns Distances such that Distances[i] == ground_distance(start, Targets[i]) in pixels
 // Note: same algorithm than Graph::ComputeDistances (derived from Dijkstra)
+// Unlike Graph::ComputeDistances, the search state is kept in local buffers rather than in the Tiles,
+// so that the Areas can be processed concurrently (Cf. Graph::ComputeChokePointDistanceMatrix).
 vector<int> Area::ComputeDistances(TilePosition start, const vector<TilePosition> & Targets) const
 {
 	const Map * pMap = GetMap();
 	vector<int> Distances(Targets.size());
 
-	Tile::UnmarkAll();
+	const auto index = [pMap](TilePosition t) { return t.y * pMap->Size().x + t.x; };
+
+	vector<int> TileDist(pMap->Size().x * pMap->Size().y, 0);		// 0 -> not in ToVisit ; otherwise the distance to start
+	vector<bool> TileMarked(pMap->Size().x * pMap->Size().y, false);
 
 	multimap<int, TilePosition> ToVisit;	// a priority queue holding the tiles to visit ordered by their distance to start.
 	ToVisit.emplace(0, start);
@@ -146,11 +151,10 @@ vector<int> Area::ComputeDistances(TilePosition start, const vector<TilePosition
 	{
 		int currentDist = ToVisit.begin()->first;
 		TilePosition current = ToVisit.begin()->second;
-		const Tile & currentTile = pMap->GetTile(current, check_t::no_check);
-		bwem_assert(currentTile.InternalData() == currentDist);
+		bwem_assert(TileDist[index(current)] == currentDist);
 		ToVisit.erase(ToVisit.begin());
-		currentTile.SetInternalData(0);										// resets Tile::m_internalData for future usage
-		currentTile.SetMarked();
+		TileDist[index(current)] = 0;
+		TileMarked[index(current)] = true;
 
 		for (int i = 0 ; i < (int)Targets.size() ; ++i)
 			if (current == Targets[i])
@@ -170,29 +174,31 @@ vector<int> Area::ComputeDistances(TilePosition start, const vector<TilePosition
 			TilePosition next = current + delta;
 			if (pMap->Valid(next))
 			{
-				const Tile & nextTile = pMap->GetTile(next, check_t::no_check); 
-				if (!nextTile.Marked())
+				if (!TileMarked[index(next)])
 				{
-					if (nextTile.InternalData())	// next already in ToVisit
+					int & nextDist = TileDist[index(next)];
+					if (nextDist)	// next already in ToVisit
 					{
-						if (newNextDist < nextTile.InternalData())		// nextNewDist < nextOldDist
+						if (newNextDist < nextDist)		// nextNewDist < nextOldDist
 						{	// To update next's distance, we need to remove-insert it from ToVisit:
-							auto range = ToVisit.equal_range(nextTile.InternalData());
+							auto range = ToVisit.equal_range(nextDist);
 							auto iNext = find_if(range.first, range.second, [next]
 								(const pair<int, TilePosition> & e) { return e.second == next; });
 							bwem_assert(iNext != range.second);
 
 							ToVisit.erase(iNext);
-							nextTile.SetInternalData(newNextDist);
-						//	nextTile.SetPtr(const_cast<Tile *>(&currentTile));		// note: we won't use this backward trace
+							nextDist = newNextDist;
 							ToVisit.emplace(newNextDist, next);
 						}
 					}
-					else if ((nextTile.AreaId() == Id()) || (nextTile.AreaId() == -1))
+					else
 					{
-						nextTile.SetInternalData(newNextDist);
-					//	nextTile.SetPtr(const_cast<Tile *>(&currentTile));			// note: we won't use this backward trace
-						ToVisit.emplace(newNextDist, next);
+						const Tile & nextTile = pMap->GetTile(next, check_t::no_check);
+						if ((nextTile.AreaId() == Id()) || (nextTile.AreaId() == -1))
+						{
+							nextDist = newNextDist;
+							ToVisit.emplace(newNextDist, next);
+						}
 					}
 				}
 			}
@@ -201,10 +207,6 @@ vector<int> Area::ComputeDistances(TilePosition start, const vector<TilePosition
 
 	bwem_assert(!remainingTargets);
 
-	// Reset Tile::m_internalData for future usage
-	for (auto e : ToVisit)
-		pMap->GetTile(e.second, check_t::no_check).SetInternalData(0);	
-	
 	return Distances;
 }
 
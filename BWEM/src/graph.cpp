@@ -13,6 +13,8 @@
 #include "neutral.h"
 #include <map>
 #include <deque>
+#include <thread>
+#include <atomic>
 
 
 using namespace BWAPI;
@@ -25,6 +27,49 @@ namespace BWEM {
 namespace detail {
 
 
+// Returns the ChokePoints of pContext that come before pStart. Computing the distances from each ChokePoint to the
+// previous ones only is enough to fill the symmetric matrix.
+template<class Context>
+static vector<const ChokePoint *> targetsBefore(const Context * pContext, const ChokePoint * pStart)
+{
+	vector<const ChokePoint *> Targets;
+	for (const ChokePoint * cp : pContext->ChokePoints())
+	{
+		if (cp == pStart) break;	// breaks symmetry
+		Targets.push_back(cp);
+	}
+
+	return Targets;
+}
+
+
+// Calls f(i) for each i in [0, count), spreading the calls over the available hardware threads.
+// f must be safe to call concurrently for different values of i.
+template<class Func>
+static void parallelFor(int count, Func f)
+{
+	const int threadCount = min(count, max(1, (int)thread::hardware_concurrency()));
+	if (threadCount <= 1)
+	{
+		for (int i = 0 ; i < count ; ++i) f(i);
+		return;
+	}
+
+	atomic<int> next(0);
+	auto worker = [&next, count, &f]()
+	{
+		for (int i = next++ ; i < count ; i = next++) f(i);
+	};
+
+	vector<thread> Threads;
+	for (int t = 1 ; t < threadCount ; ++t)
+		Threads.emplace_back(worker);
+	worker();
+
+	for (auto & t : Threads) t.join();
+}
+
+
 Area * mainArea(MapImpl * pMap, TilePosition topLeft, TilePosition size)
 {
 	map<Area *, int> map_Area_freq;
@@ -245,53 +290,45 @@ void Graph::SetPath(const ChokePoint * cpA, const ChokePoint * cpB, const CPPath
 template<class Context>
 void Graph::ComputeChokePointDistances(const Context * pContext)
 {
-///	multimap<int, vector<WalkPosition>> trace;
-
 	for (const ChokePoint * pStart : pContext->ChokePoints())
 	{
-		vector<const ChokePoint *> Targets;
-		for (const ChokePoint * cp : pContext->ChokePoints())
-		{
-			if (cp == pStart) break;	// breaks symmetry
-			Targets.push_back(cp);
-		}
-
-		auto DistanceToTargets = pContext->ComputeDistances(pStart, Targets);
+		vector<const ChokePoint *> Targets = targetsBefore(pContext, pStart);
+		ApplyChokePointDistances(pContext, pStart, Targets, pContext->ComputeDistances(pStart, Targets));
+	}
+}
+template void Graph::ComputeChokePointDistances<Graph>(const Graph * pContext);
+template void Graph::ComputeChokePointDistances<Area>(const Area * pContext);
 
-		for (int i = 0 ; i < (int)Targets.size() ; ++i)
-		{
-			int newDist = DistanceToTargets[i];
-			int existingDist = Distance(pStart, Targets[i]);
 
-			if (newDist && ((existingDist == -1) || (newDist < existingDist)))
-			{
-				SetDistance(pStart, Targets[i], newDist);
+// Records the distances (and paths) from pStart to each of Targets that improve on the current ones.
+template<class Context>
+void Graph::ApplyChokePointDistances(const Context * pContext, const ChokePoint * pStart, const vector<const ChokePoint *> & Targets, const vector<int> & DistanceToTargets)
+{
+	for (int i = 0 ; i < (int)Targets.size() ; ++i)
+	{
+		int newDist = DistanceToTargets[i];
+		int existingDist = Distance(pStart, Targets[i]);
 
-				// Build the path from pStart to Targets[i]:
+		if (newDist && ((existingDist == -1) || (newDist < existingDist)))
+		{
+			SetDistance(pStart, Targets[i], newDist);
 
-				CPPath Path {pStart, Targets[i]};
+			// Build the path from pStart to Targets[i]:
 
-				// if (Context == Graph), there may be intermediate ChokePoints. They have been set by ComputeDistances,
-				// so we just have to collect them (in the reverse order) and insert them into Path:
-				if ((void *)(pContext) == (void *)(this))	// tests (Context == Graph) without warning about constant condition
-					for (const ChokePoint * pPrev = Targets[i]->PathBackTrace() ; pPrev != pStart ; pPrev = pPrev->PathBackTrace())
-						Path.insert(Path.begin()+1, pPrev);
+			CPPath Path {pStart, Targets[i]};
 
-				SetPath(pStart, Targets[i], Path);
+			// if (Context == Graph), there may be intermediate ChokePoints. They have been set by ComputeDistances,
+			// so we just have to collect them (in the reverse order) and insert them into Path:
+			if ((void *)(pContext) == (void *)(this))	// tests (Context == Graph) without warning about constant condition
+				for (const ChokePoint * pPrev = Targets[i]->PathBackTrace() ; pPrev != pStart ; pPrev = pPrev->PathBackTrace())
+					Path.insert(Path.begin()+1, pPrev);
 
-			///	vector<WalkPosition> PathTrace;
-			///	for (auto e : Path) PathTrace.push_back(e->Center());
-			///	trace.emplace(int(0.5 + DistanceToTargets[i]/8.0), PathTrace);
-			}
+			SetPath(pStart, Targets[i], Path);
 		}
 	}
-
-///	for (auto & line : trace) { Log << line.first; for (auto e : line.second) Log << " " << e; Log << endl; }
-
 }
-
-template void Graph::ComputeChokePointDistances<Graph>(const Graph * pContext);
-template void Graph::ComputeChokePointDistances<Area>(const Area * pContext);
+template void Graph::ApplyChokePointDistances<Graph>(const Graph * pContext, const ChokePoint * pStart, const vector<const ChokePoint *> & Targets, const vector<int> & DistanceToTargets);
+template void Graph::ApplyChokePointDistances<Area>(const Area * pContext, const ChokePoint * pStart, const vector<const ChokePoint *> & Targets, const vector<int> & DistanceToTargets);
 
 
 void Graph::ComputeChokePointDistanceMatrix()
@@ -308,8 +345,25 @@ void Graph::ComputeChokePointDistanceMatrix()
 		line.resize(m_ChokePointList.size());
 
 	// 2) Compute distances inside each Area
-	for (const Area & area : Areas())
-		ComputeChokePointDistances(&area);
+	//    The Dijkstras of the different Areas are independent (Cf. Area::ComputeDistances), so they are run in parallel.
+	//    The results are then applied in the serial order, so the matrix is identical to the one computed serially.
+	vector<vector<vector<int>>> DistancesByArea(Areas().size());
+	parallelFor((int)Areas().size(), [this, &DistancesByArea](int i)
+	{
+		const Area & area = Areas()[i];
+		for (const ChokePoint * pStart : area.ChokePoints())
+			DistancesByArea[i].push_back(area.ComputeDistances(pStart, targetsBefore(&area, pStart)));
+	});
+
+	for (int i = 0 ; i < (int)Areas().size() ; ++i)
+	{
+		const Area & area = Areas()[i];
+		for (int j = 0 ; j < (int)area.ChokePoints().size() ; ++j)
+		{
+			const ChokePoint * pStart = area.ChokePoints()[j];
+			ApplyChokePointDistances(&area, pStart, targetsBefore(&area, pStart), DistancesByArea[i][j]);
+		}
+	}
 
 	// 3) Compute distances through connected Areas
 	ComputeChokePointDistances(this);
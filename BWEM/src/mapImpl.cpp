@@ -57,6 +57,8 @@ MapImpl::~MapImpl()
 
 void MapImpl::Initialize(BWAPI::Game *game)
 {
+	vector<altitude_t> precomputedAltitudes = move(m_precomputedAltitudes);
+
 	this->~MapImpl();
     new (this) MapImpl();
 
@@ -87,7 +89,8 @@ void MapImpl::Initialize(BWAPI::Game *game)
 	InitializeNeutrals(game);
 ///	bw << "Map::InitializeNeutrals: " << timer.ElapsedMilliseconds() << " ms" << endl; timer.Reset();
 
-	ComputeAltitude();
+	if (!LoadAltitude(precomputedAltitudes))
+		ComputeAltitude();
 ///	bw << "Map::ComputeAltitude: " << timer.ElapsedMilliseconds() << " ms" << endl; timer.Reset();
 
 	ProcessBlockingNeutrals();
@@ -341,6 +344,40 @@ void MapImpl::ComputeAltitude()
 }
 
 
+// Assigns MiniTile::m_altitude from altitudes exported by a previous call to ComputeAltitude on the same map.
+// Returns false if the altitudes don't match the map, in which case nothing is changed.
+bool MapImpl::LoadAltitude(const vector<altitude_t> & altitudes)
+{
+	if ((int)altitudes.size() != WalkSize().x * WalkSize().y) return false;
+
+	m_maxAltitude = 0;
+	for (int y = 0 ; y < WalkSize().y ; ++y)
+	for (int x = 0 ; x < WalkSize().x ; ++x)
+	{
+		auto & miniTile = GetMiniTile_(WalkPosition(x, y), check_t::no_check);
+		if (miniTile.AltitudeMissing())
+		{
+			altitude_t altitude = altitudes[x + y * WalkSize().x];
+			miniTile.SetAltitude(altitude);
+			m_maxAltitude = max(m_maxAltitude, altitude);
+		}
+	}
+
+	return true;
+}
+
+
+vector<altitude_t> MapImpl::ExportAltitudes() const
+{
+	vector<altitude_t> altitudes(WalkSize().x * WalkSize().y);
+	for (int y = 0 ; y < WalkSize().y ; ++y)
+	for (int x = 0 ; x < WalkSize().x ; ++x)
+		altitudes[x + y * WalkSize().x] = GetMiniTile(WalkPosition(x, y), check_t::no_check).Altitude();
+
+	return altitudes;
+}
+
+
 void MapImpl::ProcessBlockingNeutrals()
 {
 	vector<Neutral *> Candidates;
@@ -1,6 +1,7 @@
 #include "Common.h"
 #include "BOSSManager.h"
 #include "UnitUtil.h"
+#include "Profiler.h"
 
 using namespace UAlbertaBot;
 
@@ -28,6 +29,8 @@ void BOSSManager::reset()
 // start a new search for a new goal
 void BOSSManager::startNewSearch(const std::vector<MetaPair> & goalUnits)
 {
+	PROFILE_ZONE("BOSS start search");
+
     size_t numWorkers   = UnitUtil::GetAllUnitCount(BWAPI::Broodwar->self()->getRace().getWorker());
     size_t numDepots    = UnitUtil::GetAllUnitCount(BWAPI::Broodwar->self()->getRace().getCenter())
                         + UnitUtil::GetAllUnitCount(BWAPI::UnitTypes::Zerg_Lair)
@@ -51,6 +54,13 @@ void BOSSManager::startNewSearch(const std::vector<MetaPair> & goalUnits)
     {
         BOSS::BuildOrderSearchGoal goal = GetGoal(goalUnits);
 
+        // Plan with the income our workers have actually been gathering
+        double mineralIncome = WorkerManager::Instance().getMineralIncomePerWorker();
+        if (mineralIncome > 0.0)
+        {
+            BOSS::Constants::SetMineralsPerWorkerPerFrame(size_t(mineralIncome * BOSS::Constants::RESOURCE_SCALE + 0.5));
+        }
+
         BOSS::GameState initialState(BWAPI::Broodwar, BWAPI::Broodwar->self(), BuildingManager::Instance().buildingTypesQueued());
 
         _smartSearch = SearchPtr(new BOSS::DFBB_BuildOrderSmartSearch(initialState.getRace()));
@@ -125,14 +135,16 @@ void BOSSManager::update(double timeLimit)
         _previousStatus.clear();
 
         // give the search at least 5ms to search this frame
+        // and never less than 1ms, since a time limit of 0 means no limit
         double realTimeLimit = timeLimit < 0 ? 5 : timeLimit;
-        _smartSearch->setTimeLimit((int)realTimeLimit);
+        _smartSearch->setTimeLimit((std::max)(1, (int)realTimeLimit));
         bool caughtException = false;
 
 		try
         {
             // call the search to continue searching
             // this will resume a search in progress or start a new search if not yet started
+			PROFILE_ZONE("BOSS search");
 			_smartSearch->search();
 		}
 		catch (const BOSS::BOSSException &)
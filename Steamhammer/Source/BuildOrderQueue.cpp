@@ -19,7 +19,7 @@ BuildOrderQueue::BuildOrderQueue()
 
 void BuildOrderQueue::clearAll() 
 {
-    if (!queue.empty()) Log().Debug() << "Cleared build queue";
+    if (!queue.empty()) LOG_DEBUG << "Cleared build queue";
     queue.clear();
 	modified = true;
 }
@@ -46,21 +46,21 @@ void BuildOrderQueue::queueAsHighestPriority(MacroAct m, bool gasSteal)
 {
 	queue.push_back(BuildOrderItem(m, gasSteal));
 	modified = true;
-	Log().Debug() << "Queued " << m << " at top of queue";
+	LOG_DEBUG << "Queued " << m << " at top of queue";
 }
 
 void BuildOrderQueue::queueAsLowestPriority(MacroAct m) 
 {
 	queue.push_front(BuildOrderItem(m));
 	modified = true;
-	Log().Debug() << "Queued " << m << " at bottom of queue";
+	LOG_DEBUG << "Queued " << m << " at bottom of queue";
 }
 
 void BuildOrderQueue::removeHighestPriorityItem() 
 {
 	queue.pop_back();
 	modified = true;
-	Log().Debug() << "Removed highest priority item";
+	LOG_DEBUG << "Removed highest priority item";
 }
 
 void BuildOrderQueue::doneWithHighestPriorityItem()
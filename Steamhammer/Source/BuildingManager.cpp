@@ -146,7 +146,7 @@ void BuildingManager::assignWorkersToUnassignedBuildings()
         b.status = BuildingStatus::Assigned;
 		// BWAPI::Broodwar->printf("assigned and placed building %s", b.type.getName().c_str());
 
-		Log().Debug() << "Assigned " << b.builderUnit->getID() << " to build " << b.type << " @ " << b.finalPosition;
+		LOG_DEBUG << "Assigned " << b.builderUnit->getID() << " to build " << b.type << " @ " << b.finalPosition;
 	}
 }
 
@@ -212,7 +212,7 @@ void BuildingManager::constructAssignedBuildings()
 
 				// Unreserve the building location. The building will mark its own location.
 				BuildingPlacer::Instance().freeTiles(b.finalPosition, b.type.tileWidth(), b.type.tileHeight());
-				Log().Debug() << "Failed to build " << b.type << " @ " << b.finalPosition << "; assume something was in the way";
+				LOG_DEBUG << "Failed to build " << b.type << " @ " << b.finalPosition << "; assume something was in the way";
 
                 // If we're trying to build a nexus against a terran opponent, assume there's a spider mine in the way
                 // We'll send a unit by to clear it
@@ -222,7 +222,7 @@ void BuildingManager::constructAssignedBuildings()
                     auto base = InformationManager::Instance().baseAt(b.finalPosition);
                     if (base)
                     {
-                        Log().Debug() << "Detected spider mine blocking base @ " << b.finalPosition;
+                        LOG_DEBUG << "Detected spider mine blocking base @ " << b.finalPosition;
                         base->spiderMined = true;
                     }
                 }
@@ -232,7 +232,7 @@ void BuildingManager::constructAssignedBuildings()
 				// Issue the build order and record whether it succeeded.
 				// If the builderUnit is zerg, it changes to !exists() when it builds.
 				b.buildCommandGiven = b.builderUnit->build(b.type, b.finalPosition);
-				Log().Debug() << "Gave build command to " << b.builderUnit->getID() << " to build " << b.type << " @ " << b.finalPosition << "; result " << b.buildCommandGiven;
+				LOG_DEBUG << "Gave build command to " << b.builderUnit->getID() << " to build " << b.type << " @ " << b.finalPosition << "; result " << b.buildCommandGiven;
 
                 // The build command failed, let's try to figure out why
                 if (!b.buildCommandGiven)
@@ -385,7 +385,7 @@ void BuildingManager::checkForCompletedBuildings()
 
         if (b.buildingUnit->isCompleted())
         {
-			Log().Debug() << "Completed building " << b.type << " @ " << b.finalPosition;
+			LOG_DEBUG << "Completed building " << b.type << " @ " << b.finalPosition;
 
             // if we are terran, give the worker back to worker manager
 			// Zerg and protoss are handled when the building starts.
@@ -472,7 +472,7 @@ Building & BuildingManager::addTrackedBuildingTask(const MacroAct & act, BWAPI::
 	if (act.hasReservedPosition())
 		b.finalPosition = act.getReservedPosition();
 
-	Log().Debug() << "Queued building task for " << type;
+	LOG_DEBUG << "Queued building task for " << type;
 
 	_buildings.push_back(b);      // make a "permanent" copy of the Building object
 	return _buildings.back();     // return a reference to the permanent copy
@@ -5,6 +5,7 @@
 #include "MapGrid.h"
 #include "MapTools.h"
 #include "PathFinding.h"
+#include "Profiler.h"
 
 using namespace UAlbertaBot;
 
@@ -20,7 +21,7 @@ BuildingPlacer::BuildingPlacer()
     , _centerProxyBlock (-1)
     , _proxyBlock       (-1)
 {
-    _reserveMap = std::vector< std::vector<bool> >(BWAPI::Broodwar->mapWidth(),std::vector<bool>(BWAPI::Broodwar->mapHeight(),false));
+    _reserveMap = TileBitGrid(BWAPI::Broodwar->mapWidth(), BWAPI::Broodwar->mapHeight(), false);
 
     computeResourceBox();
 }
@@ -81,15 +82,9 @@ bool BuildingPlacer::canBuildHere(BWAPI::TilePosition position,const Building &
     }
 
     // check the reserve map
-    for (int x = position.x; x < position.x + b.type.tileWidth(); x++)
+    if (_reserveMap.anyInRect(position.x, position.y, b.type.tileWidth(), b.type.tileHeight()))
     {
-        for (int y = position.y; y < position.y + b.type.tileHeight(); y++)
-        {
-            if (_reserveMap[x][y])
-            {
-                return false;
-            }
-        }
+        return false;
     }
 
     // if it overlaps a base location return false
@@ -167,19 +162,28 @@ bool BuildingPlacer::canBuildHereWithSpace(BWAPI::TilePosition position,const Bu
         return false;
     }
 
-    // if space is reserved, or it's in the resource box, we can't build here
+    // refineries go on the geyser, so the checks below don't apply
+    if (b.type.isRefinery())
+    {
+        return true;
+    }
+
+    // if space is reserved, we can't build here
+    // checking the whole rectangle at once is cheap, so do it before the per-tile checks
+    if (_reserveMap.anyInRect(startx, starty, endx - startx, endy - starty))
+    {
+        return false;
+    }
+
+    // if it's not buildable, or it's in the resource box, we can't build here
     for (int x = startx; x < endx; x++)
     {
         for (int y = starty; y < endy; y++)
         {
-            if (!b.type.isRefinery())
+            if (!buildable(b,x,y) ||
+                (b.type != BWAPI::UnitTypes::Protoss_Photon_Cannon && isInResourceBox(x,y)))
             {
-                if (!buildable(b,x,y) ||
-					_reserveMap[x][y] ||
-					(b.type != BWAPI::UnitTypes::Protoss_Photon_Cannon && isInResourceBox(x,y)))
-                {
-                    return false;
-                }
+                return false;
             }
         }
     }
@@ -278,8 +282,8 @@ bool BuildingPlacer::buildable(const Building & b,int x,int y) const
 
 void BuildingPlacer::reserveTiles(BWAPI::TilePosition position,int width,int height)
 {
-    int rwidth = _reserveMap.size();
-    int rheight = _reserveMap[0].size();
+    int rwidth = _reserveMap.width();
+    int rheight = _reserveMap.height();
     for (int x = position.x; x < position.x + width && x < rwidth; x++)
     {
         for (int y = position.y; y < position.y + height && y < rheight; y++)
@@ -287,7 +291,7 @@ void BuildingPlacer::reserveTiles(BWAPI::TilePosition position,int width,int hei
 			BWAPI::TilePosition t(x, y);
 			if (!t.isValid()) continue;
 
-			_reserveMap[x][y] = true;
+			_reserveMap.set(x, y, true);
 			bwebMap.getUsedTiles().insert(t);
             bwebMap.usedTilesGrid[x][y] = true;
 		}
@@ -301,14 +305,14 @@ void BuildingPlacer::drawReservedTiles()
         return;
     }
 
-    int rwidth = _reserveMap.size();
-    int rheight = _reserveMap[0].size();
+    int rwidth = _reserveMap.width();
+    int rheight = _reserveMap.height();
 
     for (int x = 0; x < rwidth; ++x)
     {
         for (int y = 0; y < rheight; ++y)
         {
-            if (_reserveMap[x][y] || isInResourceBox(x,y))
+            if (_reserveMap.get(x, y) || isInResourceBox(x,y))
             {
                 int x1 = x*32 + 8;
                 int y1 = y*32 + 8;
@@ -323,8 +327,8 @@ void BuildingPlacer::drawReservedTiles()
 
 void BuildingPlacer::freeTiles(BWAPI::TilePosition position, int width, int height)
 {
-    int rwidth = _reserveMap.size();
-    int rheight = _reserveMap[0].size();
+    int rwidth = _reserveMap.width();
+    int rheight = _reserveMap.height();
 
     for (int x = position.x; x < position.x + width && x < rwidth; x++)
     {
@@ -333,7 +337,7 @@ void BuildingPlacer::freeTiles(BWAPI::TilePosition position, int width, int heig
 			BWAPI::TilePosition t(x, y);
 			if (!t.isValid()) continue;
 			
-			_reserveMap[x][y] = false;
+			_reserveMap.set(x, y, false);
 			bwebMap.getUsedTiles().erase(t);
             bwebMap.usedTilesGrid[x][y] = false;
 		}
@@ -379,18 +383,20 @@ BWAPI::TilePosition BuildingPlacer::getRefineryPosition()
 
 bool BuildingPlacer::isReserved(int x, int y) const
 {
-    int rwidth = _reserveMap.size();
-    int rheight = _reserveMap[0].size();
+    int rwidth = _reserveMap.width();
+    int rheight = _reserveMap.height();
     if (x < 0 || y < 0 || x >= rwidth || y >= rheight)
     {
         return false;
     }
 
-    return _reserveMap[x][y];
+    return _reserveMap.get(x, y);
 }
 
 void BuildingPlacer::initializeBWEB()
 {
+    PROFILE_ZONE("BWEB init");
+
     bwebMap.onStart();
 
     // TODO: Check if non-tight walls are better vs. protoss and terran
@@ -544,7 +550,7 @@ int addProxyBlock(BWAPI::TilePosition tile, std::set<BWAPI::TilePosition> & unbu
         newBlock.insertLarge(tile + BWAPI::TilePosition(6, 3));
         bwebMap.blocks.push_back(newBlock);
 
-        Log().Debug() << "Added 10x6 proxy block @ " << tile;
+        LOG_DEBUG << "Added 10x6 proxy block @ " << tile;
 
         return bwebMap.blocks.size() - 1;
     }   
@@ -559,7 +565,7 @@ int addProxyBlock(BWAPI::TilePosition tile, std::set<BWAPI::TilePosition> & unbu
         newBlock.insertLarge(tile + BWAPI::TilePosition(6, 0));
         bwebMap.blocks.push_back(newBlock);
 
-        Log().Debug() << "Added 10x3 proxy block @ " << tile;
+        LOG_DEBUG << "Added 10x3 proxy block @ " << tile;
 
         return bwebMap.blocks.size() - 1;
     }   
@@ -575,12 +581,12 @@ int addProxyBlock(BWAPI::TilePosition tile, std::set<BWAPI::TilePosition> & unbu
         newBlock.insertLarge(tile + BWAPI::TilePosition(0, 5));
         bwebMap.blocks.push_back(newBlock);
 
-        Log().Debug() << "Added 4x8 proxy block @ " << tile;
+        LOG_DEBUG << "Added 4x8 proxy block @ " << tile;
 
         return bwebMap.blocks.size() - 1;
     }
 
-    Log().Debug() << "Could not add proxy block @ " << tile;
+    LOG_DEBUG << "Could not add proxy block @ " << tile;
 
     return -1;
 }
@@ -883,7 +889,7 @@ void BuildingPlacer::findProxyBlocks()
     // Add the block
     _centerProxyBlock = addProxyBlock(overallTileBest, unbuildableTiles);
 
-    Log().Debug() << debug.str();
+    LOG_DEBUG << debug.str();
 }
 
 BWAPI::TilePosition buildLocationInBlock(BWAPI::UnitType type, const BWEB::Block & block)
@@ -6,6 +6,7 @@
 #include "InformationManager.h"
 #include "BuildOrder.h"
 #include "LocutusWall.h"
+#include "TileBitGrid.h"
 
 namespace UAlbertaBot
 {
@@ -14,7 +15,7 @@ class BuildingPlacer
 {
     BuildingPlacer();
 
-    std::vector< std::vector<bool> > _reserveMap;
+    TileBitGrid _reserveMap;
 
     int     _boxTop;
     int	    _boxBottom;
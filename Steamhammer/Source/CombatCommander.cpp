@@ -1,6 +1,7 @@
 #include "CombatCommander.h"
 
 #include "Bases.h"
+#include "DamageAssignment.h"
 #include "OpponentModel.h"
 #include "ProductionManager.h"
 #include "Random.h"
@@ -112,26 +113,7 @@ void CombatCommander::update(const BWAPI::Unitset & combatUnits)
 
     _combatUnits = combatUnits;
 
-	int frame8 = BWAPI::Broodwar->getFrameCount() % 8;
-
-	if (frame8 == 1)
-	{
-		updateIdleSquad();
-        updateKamikazeSquad();
-		updateProxySquad();
-		updateDropSquads();
-        updateBlockScoutingSquad();
-        updateScoutDefenseSquad();
-		updateBaseDefenseSquads();
-		updateHarassSquads();
-        updateDefuseSquads();
-		updateReconSquad();
-		updateAttackSquads();
-	}
-	else if (frame8 % 4 == 2)
-	{
-		doComsatScan();
-	}
+	DamageAssignment::Instance().update();
 
 	loadOrUnloadBunkers();
 
@@ -140,6 +122,30 @@ void CombatCommander::update(const BWAPI::Unitset & combatUnits)
 	cancelDyingItems();
 }
 
+// Reassign units among the squads.
+// The frame scheduler runs this every 8 frames, before update(), and may put it off when time is short.
+void CombatCommander::updateSquadAssignments(const BWAPI::Unitset & combatUnits)
+{
+    if (!_initialized)
+    {
+        initializeSquads();
+    }
+
+    _combatUnits = combatUnits;
+
+	updateIdleSquad();
+    updateKamikazeSquad();
+	updateProxySquad();
+	updateDropSquads();
+    updateBlockScoutingSquad();
+    updateScoutDefenseSquad();
+	updateBaseDefenseSquads();
+	updateHarassSquads();
+    updateDefuseSquads();
+	updateReconSquad();
+	updateAttackSquads();
+}
+
 void CombatCommander::updateIdleSquad()
 {
     Squad & idleSquad = _squadData.getSquad("Idle");
@@ -465,7 +471,7 @@ void CombatCommander::updateHarassSquads()
                     ui.second.lastPosition.isValid() && !ui.second.goneFromLastPosition &&
                     BWTA::getRegion(BWAPI::TilePosition(ui.second.lastPosition)) == base->getRegion())
                 {
-                    Log().Debug() << "Continuing harass because of enemy " << ui.second.type << " @ " << BWAPI::TilePosition(ui.second.lastPosition);
+                    LOG_DEBUG << "Continuing harass because of enemy " << ui.second.type << " @ " << BWAPI::TilePosition(ui.second.lastPosition);
                     harassBase = true;
                     break;
                 }
@@ -1293,7 +1299,7 @@ void CombatCommander::updateBlockScoutingSquad()
                 enemyWorkerClose = true;
     if (disband || nearbyDragoons > 1 || (nearbyDragoons == 1 && !enemyWorkerClose))
     {
-        Log().Debug() << "Disbanded block scout squad";
+        LOG_DEBUG << "Disbanded block scout squad";
         blockRampSquad.clear();
         _squadData.removeSquad("Block scout");
         return;
@@ -1719,7 +1725,7 @@ void CombatCommander::updateBaseDefenseSquads()
                 PathFinding::PathFindingOptions::UseNearestBWEMArea);
             int workerMovementFrames = 1.3 * wallDistance / BWAPI::UnitTypes::Protoss_Probe.topSpeed();
 
-            Log().Debug() << "Active wall cannons: " << activeWallCannons << "; rush distance: " << rushDistance << "; arrival frame: " << zerglingArrivalFrame << "; worker frames: " << workerMovementFrames;
+            LOG_DEBUG << "Active wall cannons: " << activeWallCannons << "; rush distance: " << rushDistance << "; arrival frame: " << zerglingArrivalFrame << "; worker frames: " << workerMovementFrames;
 
             // Simulate 3 zerglings in the first wave, 2 in following waves to get a suitable number of workers
             if (BWAPI::Broodwar->getFrameCount() > (zerglingArrivalFrame - workerMovementFrames))
@@ -1804,7 +1810,7 @@ void CombatCommander::updateBaseDefenseSquads()
             }
         }
 
-        Log().Debug() << "Defense squad " << defenseSquad.getName() << ": needs " << groundDefendersNeeded << ", assigned " << defenseSquad.getUnits().size();
+        LOG_DEBUG << "Defense squad " << defenseSquad.getName() << ": needs " << groundDefendersNeeded << ", assigned " << defenseSquad.getUnits().size();
         updateDefenseSquadUnits(defenseSquad, flyingDefendersNeeded, groundDefendersNeeded, pullWorkers, preferRangedUnits, requiresMineralWalk);
 
         // Add an observer if needed
@@ -1917,7 +1923,7 @@ void CombatCommander::updateDefenseSquadUnits(
 			groundDefendersAdded += 4;
 		else
 			groundDefendersAdded += 5;
-        Log().Debug() << "Assigned " << defenderToAdd->getType() << " " << defenderToAdd->getID() << " @ " << defenderToAdd->getTilePosition();
+        LOG_DEBUG << "Assigned " << defenderToAdd->getType() << " " << defenderToAdd->getID() << " @ " << defenderToAdd->getTilePosition();
 		_squadData.assignUnitToSquad(defenderToAdd, defenseSquad);
 	}
 
@@ -1961,8 +1967,8 @@ BWAPI::Unit CombatCommander::findClosestDefender(
 
         if (!_squadData.canAssignUnitToSquad(unit, defenseSquad))
         {
-            Log().Debug() << "Cannot assign " << unit->getType() << " @ " << unit->getTilePosition();
-            if (_squadData.getUnitSquad(unit)) Log().Debug() << "current squad: " << _squadData.getUnitSquad(unit)->getName();
+            LOG_DEBUG << "Cannot assign " << unit->getType() << " @ " << unit->getTilePosition();
+            if (_squadData.getUnitSquad(unit)) LOG_DEBUG << "current squad: " << _squadData.getUnitSquad(unit)->getName();
             continue;
         }
 
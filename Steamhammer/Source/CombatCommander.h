@@ -36,7 +36,6 @@ class CombatCommander
     void            updateProxySquad();
 
 	void			loadOrUnloadBunkers();
-	void			doComsatScan();
 
 	int				weighReconUnit(const BWAPI::Unit unit) const;
 	int				weighReconUnit(const BWAPI::UnitType type) const;
@@ -80,6 +79,8 @@ public:
 	CombatCommander();
 
 	void update(const BWAPI::Unitset & combatUnits);
+	void updateSquadAssignments(const BWAPI::Unitset & combatUnits);
+	void doComsatScan();
 
 	void setAggression(bool aggressive) 
 	{ 
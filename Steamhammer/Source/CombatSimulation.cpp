@@ -14,14 +14,34 @@ CombatSimulation::CombatSimulation()
     , enemyVanguard(BWAPI::Positions::Invalid)
     , enemyUnitsCentroid(BWAPI::Positions::Invalid)
     , airBattle(false)
+    , rushing(false)
+    , narrowChoke(false)
+    , elevationDifference(0)
 {
 }
 
+// Squads are copied around by value. The FAP state is only meaningful between
+// setCombatUnits() and simulateCombat(), so a copy does not take it.
+CombatSimulation::CombatSimulation(const CombatSimulation &)
+    : CombatSimulation()
+{
+}
+
+CombatSimulation::~CombatSimulation()
+{
+}
+
+CombatSimulation & CombatSimulation::operator=(const CombatSimulation &)
+{
+    return *this;
+}
+
 // sets the starting states based on the combat units within a radius of a given position
 // this center will most likely be the position of the forwardmost combat unit we control
 void CombatSimulation::setCombatUnits(BWAPI::Position _myVanguard, BWAPI::Position _enemyVanguard, int radius, bool visibleOnly, bool ignoreBunkers)
 {
-    fap.clearState();
+    if (!fap) fap.reset(new FastAPproximation());
+    fap->clearState();
     myVanguard = _myVanguard;
     myUnitsCentroid = BWAPI::Positions::Invalid;
     enemyVanguard = _enemyVanguard;
@@ -32,15 +52,15 @@ void CombatSimulation::setCombatUnits(BWAPI::Position _myVanguard, BWAPI::Positi
     // cloaked units if they have any detectors in the sim
     bool enemyHasDetection = false;
 
-    std::vector<UnitInfo> enemyUnits;
+    FrameVector<UnitInfo> enemyUnits;
 
-    bool rushing = StrategyManager::Instance().isRushingOrProxyRushing();
+    rushing = StrategyManager::Instance().isRushingOrProxyRushing();
 
 	// Add enemy units.
 	if (visibleOnly)
 	{
 		// Only units that we can see right now.
-		BWAPI::Unitset enemyCombatUnits;
+		FrameVector<BWAPI::Unit> enemyCombatUnits;
 		MapGrid::Instance().getUnits(enemyCombatUnits, enemyVanguard, radius, false, true);
 		for (const auto unit : enemyCombatUnits)
 		{
@@ -58,7 +78,7 @@ void CombatSimulation::setCombatUnits(BWAPI::Position _myVanguard, BWAPI::Positi
 		}
 
 		// Also static defense that is out of sight.
-		std::vector<UnitInfo> enemyStaticDefense;
+		FrameVector<UnitInfo> enemyStaticDefense;
 		InformationManager::Instance().getNearbyForce(enemyStaticDefense, enemyVanguard, BWAPI::Broodwar->enemy(), radius);
 		for (const UnitInfo & ui : enemyStaticDefense)
 		{
@@ -83,7 +103,7 @@ void CombatSimulation::setCombatUnits(BWAPI::Position _myVanguard, BWAPI::Positi
 	{
 		// All known enemy units, according to their most recently seen position.
 		// Skip if goneFromLastPosition, which means the last position was seen and the unit wasn't there.
-		std::vector<UnitInfo> enemyCombatUnits;
+		FrameVector<UnitInfo> enemyCombatUnits;
 		InformationManager::Instance().getNearbyForce(enemyCombatUnits, enemyVanguard, BWAPI::Broodwar->enemy(), radius);
 		for (const UnitInfo & ui : enemyCombatUnits)
 		{
@@ -122,7 +142,7 @@ void CombatSimulation::setCombatUnits(BWAPI::Position _myVanguard, BWAPI::Positi
             debug << "\n" << unit.type << " @ " << BWAPI::TilePosition(unit.lastPosition);
 #endif
 
-            fap.addIfCombatUnitPlayer2(unit);
+            fap->addIfCombatUnitPlayer2(unit);
             enemyUnitsCentroid += unit.lastPosition;
             if (unit.type.isDetector()) enemyHasDetection = true;
         }
@@ -131,9 +151,9 @@ void CombatSimulation::setCombatUnits(BWAPI::Position _myVanguard, BWAPI::Positi
     }
 
 	// Collect our units.
-	BWAPI::Unitset ourCombatUnits;
+	FrameVector<BWAPI::Unit> ourCombatUnits;
 	MapGrid::Instance().getUnits(ourCombatUnits, myVanguard, radius, true, false);
-    std::vector<BWAPI::Unit> myUnits;
+    FrameVector<BWAPI::Unit> myUnits;
 	for (const auto unit : ourCombatUnits)
 	{
 		if (UnitUtil::IsCombatSimUnit(unit))
@@ -162,7 +182,7 @@ void CombatSimulation::setCombatUnits(BWAPI::Position _myVanguard, BWAPI::Positi
 #endif
             FastAPproximation::FAPUnit fapUnit(unit);
             fapUnit.undetected = fapUnit.undetected && !enemyHasDetection;
-            fap.addIfCombatUnitPlayer1(fapUnit);
+            fap->addIfCombatUnitPlayer1(fapUnit);
             myUnitsCentroid += unit->getPosition();
 
             if (unit->isFlying()) airBattle = true;
@@ -172,16 +192,59 @@ void CombatSimulation::setCombatUnits(BWAPI::Position _myVanguard, BWAPI::Positi
     }
 
 #ifdef COMBATSIM_DEBUG
-    Log().Debug() << debug.str();
+    LOG_DEBUG << debug.str();
 #endif
+
+    analyzeGeography();
 }
 
-std::pair<int, int> CombatSimulation::simulate(int frames, bool narrowChoke, int elevationDifference, std::pair<int, int> & initialScores)
+// Analyze the ground geography if we know where the armies are located
+// Doesn't apply to rushes: zealots don't have as many problems with chokes, and FAP will simulate elevation
+void CombatSimulation::analyzeGeography()
 {
-    fap.simulate(frames);
+    narrowChoke = false;
+    elevationDifference = 0;
+    if (!myUnitsCentroid.isValid() || !enemyVanguard.isValid() || airBattle || rushing) return;
 
-    int ourChange = initialScores.first - fap.playerScores().first;
-    int theirChange = initialScores.second - fap.playerScores().second;
+#ifdef COMBATSIM_DEBUG
+    std::ostringstream debug;
+    debug << "Combat sim geography";
+#endif
+
+    // Are we attacking through a narrow choke?
+    for (auto choke : PathFinding::GetChokePointPath(myUnitsCentroid, enemyVanguard))
+    {
+        if (((ChokeData*)choke->Ext())->width < 96)
+        {
+            narrowChoke = true;
+#ifdef COMBATSIM_DEBUG
+            debug << "\nFight crosses narrow choke";
+#endif
+        }
+    }
+
+    // Is there an elevation difference?
+    elevationDifference = BWAPI::Broodwar->getGroundHeight(BWAPI::TilePosition(enemyVanguard))
+        - BWAPI::Broodwar->getGroundHeight(BWAPI::TilePosition(myUnitsCentroid));
+#ifdef COMBATSIM_DEBUG
+    if (elevationDifference > 0)
+    {
+        debug << "\nFight is uphill";
+    }
+    else if (elevationDifference < 0)
+    {
+        debug << "\nFight is downhill";
+    }
+    LOG_DEBUG << debug.str();
+#endif
+}
+
+std::pair<int, int> CombatSimulation::simulate(int frames, std::pair<int, int> & initialScores)
+{
+    fap->simulate(frames);
+
+    int ourChange = initialScores.first - fap->playerScores().first;
+    int theirChange = initialScores.second - fap->playerScores().second;
 
     // If fighting through a narrow choke, assume our units won't be as effective
     // Scales according to army size: the more units we have, the more the choke will affect performance
@@ -208,60 +271,27 @@ std::pair<int, int> CombatSimulation::simulate(int frames, bool narrowChoke, int
 
 int CombatSimulation::simulateCombat(bool currentlyRetreating)
 {
+    if (!fap) return 0;     // setCombatUnits() was not called
+
 #ifdef COMBATSIM_DEBUG
     std::ostringstream debug;
     debug << "combat sim" << (currentlyRetreating ? " (retreating)" : " (attacking)");
 #endif
 
-    bool rushing = StrategyManager::Instance().isRushingOrProxyRushing();
-
-    // Analyze the ground geography if we know where the armies are located
-    // Doesn't apply to rushes: zealots don't have as many problems with chokes, and FAP will simulate elevation
-    bool narrowChoke = false;
-    int elevationDifference = 0;
-    if (myUnitsCentroid.isValid() && enemyVanguard.isValid() && !airBattle && !rushing)
-    {
-        // Are we attacking through a narrow choke?
-        for (auto choke : PathFinding::GetChokePointPath(myUnitsCentroid, enemyVanguard))
-        {
-            if (((ChokeData*)choke->Ext())->width < 96)
-            {
-                narrowChoke = true;
-#ifdef COMBATSIM_DEBUG
-                debug << "\nFight crosses narrow choke";
-#endif
-            }
-        }
-
-        // Is there an elevation difference?
-        elevationDifference = BWAPI::Broodwar->getGroundHeight(BWAPI::TilePosition(enemyVanguard))
-            - BWAPI::Broodwar->getGroundHeight(BWAPI::TilePosition(myUnitsCentroid));
-#ifdef COMBATSIM_DEBUG
-        if (elevationDifference > 0)
-        {
-            debug << "\nFight is uphill";
-        }
-        else if (elevationDifference < 0)
-        {
-            debug << "\nFight is downhill";
-        }
-#endif
-    }
-
 #ifdef COMBATSIM_DEBUG
-    debug << "\nInitial values: ours " << fap.playerScores().first << " theirs " << fap.playerScores().second;
+    debug << "\nInitial values: ours " << fap->playerScores().first << " theirs " << fap->playerScores().second;
 #endif
 
-    std::pair<int, int> initial = fap.playerScores();
+    std::pair<int, int> initial = fap->playerScores();
 
     // Sim six seconds into the future, one second at a time
     std::pair<int, int> result;
     for (int step = 1; step <= 6; step++)
     {
-        result = simulate(24, narrowChoke, elevationDifference, initial);
+        result = simulate(24, initial);
 
 #ifdef COMBATSIM_DEBUG
-        debug << "\nResult after " << (step * 24) << " frames: ours " << fap.playerScores().first << " theirs " << fap.playerScores().second << " gain " << (result.second - result.first);
+        debug << "\nResult after " << (step * 24) << " frames: ours " << fap->playerScores().first << " theirs " << fap->playerScores().second << " gain " << (result.second - result.first);
 #endif
 
         // We short-circuit if we project a gain after 3 or more seconds and either:
@@ -269,36 +299,36 @@ int CombatSimulation::simulateCombat(bool currentlyRetreating)
         // - our losses are insignificant
         // - the gain is more significant than our loss
         if (step >= 3 && result.second > result.first && 
-            (fap.playerScores().first >= fap.playerScores().second || 
-                fap.playerScores().first >= (initial.first - 50) ||
-                (result.second - result.first) > (fap.playerScores().second - fap.playerScores().first)))
+            (fap->playerScores().first >= fap->playerScores().second || 
+                fap->playerScores().first >= (initial.first - 50) ||
+                (result.second - result.first) > (fap->playerScores().second - fap->playerScores().first)))
         {
 #ifdef COMBATSIM_DEBUG
             debug << "\nPositive result, short-circuiting";
-            Log().Debug() << debug.str();
+            LOG_DEBUG << debug.str();
 #endif
             return 1;
         }
 
         // While rushing, we are more aggressive
         if (step >= 3 && rushing && 
-            (fap.playerScores().first >= 300 || (!currentlyRetreating && fap.playerScores().first >= 100)) &&
-            (double)(fap.playerScores().second - initial.second) / (double)(fap.playerScores().first - initial.first) > 0.5)
+            (fap->playerScores().first >= 300 || (!currentlyRetreating && fap->playerScores().first >= 100)) &&
+            (double)(fap->playerScores().second - initial.second) / (double)(fap->playerScores().first - initial.first) > 0.5)
         {
 #ifdef COMBATSIM_DEBUG
             debug << "\nRush mode: acceptable loss";
-            Log().Debug() << debug.str();
+            LOG_DEBUG << debug.str();
 #endif
             return 1;
         }
     }
 
     // We project no result
-    if (fap.playerScores().first == initial.first && fap.playerScores().second == initial.second)
+    if (fap->playerScores().first == initial.first && fap->playerScores().second == initial.second)
     {
 #ifdef COMBATSIM_DEBUG
         debug << "\nNo result";
-        if (initial.first > 0 && initial.second > 0) Log().Debug() << debug.str();
+        if (initial.first > 0 && initial.second > 0) LOG_DEBUG << debug.str();
 #endif
         return 0;
     }
@@ -306,11 +336,11 @@ int CombatSimulation::simulateCombat(bool currentlyRetreating)
     // At this point we project either a loss or a risky gain, otherwise we would have returned earlier
 
     // Press the attack if our army outnumbers theirs by a good margin
-    if ((double)fap.playerScores().second / (double)fap.playerScores().first < 0.6)
+    if ((double)fap->playerScores().second / (double)fap->playerScores().first < 0.6)
     {
 #ifdef COMBATSIM_DEBUG
         debug << "\nTheir army is significantly smaller than ours; pressing the attack";
-        Log().Debug() << debug.str();
+        LOG_DEBUG << debug.str();
 #endif
         return 1;
     }
@@ -326,14 +356,14 @@ int CombatSimulation::simulateCombat(bool currentlyRetreating)
     if (ourPercentageChange < theirPercentageChange)
     {
 #ifdef COMBATSIM_DEBUG
-        Log().Debug() << debug.str();
+        LOG_DEBUG << debug.str();
 #endif
         return 1;
     }
 
     // Otherwise, we found no result to indicate an attack being worthwhile
 #ifdef COMBATSIM_DEBUG
-    Log().Debug() << debug.str();
+    LOG_DEBUG << debug.str();
 #endif
     return -1;
 }
@@ -5,25 +5,43 @@
 
 #include "InformationManager.h"
 
+#include <memory>
+
 namespace UAlbertaBot
 {
+struct FastAPproximation;
+
+// setCombatUnits() reads everything the sim needs from the game, on the main thread.
+// simulateCombat() then only runs the sim on the simulation's own FAP state, so the sims
+// of different squads can run at the same time as jobs.
 class CombatSimulation
 {
 private:
+    std::unique_ptr<FastAPproximation> fap;      // allocated on first use; a copy starts without one
+
     BWAPI::Position myVanguard;
     BWAPI::Position myUnitsCentroid;
     BWAPI::Position enemyVanguard;
     BWAPI::Position enemyUnitsCentroid;
     bool airBattle;
+    bool rushing;
+    bool narrowChoke;
+    int elevationDifference;
 
-    std::pair<int, int> simulate(int frames, bool narrowChoke, int elevationDifference, std::pair<int, int> & initialScores);
+    void analyzeGeography();
+    std::pair<int, int> simulate(int frames, std::pair<int, int> & initialScores);
 
 public:
 
 	CombatSimulation();
+	CombatSimulation(const CombatSimulation &);
+	~CombatSimulation();
+
+	CombatSimulation & operator=(const CombatSimulation &);
 
 	void setCombatUnits(BWAPI::Position _myVanguard, BWAPI::Position _enemyVanguard, const int radius, bool visibleOnly, bool ignoreBunkers);
 
+	// Does not call BWAPI; safe to run as a job.
 	int simulateCombat(bool currentlyRetreating);
 };
 }
\ No newline at end of file
@@ -60,6 +60,7 @@ namespace Config
     namespace Tournament						
     {
         int GameEndFrame                    = 86400;	
+        int FrameBudgetMs                   = 35;
     }
     
     namespace Debug								
@@ -89,6 +90,10 @@ namespace Config
         bool DrawBOSSStateInfo              = false;
 
         std::string ErrorLogFilename        = "Locutus_ErrorLog.txt";
+        std::string ProfileTraceFilename    = "";
+        std::string FrameRecordFilename     = "";
+        int MemoryCeilingMB                 = 0;
+        bool DeterministicJobs              = false;
         bool LogAssertToErrorFile           = false;
 
         bool LogDebug			            = false;
@@ -54,6 +54,7 @@ namespace Config
     namespace Tournament
     {
         extern int GameEndFrame;	
+        extern int FrameBudgetMs;
     }
 
     namespace Debug
@@ -83,6 +84,10 @@ namespace Config
 		extern bool DrawBOSSStateInfo;
 
         extern std::string ErrorLogFilename;
+        extern std::string ProfileTraceFilename;
+        extern std::string FrameRecordFilename;
+        extern int MemoryCeilingMB;
+        extern bool DeterministicJobs;
         extern bool LogAssertToErrorFile;
 
 		extern bool LogDebug;
@@ -0,0 +1,164 @@
+#include "DamageAssignment.h"
+
+#include "InformationManager.h"
+#include "UnitUtil.h"
+
+#include <limits>
+
+using namespace UAlbertaBot;
+
+namespace
+{
+	const int ImminentFrames = 8;		// count attacks whose weapon is ready within this many frames, plus latency
+	const int LandingFrames = 8;		// approximate time from the attack order to the damage showing
+}
+
+DamageAssignment & DamageAssignment::Instance()
+{
+	static DamageAssignment instance;
+	return instance;
+}
+
+void DamageAssignment::removeAttack(BWAPI::Unit attacker)
+{
+	auto it = _targetOf.find(attacker);
+	if (it == _targetOf.end()) return;
+
+	auto & attacks = _attacksOn[it->second];
+	attacks.erase(std::remove_if(attacks.begin(), attacks.end(),
+		[attacker](const PendingAttack & attack) { return attack.attacker == attacker; }),
+		attacks.end());
+	if (attacks.empty()) _attacksOn.erase(it->second);
+
+	_targetOf.erase(it);
+}
+
+// The damage one attack does to the target, with upgrades, armor and damage type.
+// Armor and damage type apply to each hit of the attack. Damage to shields ignores damage type, as in the game.
+int DamageAssignment::expectedDamage(BWAPI::Unit attacker, BWAPI::Unit target) const
+{
+	const BWAPI::WeaponType weapon = UnitUtil::GetWeapon(attacker, target);
+	if (weapon == BWAPI::WeaponTypes::None)
+	{
+		return 0;
+	}
+
+	// Player::damage() is for all of the weapon's hits together.
+	const int factor = (std::max)(1, weapon.damageFactor());
+	const int hitDamage = BWAPI::Broodwar->self()->damage(weapon) / factor;
+	const int maxHits = target->isFlying() ? attacker->getType().maxAirHits() : attacker->getType().maxGroundHits();
+	const int hits = factor * (std::max)(1, maxHits);
+
+	if (target->getShields() > 0)
+	{
+		int shieldArmor = target->getPlayer()->getUpgradeLevel(BWAPI::UpgradeTypes::Protoss_Plasma_Shields);
+		return hits * (std::max)(1, hitDamage - shieldArmor);
+	}
+
+	double hpDamage = hitDamage - target->getPlayer()->armor(target->getType());
+
+	const BWAPI::UnitSizeType size = target->getType().size();
+	if (weapon.damageType() == BWAPI::DamageTypes::Explosive)
+	{
+		if (size == BWAPI::UnitSizeTypes::Small) hpDamage *= 0.5;
+		else if (size == BWAPI::UnitSizeTypes::Medium) hpDamage *= 0.75;
+	}
+	else if (weapon.damageType() == BWAPI::DamageTypes::Concussive)
+	{
+		if (size == BWAPI::UnitSizeTypes::Medium) hpDamage *= 0.5;
+		else if (size == BWAPI::UnitSizeTypes::Large) hpDamage *= 0.25;
+	}
+
+	// The game does at least half a point per hit.
+	return (std::max)(1, int(hits * (std::max)(0.5, hpDamage)));
+}
+
+// Frames until the attacker can fire at the target: until its weapon is ready, or
+// until it can move into range, whichever is later, since the cooldown runs down as it moves.
+// For the ground weapon the cooldown is the cooldown frame kept in our unit info.
+int DamageAssignment::framesUntilAttack(BWAPI::Unit attacker, BWAPI::Unit target) const
+{
+	int cooldown;
+	if (target->isFlying())
+	{
+		cooldown = attacker->getAirWeaponCooldown();
+	}
+	else
+	{
+		const auto & ourUnits = InformationManager::Instance().getUnitInfo(BWAPI::Broodwar->self());
+		auto it = ourUnits.find(attacker);
+		cooldown = it == ourUnits.end()
+			? attacker->getGroundWeaponCooldown()
+			: (std::max)(0, it->second.groundWeaponCooldownFrame - BWAPI::Broodwar->getFrameCount());
+	}
+
+	const int outOfRange = attacker->getDistance(target) - UnitUtil::GetAttackRange(attacker, target);
+	if (outOfRange <= 0)
+	{
+		return cooldown;
+	}
+
+	const double speed = BWAPI::Broodwar->self()->topSpeed(attacker->getType());
+	if (speed < 0.001)
+	{
+		return (std::numeric_limits<int>::max)();
+	}
+	return (std::max)(cooldown, int(outOfRange / speed));
+}
+
+void DamageAssignment::update()
+{
+	const int now = BWAPI::Broodwar->getFrameCount();
+
+	for (auto it = _attacksOn.begin(); it != _attacksOn.end(); )
+	{
+		auto & attacks = it->second;
+		bool targetGone = !it->first->exists();
+
+		attacks.erase(std::remove_if(attacks.begin(), attacks.end(),
+			[&](const PendingAttack & attack)
+			{
+				if (targetGone || attack.landFrame < now || !attack.attacker->exists())
+				{
+					_targetOf.erase(attack.attacker);
+					return true;
+				}
+				return false;
+			}),
+			attacks.end());
+
+		if (attacks.empty()) it = _attacksOn.erase(it);
+		else ++it;
+	}
+}
+
+void DamageAssignment::addAttack(BWAPI::Unit attacker, BWAPI::Unit target)
+{
+	if (!attacker || !target) return;
+
+	removeAttack(attacker);
+
+	const int latency = BWAPI::Broodwar->getRemainingLatencyFrames();
+	const int frames = framesUntilAttack(attacker, target);
+	if (frames > ImminentFrames + latency) return;
+
+	int damage = expectedDamage(attacker, target);
+	if (damage <= 0) return;
+
+	const int landFrame = BWAPI::Broodwar->getFrameCount() + (std::max)(frames, latency) + LandingFrames;
+	_attacksOn[target].push_back(PendingAttack{ attacker, damage, landFrame });
+	_targetOf[attacker] = target;
+}
+
+bool DamageAssignment::isOverkill(BWAPI::Unit attacker, BWAPI::Unit target) const
+{
+	auto it = _attacksOn.find(target);
+	if (it == _attacksOn.end()) return false;
+
+	int damage = 0;
+	for (const PendingAttack & attack : it->second)
+	{
+		if (attack.attacker != attacker) damage += attack.damage;
+	}
+	return damage >= target->getHitPoints() + target->getShields();
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Common.h"
+
+// Keeps track of the damage our units are about to deal to each enemy unit, across all squads.
+// Micro managers record each attack they order, and the damage stays pending until it should have landed.
+// A target that pending damage will already kill is overkill for any other unit to shoot at.
+
+namespace UAlbertaBot
+{
+
+class DamageAssignment
+{
+	struct PendingAttack
+	{
+		BWAPI::Unit	attacker;
+		int			damage;			// to hit points and shields together
+		int			landFrame;		// frame by which the damage should show on the target
+	};
+
+	std::map<BWAPI::Unit, std::vector<PendingAttack>>	_attacksOn;		// target -> pending attacks on it
+	std::map<BWAPI::Unit, BWAPI::Unit>					_targetOf;		// attacker -> its pending target
+
+	DamageAssignment() {};
+
+	void	removeAttack(BWAPI::Unit attacker);
+	int		expectedDamage(BWAPI::Unit attacker, BWAPI::Unit target) const;
+	int		framesUntilAttack(BWAPI::Unit attacker, BWAPI::Unit target) const;
+
+public:
+
+	// Score adjustment for a target that is overkill, the same as being 8 tiles farther away
+	static const int OverkillPenalty = 8 * 32;
+
+	static DamageAssignment & Instance();
+
+	// Forget attacks that have landed, or whose attacker or target is gone. Call once per frame.
+	void	update();
+
+	// Record that the attacker has been ordered to attack the target.
+	// Attacks that will not fire soon are not counted, since the attacker may choose again before then.
+	void	addAttack(BWAPI::Unit attacker, BWAPI::Unit target);
+
+	// Whether attacks by other units are already expected to kill the target.
+	bool	isOverkill(BWAPI::Unit attacker, BWAPI::Unit target) const;
+};
+
+}
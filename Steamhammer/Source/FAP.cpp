@@ -5,8 +5,6 @@
 #include "Logger.h"
 #include "Random.h"
 
-UAlbertaBot::FastAPproximation fap;
-
 // NOTE FAP does not use UnitInfo.goneFromLastPosition. The flag is always set false
 // on a UnitInfo value which is passed in (CombatSimulation makes sure of it).
 
@@ -21,7 +19,7 @@ namespace UAlbertaBot {
 #endif
     }
 
-    void FastAPproximation::addUnitPlayer1(FAPUnit fu) { player1.push_back(fu); }
+    void FastAPproximation::addUnitPlayer1(FAPUnit fu) { player1.push_back(fu); addBunkerMarine(fu); }
 
     void FastAPproximation::addIfCombatUnitPlayer1(FAPUnit fu) {
         if (fu.unitType == BWAPI::UnitTypes::Protoss_Interceptor)
@@ -35,7 +33,7 @@ namespace UAlbertaBot {
         }
     }
 
-    void FastAPproximation::addUnitPlayer2(FAPUnit fu) { player2.push_back(fu); }
+    void FastAPproximation::addUnitPlayer2(FAPUnit fu) { player2.push_back(fu); addBunkerMarine(fu); }
 
     void FastAPproximation::addIfCombatUnitPlayer2(FAPUnit fu) {
         if (fu.groundDamage || fu.airDamage ||
@@ -117,7 +115,7 @@ namespace UAlbertaBot {
     }
 
     void FastAPproximation::clearState() {
-        player1.clear(), player2.clear(), frame = 0;
+        player1.clear(), player2.clear(), bunkerMarines.clear(), frame = 0;
         memset(&collision[0][0], 0, sizeof(unsigned short) * 512 * 512);
  
 #ifdef FAP_DEBUG
@@ -499,26 +497,46 @@ namespace UAlbertaBot {
         }
     }
 
-    void FastAPproximation::convertToUnitType(const FAPUnit &fu,
-        BWAPI::UnitType ut) {
-        UAlbertaBot::UnitInfo ui;
-        ui.lastPosition = BWAPI::Position(fu.x, fu.y);
-        ui.player = fu.player;
-        ui.type = ut;
+    void FastAPproximation::addBunkerMarine(const FAPUnit &bunker) {
+        if (bunker.unitType != BWAPI::UnitTypes::Terran_Bunker)
+            return;
+        for (const auto &marine : bunkerMarines)
+            if (marine.player == bunker.player)
+                return;
 
-        FAPUnit funew(ui);
-        funew.attackCooldownRemaining = fu.attackCooldownRemaining;
-        funew.elevation = fu.elevation;
+        UAlbertaBot::UnitInfo ui;
+        ui.lastPosition = BWAPI::Position(bunker.x, bunker.y);
+        ui.player = bunker.player;
+        ui.type = BWAPI::UnitTypes::Terran_Marine;
+        bunkerMarines.push_back(FAPUnit(ui));
+    }
 
-        fu.operator=(funew);
+    void FastAPproximation::convertToUnitType(const FAPUnit &fu,
+        BWAPI::UnitType ut) {
+        for (const auto &funew : bunkerMarines) {
+            if (funew.player != fu.player || funew.unitType != ut)
+                continue;
+
+            int x = fu.x, y = fu.y;
+            int attackCooldownRemaining = fu.attackCooldownRemaining;
+            int elevation = fu.elevation;
+
+            fu.operator=(funew);
+            fu.x = x, fu.y = y;
+            fu.attackCooldownRemaining = attackCooldownRemaining;
+            fu.elevation = elevation;
+            return;
+        }
     }
 
     FastAPproximation::FAPUnit::FAPUnit(BWAPI::Unit u) : FAPUnit(UnitInfo(u)) {}
 
-    FastAPproximation::FAPUnit::FAPUnit(UnitInfo ui)
+    FastAPproximation::FAPUnit::FAPUnit(UnitInfo ui) : FAPUnit(ui, InformationManager::Instance().getUnitStats(ui.player, ui.type)) {}
+
+    FastAPproximation::FAPUnit::FAPUnit(const UnitInfo & ui, const UpgradeTracker::UnitStats & stats)
         : x(ui.lastPosition.x), y(ui.lastPosition.y),
 
-        speed(InformationManager::Instance().getUnitTopSpeed(ui.player, ui.type)),
+        speed(stats.topSpeed),
 
         health(ui.lastHealth),
         maxHealth(ui.type.maxHitPoints()),
@@ -526,20 +544,20 @@ namespace UAlbertaBot {
         shields(ui.lastShields),
         shieldArmor(ui.player->getUpgradeLevel(BWAPI::UpgradeTypes::Protoss_Plasma_Shields)),
         maxShields(ui.type.maxShields()),
-        armor(InformationManager::Instance().getUnitArmor(ui.player, ui.type)),
+        armor(stats.armor),
         flying(ui.type.isFlyer()),
 
         undetected(ui.undetected),
 
-        groundDamage(InformationManager::Instance().getWeaponDamage(ui.player, ui.type.groundWeapon())),
-        groundCooldown(ui.type.groundWeapon().damageFactor() && ui.type.maxGroundHits() ? InformationManager::Instance().getUnitCooldown(ui.player, ui.type) / (ui.type.groundWeapon().damageFactor() * ui.type.maxGroundHits()) : 0),
-        groundMaxRange(InformationManager::Instance().getWeaponRange(ui.player, ui.type.groundWeapon())),
+        groundDamage(stats.groundDamage),
+        groundCooldown(ui.type.groundWeapon().damageFactor() && ui.type.maxGroundHits() ? stats.cooldown / (ui.type.groundWeapon().damageFactor() * ui.type.maxGroundHits()) : 0),
+        groundMaxRange(stats.groundRange),
         groundMinRange(ui.type.groundWeapon().minRange()),
         groundDamageType(ui.type.groundWeapon().damageType()),
 
-        airDamage(InformationManager::Instance().getWeaponDamage(ui.player, ui.type.airWeapon())),
+        airDamage(stats.airDamage),
         airCooldown(ui.type.airWeapon().damageFactor() && ui.type.maxAirHits() ? ui.type.airWeapon().damageCooldown() / (ui.type.airWeapon().damageFactor() * ui.type.maxAirHits()) : 0),
-        airMaxRange(InformationManager::Instance().getWeaponRange(ui.player, ui.type.airWeapon())),
+        airMaxRange(stats.airRange),
         airMinRange(ui.type.airWeapon().minRange()),
         airDamageType(ui.type.airWeapon().damageType()),
 
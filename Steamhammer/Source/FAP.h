@@ -1,6 +1,7 @@
 #pragma once
 
 #include "UnitData.h"
+#include "UpgradeTracker.h"
 
 //#define FAP_DEBUG 1
 
@@ -10,6 +11,7 @@ namespace UAlbertaBot {
         struct FAPUnit {
             FAPUnit(BWAPI::Unit u);
             FAPUnit(UnitInfo ui);
+            FAPUnit(const UnitInfo & ui, const UpgradeTracker::UnitStats & stats);
             const FAPUnit &operator=(const FAPUnit &other) const;
 
             int id = 0;
@@ -77,6 +79,10 @@ namespace UAlbertaBot {
 
         std::vector<FAPUnit> player1, player2;
 
+        // The marines that come out of the bunkers when they die, made when the bunkers are added.
+        // Making a unit reads the game, and the simulation itself must not.
+        std::vector<FAPUnit> bunkerMarines;
+
         // Current approach to collisions: allow two units to share the same grid cell, using half-tile resolution
         // This seems to strike a reasonable balance between improving how large melee armies are simmed and avoiding
         // expensive collision-based pathing calculations
@@ -95,9 +101,8 @@ namespace UAlbertaBot {
         bool suicideSim(const FAPUnit &fu, std::vector<FAPUnit> &enemyUnits);
         void isimulate();
         void unitDeath(const FAPUnit &fu, std::vector<FAPUnit> &itsFriendlies);
+        void addBunkerMarine(const FAPUnit &bunker);
         void convertToUnitType(const FAPUnit &fu, BWAPI::UnitType ut);
         };
 
 }
-
-extern UAlbertaBot::FastAPproximation fap;
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include "FrameArena.h"
+
+#include "Common.h"
+
+using namespace UAlbertaBot;
+
+FrameArena::FrameArena()
+	: _block(0)
+	, _used(0)
+	, _owner(std::this_thread::get_id())
+{
+}
+
+FrameArena & FrameArena::Instance()
+{
+	static FrameArena instance;
+	return instance;
+}
+
+FrameArena * FrameArena::ForThisThread()
+{
+	FrameArena & arena = Instance();
+	return std::this_thread::get_id() == arena._owner ? &arena : nullptr;
+}
+
+void * FrameArena::allocate(size_t bytes, size_t alignment)
+{
+	while (_block < _blocks.size())
+	{
+		Block & block = _blocks[_block];
+		const size_t start = (_used + alignment - 1) & ~(alignment - 1);
+		if (start + bytes <= block.size)
+		{
+			_used = start + bytes;
+			return block.memory.get() + start;
+		}
+		++_block;
+		_used = 0;
+	}
+
+	// Out of blocks. Add one big enough, with room to align.
+	Block block;
+	block.size = (std::max)(BlockSize, bytes + alignment);
+	block.memory.reset(new char[block.size]);
+	_blocks.push_back(std::move(block));
+	_block = _blocks.size() - 1;
+	_used = 0;
+	return allocate(bytes, alignment);
+}
+
+// Free everything. The blocks are kept for the next frame.
+void FrameArena::reset()
+{
+	UAB_ASSERT(std::this_thread::get_id() == _owner, "frame arena reset off its thread");
+
+	_block = 0;
+	_used = 0;
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+// A bump-pointer arena for containers that live only within a frame.
+// Memory is handed out from large blocks and never freed one piece at a time. Instead the
+// whole arena is reset at the end of GameCommander::update(), and its blocks are reused.
+// Anything allocated from the arena must be gone by then: use it for locals, never for
+// members or statics.
+// Only the thread that owns the arena, the one that runs the frame and first uses the
+// arena, allocates from it.
+// A FrameAllocator made on another thread uses the heap instead, so the containers are
+// safe to use anywhere.
+
+namespace UAlbertaBot
+{
+
+class FrameArena
+{
+	static const size_t BlockSize = 1 << 20;
+
+	struct Block
+	{
+		std::unique_ptr<char[]>	memory;
+		size_t					size;
+	};
+
+	std::vector<Block>	_blocks;
+	size_t				_block;			// the block we are allocating from
+	size_t				_used;			// bytes used in that block
+	std::thread::id		_owner;
+
+	FrameArena();
+
+public:
+
+	static FrameArena & Instance();
+
+	// The arena if this thread owns it, otherwise null.
+	static FrameArena * ForThisThread();
+
+	void *	allocate(size_t bytes, size_t alignment);
+	void	reset();
+};
+
+// An STL allocator that allocates from the frame arena, or from the heap off the frame's thread.
+template <class T>
+class FrameAllocator
+{
+	FrameArena * _arena;
+
+public:
+	typedef T value_type;
+
+	FrameAllocator()
+		: _arena(FrameArena::ForThisThread())
+	{
+	}
+
+	template <class U>
+	FrameAllocator(const FrameAllocator<U> & other)
+		: _arena(other.arena())
+	{
+	}
+
+	FrameArena * arena() const { return _arena; };
+
+	T * allocate(size_t n)
+	{
+		if (_arena)
+		{
+			return static_cast<T *>(_arena->allocate(n * sizeof(T), alignof(T)));
+		}
+		return static_cast<T *>(::operator new(n * sizeof(T)));
+	}
+
+	void deallocate(T * p, size_t)
+	{
+		if (!_arena)
+		{
+			::operator delete(p);
+		}
+	}
+
+	template <class U>
+	bool operator==(const FrameAllocator<U> & other) const { return _arena == other.arena(); };
+
+	template <class U>
+	bool operator!=(const FrameAllocator<U> & other) const { return _arena != other.arena(); };
+};
+
+template <class T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+template <class T, class Compare = std::less<T>>
+using FrameSet = std::set<T, Compare, FrameAllocator<T>>;
+
+template <class K, class V, class Compare = std::less<K>>
+using FrameMap = std::map<K, V, Compare, FrameAllocator<std::pair<const K, V>>>;
+
+}
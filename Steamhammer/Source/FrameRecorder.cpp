@@ -0,0 +1,503 @@
+#include "FrameRecorder.h"
+
+#include "GameRecord.h"
+
+using namespace UAlbertaBot;
+
+const std::string FrameRecord::Magic = "LFRM";
+const int FrameRecord::Version = 1;
+
+// Zigzag: small negative numbers become small positive numbers.
+void FrameRecord::putSigned(std::string & output, int n)
+{
+	GameRecord::putNumber(output, int(static_cast<unsigned int>(n) << 1 ^ static_cast<unsigned int>(n >> 31)));
+}
+
+int FrameRecord::getSigned(const char *& data, const char * end)
+{
+	const unsigned int u = static_cast<unsigned int>(GameRecord::getNumber(data, end));
+	return int(u >> 1 ^ (0 - (u & 1)));
+}
+
+void FrameRecord::putString(std::string & output, const std::string & s)
+{
+	GameRecord::putNumber(output, int(s.size()));
+	output += s;
+}
+
+std::string FrameRecord::getString(const char *& data, const char * end)
+{
+	const int length = GameRecord::getNumber(data, end);
+	if (end - data < length)
+	{
+		throw game_record_read_error();
+	}
+	std::string s(data, length);
+	data += length;
+	return s;
+}
+
+namespace
+{
+	int unitID(BWAPI::Unit unit)
+	{
+		return unit ? unit->getID() : -1;
+	}
+
+	// Write the lengths of the runs of alternating values, starting with false.
+	void putRuns(std::string & output, const std::vector<bool> & values)
+	{
+		bool value = false;
+		size_t start = 0;
+		for (size_t i = 0; i <= values.size(); ++i)
+		{
+			if (i == values.size() || values[i] != value)
+			{
+				GameRecord::putNumber(output, int(i - start));
+				start = i;
+				value = !value;
+			}
+		}
+	}
+
+	// Write the indexes of the values that changed, and remember the new values.
+	void putFlips(std::string & output, std::vector<bool> & last, const std::vector<bool> & now)
+	{
+		std::vector<int> flips;
+		for (size_t i = 0; i < now.size(); ++i)
+		{
+			if (now[i] != last[i])
+			{
+				flips.push_back(int(i));
+			}
+		}
+
+		GameRecord::putNumber(output, int(flips.size()));
+		int previous = -1;
+		for (int i : flips)
+		{
+			GameRecord::putNumber(output, i - previous - 1);
+			previous = i;
+		}
+
+		last = now;
+	}
+}
+
+FrameRecorder::FrameRecorder()
+{
+}
+
+FrameRecorder & FrameRecorder::Instance()
+{
+	static FrameRecorder instance;
+	return instance;
+}
+
+void FrameRecorder::getFields(BWAPI::Unit unit, FrameRecord::UnitFields & fields)
+{
+	using namespace FrameRecord;
+
+	fields[Type] = unit->getType().getID();
+	fields[Player] = unit->getPlayer()->getID();
+	fields[PositionX] = unit->getPosition().x;
+	fields[PositionY] = unit->getPosition().y;
+	fields[Angle] = int(unit->getAngle() * Scale);
+	fields[VelocityX] = int(unit->getVelocityX() * Scale);
+	fields[VelocityY] = int(unit->getVelocityY() * Scale);
+	fields[HitPoints] = unit->getHitPoints();
+	fields[Shields] = unit->getShields();
+	fields[Energy] = unit->getEnergy();
+	fields[Resources] = unit->getResources();
+	fields[ResourceGroup] = unit->getResourceGroup();
+	fields[GroundWeaponCooldown] = unit->getGroundWeaponCooldown();
+	fields[AirWeaponCooldown] = unit->getAirWeaponCooldown();
+	fields[SpellCooldown] = unit->getSpellCooldown();
+	fields[Order] = unit->getOrder().getID();
+	fields[OrderTarget] = unitID(unit->getOrderTarget());
+	fields[OrderTargetPositionX] = unit->getOrderTargetPosition().x;
+	fields[OrderTargetPositionY] = unit->getOrderTargetPosition().y;
+	fields[SecondaryOrder] = unit->getSecondaryOrder().getID();
+	fields[Target] = unitID(unit->getTarget());
+	fields[TargetPositionX] = unit->getTargetPosition().x;
+	fields[TargetPositionY] = unit->getTargetPosition().y;
+	fields[BuildType] = unit->getBuildType().getID();
+	fields[BuildUnit] = unitID(unit->getBuildUnit());
+
+	const BWAPI::UnitType::list queue = unit->getTrainingQueue();
+	fields[TrainingQueueCount] = int(queue.size());
+	fields[TrainingQueueFront] = queue.empty() ? BWAPI::UnitTypes::None.getID() : queue.front().getID();
+
+	fields[RemainingBuildTime] = unit->getRemainingBuildTime();
+	fields[RemainingTrainTime] = unit->getRemainingTrainTime();
+	fields[RemainingResearchTime] = unit->getRemainingResearchTime();
+	fields[RemainingUpgradeTime] = unit->getRemainingUpgradeTime();
+	fields[Tech] = unit->getTech().getID();
+	fields[Upgrade] = unit->getUpgrade().getID();
+	fields[Transport] = unitID(unit->getTransport());
+	fields[Carrier] = unitID(unit->getCarrier());
+	fields[Hatchery] = unitID(unit->getHatchery());
+	fields[Addon] = unitID(unit->getAddon());
+	fields[InterceptorCount] = unit->getInterceptorCount();
+	fields[ScarabCount] = unit->getScarabCount();
+	fields[SpiderMineCount] = unit->getSpiderMineCount();
+	fields[KillCount] = unit->getKillCount();
+	fields[CarryResourceType] = unit->isCarryingMinerals() ? 1 : unit->isCarryingGas() ? 2 : 0;
+	fields[StimTimer] = unit->getStimTimer();
+	fields[LockdownTimer] = unit->getLockdownTimer();
+	fields[StasisTimer] = unit->getStasisTimer();
+	fields[MaelstromTimer] = unit->getMaelstromTimer();
+	fields[EnsnareTimer] = unit->getEnsnareTimer();
+	fields[IrradiateTimer] = unit->getIrradiateTimer();
+	fields[PlagueTimer] = unit->getPlagueTimer();
+	fields[DefenseMatrixPoints] = unit->getDefenseMatrixPoints();
+	fields[AcidSporeCount] = unit->getAcidSporeCount();
+	fields[RallyPositionX] = unit->getRallyPosition().x;
+	fields[RallyPositionY] = unit->getRallyPosition().y;
+	fields[RallyUnit] = unitID(unit->getRallyUnit());
+
+	const bool flags[] =
+	{
+		unit->isCompleted(), unit->isMorphing(), unit->isConstructing(), unit->isIdle(),
+		unit->isMoving(), unit->isAttacking(), unit->isAttackFrame(), unit->isStartingAttack(),
+		unit->isGatheringMinerals() || unit->isGatheringGas(), unit->isBeingGathered(),
+		unit->isBurrowed(), unit->isCloaked(), unit->isDetected(), unit->isLifted(),
+		unit->isTraining(), unit->isUnderAttack(), unit->isPowered(), unit->isStuck(),
+		unit->isInterruptible(), unit->isInvincible(), unit->isHallucination(), unit->isBlind(),
+		unit->isParasited(), unit->isUnderStorm(), unit->isUnderDarkSwarm(), unit->isUnderDisruptionWeb(),
+		unit->isBraking(), unit->isAccelerating(), unit->hasNuke(), unit->isVisible(BWAPI::Broodwar->self())
+	};
+	static_assert(sizeof(flags) / sizeof(flags[0]) == Visible + 1, "one value per flag");
+
+	fields[Flags] = 0;
+	for (int i = 0; i <= Visible; ++i)
+	{
+		if (flags[i])
+		{
+			fields[Flags] |= 1 << i;
+		}
+	}
+}
+
+void FrameRecorder::writeHeader()
+{
+	const int width = BWAPI::Broodwar->mapWidth();
+	const int height = BWAPI::Broodwar->mapHeight();
+
+	_output = FrameRecord::Magic;
+	GameRecord::putNumber(_output, FrameRecord::Version);
+
+	GameRecord::putNumber(_output, width);
+	GameRecord::putNumber(_output, height);
+	FrameRecord::putString(_output, BWAPI::Broodwar->mapFileName());
+
+	std::vector<bool> walkable;
+	for (int y = 0; y < 4 * height; ++y)
+	{
+		for (int x = 0; x < 4 * width; ++x)
+		{
+			walkable.push_back(BWAPI::Broodwar->isWalkable(x, y));
+		}
+	}
+	putRuns(_output, walkable);
+
+	std::vector<bool> buildable;
+	std::vector<int> groundHeight;
+	for (int y = 0; y < height; ++y)
+	{
+		for (int x = 0; x < width; ++x)
+		{
+			buildable.push_back(BWAPI::Broodwar->isBuildable(x, y));
+			groundHeight.push_back(BWAPI::Broodwar->getGroundHeight(x, y));
+		}
+	}
+	putRuns(_output, buildable);
+
+	for (size_t start = 0; start < groundHeight.size(); )
+	{
+		size_t end = start;
+		while (end < groundHeight.size() && groundHeight[end] == groundHeight[start])
+		{
+			++end;
+		}
+		GameRecord::putNumber(_output, groundHeight[start]);
+		GameRecord::putNumber(_output, int(end - start));
+		start = end;
+	}
+
+	GameRecord::putNumber(_output, int(BWAPI::Broodwar->getStartLocations().size()));
+	for (BWAPI::TilePosition tile : BWAPI::Broodwar->getStartLocations())
+	{
+		GameRecord::putNumber(_output, tile.x);
+		GameRecord::putNumber(_output, tile.y);
+	}
+
+	_players = { BWAPI::Broodwar->self(), BWAPI::Broodwar->enemy() };
+	for (BWAPI::Player player : _players)
+	{
+		GameRecord::putNumber(_output, player->getID());
+		FrameRecord::putString(_output, player->getName());
+		GameRecord::putNumber(_output, player->getRace().getID());
+		FrameRecord::putSigned(_output, player->getStartLocation().x);
+		FrameRecord::putSigned(_output, player->getStartLocation().y);
+	}
+	GameRecord::putNumber(_output, BWAPI::Broodwar->neutral()->getID());
+
+	const BWAPI::Unitset & statics = BWAPI::Broodwar->getStaticNeutralUnits();
+	GameRecord::putNumber(_output, int(statics.size()));
+	for (BWAPI::Unit unit : statics)
+	{
+		GameRecord::putNumber(_output, unit->getID());
+		GameRecord::putNumber(_output, unit->getInitialType().getID());
+		GameRecord::putNumber(_output, unit->getInitialPosition().x);
+		GameRecord::putNumber(_output, unit->getInitialPosition().y);
+		GameRecord::putNumber(_output, unit->getInitialResources());
+	}
+
+	_playerFields.assign(_players.size(), FrameRecord::PlayerFields());
+	_upgrades.assign(_players.size(), std::vector<int>(BWAPI::UpgradeTypes::Enum::MAX, 0));
+	_techs.assign(_players.size(), std::vector<int>(BWAPI::TechTypes::Enum::MAX, 0));
+	for (FrameRecord::PlayerFields & fields : _playerFields)
+	{
+		fields.fill(0);
+	}
+	_visible.assign(width * height, false);
+	_creep.assign(width * height, false);
+	_units.clear();
+}
+
+void FrameRecorder::writePlayers()
+{
+	for (size_t p = 0; p < _players.size(); ++p)
+	{
+		const BWAPI::Player player = _players[p];
+
+		FrameRecord::PlayerFields fields;
+		fields[FrameRecord::Minerals] = player->minerals();
+		fields[FrameRecord::Gas] = player->gas();
+		fields[FrameRecord::GatheredMinerals] = player->gatheredMinerals();
+		fields[FrameRecord::GatheredGas] = player->gatheredGas();
+
+		int mask = 0;
+		for (int i = 0; i < FrameRecord::NumPlayerFields; ++i)
+		{
+			if (fields[i] != _playerFields[p][i])
+			{
+				mask |= 1 << i;
+			}
+		}
+		GameRecord::putNumber(_output, mask);
+		for (int i = 0; i < FrameRecord::NumPlayerFields; ++i)
+		{
+			if (mask & (1 << i))
+			{
+				FrameRecord::putSigned(_output, fields[i] - _playerFields[p][i]);
+			}
+		}
+		_playerFields[p] = fields;
+
+		std::vector<std::pair<int, int>> changes;
+		for (int i = 0; i < BWAPI::UpgradeTypes::Enum::None; ++i)
+		{
+			const BWAPI::UpgradeType upgrade(i);
+			const int value = 2 * player->getUpgradeLevel(upgrade) + (player->isUpgrading(upgrade) ? 1 : 0);
+			if (value != _upgrades[p][i])
+			{
+				changes.push_back(std::make_pair(i, value));
+				_upgrades[p][i] = value;
+			}
+		}
+		GameRecord::putNumber(_output, int(changes.size()));
+		for (const auto & change : changes)
+		{
+			GameRecord::putNumber(_output, change.first);
+			GameRecord::putNumber(_output, change.second);
+		}
+
+		changes.clear();
+		for (int i = 0; i < BWAPI::TechTypes::Enum::None; ++i)
+		{
+			const BWAPI::TechType tech(i);
+			const int value = 2 * (player->hasResearched(tech) ? 1 : 0) + (player->isResearching(tech) ? 1 : 0);
+			if (value != _techs[p][i])
+			{
+				changes.push_back(std::make_pair(i, value));
+				_techs[p][i] = value;
+			}
+		}
+		GameRecord::putNumber(_output, int(changes.size()));
+		for (const auto & change : changes)
+		{
+			GameRecord::putNumber(_output, change.first);
+			GameRecord::putNumber(_output, change.second);
+		}
+	}
+}
+
+void FrameRecorder::writeTiles()
+{
+	const int width = BWAPI::Broodwar->mapWidth();
+	const int height = BWAPI::Broodwar->mapHeight();
+
+	std::vector<bool> visible(width * height);
+	std::vector<bool> creep(width * height);
+	for (int y = 0; y < height; ++y)
+	{
+		for (int x = 0; x < width; ++x)
+		{
+			visible[y * width + x] = BWAPI::Broodwar->isVisible(x, y);
+			creep[y * width + x] = BWAPI::Broodwar->hasCreep(x, y);
+		}
+	}
+
+	putFlips(_output, _visible, visible);
+	putFlips(_output, _creep, creep);
+}
+
+void FrameRecorder::writeUnits()
+{
+	std::map<int, FrameRecord::UnitFields> units;
+	for (BWAPI::Unit unit : BWAPI::Broodwar->getAllUnits())
+	{
+		getFields(unit, units[unit->getID()]);
+	}
+
+	// Units that changed or are new to us.
+	std::string unitOutput;
+	int nChanged = 0;
+	int previous = -1;
+	FrameRecord::UnitFields zeros;
+	zeros.fill(0);
+	for (const auto & idFields : units)
+	{
+		const auto it = _units.find(idFields.first);
+		const FrameRecord::UnitFields & last = it == _units.end() ? zeros : it->second;
+		const FrameRecord::UnitFields & now = idFields.second;
+
+		int masks[2] = { 0, 0 };
+		for (int i = 0; i < FrameRecord::NumUnitFields; ++i)
+		{
+			if (now[i] != last[i])
+			{
+				masks[i / FrameRecord::MaskBits] |= 1 << (i % FrameRecord::MaskBits);
+			}
+		}
+		if (it != _units.end() && !masks[0] && !masks[1])
+		{
+			continue;
+		}
+
+		++nChanged;
+		GameRecord::putNumber(unitOutput, idFields.first - previous - 1);
+		previous = idFields.first;
+		GameRecord::putNumber(unitOutput, masks[0]);
+		GameRecord::putNumber(unitOutput, masks[1]);
+		for (int i = 0; i < FrameRecord::NumUnitFields; ++i)
+		{
+			if (masks[i / FrameRecord::MaskBits] & (1 << (i % FrameRecord::MaskBits)))
+			{
+				if (i == FrameRecord::Flags)
+				{
+					GameRecord::putNumber(unitOutput, now[i]);
+				}
+				else
+				{
+					FrameRecord::putSigned(unitOutput, now[i] - last[i]);
+				}
+			}
+		}
+	}
+	GameRecord::putNumber(_output, nChanged);
+	_output += unitOutput;
+
+	// Units that we no longer see.
+	std::set<int> destroyed;
+	for (const BWAPI::Event & e : BWAPI::Broodwar->getEvents())
+	{
+		if (e.getType() == BWAPI::EventType::UnitDestroy && e.getUnit())
+		{
+			destroyed.insert(e.getUnit()->getID());
+		}
+	}
+
+	std::vector<int> lost;
+	for (const auto & idFields : _units)
+	{
+		if (units.find(idFields.first) == units.end())
+		{
+			lost.push_back(idFields.first);
+		}
+	}
+	GameRecord::putNumber(_output, int(lost.size()));
+	previous = -1;
+	for (int id : lost)
+	{
+		GameRecord::putNumber(_output, id - previous - 1);
+		GameRecord::putNumber(_output, destroyed.find(id) != destroyed.end() ? 1 : 0);
+		previous = id;
+	}
+
+	_units.swap(units);
+}
+
+void FrameRecorder::writeBullets()
+{
+	const BWAPI::Bulletset & bullets = BWAPI::Broodwar->getBullets();
+	GameRecord::putNumber(_output, int(bullets.size()));
+	for (BWAPI::Bullet bullet : bullets)
+	{
+		FrameRecord::putSigned(_output, bullet->getID());
+		FrameRecord::putSigned(_output, bullet->getType().getID());
+		FrameRecord::putSigned(_output, bullet->getPlayer() ? bullet->getPlayer()->getID() : -1);
+		FrameRecord::putSigned(_output, unitID(bullet->getSource()));
+		FrameRecord::putSigned(_output, unitID(bullet->getTarget()));
+		FrameRecord::putSigned(_output, bullet->getPosition().x);
+		FrameRecord::putSigned(_output, bullet->getPosition().y);
+		FrameRecord::putSigned(_output, bullet->getTargetPosition().x);
+		FrameRecord::putSigned(_output, bullet->getTargetPosition().y);
+		FrameRecord::putSigned(_output, bullet->getRemoveTimer());
+		GameRecord::putNumber(_output, bullet->isVisible() ? 1 : 0);
+	}
+}
+
+void FrameRecorder::flush()
+{
+	_file.write(_output.data(), _output.size());
+	_output.clear();
+}
+
+void FrameRecorder::update()
+{
+	if (Config::Debug::FrameRecordFilename.empty())
+	{
+		return;
+	}
+
+	if (!_file.is_open())
+	{
+		_file.open(Config::Debug::FrameRecordFilename, std::ios::binary | std::ios::trunc);
+		writeHeader();
+	}
+
+	GameRecord::putNumber(_output, 'F');
+	GameRecord::putNumber(_output, BWAPI::Broodwar->getFrameCount());
+	writePlayers();
+	writeTiles();
+	writeUnits();
+	writeBullets();
+
+	// Write in large pieces, so that recording costs little during the game.
+	if (_output.size() >= 1 << 20)
+	{
+		flush();
+	}
+}
+
+void FrameRecorder::onEnd()
+{
+	if (_file.is_open())
+	{
+		flush();
+		_file.close();
+	}
+}
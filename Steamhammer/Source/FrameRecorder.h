@@ -0,0 +1,116 @@
+#pragma once
+
+#include "Common.h"
+
+#include <fstream>
+
+// Records the game state that the bot reads, every frame, so that the game can be played
+// back offline through a HeadlessGame by FramePlayer (in LocutusTest), as a repeatable benchmark.
+// Turned on by Config::Debug::FrameRecordFilename.
+//
+// File format: the magic string and format version, the header, then one record per frame.
+// Numbers are as in GameRecord's binary format. Values that may be negative, including all
+// differences, are zigzag encoded first. Unit and player IDs are as in the recorded game.
+//   header: map width, height and name; walkability and buildability as lengths of runs of
+//           alternating values, starting with false; ground height as (height, run length)
+//           pairs; start locations; us and the enemy (id, name, race, start location); the
+//           neutral player's ID; static neutral units (id, type, x, y, resources)
+//   frame:  'F', frame count;
+//           for us and the enemy, a mask of the changed fields and their differences, then
+//           the changed upgrades and techs as (type, value) pairs;
+//           tiles whose visibility flipped, then tiles whose creep flipped;
+//           units we can see whose fields changed: ID difference, field masks, differences
+//           (the Flags field is written as is, and a unit new to us differs from all zeros);
+//           units we can no longer see: ID difference, whether destroyed;
+//           the bullets, in full.
+// Units and tiles are in increasing order, so their IDs and indexes are written as
+// differences from the last one.
+
+namespace UAlbertaBot
+{
+namespace FrameRecord
+{
+	extern const std::string Magic;
+	extern const int Version;
+
+	enum UnitField
+	{
+		Type, Player, PositionX, PositionY, Angle, VelocityX, VelocityY,
+		HitPoints, Shields, Energy, Resources, ResourceGroup,
+		GroundWeaponCooldown, AirWeaponCooldown, SpellCooldown,
+		Order, OrderTarget, OrderTargetPositionX, OrderTargetPositionY, SecondaryOrder,
+		Target, TargetPositionX, TargetPositionY,
+		BuildType, BuildUnit, TrainingQueueCount, TrainingQueueFront,	// only the front of the queue is kept
+		RemainingBuildTime, RemainingTrainTime, RemainingResearchTime, RemainingUpgradeTime,
+		Tech, Upgrade, Transport, Carrier, Hatchery, Addon,
+		InterceptorCount, ScarabCount, SpiderMineCount, KillCount, CarryResourceType,
+		StimTimer, LockdownTimer, StasisTimer, MaelstromTimer, EnsnareTimer, IrradiateTimer, PlagueTimer,
+		DefenseMatrixPoints, AcidSporeCount, RallyPositionX, RallyPositionY, RallyUnit,
+		Flags,
+		NumUnitFields
+	};
+
+	// The bits of the Flags field.
+	enum UnitFlag
+	{
+		Completed, Morphing, Constructing, Idle, Moving, Attacking, AttackFrame, StartingAttack,
+		Gathering, BeingGathered, Burrowed, Cloaked, Detected, Lifted, Training, UnderAttack,
+		Powered, Stuck, Interruptible, Invincible, Hallucination, Blind, Parasited,
+		UnderStorm, UnderDarkSwarm, UnderDisruptionWeb, Braking, Accelerating, HasNuke, Visible
+	};
+
+	enum PlayerField
+	{
+		Minerals, Gas, GatheredMinerals, GatheredGas,
+		NumPlayerFields
+	};
+
+	// Field masks are written in pieces of this many bits, to fit the number format.
+	const int MaskBits = 30;
+
+	typedef std::array<int, NumUnitFields> UnitFields;
+	typedef std::array<int, NumPlayerFields> PlayerFields;
+
+	// Angles and velocities are kept to this fraction.
+	const double Scale = 1000.0;
+
+	void putSigned(std::string & output, int n);
+	int getSigned(const char *& data, const char * end);
+	void putString(std::string & output, const std::string & s);
+	std::string getString(const char *& data, const char * end);
+}
+
+class FrameRecorder
+{
+	std::ofstream		_file;
+	std::string			_output;				// not yet written
+
+	std::vector<BWAPI::Player>					_players;		// us and the enemy
+	std::vector<FrameRecord::PlayerFields>		_playerFields;	// as last recorded
+	std::vector<std::vector<int>>				_upgrades;		// level * 2 + whether upgrading
+	std::vector<std::vector<int>>				_techs;			// researched * 2 + whether researching
+	std::vector<bool>							_visible;
+	std::vector<bool>							_creep;
+	std::map<int, FrameRecord::UnitFields>		_units;			// units we saw last frame
+
+	FrameRecorder();
+
+	void writeHeader();
+	void writePlayers();
+	void writeTiles();
+	void writeUnits();
+	void writeBullets();
+	void flush();
+
+	static void getFields(BWAPI::Unit unit, FrameRecord::UnitFields & fields);
+
+public:
+
+	static FrameRecorder & Instance();
+
+	// Record this frame. Call before the bot does anything in the frame.
+	void update();
+	void onEnd();
+};
+
+}
@@ -0,0 +1,172 @@
+#include "FrameScheduler.h"
+
+#include "Logger.h"
+#include "Profiler.h"
+
+using namespace UAlbertaBot;
+
+FrameScheduler::FrameScheduler()
+	: _current(-1)
+	, _framesOver55ms(0)
+	, _framesOver1s(0)
+	, _framesOver10s(0)
+{
+}
+
+FrameScheduler & FrameScheduler::Instance()
+{
+	static FrameScheduler instance;
+	return instance;
+}
+
+void FrameScheduler::add(const std::string & name, Priority priority, int period, int maxDelay, std::function<void()> run)
+{
+	_tasks.push_back(Task{ name, Profiler::Instance().zone(name), priority, (std::max)(1, period), maxDelay, 0.0, run, 0, false, -1.0, 0 });
+}
+
+void FrameScheduler::addFill(const std::string & name, Priority priority, int maxDelay, double minMilliseconds, std::function<void()> run)
+{
+	_tasks.push_back(Task{ name, Profiler::Instance().zone(name), priority, 1, maxDelay, minMilliseconds, run, 0, false, -1.0, 0 });
+}
+
+// The expected time for the task. Nothing is known about a task that hasn't run yet.
+double FrameScheduler::estimate(const Task & task) const
+{
+	return task.cost < 0.0 ? 0.0 : task.cost;
+}
+
+// Time to hold back for the due tasks after the given one that are more important.
+// Tasks that use the remaining time are not held back for; they get what is left.
+double FrameScheduler::reservedAfter(int index, Priority priority) const
+{
+	double reserved = 0.0;
+	for (size_t i = index + 1; i < _tasks.size(); ++i)
+	{
+		const Task & task = _tasks[i];
+		if (task.dueNow && task.minMilliseconds == 0.0 && task.priority < priority)
+		{
+			reserved += estimate(task);
+		}
+	}
+	return reserved;
+}
+
+bool FrameScheduler::shouldRun(int index) const
+{
+	const Task & task = _tasks[index];
+
+	if (task.priority == Priority::Essential ||
+		BWAPI::Broodwar->getFrameCount() >= task.nextDue + task.maxDelay)
+	{
+		return true;
+	}
+
+	const double available =
+		getBudgetMilliseconds() - Profiler::Instance().getFrameMilliseconds() - reservedAfter(index, task.priority);
+
+	if (task.minMilliseconds > 0.0)
+	{
+		return available >= task.minMilliseconds;
+	}
+	return estimate(task) <= available;
+}
+
+// Run the tasks that are due this frame and fit in the budget.
+void FrameScheduler::run()
+{
+	const int frame = BWAPI::Broodwar->getFrameCount();
+
+	for (Task & task : _tasks)
+	{
+		task.dueNow = frame >= task.nextDue;
+	}
+
+	for (size_t i = 0; i < _tasks.size(); ++i)
+	{
+		Task & task = _tasks[i];
+		if (!task.dueNow)
+		{
+			continue;
+		}
+
+		if (!shouldRun(i))
+		{
+			task.dueNow = false;
+			++task.deferrals;
+			LOG_DEBUG << "Deferred " << task.name << ", " << frame - task.nextDue << " frames late";
+			continue;
+		}
+
+		_current = i;
+		const Profiler::Clock::time_point start = Profiler::Clock::now();
+		{
+			ProfileScope scope(task.zone);
+			task.run();
+		}
+		const double ms = std::chrono::duration<double, std::milli>(Profiler::Clock::now() - start).count();
+		_current = -1;
+
+		task.dueNow = false;
+		task.nextDue = frame + task.period;
+		if (task.minMilliseconds == 0.0)
+		{
+			task.cost = task.cost < 0.0 ? ms : 0.9 * task.cost + 0.1 * ms;
+		}
+	}
+}
+
+// Count the frames that go over the tournament limits.
+void FrameScheduler::onFrameEnd(double frameMilliseconds)
+{
+	if (frameMilliseconds > 55.0)
+	{
+		++_framesOver55ms;
+		if (_framesOver55ms == FramesOver55msLimit / 2)
+		{
+			Log().Get() << "Warning: " << _framesOver55ms << " frames over 55ms, budget now " << getBudgetMilliseconds() << "ms";
+		}
+	}
+	if (frameMilliseconds > 1000.0)
+	{
+		++_framesOver1s;
+		Log().Get() << "Warning: frame took " << frameMilliseconds << "ms, " << _framesOver1s << " of " << FramesOver1sLimit << " frames over 1s";
+	}
+	if (frameMilliseconds > 10000.0)
+	{
+		++_framesOver10s;
+		Log().Get() << "Warning: frame took " << frameMilliseconds << "ms, " << _framesOver10s << " of " << FramesOver10sLimit << " frames over 10s";
+	}
+}
+
+// The configured budget, reduced as frames over 55ms use up the tournament allowance.
+// It never goes below half the configured budget, so that deferred work still gets done.
+double FrameScheduler::getBudgetMilliseconds() const
+{
+	const double used = double(_framesOver55ms) / FramesOver55msLimit;
+	return Config::Tournament::FrameBudgetMs * (std::max)(0.5, 1.0 - used);
+}
+
+double FrameScheduler::getRemainingMilliseconds() const
+{
+	double remaining = getBudgetMilliseconds() - Profiler::Instance().getFrameMilliseconds();
+	if (_current >= 0)
+	{
+		const Task & task = _tasks[_current];
+		remaining -= reservedAfter(_current, task.priority);
+
+		// A fill task that runs because it was late, or with time short, still gets its minimum.
+		remaining = (std::max)(remaining, task.minMilliseconds);
+	}
+	return remaining;
+}
+
+void FrameScheduler::logSummary() const
+{
+	std::ostringstream msg;
+	msg << "Scheduler: frames over 55ms " << _framesOver55ms << ", over 1s " << _framesOver1s << ", over 10s " << _framesOver10s;
+	for (const Task & task : _tasks)
+	{
+		msg << '\n' << task.name << ": cost " << estimate(task) << "ms, deferred " << task.deferrals;
+	}
+	Log().Get() << msg.str();
+}
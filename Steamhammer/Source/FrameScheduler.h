@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Common.h"
+
+#include <functional>
+
+// Runs the per-frame work of the bot within a time budget.
+// Subsystems register tasks, which run in the order they were registered whenever they are due.
+// A task is due every `period` frames. If its measured cost would take the frame over budget,
+// counting the due tasks of higher priority that still have to run, it is deferred to a later
+// frame, but no more than `maxDelay` frames late. Essential tasks always run when due.
+// Tournament rules limit the number of frames over 55ms, so as that count grows the budget
+// shrinks, leaving more room under the limit for the frames we can't control.
+
+namespace UAlbertaBot
+{
+
+class FrameScheduler
+{
+public:
+	enum class Priority { Essential, High, Normal, Low };
+
+private:
+	// Tournament frame time limits. A bot that exceeds one of these loses the game.
+	static const int FramesOver55msLimit = 320;
+	static const int FramesOver1sLimit = 10;
+	static const int FramesOver10sLimit = 1;
+
+	struct Task
+	{
+		std::string				name;
+		int						zone;			// profiler zone
+		Priority				priority;
+		int						period;
+		int						maxDelay;
+		double					minMilliseconds;	// for tasks that use the remaining time; 0 otherwise
+		std::function<void()>	run;
+
+		int						nextDue;		// frame
+		bool					dueNow;
+		double					cost;			// moving average in milliseconds, -1 until measured
+		int						deferrals;
+	};
+
+	std::vector<Task>	_tasks;
+	int					_current;				// index of the running task, -1 between tasks
+
+	int					_framesOver55ms;
+	int					_framesOver1s;
+	int					_framesOver10s;
+
+	FrameScheduler();
+
+	double	estimate(const Task & task) const;
+	double	reservedAfter(int index, Priority priority) const;
+	bool	shouldRun(int index) const;
+
+public:
+
+	static FrameScheduler & Instance();
+
+	// A task that does its own work each time it runs.
+	void	add(const std::string & name, Priority priority, int period, int maxDelay, std::function<void()> run);
+
+	// A task that uses whatever time is left over, like the build order search.
+	// It runs if at least minMilliseconds remain, and should ask getRemainingMilliseconds() how long to take.
+	void	addFill(const std::string & name, Priority priority, int maxDelay, double minMilliseconds, std::function<void()> run);
+
+	void	run();
+	void	onFrameEnd(double frameMilliseconds);
+
+	double	getBudgetMilliseconds() const;
+
+	// Budget left for the running task, after what the rest of this frame's due tasks should take.
+	// A fill task always gets at least its minMilliseconds, even when it was run late with less left.
+	double	getRemainingMilliseconds() const;
+
+	void	logSummary() const;
+};
+
+}
@@ -1,8 +1,11 @@
 #include "Common.h"
 #include "GameCommander.h"
+#include "FrameArena.h"
+#include "FrameRecorder.h"
 #include "OpponentModel.h"
 #include "UnitUtil.h"
 #include "PathFinding.h"
+#include "WorldSnapshot.h"
 
 using namespace UAlbertaBot;
 
@@ -13,21 +16,61 @@ GameCommander::GameCommander()
 	, _initialScoutTime(0)
 	, _surrenderTime(0)
 {
+	registerTasks();
+}
+
+// Hand the per-frame work of the managers to the frame scheduler, in the order it should run.
+// Essential tasks run every frame as before. The rest can wait a few frames when time is short.
+void GameCommander::registerTasks()
+{
+	typedef FrameScheduler::Priority Priority;
+	FrameScheduler & scheduler = FrameScheduler::Instance();
+
+	// utility managers
+	scheduler.add("UnitInfo", Priority::Essential, 1, 0, [] { InformationManager::Instance().update(); });
+	scheduler.add("MapGrid", Priority::Essential, 1, 0, [] { MapGrid::Instance().update(); });
+
+	// The build order search takes the time that is left, but at least 5ms when it runs.
+	scheduler.addFill("Search", Priority::Normal, 8, 5.0, []
+	{
+		BOSSManager::Instance().update(FrameScheduler::Instance().getRemainingMilliseconds());
+	});
+
+	scheduler.add("Worker", Priority::Essential, 1, 0, [] { WorkerManager::Instance().update(); });
+	scheduler.add("Strategy", Priority::Essential, 1, 0, [] { StrategyManager::Instance().update(); });
+	scheduler.add("Production", Priority::Essential, 1, 0, [] { ProductionManager::Instance().update(); });
+	scheduler.add("Building", Priority::Essential, 1, 0, [] { BuildingManager::Instance().update(); });
+
+	scheduler.add("Squad assignment", Priority::High, 8, 8, [this] { _combatCommander.updateSquadAssignments(_combatUnits); });
+	scheduler.add("Combat", Priority::Essential, 1, 0, [this] { _combatCommander.update(_combatUnits); });
+	scheduler.add("Comsat", Priority::Low, 4, 8, [this] { _combatCommander.doComsatScan(); });
+
+	scheduler.add("Scout", Priority::High, 1, 2, [] { ScoutManager::Instance().update(); });
+
+	// The opponent model update keeps the game record, which must see every frame.
+	scheduler.add("OpponentModel", Priority::Essential, 1, 0, [] { OpponentModel::Instance().update(); });
+	scheduler.add("Best match", Priority::Low, 32, 32, [] { OpponentModel::Instance().updateBestMatch(); });
 }
 
 void GameCommander::update()
 {
-	_timerManager.startTimer(TimerManager::Total);
+	FrameRecorder::Instance().update();
+	Profiler::Instance().beginFrame();
+
+	{
+		PROFILE_ZONE("World snapshot");
+		WorldSnapshot::Instance().update();
+	}
 
 #ifdef CRASH_DEBUG
-	Log().Debug() << "handleUnitAssignments";
+	LOG_DEBUG << "handleUnitAssignments";
 #endif
 
 	// populate the unit vectors we will pass into various managers
 	handleUnitAssignments();
 
 #ifdef CRASH_DEBUG
-	Log().Debug() << "surrenderMonkey";
+	LOG_DEBUG << "surrenderMonkey";
 #endif
 
 	// Decide whether to give up early. Implements config option SurrenderWhenHopeIsLost.
@@ -43,99 +86,28 @@ void GameCommander::update()
 			Log().Get() << "Surrendering";
 			BWAPI::Broodwar->leaveGame();
 		}
+		Profiler::Instance().endFrame();
+		FrameScheduler::Instance().onFrameEnd(Profiler::Instance().getLastFrameMilliseconds());
+		FrameArena::Instance().reset();
 		return;
 	}
 
 #ifdef CRASH_DEBUG
-	Log().Debug() << "InformationManager";
-#endif
-
-	// utility managers
-	_timerManager.startTimer(TimerManager::InformationManager);
-	InformationManager::Instance().update();
-	_timerManager.stopTimer(TimerManager::InformationManager);
-
-#ifdef CRASH_DEBUG
-	Log().Debug() << "MapGrid";
-#endif
-
-	_timerManager.startTimer(TimerManager::MapGrid);
-	MapGrid::Instance().update();
-	_timerManager.stopTimer(TimerManager::MapGrid);
-
-#ifdef CRASH_DEBUG
-	Log().Debug() << "BOSSManager";
-#endif
-
-	_timerManager.startTimer(TimerManager::Search);
-	BOSSManager::Instance().update(35 - _timerManager.getMilliseconds());
-	_timerManager.stopTimer(TimerManager::Search);
-
-#ifdef CRASH_DEBUG
-	Log().Debug() << "WorkerManager";
+	LOG_DEBUG << "scheduled tasks";
 #endif
 
-	_timerManager.startTimer(TimerManager::Worker);
-	WorkerManager::Instance().update();
-	_timerManager.stopTimer(TimerManager::Worker);
+	FrameScheduler::Instance().run();
 
 #ifdef CRASH_DEBUG
-	Log().Debug() << "StrategyManager";
+	LOG_DEBUG << "(done frame)";
 #endif
 
-	_timerManager.startTimer(TimerManager::Strategy);
-    StrategyManager::Instance().update();
-	_timerManager.stopTimer(TimerManager::Strategy);
+	Profiler::Instance().endFrame();
+	FrameScheduler::Instance().onFrameEnd(Profiler::Instance().getLastFrameMilliseconds());
 
-#ifdef CRASH_DEBUG
-	Log().Debug() << "ProductionManager";
-#endif
-
-	_timerManager.startTimer(TimerManager::Production);
-	ProductionManager::Instance().update();
-	_timerManager.stopTimer(TimerManager::Production);
-
-#ifdef CRASH_DEBUG
-	Log().Debug() << "BuildingManager";
-#endif
-
-	_timerManager.startTimer(TimerManager::Building);
-	BuildingManager::Instance().update();
-	_timerManager.stopTimer(TimerManager::Building);
-
-#ifdef CRASH_DEBUG
-	Log().Debug() << "_combatCommander";
-#endif
-
-	_timerManager.startTimer(TimerManager::Combat);
-	_combatCommander.update(_combatUnits);
-	_timerManager.stopTimer(TimerManager::Combat);
-
-#ifdef CRASH_DEBUG
-	Log().Debug() << "ScoutManager";
-#endif
-
-	_timerManager.startTimer(TimerManager::Scout);
-    ScoutManager::Instance().update();
-	_timerManager.stopTimer(TimerManager::Scout);
-
-#ifdef CRASH_DEBUG
-	Log().Debug() << "OpponentModel";
-#endif
-
-	_timerManager.startTimer(TimerManager::OpponentModel);
-	OpponentModel::Instance().update();
-	_timerManager.stopTimer(TimerManager::OpponentModel);
-
-#ifdef CRASH_DEBUG
-	Log().Debug() << "(done frame)";
-#endif
-
-	_timerManager.stopTimer(TimerManager::Total);
-
-	if (_timerManager.getMilliseconds() > 45)
+	if (Profiler::Instance().getLastFrameMilliseconds() > 45)
 	{
-        _timerManager.log();
+        Profiler::Instance().log();
 	}
 
 	drawDebugInterface();
@@ -153,6 +125,9 @@ void GameCommander::update()
 
         Log().Get() << "Summary: " << count << " combat units, " << UnitUtil::GetCompletedUnitCount(BWAPI::UnitTypes::Protoss_Probe) << " workers, " << BWAPI::Broodwar->self()->minerals() << " minerals, " << BWAPI::Broodwar->self()->gas() << " gas";
     }
+
+	// Containers from the frame arena are gone by now.
+	FrameArena::Instance().reset();
 }
 
 void GameCommander::drawDebugInterface()
@@ -169,7 +144,7 @@ void GameCommander::drawDebugInterface()
 	MapTools::Instance().drawHomeDistanceMap();
     
 	_combatCommander.drawSquadInformation(200, 30);
-    _timerManager.displayTimers(490, 225);
+    Profiler::Instance().drawZones(490, 225);
     drawGameInformation(4, 1);
 
 	drawUnitOrders();
@@ -274,8 +249,8 @@ void GameCommander::drawGameInformation(int x, int y)
 		frame,
 		int(frame / (23.8 * 60)),
 		int(frame / 23.8) % 60,
-		_timerManager.getMeanMilliseconds(),
-		_timerManager.getMaxMilliseconds());
+		Profiler::Instance().getMeanMilliseconds(),
+		Profiler::Instance().getMaxMilliseconds());
 }
 
 void GameCommander::drawUnitOrders()
@@ -417,6 +392,10 @@ void GameCommander::onEnd(bool isWinner)
 {
     OpponentModel::Instance().setWin(isWinner);
     OpponentModel::Instance().write();
+
+    Profiler::Instance().onEnd();
+    FrameScheduler::Instance().logSummary();
+    FrameRecorder::Instance().onEnd();
 }
 
 void GameCommander::onUnitShow(BWAPI::Unit unit)			
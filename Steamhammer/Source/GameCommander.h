@@ -4,13 +4,14 @@
 
 #include "BuildingManager.h"
 #include "CombatCommander.h"
+#include "FrameScheduler.h"
 #include "InformationManager.h"
 #include "MapGrid.h"
 #include "OpponentModel.h"
 #include "ProductionManager.h"
 #include "ScoutManager.h"
 #include "StrategyManager.h"
-#include "TimerManager.h"
+#include "Profiler.h"
 #include "WorkerManager.h"
 
 namespace UAlbertaBot
@@ -33,7 +34,6 @@ public:
 class GameCommander 
 {
 	CombatCommander &		_combatCommander;
-	TimerManager		    _timerManager;
 
 	BWAPI::Unitset          _validUnits;
 	BWAPI::Unitset          _combatUnits;
@@ -51,6 +51,8 @@ class GameCommander
 
 	bool					surrenderMonkey();
 
+	void					registerTasks();
+
 	BWAPI::Unit getScoutWorker();
 
 public:
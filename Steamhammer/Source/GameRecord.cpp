@@ -13,7 +13,7 @@ const std::vector<std::string> GameRecord::SupportedFileFormatVersions = { "1.4"
 // Take a digest snapshot of the game situation.
 void GameRecord::takeSnapshot()
 {
-	snapshots.push_back(new GameSnapshot(PlayerSnapshot (BWAPI::Broodwar->self()), PlayerSnapshot (BWAPI::Broodwar->enemy())));
+	snapshots.emplace_back(PlayerSnapshot (BWAPI::Broodwar->self()), PlayerSnapshot (BWAPI::Broodwar->enemy()));
 }
 
 BWAPI::Race GameRecord::charRace(char ch)
@@ -146,8 +146,8 @@ bool GameRecord::readPlayerSnapshot(std::istream & input, PlayerSnapshot & snap)
 	throw game_record_read_error();
 }
 
-// Allocate and return the next snapshot, or null if none.
-GameSnapshot * GameRecord::readGameSnapshot(std::istream & input)
+// Read the next snapshot and add it to the record. Return false if there is none.
+bool GameRecord::readGameSnapshot(std::istream & input)
 {
 	int t;
 	PlayerSnapshot me;
@@ -159,17 +159,18 @@ GameSnapshot * GameRecord::readGameSnapshot(std::istream & input)
 	{
 		if (line == gameEndMark)
 		{
-			return nullptr;
+			return false;
 		}
 		t = readNumber(line);
 	}
 
 	if (valid && readPlayerSnapshot(input, me) && valid && readPlayerSnapshot(input, you) && valid)
 	{
-		return new GameSnapshot(t, me, you);
+		snapshots.emplace_back(t, me, you);
+		return true;
 	}
 
-	return nullptr;
+	return false;
 }
 
 // Reading a game record, we hit an error before the end of the record.
@@ -237,10 +238,8 @@ void GameRecord::read(std::istream & input)
             pylonHarassBehaviour = readNumber(input);
         }
 
-		GameSnapshot * snap;
-		while (snap = readGameSnapshot(input))
+		while (readGameSnapshot(input))
 		{
-			snapshots.push_back(snap);
 		}
 	}
 	catch (const game_record_read_error &)
@@ -260,11 +259,11 @@ void GameRecord::writePlayerSnapshot(std::ostream & output, const PlayerSnapshot
 	output << '\n';
 }
 
-void GameRecord::writeGameSnapshot(std::ostream & output, const GameSnapshot * snap)
+void GameRecord::writeGameSnapshot(std::ostream & output, const GameSnapshot & snap)
 {
-	output << snap->frame << '\n';
-	writePlayerSnapshot(output, snap->us);
-	writePlayerSnapshot(output, snap->them);
+	output << snap.frame << '\n';
+	writePlayerSnapshot(output, snap.us);
+	writePlayerSnapshot(output, snap.them);
 }
 
 // Calculate a similarity distance between 2 snapshots.
@@ -272,31 +271,40 @@ void GameRecord::writeGameSnapshot(std::ostream & output, const GameSnapshot * s
 // 12 vs. 10 zerglings should count less than 2 vs. 0 lurkers.
 // Buildings and mobile units are hard to compare. Probably should weight by cost in some way.
 // Part of distance().
-int GameRecord::snapDistance(const PlayerSnapshot & a, const PlayerSnapshot & b) const
+// Both count vectors are in order of type ID, so walk them together. A type missing
+// from one side counts as 0 of that type.
+int GameRecord::snapDistance(const SnapshotCounts & a, const SnapshotCounts & b)
 {
 	int distance = 0;
 
-	// From a to b, count all differences.
-	for (std::pair<BWAPI::UnitType, int> unitCountA : a.unitCounts)
+	auto itA = a.begin();
+	auto itB = b.begin();
+	while (itA != a.end() && itB != b.end())
 	{
-		auto unitCountBIt = b.unitCounts.find(unitCountA.first);
-		if (unitCountBIt == b.unitCounts.end())
+		if (itA->first < itB->first)
+		{
+			distance += itA->second;
+			++itA;
+		}
+		else if (itB->first < itA->first)
 		{
-			distance += unitCountA.second;
+			distance += itB->second;
+			++itB;
 		}
 		else
 		{
-			distance += abs(unitCountA.second - (*unitCountBIt).second);
+			distance += abs(itA->second - itB->second);
+			++itA;
+			++itB;
 		}
 	}
-
-	// From b to a, count differences where a is missing the type.
-	for (std::pair<BWAPI::UnitType, int> unitCountB : b.unitCounts)
+	for (; itA != a.end(); ++itA)
 	{
-		if (a.unitCounts.find(unitCountB.first) == a.unitCounts.end())
-		{
-			distance += unitCountB.second;
-		}
+		distance += itA->second;
+	}
+	for (; itB != b.end(); ++itB)
+	{
+		distance += itB->second;
 	}
 
 	return distance;
@@ -350,6 +358,110 @@ GameRecord::GameRecord()
 {
 }
 
+// Read one player snapshot in the binary format.
+void GameRecord::readBinaryPlayerSnapshot(const char *& data, const char * end, PlayerSnapshot & snap)
+{
+	snap.numBases = getNumber(data, end);
+
+	const int nTypes = getNumber(data, end);
+	for (int i = 0; i < nTypes; ++i)
+	{
+		const int id = getNumber(data, end);
+		snap.unitCounts[BWAPI::UnitType(id)] = getNumber(data, end);
+	}
+}
+
+// Read a game record in the binary format from the given bytes, which hold exactly one record.
+// The fields are the same as in the text format, in the same order, with the snapshots
+// preceded by their count. Extra bytes at the end are ignored, so that later formats
+// can add fields.
+void GameRecord::readBinary(const char * data, const char * end)
+{
+	try
+	{
+		ourRace = charRace(char(getNumber(data, end)));
+		enemyRace = charRace(char(getNumber(data, end)));
+		enemyIsRandom = getNumber(data, end) != 0;
+
+		// Validity check. We should know our own race.
+		if (ourRace == BWAPI::Races::Unknown)
+		{
+			throw game_record_read_error();
+		}
+
+		for (std::string * str : { &mapName, &openingName })
+		{
+			const int length = getNumber(data, end);
+			if (end - data < length)
+			{
+				throw game_record_read_error();
+			}
+			str->assign(data, length);
+			data += length;
+		}
+
+		for (OpeningPlan * plan : { &expectedEnemyPlan, &enemyPlan })
+		{
+			const int n = getNumber(data, end);
+			if (n >= int(OpeningPlan::Size))
+			{
+				throw game_record_read_error();
+			}
+			*plan = OpeningPlan(n);
+		}
+
+		win = getNumber(data, end) != 0;
+		frameScoutSentForGasSteal = getNumber(data, end);
+		gasStealHappened = getNumber(data, end) != 0;
+		frameEnemyScoutsOurBase = getNumber(data, end);
+		frameEnemyGetsCombatUnits = getNumber(data, end);
+		frameEnemyGetsAirUnits = getNumber(data, end);
+		frameEnemyGetsStaticAntiAir = getNumber(data, end);
+		frameEnemyGetsMobileAntiAir = getNumber(data, end);
+		frameEnemyGetsCloakedUnits = getNumber(data, end);
+		frameEnemyGetsStaticDetection = getNumber(data, end);
+		frameEnemyGetsMobileDetection = getNumber(data, end);
+		frameGameEnds = getNumber(data, end);
+		pylonHarassBehaviour = getNumber(data, end);
+
+		const int nSnapshots = getNumber(data, end);
+		for (int i = 0; i < nSnapshots; ++i)
+		{
+			const int t = getNumber(data, end);
+			PlayerSnapshot me;
+			PlayerSnapshot you;
+			readBinaryPlayerSnapshot(data, end, me);
+			readBinaryPlayerSnapshot(data, end, you);
+			snapshots.emplace_back(t, me, you);
+		}
+	}
+	catch (const game_record_read_error &)
+	{
+		valid = false;
+	}
+}
+
+void GameRecord::writeBinaryPlayerSnapshot(std::string & output, const PlayerSnapshot & snap)
+{
+	putNumber(output, snap.numBases);
+	putNumber(output, int(snap.unitCounts.size()));
+	for (const auto & unitCount : snap.unitCounts)
+	{
+		putNumber(output, unitCount.first.getID());
+		putNumber(output, unitCount.second);
+	}
+}
+
+// We only now notice that there was an expected enemy opening plan.
+// Can't initialize this right off, and there is no point in tracking it during the game.
+void GameRecord::prepareToWrite()
+{
+	if (!savedRecord)
+	{
+		expectedEnemyPlan = OpponentModel::Instance().getInitialExpectedEnemyPlan();
+	}
+}
+
 // Constructor for the record of a past game.
 GameRecord::GameRecord(std::istream & input)
 	: valid(true)                  // until proven otherwise
@@ -376,6 +488,32 @@ GameRecord::GameRecord(std::istream & input)
 	read(input);
 }
 
+// Constructor for the record of a past game, in the binary format.
+GameRecord::GameRecord(const char * data, const char * end)
+	: valid(true)                  // until proven otherwise
+	, savedRecord(true)
+	, ourRace(BWAPI::Races::Unknown)
+	, enemyRace(BWAPI::Races::Unknown)
+	, enemyIsRandom(false)
+	, expectedEnemyPlan(OpeningPlan::Unknown)
+	, enemyPlan(OpeningPlan::Unknown)
+	, win(false)                   // until proven otherwise
+	, frameScoutSentForGasSteal(0)
+	, gasStealHappened(false)
+	, frameEnemyScoutsOurBase(0)
+	, frameEnemyGetsCombatUnits(0)
+	, frameEnemyGetsAirUnits(0)
+	, frameEnemyGetsStaticAntiAir(0)
+	, frameEnemyGetsMobileAntiAir(0)
+	, frameEnemyGetsCloakedUnits(0)
+	, frameEnemyGetsStaticDetection(0)
+	, frameEnemyGetsMobileDetection(0)
+	, frameGameEnds(0)
+	, pylonHarassBehaviour(0)
+{
+	readBinary(data, end);
+}
+
 // Called when the game is over.
 void GameRecord::setWin(bool isWinner)
 {
@@ -409,12 +547,7 @@ void GameRecord::setWin(bool isWinner)
 
 void GameRecord::write(std::ostream & output)
 {
-	// We only now notice that there was an expected enemy opening plan.
-	// Can't initialize this right off, and there is no point in tracking it during the game.
-	if (!savedRecord)
-	{
-		expectedEnemyPlan = OpponentModel::Instance().getInitialExpectedEnemyPlan();
-	}
+	prepareToWrite();
 
 	output << currentFileFormatVersion << '\n';
 	output <<
@@ -439,15 +572,90 @@ void GameRecord::write(std::ostream & output)
 	output << frameGameEnds << '\n';
 	output << pylonHarassBehaviour << '\n';
 
-	// TODO skip the snapshots for now
-	// for (const auto & snap : snapshots)
-	// {
-	// 	writeGameSnapshot(output, snap);
-	// }
+	for (const GameSnapshot & snap : snapshots)
+	{
+		writeGameSnapshot(output, snap);
+	}
 
 	output << gameEndMark << '\n';
 }
 
+// Write the game record in the binary format. See readBinary().
+void GameRecord::writeBinary(std::string & output)
+{
+	prepareToWrite();
+
+	putNumber(output, RaceChar(ourRace));
+	putNumber(output, RaceChar(enemyRace));
+	putNumber(output, enemyIsRandom ? 1 : 0);
+
+	for (const std::string * str : { &mapName, &openingName })
+	{
+		putNumber(output, int(str->size()));
+		output += *str;
+	}
+
+	putNumber(output, int(expectedEnemyPlan));
+	putNumber(output, int(enemyPlan));
+	putNumber(output, win ? 1 : 0);
+	putNumber(output, frameScoutSentForGasSteal);
+	putNumber(output, gasStealHappened ? 1 : 0);
+	putNumber(output, frameEnemyScoutsOurBase);
+	putNumber(output, frameEnemyGetsCombatUnits);
+	putNumber(output, frameEnemyGetsAirUnits);
+	putNumber(output, frameEnemyGetsStaticAntiAir);
+	putNumber(output, frameEnemyGetsMobileAntiAir);
+	putNumber(output, frameEnemyGetsCloakedUnits);
+	putNumber(output, frameEnemyGetsStaticDetection);
+	putNumber(output, frameEnemyGetsMobileDetection);
+	putNumber(output, frameGameEnds);
+	putNumber(output, pylonHarassBehaviour);
+
+	putNumber(output, int(snapshots.size()));
+	for (const GameSnapshot & snap : snapshots)
+	{
+		putNumber(output, snap.frame);
+		writeBinaryPlayerSnapshot(output, snap.us);
+		writeBinaryPlayerSnapshot(output, snap.them);
+	}
+}
+
+// Numbers are written 7 bits per byte, low bits first, with the high bit set on every byte
+// but the last. Nearly everything in a game record fits in 1 to 3 bytes.
+void GameRecord::putNumber(std::string & output, int n)
+{
+	unsigned int u = static_cast<unsigned int>(n);
+	while (u >= 0x80)
+	{
+		output.push_back(char((u & 0x7F) | 0x80));
+		u >>= 7;
+	}
+	output.push_back(char(u));
+}
+
+int GameRecord::getNumber(const char *& data, const char * end)
+{
+	unsigned int u = 0;
+	for (int shift = 0; shift < 32; shift += 7)
+	{
+		if (data == end)
+		{
+			throw game_record_read_error();
+		}
+		const unsigned char byte = static_cast<unsigned char>(*data++);
+		u |= static_cast<unsigned int>(byte & 0x7F) << shift;
+		if (!(byte & 0x80))
+		{
+			if (int(u) < 0)
+			{
+				throw game_record_read_error();
+			}
+			return int(u);
+		}
+	}
+	throw game_record_read_error();
+}
+
 void GameRecord::update()
 {
 	int now = BWAPI::Broodwar->getFrameCount();
@@ -531,6 +739,26 @@ int GameRecord::distance(const GameRecord & record) const
 		return -1;
 	}
 
+	// If the other record ends too early, the comparison is no good.
+	// The game we're trying to compare to ended before this game and has no information for us.
+	const int nSnapshots = (std::min)(getNumSnapshots(), record.getNumSnapshots());    // until one record runs out
+	if (!record.coversNow(nSnapshots))
+	{
+		return -1;
+	}
+
+	int distance = mapOpeningDistance(record);
+	for (int i = 0; i < nSnapshots; ++i)
+	{
+		distance += snapshotDistance(i, record);
+	}
+
+	return distance;
+}
+
+// The part of distance() that does not depend on the snapshots.
+int GameRecord::mapOpeningDistance(const GameRecord & record) const
+{
 	int distance = 0;
 
 	if (mapName != record.mapName)
@@ -543,28 +771,27 @@ int GameRecord::distance(const GameRecord & record) const
 		distance += 200;
 	}
 
-	// Differences in enemy play count 5 times more than differences in our play.
-	auto here = snapshots.begin();
-	auto there = record.snapshots.begin();
-	int latest = 0;
-	while (here != snapshots.end() && there != record.snapshots.end())     // until one record runs out
-	{
-		distance +=     snapDistance((*here)->us,   (*there)->us);
-		distance += 5 * snapDistance((*here)->them, (*there)->them);
-		latest = (*there)->frame;
+	return distance;
+}
 
-		++here;
-		++there;
-	}
+// The distance between snapshot i of this record and snapshot i of the other record.
+// Both records must have snapshot i.
+// Differences in enemy play count 5 times more than differences in our play.
+int GameRecord::snapshotDistance(int i, const GameRecord & record) const
+{
+	const GameSnapshot & here = snapshots[i];
+	const GameSnapshot & there = record.snapshots[i];
 
-	// If the 'there' record ends too early, the comparison is no good after all.
-	// The game we're trying to compare to ended before this game and has no information for us.
-	if (BWAPI::Broodwar->getFrameCount() - latest > snapshotInterval)
-	{
-		return -1;
-	}
+	return
+		    snapDistance(here.usCounts,   there.usCounts) +
+		5 * snapDistance(here.themCounts, there.themCounts);
+}
 
-	return distance;
+// Compared over its first nSnapshots snapshots, does this record reach close to the current time?
+bool GameRecord::coversNow(int nSnapshots) const
+{
+	const int latest = nSnapshots > 0 ? snapshots[nSnapshots - 1].frame : 0;
+	return BWAPI::Broodwar->getFrameCount() - latest <= snapshotInterval;
 }
 
 // Find the enemy snapshot closest in time to time t.
@@ -573,9 +800,9 @@ bool GameRecord::findClosestSnapshot(int t, PlayerSnapshot & snap) const
 {
 	for (const auto & ourSnap : snapshots)
 	{
-		if (abs(ourSnap->frame - t) < snapshotInterval)
+		if (abs(ourSnap.frame - t) < snapshotInterval)
 		{
-			snap = ourSnap->them;
+			snap = ourSnap.them;
 			return true;
 		}
 	}
@@ -601,11 +828,11 @@ void GameRecord::debugLog()
 		<< "vessels " << frameEnemyGetsMobileDetection << '\n'
 		<< "end of game " << frameGameEnds << '\n';
 
-	for (auto snap : snapshots)
+	for (const GameSnapshot & snap : snapshots)
 	{
-		msg << snap->frame << '\n'
-			<< snap->us.debugString()
-			<< snap->them.debugString();
+		msg << snap.frame << '\n'
+			<< snap.us.debugString()
+			<< snap.them.debugString();
 	}
 	msg  << '\n';
 
@@ -13,17 +13,25 @@ class game_record_read_error : public std::exception {};
 
 namespace UAlbertaBot
 {
+// The unit counts of a player snapshot as (unit type ID, count) pairs in order of type ID,
+// so that two snapshots can be compared in a single pass with no lookups.
+typedef std::vector<std::pair<int, int>> SnapshotCounts;
+
 struct GameSnapshot
 {
 	const int frame;
 	const PlayerSnapshot us;
 	const PlayerSnapshot them;
+	const SnapshotCounts usCounts;
+	const SnapshotCounts themCounts;
 
 	// For reading a snapshot from a file.
 	GameSnapshot(int t, const PlayerSnapshot & me, const PlayerSnapshot & you)
 		: frame(t)
 		, us(me)
 		, them(you)
+		, usCounts(countsOf(me))
+		, themCounts(countsOf(you))
 	{
 	}
 
@@ -32,8 +40,22 @@ struct GameSnapshot
 		: frame(BWAPI::Broodwar->getFrameCount())
 		, us(me)
 		, them(you)
+		, usCounts(countsOf(me))
+		, themCounts(countsOf(you))
 	{
 	}
+
+	static SnapshotCounts countsOf(const PlayerSnapshot & snap)
+	{
+		// The map is already in order of type ID.
+		SnapshotCounts counts;
+		counts.reserve(snap.unitCounts.size());
+		for (const auto & unitCount : snap.unitCounts)
+		{
+			counts.emplace_back(unitCount.first.getID(), unitCount.second);
+		}
+		return counts;
+	}
 };
 
 class GameRecord
@@ -82,8 +104,7 @@ private:
 	int frameGameEnds;
     int pylonHarassBehaviour;
 
-	// We allocate the snapshots and never release them.
-	std::vector<GameSnapshot *> snapshots;
+	std::vector<GameSnapshot> snapshots;
 
 	void takeSnapshot();
 
@@ -97,20 +118,27 @@ private:
 	OpeningPlan readOpeningPlan(std::istream & input);
 
 	bool readPlayerSnapshot(std::istream & input, PlayerSnapshot & snap);
-	GameSnapshot * readGameSnapshot(std::istream & input);
+	bool readGameSnapshot(std::istream & input);
 	void skipToEnd(std::istream & input);
 	void read(std::istream & input);
 
 	void writePlayerSnapshot(std::ostream & output, const PlayerSnapshot & snap);
-	void writeGameSnapshot(std::ostream & output, const GameSnapshot * snap);
+	void writeGameSnapshot(std::ostream & output, const GameSnapshot & snap);
+
+	void readBinaryPlayerSnapshot(const char *& data, const char * end, PlayerSnapshot & snap);
+	void readBinary(const char * data, const char * end);
+	void writeBinaryPlayerSnapshot(std::string & output, const PlayerSnapshot & snap);
 
-	int snapDistance(const PlayerSnapshot & a, const PlayerSnapshot & b) const;
+	void prepareToWrite();
+
+	static int snapDistance(const SnapshotCounts & a, const SnapshotCounts & b);
 
 	bool enemyScoutedUs() const;
 
 public:
 	GameRecord();
 	GameRecord(std::istream & input);
+	GameRecord(const char * data, const char * end);
 
 	bool isValid() { return valid; };
 	void setOpening(const std::string & opening) { openingName = opening; };
@@ -118,13 +146,28 @@ public:
     void setPylonHarassBehaviour(int result) { pylonHarassBehaviour = result; };
 
 	void write(std::ostream & output);
+	void writeBinary(std::string & output);
+
+	// Numbers in the binary format. They must be >= 0.
+	// Reading throws game_record_read_error at the end of the data or on a malformed number.
+	static void putNumber(std::string & output, int n);
+	static int getNumber(const char *& data, const char * end);
 
 	void update();
 
 	int distance(const GameRecord & record) const;    // similarity distance
 
+	// The parts of distance(), for callers that keep partial distances between calls.
+	int mapOpeningDistance(const GameRecord & record) const;
+	int snapshotDistance(int i, const GameRecord & record) const;
+	bool coversNow(int nSnapshots) const;
+
+	int getNumSnapshots() const { return int(snapshots.size()); };
+
 	bool findClosestSnapshot(int t, PlayerSnapshot & snap) const;
 
+	BWAPI::Race getOurRace() const { return ourRace; };
+	BWAPI::Race getEnemyRace() const { return enemyRace; };
 	bool getEnemyIsRandom() const { return enemyIsRandom; };
 	bool sameMatchup(const GameRecord & record) const;
 	const std::string & getMapName() const { return mapName; };
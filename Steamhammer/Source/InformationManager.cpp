@@ -7,10 +7,28 @@
 #include "Random.h"
 #include "UnitUtil.h"
 #include "PathFinding.h"
+#include "Profiler.h"
 
 namespace { auto & bwemMap = BWEM::Map::Instance(); }
 namespace { auto & bwebMap = BWEB::Map::Instance(); }
 
+namespace
+{
+	// Whether any known unit of the type is completed, or is estimated to have completed by now.
+	bool anyCompleted(const UAlbertaBot::UnitData & unitData, BWAPI::UnitType type)
+	{
+		for (const auto ui : unitData.getUnitsOfType(type))
+		{
+			if (ui->completed || ui->estimatedCompletionFrame < BWAPI::Broodwar->getFrameCount())
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
+
 using namespace UAlbertaBot;
 
 InformationManager::InformationManager()
@@ -308,7 +326,7 @@ void InformationManager::update()
 {
     // Update the upgrade trackers first, as they adjust the grids when the range or damage changes
     for (auto & upgradeTracker : _upgradeTrackers)
-        upgradeTracker.second.update(getUnitInfo(upgradeTracker.first), getUnitGrid(upgradeTracker.first));
+        upgradeTracker.second.update(getUnitData(upgradeTracker.first), getUnitGrid(upgradeTracker.first));
 
 	updateUnitInfo();
 	updateBaseLocationInfo();
@@ -439,7 +457,7 @@ void InformationManager::update()
         }
     }
 
-    if (anyDebugUnits) Log().Debug() << debug.str();
+    if (anyDebugUnits) LOG_DEBUG << debug.str();
 }
 
 void InformationManager::updateUnitInfo() 
@@ -716,7 +734,7 @@ void InformationManager::updateTheBases()
                     if (!unit->isFlying() && UnitUtil::IsCombatUnit(unit))
                     {
                         _theBases[base]->spiderMined = false;
-                        Log().Debug() << "Defused spider-mined base @ " << base->getTilePosition();
+                        LOG_DEBUG << "Defused spider-mined base @ " << base->getTilePosition();
                         break;
                     }
                 }
@@ -826,7 +844,7 @@ void InformationManager::updateBullets()
 
 bool trace(BWAPI::TilePosition tile, BWAPI::TilePosition wallTile, int direction, std::set<BWAPI::TilePosition> & wallTiles)
 {
-    Log().Debug() << "Wall tracing from " << tile << "; wall " << wallTile << "; direction=" << direction;
+    LOG_DEBUG << "Wall tracing from " << tile << "; wall " << wallTile << "; direction=" << direction;
 
     BWAPI::TilePosition start = tile;
 
@@ -873,7 +891,7 @@ bool trace(BWAPI::TilePosition tile, BWAPI::TilePosition wallTile, int direction
         wallTile = nextWall;
         wallTiles.insert(wallTile);
 
-        Log().Debug() << "Next " << tile << "; wall " << wallTile << "; direction=" << direction;
+        LOG_DEBUG << "Next " << tile << "; wall " << wallTile << "; direction=" << direction;
     }
 }
 
@@ -903,6 +921,8 @@ void floodFill(BWAPI::TilePosition start, std::set<BWAPI::TilePosition> & visite
 // If it is near a chokepoint, we check if it creates a wall
 void InformationManager::detectEnemyWall(BWAPI::Unit unit)
 {
+    PROFILE_ZONE("Detect enemy wall");
+
     if (!unit->getType().isBuilding()) return;
 
     // Ensure BWEB has the building registered
@@ -1095,20 +1115,13 @@ bool InformationManager::isEnemyBuildingInRegion(BWTA::Region * region, bool ign
 
 bool InformationManager::isEnemyBuildingNearby(BWAPI::Position position, int threshold, bool ignoreRefineries, bool ignorePylons)
 {
-	for (const auto & kv : _unitData[_enemy].getUnits())
+	return _unitData[_enemy].anyUnitNear(position, threshold, [&](const UnitInfo & ui)
 	{
-		const UnitInfo & ui(kv.second);
-
-		if (ui.type.isBuilding() && !ui.goneFromLastPosition && (!ignoreRefineries || !ui.type.isRefinery()) && (!ignorePylons || ui.type != BWAPI::UnitTypes::Protoss_Pylon))
-		{
-			if (ui.lastPosition.getApproxDistance(position) < threshold) 
-			{
-				return true;
-			}
-		}
-	}
-
-	return false;
+		return ui.type.isBuilding() && !ui.goneFromLastPosition &&
+			(!ignoreRefineries || !ui.type.isRefinery()) &&
+			(!ignorePylons || ui.type != BWAPI::UnitTypes::Protoss_Pylon) &&
+			ui.lastPosition.getApproxDistance(position) < threshold;
+	});
 }
 
 const UIMap & InformationManager::getUnitInfo(BWAPI::Player player) const
@@ -1336,13 +1349,12 @@ int InformationManager::getAir2GroundSupply(BWAPI::Player player) const
 {
 	int supply = 0;
 
-	for (const auto & kv : getUnitData(player).getUnits())
+	const UnitData & unitData = getUnitData(player);
+	for (BWAPI::UnitType type : unitData.getKnownTypes())
 	{
-		const UnitInfo & ui(kv.second);
-
-		if (ui.type.isFlyer() && UnitUtil::TypeCanAttackGround(ui.type))
+		if (type.isFlyer() && UnitUtil::TypeCanAttackGround(type))
 		{
-			supply += ui.type.supplyRequired();
+			supply += type.supplyRequired() * int(unitData.getUnitsOfType(type).size());
 		}
 	}
 
@@ -1697,13 +1709,23 @@ void InformationManager::onEnemyBuildingFlying(BWAPI::UnitType type, BWAPI::Posi
 }
 
 // Only returns units believed to be completed.
-void InformationManager::getNearbyForce(std::vector<UnitInfo> & unitInfo, BWAPI::Position p, BWAPI::Player player, int radius) 
+// Call f on each of the player's combat units that could take part in a fight within the radius.
+template <class Func>
+void InformationManager::forNearbyForce(BWAPI::Position p, BWAPI::Player player, int radius, Func f)
 {
-	// for each unit we know about for that player
-	for (const auto & kv : getUnitData(player).getUnits())
+	// The longest range any unit can have, to bound the search
+	static int maxRange = 0;
+	if (maxRange == 0)
 	{
-		const UnitInfo & ui(kv.second);
+		for (BWAPI::UnitType type : BWAPI::UnitTypes::allUnitTypes())
+		{
+			maxRange = std::max(maxRange, UnitUtil::GetMaxAttackRange(type));
+		}
+	}
 
+	// for each unit we know about for that player that might be close enough
+	getUnitData(player).anyUnitNear(p, radius + std::max(maxRange + 32, 64), [&](const UnitInfo & ui)
+	{
 		// if it's a combat unit we care about
 		// and it's finished! 
 		if (UnitUtil::IsCombatSimUnit(ui.type) && ui.completed && !ui.goneFromLastPosition)
@@ -1713,7 +1735,7 @@ void InformationManager::getNearbyForce(std::vector<UnitInfo> & unitInfo, BWAPI:
 				// Spellcasters that the combat simulator is able to simulate.
 				if (ui.lastPosition.getDistance(p) <= (radius + 64))
 				{
-					unitInfo.push_back(ui);
+					f(ui);
 				}
 			}
 			else
@@ -1726,16 +1748,28 @@ void InformationManager::getNearbyForce(std::vector<UnitInfo> & unitInfo, BWAPI:
 				// Include it if it can attack into the radius we care about (with fudge factor).
 				if (range && ui.lastPosition.getDistance(p) <= (radius + range + 32))
 				{
-					unitInfo.push_back(ui);
+					f(ui);
 				}
 			}
 		}
 		// NOTE FAP does not support detectors.
 		// else if (ui.type.isDetector() && ui.lastPosition.getDistance(p) <= (radius + 250))
         // {
-		//	unitInfo.push_back(ui);
+		//	f(ui);
         // }
-	}
+
+		return false;
+	});
+}
+
+void InformationManager::getNearbyForce(std::vector<UnitInfo> & unitInfo, BWAPI::Position p, BWAPI::Player player, int radius)
+{
+	forNearbyForce(p, player, radius, [&](const UnitInfo & ui) { unitInfo.push_back(ui); });
+}
+
+void InformationManager::getNearbyForce(FrameVector<UnitInfo> & unitInfo, BWAPI::Position p, BWAPI::Player player, int radius)
+{
+	forNearbyForce(p, player, radius, [&](const UnitInfo & ui) { unitInfo.push_back(ui); });
 }
 
 int InformationManager::getNumUnits(BWAPI::UnitType t, BWAPI::Player player) const
@@ -1835,18 +1869,24 @@ bool InformationManager::enemyHasCombatUnits()
 		return true;
 	}
 
-	for (const auto & kv : getUnitData(_enemy).getUnits())
+	const UnitData & enemyData = getUnitData(_enemy);
+	for (BWAPI::UnitType type : enemyData.getKnownTypes())
 	{
-		const UnitInfo & ui(kv.second);
+		if (type.isWorker() ||
+			type.isBuilding() ||
+			type == BWAPI::UnitTypes::Zerg_Larva ||
+			type == BWAPI::UnitTypes::Zerg_Overlord)
+		{
+			continue;
+		}
 
-		if (!ui.type.isWorker() &&
-			!ui.type.isBuilding() &&
-			ui.completed &&
-			ui.type != BWAPI::UnitTypes::Zerg_Larva &&
-			ui.type != BWAPI::UnitTypes::Zerg_Overlord)
+		for (const auto ui : enemyData.getUnitsOfType(type))
 		{
-			_enemyHasCombatUnits = true;
-			return true;
+			if (ui->completed)
+			{
+				_enemyHasCombatUnits = true;
+				return true;
+			}
 		}
 	}
 
@@ -1869,19 +1909,13 @@ bool InformationManager::enemyCanProduceCombatUnits()
         return true;
     }
 
-	for (const auto & kv : getUnitData(_enemy).getUnits())
+	const UnitData & enemyData = getUnitData(_enemy);
+	if (anyCompleted(enemyData, BWAPI::UnitTypes::Zerg_Spawning_Pool) ||
+		anyCompleted(enemyData, BWAPI::UnitTypes::Terran_Barracks) ||
+		anyCompleted(enemyData, BWAPI::UnitTypes::Protoss_Gateway))
 	{
-		const UnitInfo & ui(kv.second);
-
-        bool completed = ui.completed || ui.estimatedCompletionFrame < BWAPI::Broodwar->getFrameCount();
-
-        if (completed && (ui.type == BWAPI::UnitTypes::Zerg_Spawning_Pool || 
-            ui.type == BWAPI::UnitTypes::Terran_Barracks ||
-            ui.type == BWAPI::UnitTypes::Protoss_Gateway))
-        {
-            _enemyCanProduceCombatUnits = true;
-            return true;
-        }
+		_enemyCanProduceCombatUnits = true;
+		return true;
 	}
 
 	return false;
@@ -1896,17 +1930,13 @@ bool InformationManager::enemyHasStaticAntiAir()
 		return true;
 	}
 
-	for (const auto & kv : getUnitData(_enemy).getUnits())
+	const UnitData & enemyData = getUnitData(_enemy);
+	if (enemyData.hasUnitOfType(BWAPI::UnitTypes::Terran_Missile_Turret) ||
+		enemyData.hasUnitOfType(BWAPI::UnitTypes::Protoss_Photon_Cannon) ||
+		enemyData.hasUnitOfType(BWAPI::UnitTypes::Zerg_Spore_Colony))
 	{
-		const UnitInfo & ui(kv.second);
-
-		if (ui.type == BWAPI::UnitTypes::Terran_Missile_Turret ||
-			ui.type == BWAPI::UnitTypes::Protoss_Photon_Cannon ||
-			ui.type == BWAPI::UnitTypes::Zerg_Spore_Colony)
-		{
-			_enemyHasStaticAntiAir = true;
-			return true;
-		}
+		_enemyHasStaticAntiAir = true;
+		return true;
 	}
 
 	return false;
@@ -1921,33 +1951,31 @@ bool InformationManager::enemyHasAntiAir()
 		return true;
 	}
 
-	for (const auto & kv : getUnitData(_enemy).getUnits())
+	for (BWAPI::UnitType type : getUnitData(_enemy).getKnownTypes())
 	{
-		const UnitInfo & ui(kv.second);
-
 		if (
 			// For terran, anything other than SCV, command center, depot is a hit.
 			// Surely nobody makes ebay before barracks!
 			(_enemy->getRace() == BWAPI::Races::Terran &&
-			ui.type != BWAPI::UnitTypes::Terran_SCV &&
-			ui.type != BWAPI::UnitTypes::Terran_Command_Center &&
-			ui.type != BWAPI::UnitTypes::Terran_Supply_Depot)
+			type != BWAPI::UnitTypes::Terran_SCV &&
+			type != BWAPI::UnitTypes::Terran_Command_Center &&
+			type != BWAPI::UnitTypes::Terran_Supply_Depot)
 
 			||
 
 			// Otherwise, any mobile unit that has an air weapon.
-			(!ui.type.isBuilding() && UnitUtil::TypeCanAttackAir(ui.type))
+			(!type.isBuilding() && UnitUtil::TypeCanAttackAir(type))
 
 			||
 
 			// Or a building for making such a unit.
-			ui.type == BWAPI::UnitTypes::Protoss_Cybernetics_Core ||
-			ui.type == BWAPI::UnitTypes::Protoss_Stargate ||
-			ui.type == BWAPI::UnitTypes::Protoss_Fleet_Beacon ||
-			ui.type == BWAPI::UnitTypes::Protoss_Arbiter_Tribunal ||
-			ui.type == BWAPI::UnitTypes::Zerg_Hydralisk_Den ||
-			ui.type == BWAPI::UnitTypes::Zerg_Spire ||
-			ui.type == BWAPI::UnitTypes::Zerg_Greater_Spire
+			type == BWAPI::UnitTypes::Protoss_Cybernetics_Core ||
+			type == BWAPI::UnitTypes::Protoss_Stargate ||
+			type == BWAPI::UnitTypes::Protoss_Fleet_Beacon ||
+			type == BWAPI::UnitTypes::Protoss_Arbiter_Tribunal ||
+			type == BWAPI::UnitTypes::Zerg_Hydralisk_Den ||
+			type == BWAPI::UnitTypes::Zerg_Spire ||
+			type == BWAPI::UnitTypes::Zerg_Greater_Spire
 
 			)
 		{
@@ -1972,23 +2000,23 @@ bool InformationManager::enemyHasAirTech()
 		return true;
 	}
 
-	for (const auto & kv : getUnitData(_enemy).getUnits())
+	const UnitData & enemyData = getUnitData(_enemy);
+	for (BWAPI::UnitType type : enemyData.getKnownTypes())
 	{
-		const UnitInfo & ui(kv.second);
+		bool needsCompletion =
+			type == BWAPI::UnitTypes::Terran_Starport ||
+			type == BWAPI::UnitTypes::Protoss_Stargate ||
+			type == BWAPI::UnitTypes::Zerg_Spire;
 
-		bool completed = ui.completed || ui.estimatedCompletionFrame < BWAPI::Broodwar->getFrameCount();
-
-		if ((ui.type.isFlyer() && ui.type != BWAPI::UnitTypes::Zerg_Overlord && ui.type != BWAPI::UnitTypes::Protoss_Observer) ||
-			(completed && ui.type == BWAPI::UnitTypes::Terran_Starport) ||
-			ui.type == BWAPI::UnitTypes::Terran_Control_Tower ||
-			ui.type == BWAPI::UnitTypes::Terran_Science_Facility ||
-			ui.type == BWAPI::UnitTypes::Terran_Covert_Ops ||
-			ui.type == BWAPI::UnitTypes::Terran_Physics_Lab ||
-			(completed && ui.type == BWAPI::UnitTypes::Protoss_Stargate) ||
-			ui.type == BWAPI::UnitTypes::Protoss_Arbiter_Tribunal ||
-			ui.type == BWAPI::UnitTypes::Protoss_Fleet_Beacon ||
-			(completed && ui.type == BWAPI::UnitTypes::Zerg_Spire) ||
-			ui.type == BWAPI::UnitTypes::Zerg_Greater_Spire)
+		if ((type.isFlyer() && type != BWAPI::UnitTypes::Zerg_Overlord && type != BWAPI::UnitTypes::Protoss_Observer) ||
+			(needsCompletion && anyCompleted(enemyData, type)) ||
+			type == BWAPI::UnitTypes::Terran_Control_Tower ||
+			type == BWAPI::UnitTypes::Terran_Science_Facility ||
+			type == BWAPI::UnitTypes::Terran_Covert_Ops ||
+			type == BWAPI::UnitTypes::Terran_Physics_Lab ||
+			type == BWAPI::UnitTypes::Protoss_Arbiter_Tribunal ||
+			type == BWAPI::UnitTypes::Protoss_Fleet_Beacon ||
+			type == BWAPI::UnitTypes::Zerg_Greater_Spire)
 		{
 			_enemyHasAirTech = true;
 			return true;
@@ -2006,18 +2034,18 @@ bool InformationManager::enemyWillSoonHaveAirTech()
 		return true;
 	}
 
-	for (const auto & kv : getUnitData(_enemy).getUnits())
+	const UnitData & enemyData = getUnitData(_enemy);
+	for (BWAPI::UnitType type : { BWAPI::UnitTypes::Terran_Starport, BWAPI::UnitTypes::Protoss_Stargate, BWAPI::UnitTypes::Zerg_Spire })
 	{
-		const UnitInfo & ui(kv.second);
-
-		bool willSoonComplete = !ui.completed && ui.estimatedCompletionFrame > 0 
-			&& ui.estimatedCompletionFrame < (BWAPI::Broodwar->getFrameCount() + BWAPI::UnitTypes::Protoss_Photon_Cannon.buildTime());
-
-		if ((willSoonComplete && ui.type == BWAPI::UnitTypes::Terran_Starport) ||
-			(willSoonComplete && ui.type == BWAPI::UnitTypes::Protoss_Stargate) ||
-			(willSoonComplete && ui.type == BWAPI::UnitTypes::Zerg_Spire))
+		for (const auto ui : enemyData.getUnitsOfType(type))
 		{
-			return true;
+			bool willSoonComplete = !ui->completed && ui->estimatedCompletionFrame > 0
+				&& ui->estimatedCompletionFrame < (BWAPI::Broodwar->getFrameCount() + BWAPI::UnitTypes::Protoss_Photon_Cannon.buildTime());
+
+			if (willSoonComplete)
+			{
+				return true;
+			}
 		}
 	}
 
@@ -2026,14 +2054,12 @@ bool InformationManager::enemyWillSoonHaveAirTech()
 
 bool InformationManager::enemyCurrentlyHasAirCombatUnits()
 {
-    for (const auto & kv : getUnitData(_enemy).getUnits())
+    for (BWAPI::UnitType type : getUnitData(_enemy).getKnownTypes())
     {
-        const UnitInfo & ui(kv.second);
-
-        if (!ui.type.isBuilding() && ui.type.isFlyer() &&
-            ui.type != BWAPI::UnitTypes::Zerg_Overlord &&
-            ui.type != BWAPI::UnitTypes::Protoss_Observer &&
-            ui.type != BWAPI::UnitTypes::Zerg_Scourge)
+        if (!type.isBuilding() && type.isFlyer() &&
+            type != BWAPI::UnitTypes::Zerg_Overlord &&
+            type != BWAPI::UnitTypes::Protoss_Observer &&
+            type != BWAPI::UnitTypes::Zerg_Scourge)
         {
             return true;
         }
@@ -2049,14 +2075,12 @@ bool InformationManager::enemyHasAirCombatUnits()
 		return true;
 	}
 
-	for (const auto & kv : getUnitData(_enemy).getUnits())
+	for (BWAPI::UnitType type : getUnitData(_enemy).getKnownTypes())
 	{
-		const UnitInfo & ui(kv.second);
-
-		if (!ui.type.isBuilding() && ui.type.isFlyer() && 
-            ui.type != BWAPI::UnitTypes::Zerg_Overlord && 
-            ui.type != BWAPI::UnitTypes::Protoss_Observer && 
-            ui.type != BWAPI::UnitTypes::Zerg_Scourge)
+		if (!type.isBuilding() && type.isFlyer() && 
+            type != BWAPI::UnitTypes::Zerg_Overlord && 
+            type != BWAPI::UnitTypes::Protoss_Observer && 
+            type != BWAPI::UnitTypes::Zerg_Scourge)
 		{
 			Log().Get() << "Detected enemy air combat unit";
 			_enemyHasAirCombatUnits = true;
@@ -2077,25 +2101,36 @@ bool InformationManager::enemyHasCloakTech()
 		return true;
 	}
 
-	for (const auto & kv : getUnitData(_enemy).getUnits())
+	const UnitData & enemyData = getUnitData(_enemy);
+	for (BWAPI::UnitType type : enemyData.getKnownTypes())
 	{
-		const UnitInfo & ui(kv.second);
-
-		if (ui.type.hasPermanentCloak() ||                             // DT, observer
-			ui.type.isCloakable() ||                                   // wraith, ghost
-			ui.type == BWAPI::UnitTypes::Terran_Vulture_Spider_Mine ||
-			(ui.type == BWAPI::UnitTypes::Protoss_Citadel_of_Adun && getEnemyName() != "cse") ||    // assume DT
-			ui.type == BWAPI::UnitTypes::Protoss_Templar_Archives ||   // assume DT
-			ui.type == BWAPI::UnitTypes::Protoss_Observatory ||
-			ui.type == BWAPI::UnitTypes::Protoss_Arbiter_Tribunal ||
-			ui.type == BWAPI::UnitTypes::Protoss_Arbiter ||
-			ui.type == BWAPI::UnitTypes::Zerg_Lurker ||
-			ui.type == BWAPI::UnitTypes::Zerg_Lurker_Egg ||
-			ui.unit->isBurrowed())
+		if (type.hasPermanentCloak() ||                             // DT, observer
+			type.isCloakable() ||                                   // wraith, ghost
+			type == BWAPI::UnitTypes::Terran_Vulture_Spider_Mine ||
+			(type == BWAPI::UnitTypes::Protoss_Citadel_of_Adun && getEnemyName() != "cse") ||    // assume DT
+			type == BWAPI::UnitTypes::Protoss_Templar_Archives ||   // assume DT
+			type == BWAPI::UnitTypes::Protoss_Observatory ||
+			type == BWAPI::UnitTypes::Protoss_Arbiter_Tribunal ||
+			type == BWAPI::UnitTypes::Protoss_Arbiter ||
+			type == BWAPI::UnitTypes::Zerg_Lurker ||
+			type == BWAPI::UnitTypes::Zerg_Lurker_Egg)
 		{
 			_enemyHasCloakTech = true;
 			return true;
 		}
+
+		// Only units of burrowable types can be burrowed
+		if (type.isBurrowable())
+		{
+			for (const auto ui : enemyData.getUnitsOfType(type))
+			{
+				if (ui->unit->isBurrowed())
+				{
+					_enemyHasCloakTech = true;
+					return true;
+				}
+			}
+		}
 	}
 
 	return false;
@@ -2111,18 +2146,16 @@ bool InformationManager::enemyHasMobileCloakTech()
 		return true;
 	}
 
-	for (const auto & kv : getUnitData(_enemy).getUnits())
+	for (BWAPI::UnitType type : getUnitData(_enemy).getKnownTypes())
 	{
-		const UnitInfo & ui(kv.second);
-
-		if (ui.type.isCloakable() ||                                   // wraith, ghost
-			ui.type == BWAPI::UnitTypes::Protoss_Dark_Templar ||
-			(ui.type == BWAPI::UnitTypes::Protoss_Citadel_of_Adun && getEnemyName() != "cse") ||    // assume DT
-			ui.type == BWAPI::UnitTypes::Protoss_Templar_Archives ||   // assume DT
-			ui.type == BWAPI::UnitTypes::Protoss_Arbiter_Tribunal ||
-			ui.type == BWAPI::UnitTypes::Protoss_Arbiter ||
-			ui.type == BWAPI::UnitTypes::Zerg_Lurker ||
-			ui.type == BWAPI::UnitTypes::Zerg_Lurker_Egg)
+		if (type.isCloakable() ||                                   // wraith, ghost
+			type == BWAPI::UnitTypes::Protoss_Dark_Templar ||
+			(type == BWAPI::UnitTypes::Protoss_Citadel_of_Adun && getEnemyName() != "cse") ||    // assume DT
+			type == BWAPI::UnitTypes::Protoss_Templar_Archives ||   // assume DT
+			type == BWAPI::UnitTypes::Protoss_Arbiter_Tribunal ||
+			type == BWAPI::UnitTypes::Protoss_Arbiter ||
+			type == BWAPI::UnitTypes::Zerg_Lurker ||
+			type == BWAPI::UnitTypes::Zerg_Lurker_Egg)
 		{
 			_enemyHasMobileCloakTech = true;
 			return true;
@@ -2141,14 +2174,12 @@ bool InformationManager::enemyHasCloakedCombatUnits()
         return true;
     }
 
-    for (const auto & kv : getUnitData(_enemy).getUnits())
+    for (BWAPI::UnitType type : getUnitData(_enemy).getKnownTypes())
     {
-        const UnitInfo & ui(kv.second);
-
-        if (ui.type.isCloakable() ||                                   // wraith, ghost
-            ui.type == BWAPI::UnitTypes::Protoss_Dark_Templar ||
-            ui.type == BWAPI::UnitTypes::Zerg_Lurker ||
-            ui.type == BWAPI::UnitTypes::Zerg_Lurker_Egg)
+        if (type.isCloakable() ||                                   // wraith, ghost
+            type == BWAPI::UnitTypes::Protoss_Dark_Templar ||
+            type == BWAPI::UnitTypes::Zerg_Lurker ||
+            type == BWAPI::UnitTypes::Zerg_Lurker_Egg)
         {
             Log().Get() << "Detected enemy cloaked combat unit";
             _enemyHasCloakedCombatUnits = true;
@@ -2171,21 +2202,21 @@ bool InformationManager::enemyHasOverlordHunters()
 		return true;
 	}
 
-	for (const auto & kv : getUnitData(_enemy).getUnits())
-	{
-		const UnitInfo & ui(kv.second);
-
-		if (ui.type == BWAPI::UnitTypes::Terran_Wraith ||
-			ui.type == BWAPI::UnitTypes::Terran_Valkyrie ||
-			ui.type == BWAPI::UnitTypes::Terran_Battlecruiser ||
-			ui.type == BWAPI::UnitTypes::Protoss_Corsair ||
-			ui.type == BWAPI::UnitTypes::Protoss_Scout ||
-			ui.type == BWAPI::UnitTypes::Protoss_Carrier ||
-			ui.type == BWAPI::UnitTypes::Protoss_Stargate ||
-			ui.type == BWAPI::UnitTypes::Zerg_Spire ||
-			ui.type == BWAPI::UnitTypes::Zerg_Greater_Spire ||
-			ui.type == BWAPI::UnitTypes::Zerg_Mutalisk ||
-			ui.type == BWAPI::UnitTypes::Zerg_Scourge)
+	const UnitData & enemyData = getUnitData(_enemy);
+	for (BWAPI::UnitType type : {
+			BWAPI::UnitTypes::Terran_Wraith,
+			BWAPI::UnitTypes::Terran_Valkyrie,
+			BWAPI::UnitTypes::Terran_Battlecruiser,
+			BWAPI::UnitTypes::Protoss_Corsair,
+			BWAPI::UnitTypes::Protoss_Scout,
+			BWAPI::UnitTypes::Protoss_Carrier,
+			BWAPI::UnitTypes::Protoss_Stargate,
+			BWAPI::UnitTypes::Zerg_Spire,
+			BWAPI::UnitTypes::Zerg_Greater_Spire,
+			BWAPI::UnitTypes::Zerg_Mutalisk,
+			BWAPI::UnitTypes::Zerg_Scourge })
+	{
+		if (enemyData.hasUnitOfType(type))
 		{
 			_enemyHasOverlordHunters = true;
 			return true;
@@ -2212,15 +2243,10 @@ bool InformationManager::enemyHasStaticDetection()
 		return true;
 	}
 
-	for (const auto & kv : getUnitData(_enemy).getUnits())
+	if (getUnitData(_enemy).hasUnitOfType(BWAPI::UnitTypes::Terran_Vulture_Spider_Mine))
 	{
-		const UnitInfo & ui(kv.second);
-
-		if (ui.type == BWAPI::UnitTypes::Terran_Vulture_Spider_Mine)
-		{
-			_enemyHasStaticDetection = true;
-			return true;
-		}
+		_enemyHasStaticDetection = true;
+		return true;
 	}
 
 	return false;
@@ -2243,19 +2269,15 @@ bool InformationManager::enemyHasMobileDetection()
 		return true;
 	}
 
-	for (const auto & kv : getUnitData(_enemy).getUnits())
+	const UnitData & enemyData = getUnitData(_enemy);
+	if (enemyData.hasUnitOfType(BWAPI::UnitTypes::Terran_Comsat_Station) ||
+		enemyData.hasUnitOfType(BWAPI::UnitTypes::Terran_Science_Facility) ||
+		enemyData.hasUnitOfType(BWAPI::UnitTypes::Terran_Science_Vessel) ||
+		enemyData.hasUnitOfType(BWAPI::UnitTypes::Protoss_Observatory) ||
+		enemyData.hasUnitOfType(BWAPI::UnitTypes::Protoss_Observer))
 	{
-		const UnitInfo & ui(kv.second);
-
-		if (ui.type == BWAPI::UnitTypes::Terran_Comsat_Station ||
-			ui.type == BWAPI::UnitTypes::Terran_Science_Facility ||
-			ui.type == BWAPI::UnitTypes::Terran_Science_Vessel ||
-			ui.type == BWAPI::UnitTypes::Protoss_Observatory ||
-			ui.type == BWAPI::UnitTypes::Protoss_Observer)
-		{
-			_enemyHasMobileDetection = true;
-			return true;
-		}
+		_enemyHasMobileDetection = true;
+		return true;
 	}
 
 	return false;
@@ -2273,15 +2295,10 @@ bool InformationManager::enemyHasSiegeTech()
     // Only terran can get siege tech
     if (_enemy->getRace() != BWAPI::Races::Terran) return false;
 
-	for (const auto & kv : getUnitData(_enemy).getUnits())
+	if (getUnitData(_enemy).hasUnitOfType(BWAPI::UnitTypes::Terran_Siege_Tank_Siege_Mode))
 	{
-		const UnitInfo & ui(kv.second);
-
-		if (ui.type == BWAPI::UnitTypes::Terran_Siege_Tank_Siege_Mode)
-		{
-            _enemyHasSiegeTech = true;
-			return true;
-		}
+        _enemyHasSiegeTech = true;
+		return true;
 	}
 
 	return false;
@@ -2344,6 +2361,11 @@ int InformationManager::getUnitArmor(BWAPI::Player player, BWAPI::UnitType type)
     return getUpgradeTracker(player).getUnitArmor(type);
 }
 
+const UpgradeTracker::UnitStats & InformationManager::getUnitStats(BWAPI::Player player, BWAPI::UnitType type)
+{
+    return getUpgradeTracker(player).getUnitStats(type);
+}
+
 // Our nearest shield battery, by air distance.
 // Null if none.
 BWAPI::Unit InformationManager::nearestShieldBattery(BWAPI::Position pos) const
@@ -2378,18 +2400,17 @@ int InformationManager::nScourgeNeeded()
 {
 	int count = 0;
 
-	for (const auto & kv : getUnitData(_enemy).getUnits())
+	const UnitData & enemyData = getUnitData(_enemy);
+	for (BWAPI::UnitType type : enemyData.getKnownTypes())
 	{
-		const UnitInfo & ui(kv.second);
-
 		// A few unit types should not usually be scourged. Skip them.
-		if (ui.type.isFlyer() &&
-			ui.type != BWAPI::UnitTypes::Zerg_Overlord &&
-			ui.type != BWAPI::UnitTypes::Zerg_Scourge &&
-			ui.type != BWAPI::UnitTypes::Protoss_Interceptor)
+		if (type.isFlyer() &&
+			type != BWAPI::UnitTypes::Zerg_Overlord &&
+			type != BWAPI::UnitTypes::Zerg_Scourge &&
+			type != BWAPI::UnitTypes::Protoss_Interceptor)
 		{
-			int hp = ui.type.maxHitPoints() + ui.type.maxShields();      // assume the worst
-			count += (hp + 109) / 110;
+			int hp = type.maxHitPoints() + type.maxShields();      // assume the worst
+			count += int(enemyData.getUnitsOfType(type).size()) * ((hp + 109) / 110);
 		}
 	}
 
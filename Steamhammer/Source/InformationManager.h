@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Common.h"
+#include "FrameArena.h"
 #include "BWTA.h"
 
 #include "Base.h"
@@ -92,6 +93,9 @@ class InformationManager
 
     UpgradeTracker&         getUpgradeTracker(BWAPI::Player player);
 
+    template <class Func>
+    void                    forNearbyForce(BWAPI::Position p, BWAPI::Player player, int radius, Func f);
+
 public:
 
     void                    update();
@@ -114,6 +118,7 @@ public:
     bool					nearbyForceHasCloaked(BWAPI::Position p,BWAPI::Player player,int radius);
 
     void                    getNearbyForce(std::vector<UnitInfo> & unitInfo,BWAPI::Position p,BWAPI::Player player,int radius);
+    void                    getNearbyForce(FrameVector<UnitInfo> & unitInfo,BWAPI::Position p,BWAPI::Player player,int radius);
 
     bool                    enemyHasWall() const { return !enemyWalls.empty(); }
     bool                    isEnemyWallBuilding(BWAPI::Unit unit);
@@ -180,6 +185,7 @@ public:
     int                     getUnitCooldown(BWAPI::Player player, BWAPI::UnitType type);
     double                  getUnitTopSpeed(BWAPI::Player player, BWAPI::UnitType type);
     int                     getUnitArmor(BWAPI::Player player, BWAPI::UnitType type);
+    const UpgradeTracker::UnitStats & getUnitStats(BWAPI::Player player, BWAPI::UnitType type);
 
 	void					enemySeenBurrowing() { _enemyHasCloakTech = true; };
 
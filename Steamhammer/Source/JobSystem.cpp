@@ -0,0 +1,188 @@
+#include "JobSystem.h"
+
+#include "Common.h"
+
+using namespace UAlbertaBot;
+
+namespace
+{
+	// This thread's queue: 0 for the main thread, 1 and up for workers, -1 for other threads.
+	thread_local int currentQueue = -1;
+}
+
+JobGroup::JobGroup()
+	: _pending(0)
+	, _skipped(0)
+	, _cancelled(false)
+	, _hasDeadline(false)
+{
+}
+
+// Set before starting the group's jobs.
+void JobGroup::setDeadline(Clock::time_point deadline)
+{
+	_hasDeadline = true;
+	_deadline = deadline;
+}
+
+bool JobGroup::cancelled() const
+{
+	return _cancelled || (_hasDeadline && Clock::now() >= _deadline);
+}
+
+JobSystem::JobSystem()
+	: _queued(0)
+	, _stopping(false)
+	, _deterministic(false)
+{
+	_queues.emplace_back(new Queue());
+}
+
+// Never destroyed, so that the workers are not joined while the DLL is unloading.
+JobSystem & JobSystem::Instance()
+{
+	static JobSystem * instance = new JobSystem();
+	return *instance;
+}
+
+void JobSystem::initialize()
+{
+	if (!_threads.empty())
+	{
+		return;
+	}
+
+	currentQueue = 0;
+	const int workers = (std::max)(1, int(std::thread::hardware_concurrency())) - 1;
+	for (int i = 1; i <= workers; ++i)
+	{
+		_queues.emplace_back(new Queue());
+	}
+	for (int i = 1; i <= workers; ++i)
+	{
+		_threads.emplace_back(&JobSystem::workerLoop, this, i);
+	}
+}
+
+void JobSystem::shutdown()
+{
+	{
+		std::lock_guard<std::mutex> lock(_wakeMutex);
+		_stopping = true;
+	}
+	_wake.notify_all();
+
+	for (std::thread & thread : _threads)
+	{
+		thread.join();
+	}
+	_threads.clear();
+	_queues.resize(1);
+	_stopping = false;
+}
+
+bool JobSystem::isMainThread() const
+{
+	return currentQueue == 0;
+}
+
+// Take the newest job from our own queue, or else the oldest from someone else's.
+bool JobSystem::takeJob(int queue, Job & job)
+{
+	const int n = int(_queues.size());
+	for (int i = 0; i < n; ++i)
+	{
+		Queue & q = *_queues[(queue + i) % n];
+		std::lock_guard<std::mutex> lock(q.mutex);
+		if (!q.jobs.empty())
+		{
+			if (i == 0)
+			{
+				job = std::move(q.jobs.back());
+				q.jobs.pop_back();
+			}
+			else
+			{
+				job = std::move(q.jobs.front());
+				q.jobs.pop_front();
+			}
+			--_queued;
+			return true;
+		}
+	}
+	return false;
+}
+
+void JobSystem::execute(Job & job)
+{
+	if (job.group->cancelled())
+	{
+		++job.group->_skipped;
+	}
+	else
+	{
+		job.work();
+	}
+	--job.group->_pending;
+}
+
+void JobSystem::workerLoop(int queue)
+{
+	currentQueue = queue;
+
+	while (!_stopping)
+	{
+		Job job;
+		if (takeJob(queue, job))
+		{
+			execute(job);
+		}
+		else
+		{
+			std::unique_lock<std::mutex> lock(_wakeMutex);
+			_wake.wait(lock, [this]() { return _stopping || _queued > 0; });
+		}
+	}
+}
+
+void JobSystem::run(JobGroup & group, std::function<void()> work)
+{
+	++group._pending;
+	Job job{ std::move(work), &group };
+
+	if (_threads.empty() || _deterministic)
+	{
+		execute(job);
+		return;
+	}
+
+	Queue & q = *_queues[(std::max)(0, currentQueue)];
+	{
+		std::lock_guard<std::mutex> lock(q.mutex);
+		q.jobs.push_back(std::move(job));
+	}
+	{
+		// Under the lock, so that a worker cannot miss the wakeup between its check and its wait.
+		std::lock_guard<std::mutex> lock(_wakeMutex);
+		++_queued;
+	}
+	_wake.notify_one();
+}
+
+// Run jobs until all of the group's jobs are done.
+void JobSystem::wait(JobGroup & group)
+{
+	const int queue = (std::max)(0, currentQueue);
+	while (group._pending > 0)
+	{
+		Job job;
+		if (takeJob(queue, job))
+		{
+			execute(job);
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A pool of worker threads that run jobs for any part of the bot, fork-join style.
+// Start jobs with run() under a JobGroup, then wait() for the group. A waiting thread runs
+// jobs itself rather than sleep. Each thread has its own queue; a thread with nothing to do
+// takes the oldest job from another thread's queue.
+// A group can be cancelled, or given a deadline such as the end of the frame's time budget.
+// Jobs of the group that have not started by then are skipped, and running jobs can check
+// cancelled() to stop early.
+// Jobs must not call BWAPI. Read what they need on the main thread before starting them.
+// In deterministic mode (Config::Debug::DeterministicJobs), and before initialize(), each
+// job runs at once on the thread that starts it, in order, for debugging.
+
+namespace UAlbertaBot
+{
+
+class JobGroup
+{
+	friend class JobSystem;
+
+public:
+	typedef std::chrono::steady_clock Clock;
+
+private:
+	std::atomic<int>	_pending;
+	std::atomic<int>	_skipped;
+	std::atomic<bool>	_cancelled;
+	bool				_hasDeadline;
+	Clock::time_point	_deadline;
+
+public:
+	JobGroup();
+
+	void	cancel()							{ _cancelled = true; };
+	void	setDeadline(Clock::time_point deadline);
+
+	// Cancelled, or past the deadline.
+	bool	cancelled() const;
+
+	// Jobs that were skipped because the group was cancelled.
+	int		skipped() const						{ return _skipped; };
+};
+
+class JobSystem
+{
+	struct Job
+	{
+		std::function<void()>	work;
+		JobGroup *				group;
+	};
+
+	struct Queue
+	{
+		std::mutex				mutex;
+		std::deque<Job>			jobs;
+	};
+
+	std::vector<std::unique_ptr<Queue>>	_queues;		// [0] is the main thread's
+	std::vector<std::thread>	_threads;
+	std::mutex					_wakeMutex;
+	std::condition_variable		_wake;
+	std::atomic<int>			_queued;
+	std::atomic<bool>			_stopping;
+	bool						_deterministic;
+
+	JobSystem();
+
+	bool	takeJob(int queue, Job & job);
+	void	execute(Job & job);
+	void	workerLoop(int queue);
+
+public:
+
+	static JobSystem & Instance();
+
+	// Start the workers. Call from the main thread.
+	void	initialize();
+	void	shutdown();
+	void	setDeterministic(bool deterministic)	{ _deterministic = deterministic; };
+
+	int		threadCount() const						{ return int(_threads.size()) + 1; };
+	bool	isMainThread() const;
+
+	void	run(JobGroup & group, std::function<void()> work);
+	void	wait(JobGroup & group);
+
+	// Call f(i) for each i in [0, count), in parallel, and wait for all of them.
+	template <class Func>
+	void	parallelFor(int count, Func f, JobGroup & group)
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			run(group, [&f, i]() { f(i); });
+		}
+		wait(group);
+	}
+
+	template <class Func>
+	void	parallelFor(int count, Func f)
+	{
+		JobGroup group;
+		parallelFor(count, f, group);
+	}
+};
+
+}
@@ -9,7 +9,7 @@ using namespace UAlbertaBot;
 // Generally this is more useful as it forces our units to keep their distance
 const int RANGE_BUFFER = 48;
 
-LocutusMapGrid::LocutusMapGrid(BWAPI::Player player) : _player(player) 
+LocutusMapGrid::LocutusMapGrid(BWAPI::Player player) : _player(player), threatVersion(0)
 {
 #ifdef GRID_DEBUG
     std::ostringstream filename;
@@ -22,6 +22,8 @@ LocutusMapGrid::LocutusMapGrid(BWAPI::Player player) : _player(player)
 
 void LocutusMapGrid::add(BWAPI::UnitType type, int range, BWAPI::Position position, int delta, long(&matrix)[1024][1024])
 {
+    if (&matrix != &collision) threatVersion++;
+
     int startX = position.x >> 3;
     int startY = position.y >> 3;
     for (auto pos : getPositionsInRange(type, range))
@@ -61,12 +63,14 @@ void LocutusMapGrid::unitCompleted(BWAPI::UnitType type, BWAPI::Position positio
     if (doDebug) debug << "\n" << BWAPI::Broodwar->getFrameCount() << ";complete;" << type << ";" << position.x << ";" << position.y << ";;;";
 #endif
 
+    const auto & stats = InformationManager::Instance().getUnitStats(_player, type);
+
     if (type.groundWeapon() != BWAPI::WeaponTypes::None)
     {
         add(type,
-            InformationManager::Instance().getWeaponRange(_player, type.groundWeapon()) + RANGE_BUFFER,
+            stats.groundRange + RANGE_BUFFER,
             position,
-            InformationManager::Instance().getWeaponDamage(_player, type.groundWeapon()) * type.maxGroundHits() * type.groundWeapon().damageFactor(),
+            stats.groundDamage * type.maxGroundHits() * type.groundWeapon().damageFactor(),
             groundThreat);
 
         // For sieged tanks, subtract the area close to the tank
@@ -75,7 +79,7 @@ void LocutusMapGrid::unitCompleted(BWAPI::UnitType type, BWAPI::Position positio
             add(type,
                 type.groundWeapon().minRange() - RANGE_BUFFER,
                 position,
-                -InformationManager::Instance().getWeaponDamage(_player, type.groundWeapon()) * type.maxGroundHits() * type.groundWeapon().damageFactor(),
+                -stats.groundDamage * type.maxGroundHits() * type.groundWeapon().damageFactor(),
                 groundThreat);
         }
     }
@@ -83,9 +87,9 @@ void LocutusMapGrid::unitCompleted(BWAPI::UnitType type, BWAPI::Position positio
     if (type.airWeapon() != BWAPI::WeaponTypes::None)
     {
         add(type,
-            InformationManager::Instance().getWeaponRange(_player, type.airWeapon()) + RANGE_BUFFER,
+            stats.airRange + RANGE_BUFFER,
             position,
-            InformationManager::Instance().getWeaponDamage(_player, type.airWeapon()) * type.maxAirHits() * type.airWeapon().damageFactor(),
+            stats.airDamage * type.maxAirHits() * type.airWeapon().damageFactor(),
             airThreat);
     }
 
@@ -125,12 +129,14 @@ void LocutusMapGrid::unitDestroyed(BWAPI::UnitType type, BWAPI::Position positio
     // need to update the collision grid
     if (!completed) return;
 
+    const auto & stats = InformationManager::Instance().getUnitStats(_player, type);
+
     if (type.groundWeapon() != BWAPI::WeaponTypes::None)
     {
         add(type,
-            InformationManager::Instance().getWeaponRange(_player, type.groundWeapon()) + RANGE_BUFFER,
+            stats.groundRange + RANGE_BUFFER,
             position,
-            -InformationManager::Instance().getWeaponDamage(_player, type.groundWeapon()) * type.maxGroundHits() * type.groundWeapon().damageFactor(),
+            -stats.groundDamage * type.maxGroundHits() * type.groundWeapon().damageFactor(),
             groundThreat);
 
         // For sieged tanks, add back the area close to the tank
@@ -139,7 +145,7 @@ void LocutusMapGrid::unitDestroyed(BWAPI::UnitType type, BWAPI::Position positio
             add(type,
                 type.groundWeapon().minRange() - RANGE_BUFFER,
                 position,
-                InformationManager::Instance().getWeaponDamage(_player, type.groundWeapon()) * type.maxGroundHits() * type.groundWeapon().damageFactor(),
+                stats.groundDamage * type.maxGroundHits() * type.groundWeapon().damageFactor(),
                 groundThreat);
         }
     }
@@ -147,9 +153,9 @@ void LocutusMapGrid::unitDestroyed(BWAPI::UnitType type, BWAPI::Position positio
     if (type.airWeapon() != BWAPI::WeaponTypes::None)
     {
         add(type,
-            InformationManager::Instance().getWeaponRange(_player, type.airWeapon()) + RANGE_BUFFER,
+            stats.airRange + RANGE_BUFFER,
             position,
-            -InformationManager::Instance().getWeaponDamage(_player, type.airWeapon()) * type.maxAirHits() * type.airWeapon().damageFactor(),
+            -stats.airDamage * type.maxAirHits() * type.airWeapon().damageFactor(),
             airThreat);
     }
 
@@ -22,6 +22,8 @@ private:
     long groundThreat[1024][1024] = {};
     long airThreat[1024][1024] = {};
     long detection[1024][1024] = {};
+
+    int threatVersion;      // changes whenever the threat or detection grids change
     
     void add(BWAPI::UnitType type, int range, BWAPI::Position position, int delta, long (&matrix)[1024][1024]);
 
@@ -50,6 +52,8 @@ public:
 
     long getDetection(BWAPI::Position position) const { return detection[position.x / 8][position.y / 8]; };
     long getDetection(BWAPI::WalkPosition position) const { return detection[position.x][position.y]; };
+
+    int getThreatVersion() const { return threatVersion; };
 };
 
 }
\ No newline at end of file
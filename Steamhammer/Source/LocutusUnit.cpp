@@ -9,6 +9,10 @@ const double pi = 3.14159265358979323846;
 
 const int DRAGOON_ATTACK_FRAMES = 6;
 
+// When the enemy threat grid changes, re-plan a safe path at most this often.
+// Moving enemy units change the grid nearly every frame.
+const int SAFE_PATH_REPLAN_FRAMES = 24;
+
 namespace { auto & bwemMap = BWEM::Map::Instance(); }
 namespace { auto & bwebMap = BWEB::Map::Instance(); }
 
@@ -355,6 +359,35 @@ void LocutusUnit::mineralWalk()
     lastMoveFrame = BWAPI::Broodwar->getFrameCount();
 }
 
+// Move to the position along a path that avoids enemy threats, as given by PathFinding::GetSafePath.
+// The path is kept between frames, and planned again only when the position changes or the enemy
+// threat grid has changed since the last plan.
+// Falls back to moveTo if there is no safe path within the search budget.
+bool LocutusUnit::moveToSafely(BWAPI::Position position)
+{
+    auto & enemyUnitGrid = InformationManager::Instance().getEnemyUnitGrid();
+    int now = BWAPI::Broodwar->getFrameCount();
+
+    if (position != safePathTarget ||
+        (enemyUnitGrid.getThreatVersion() != safePathThreatVersion && now - safePathFrame >= SAFE_PATH_REPLAN_FRAMES))
+    {
+        safePath = PathFinding::GetSafePath(unit->getPosition(), position, unit->getType());
+        safePathTarget = position;
+        safePathThreatVersion = enemyUnitGrid.getThreatVersion();
+        safePathFrame = now;
+    }
+
+    // Drop the waypoints we have reached
+    auto next = safePath.begin();
+    while (next != safePath.end() && next + 1 != safePath.end() && unit->getDistance(*next) <= 96)
+        next++;
+    safePath.erase(safePath.begin(), next);
+
+    if (safePath.empty()) return moveTo(position);
+
+    return moveTo(safePath.front());
+}
+
 void LocutusUnit::fleeFrom(BWAPI::Position position)
 {
     // TODO: Use a threat matrix, maybe it's actually best to move towards the position sometimes
@@ -17,6 +17,12 @@ class LocutusUnit
     BWAPI::Position                     mineralWalkingStartPosition;
     int                                 lastMoveFrame;
 
+    // Used for pathing around threats
+    std::vector<BWAPI::Position>        safePath;
+    BWAPI::Position                     safePathTarget;
+    int                                 safePathThreatVersion;
+    int                                 safePathFrame;
+
     // Used for various things, like detecting stuck goons and updating our collision matrix
     BWAPI::Position lastPosition;
 
@@ -39,6 +45,9 @@ public:
         , mineralWalkingTargetArea(nullptr)
         , mineralWalkingStartPosition(BWAPI::Positions::Invalid)
         , lastMoveFrame(0)
+        , safePathTarget(BWAPI::Positions::Invalid)
+        , safePathThreatVersion(-1)
+        , safePathFrame(0)
         , lastAttackStartedAt(0)
         , lastPosition(BWAPI::Positions::Invalid)
         , potentiallyStuckSince(0)
@@ -53,6 +62,9 @@ public:
         , mineralWalkingTargetArea(nullptr)
         , mineralWalkingStartPosition(BWAPI::Positions::Invalid)
         , lastMoveFrame(0)
+        , safePathTarget(BWAPI::Positions::Invalid)
+        , safePathThreatVersion(-1)
+        , safePathFrame(0)
         , lastAttackStartedAt(0)
         , lastPosition(BWAPI::Positions::Invalid)
         , potentiallyStuckSince(0)
@@ -62,6 +74,7 @@ public:
     void update();
 
     bool moveTo(BWAPI::Position position, bool avoidNarrowChokes = false);
+    bool moveToSafely(BWAPI::Position position);
     void fleeFrom(BWAPI::Position position);
     int  distanceToMoveTarget() const;
 
@@ -1,4 +1,6 @@
 #include "LocutusWall.h"
+#include "JobSystem.h"
+#include "MapAnalysisCache.h"
 
 #include <Wall.h>
 
@@ -127,7 +129,7 @@ namespace UAlbertaBot
 			if (bwebMap.overlapsAnything(tile, building.tileWidth(), building.tileHeight(), true)) continue;
 
 			auto result = buildingOptions.insert(tile);
-			if (result.second) Log().Debug() << building << " option at " << tile;
+			if (result.second) LOG_DEBUG << building << " option at " << tile;
 		}
 	}
 
@@ -155,48 +157,119 @@ namespace UAlbertaBot
 		geo.push_back(center(BWAPI::TilePosition(gateway.x, gateway.y + 1)));
 	}
 
-	void addWallOption(BWAPI::TilePosition forge, BWAPI::TilePosition gateway, std::vector<BWAPI::Position>* geo, std::vector<ForgeGatewayWallOption>& wallOptions)
+	// A forge and gateway combination we want to score as a wall option
+	struct WallCandidate
+	{
+		BWAPI::TilePosition forge;
+		BWAPI::TilePosition gateway;
+		std::vector<BWAPI::Position>* geo;
+	};
+
+	// The candidates in the order they were generated, along with a lookup to skip duplicates
+	struct WallCandidates
+	{
+		std::vector<WallCandidate> ordered;
+		std::set<std::pair<BWAPI::TilePosition, BWAPI::TilePosition>> seen;
+	};
+
+	void addWallOption(BWAPI::TilePosition forge, BWAPI::TilePosition gateway, std::vector<BWAPI::Position>* geo, WallCandidates& candidates)
 	{
 		// Check if we've already considered this wall
-		for (auto const& option : wallOptions)
-			if (option.forge == forge && option.gateway == gateway)
-				return;
+		if (!candidates.seen.insert(std::make_pair(forge, gateway)).second) return;
 
-		// Buildings overlap
-		if (forge.x > (gateway.x - 3) && forge.x < (gateway.x + 4) && forge.y >(gateway.y - 2) && forge.y < (gateway.y + 3))
+		candidates.ordered.push_back(WallCandidate{ forge, gateway, geo });
+	}
+
+	// The bounding box of a set of positions, for a cheap lower bound on the distance between two sets
+	struct GeoBox
+	{
+		int left, top, right, bottom;
+
+		GeoBox() : left(INT_MAX), top(INT_MAX), right(INT_MIN), bottom(INT_MIN) {}
+
+		bool empty() const { return left > right; }
+
+		void add(BWAPI::Position pos)
 		{
-			wallOptions.push_back(ForgeGatewayWallOption(forge, gateway));
-			return;
+			left = std::min(left, pos.x);
+			top = std::min(top, pos.y);
+			right = std::max(right, pos.x);
+			bottom = std::max(bottom, pos.y);
 		}
 
-		// Buildings cannot be placed
-		if (!bwebMap.isPlaceable(BWAPI::UnitTypes::Protoss_Forge, forge) ||
-			bwebMap.overlapsAnything(forge, BWAPI::UnitTypes::Protoss_Forge.tileWidth(), BWAPI::UnitTypes::Protoss_Forge.tileHeight(), true) ||
-			!bwebMap.isPlaceable(BWAPI::UnitTypes::Protoss_Gateway, gateway) ||
-			bwebMap.overlapsAnything(gateway, BWAPI::UnitTypes::Protoss_Gateway.tileWidth(), BWAPI::UnitTypes::Protoss_Gateway.tileHeight(), true))
+		// The tile centers of a building, as addForgeGeo and addGatewayGeo give them
+		void addBuilding(BWAPI::TilePosition tile, BWAPI::UnitType type)
 		{
-			wallOptions.push_back(ForgeGatewayWallOption(forge, gateway));
-			return;
+			add(center(tile));
+			add(center(BWAPI::TilePosition(tile.x + type.tileWidth() - 1, tile.y + type.tileHeight() - 1)));
 		}
 
+		// No pair of points, one in each box, is closer than this
+		double distance(const GeoBox & other) const
+		{
+			int dx = std::max({ 0, left - other.right, other.left - right });
+			int dy = std::max({ 0, top - other.bottom, other.top - bottom });
+			return std::sqrt(double(dx * dx + dy * dy));
+		}
+	};
+
+	GeoBox geoBox(const std::vector<BWAPI::Position> & geo)
+	{
+		GeoBox box;
+		for (BWAPI::Position pos : geo) box.add(pos);
+		return box;
+	}
+
+	// Whether the gap of a wall candidate can be no larger than maxGapSize
+	// The gap is measured between the closest pair of positions, so the bounding boxes give a lower bound on it
+	bool mayFitGap(const WallCandidate & candidate, const GeoBox & candidateGeoBox, int maxGapSize)
+	{
+		GeoBox box1;
+		GeoBox box2;
+		box1.addBuilding(candidate.forge, BWAPI::UnitTypes::Protoss_Forge);
+		if (candidate.geo)
+		{
+			box1.addBuilding(candidate.gateway, BWAPI::UnitTypes::Protoss_Gateway);
+			box2 = candidateGeoBox;
+		}
+		else
+		{
+			box2.addBuilding(candidate.gateway, BWAPI::UnitTypes::Protoss_Gateway);
+		}
+
+		if (box2.empty()) return true;
+		return (int)floor(box1.distance(box2) / 16.0) - 2 <= maxGapSize;
+	}
+
+	// Scores the gap of a wall candidate
+	// Only does geometry on data we pass in, so it is safe to call for several candidates concurrently
+	ForgeGatewayWallOption scoreWallOption(const WallCandidate & candidate, BWAPI::Position natCenter)
+	{
+		BWAPI::TilePosition forge = candidate.forge;
+		BWAPI::TilePosition gateway = candidate.gateway;
+
+		// Buildings overlap
+		if (forge.x > (gateway.x - 3) && forge.x < (gateway.x + 4) && forge.y >(gateway.y - 2) && forge.y < (gateway.y + 3))
+			return ForgeGatewayWallOption(forge, gateway);
+
 		// Set up the sets of positions we are comparing between
 		std::vector<BWAPI::Position> geo1;
-		std::vector<BWAPI::Position> * geo2;
+		std::vector<BWAPI::Position> gatewayGeo;
+		const std::vector<BWAPI::Position> * geo2;
 
-		if (geo)
+		if (candidate.geo)
 		{
 			addForgeGeo(forge, geo1);
 			addGatewayGeo(gateway, geo1);
-			geo2 = geo;
+			geo2 = candidate.geo;
 		}
 		else
 		{
 			addForgeGeo(forge, geo1);
-			geo2 = new std::vector<BWAPI::Position>();
-			addGatewayGeo(gateway, *geo2);
+			addGatewayGeo(gateway, gatewayGeo);
+			geo2 = &gatewayGeo;
 		}
 
-		BWAPI::Position natCenter = BWAPI::Position(bwebMap.getNatural()) + BWAPI::Position(64, 48);
 		double bestDist = DBL_MAX;
 		double bestNatDist = DBL_MAX;
 		BWAPI::Position bestCenter = BWAPI::Positions::Invalid;
@@ -215,15 +288,12 @@ namespace UAlbertaBot
 					bestNatDist = bestCenter.getDistance(natCenter);
 					end1 = first;
 					end2 = second;
-					//Log().Get() << "best: " << BWAPI::TilePosition(bestCenter) << "; " << bestNatDist;
 				}
 				else if (dist == bestDist)
 				{
 					BWAPI::Position thisCenter = BWAPI::Position((first.x + second.x) / 2, (first.y + second.y) / 2);
 					double natDist = thisCenter.getDistance(natCenter);
 
-					//Log().Get() << "equal: " << BWAPI::TilePosition(bestCenter) << "; " << bestNatDist << " new " << BWAPI::TilePosition(thisCenter) << "; " << natDist;
-
 					if (natDist < bestNatDist)
 					{
 						bestCenter = thisCenter;
@@ -234,25 +304,11 @@ namespace UAlbertaBot
 				}
 			}
 
-        if (!bestCenter.isValid())
-        {
-            Log().Debug() << "Error scoring wall forge " << forge << ", gateway " << gateway << ", geo1 size " << geo1.size() << ", geo2 size " << geo2->size();
-            wallOptions.push_back(ForgeGatewayWallOption(forge, gateway));
-            return;
-        }
-
-		if (!geo)
-			delete geo2;
-
 		// Gap must be at least 64
-		if (bestDist < 64.0)
-		{
-			wallOptions.push_back(ForgeGatewayWallOption(forge, gateway));
-			return;
-		}
+		if (!bestCenter.isValid() || bestDist < 64.0)
+			return ForgeGatewayWallOption(forge, gateway);
 
-		wallOptions.push_back(ForgeGatewayWallOption(forge, gateway, (int)floor(bestDist / 16.0) - 2, bestCenter, end1, end2));
-		Log().Debug() << "Scored wall forge " << forge << ", gateway " << gateway << ", gap " << bestDist << ", center " << BWAPI::TilePosition(bestCenter);
+		return ForgeGatewayWallOption(forge, gateway, (int)floor(bestDist / 16.0) - 2, bestCenter, end1, end2);
 	}
 
 	// Computes the angle with the x-axis of a vector as defined by points p0, p1
@@ -505,7 +561,7 @@ namespace UAlbertaBot
 				}
 			}
 
-		Log().Debug() << "Initializing end tile: nat@" << BWAPI::TilePosition(p1) << ";choke@" << BWAPI::TilePosition(p0) << ";start@" << BWAPI::TilePosition(center(start)) << ";final@" << BWAPI::TilePosition(center(bestTile));
+		LOG_DEBUG << "Initializing end tile: nat@" << BWAPI::TilePosition(p1) << ";choke@" << BWAPI::TilePosition(p0) << ";start@" << BWAPI::TilePosition(center(start)) << ";final@" << BWAPI::TilePosition(center(bestTile));
 
 		bwebMap.endTile = bestTile;
 	}
@@ -563,7 +619,7 @@ namespace UAlbertaBot
 			if (end1.x > end2.x) swap(end1, end2);
 
 			// Straight vertical wall
-			Log().Debug() << "Vertical wall between " << end1 << " and " << end2;
+			LOG_DEBUG << "Vertical wall between " << end1 << " and " << end2;
 
 			// Find options on left side
 			for (int x = end1.x - 2; x <= end1.x + 2; x++)
@@ -597,7 +653,7 @@ namespace UAlbertaBot
 			if (end1.y > end2.y) swap(end1, end2);
 
 			// Straight horizontal wall
-			Log().Debug() << "Horizontal wall between " << end1 << " and " << end2;
+			LOG_DEBUG << "Horizontal wall between " << end1 << " and " << end2;
 
 			// Find options on top side
 			for (int x = end1.x - 5; x <= end1.x + 5; x++)
@@ -631,7 +687,7 @@ namespace UAlbertaBot
 			if (end1.x > end2.x) swap(end1, end2);
 
 			// Diagonal wall
-			Log().Debug() << "Diagonal wall between " << end1 << " and " << end2;
+			LOG_DEBUG << "Diagonal wall between " << end1 << " and " << end2;
 
 			BWAPI::Position end1Center = center(end1);
 			BWAPI::Position end2Center = center(end2);
@@ -684,19 +740,21 @@ namespace UAlbertaBot
 		std::set<BWAPI::TilePosition> & end2GatewayOptions,
 		int maxGapSize)
 	{
+		WallCandidates candidates;
+
 		// Forge on end1 side
 		for (BWAPI::TilePosition forge : end1ForgeOptions)
 		{
 			// Gateway on end2 side
 			for (BWAPI::TilePosition gate : end2GatewayOptions)
-				addWallOption(forge, gate, nullptr, wallOptions);
+				addWallOption(forge, gate, nullptr, candidates);
 
 			// Gateway above forge
-			addWallOption(forge, BWAPI::TilePosition(forge.x - 3, forge.y - 3), &end2Geo, wallOptions);
-			addWallOption(forge, BWAPI::TilePosition(forge.x - 2, forge.y - 3), &end2Geo, wallOptions);
-			addWallOption(forge, BWAPI::TilePosition(forge.x - 1, forge.y - 3), &end2Geo, wallOptions);
-			addWallOption(forge, BWAPI::TilePosition(forge.x, forge.y - 3), &end2Geo, wallOptions);
-			addWallOption(forge, BWAPI::TilePosition(forge.x + 1, forge.y - 3), &end2Geo, wallOptions);
+			addWallOption(forge, BWAPI::TilePosition(forge.x - 3, forge.y - 3), &end2Geo, candidates);
+			addWallOption(forge, BWAPI::TilePosition(forge.x - 2, forge.y - 3), &end2Geo, candidates);
+			addWallOption(forge, BWAPI::TilePosition(forge.x - 1, forge.y - 3), &end2Geo, candidates);
+			addWallOption(forge, BWAPI::TilePosition(forge.x, forge.y - 3), &end2Geo, candidates);
+			addWallOption(forge, BWAPI::TilePosition(forge.x + 1, forge.y - 3), &end2Geo, candidates);
 		}
 
 		// Forge on end2 side
@@ -704,43 +762,72 @@ namespace UAlbertaBot
 		{
 			// Gateway on end1 side
 			for (BWAPI::TilePosition gate : end1GatewayOptions)
-				addWallOption(forge, gate, nullptr, wallOptions);
+				addWallOption(forge, gate, nullptr, candidates);
 
 			// Gateway above forge
-			addWallOption(forge, BWAPI::TilePosition(forge.x - 3, forge.y - 3), &end1Geo, wallOptions);
-			addWallOption(forge, BWAPI::TilePosition(forge.x - 2, forge.y - 3), &end1Geo, wallOptions);
-			addWallOption(forge, BWAPI::TilePosition(forge.x - 1, forge.y - 3), &end1Geo, wallOptions);
-			addWallOption(forge, BWAPI::TilePosition(forge.x, forge.y - 3), &end1Geo, wallOptions);
-			addWallOption(forge, BWAPI::TilePosition(forge.x + 1, forge.y - 3), &end1Geo, wallOptions);
+			addWallOption(forge, BWAPI::TilePosition(forge.x - 3, forge.y - 3), &end1Geo, candidates);
+			addWallOption(forge, BWAPI::TilePosition(forge.x - 2, forge.y - 3), &end1Geo, candidates);
+			addWallOption(forge, BWAPI::TilePosition(forge.x - 1, forge.y - 3), &end1Geo, candidates);
+			addWallOption(forge, BWAPI::TilePosition(forge.x, forge.y - 3), &end1Geo, candidates);
+			addWallOption(forge, BWAPI::TilePosition(forge.x + 1, forge.y - 3), &end1Geo, candidates);
 		}
 
 		// Gateway on end1 side, forge below gateway
 		for (BWAPI::TilePosition gateway : end1GatewayOptions)
 		{
-			addWallOption(BWAPI::TilePosition(gateway.x - 2, gateway.y + 3), gateway, &end2Geo, wallOptions);
-			addWallOption(BWAPI::TilePosition(gateway.x - 1, gateway.y + 3), gateway, &end2Geo, wallOptions);
-			addWallOption(BWAPI::TilePosition(gateway.x, gateway.y + 3), gateway, &end2Geo, wallOptions);
-			addWallOption(BWAPI::TilePosition(gateway.x + 1, gateway.y + 3), gateway, &end2Geo, wallOptions);
-			addWallOption(BWAPI::TilePosition(gateway.x + 2, gateway.y + 3), gateway, &end2Geo, wallOptions);
+			addWallOption(BWAPI::TilePosition(gateway.x - 2, gateway.y + 3), gateway, &end2Geo, candidates);
+			addWallOption(BWAPI::TilePosition(gateway.x - 1, gateway.y + 3), gateway, &end2Geo, candidates);
+			addWallOption(BWAPI::TilePosition(gateway.x, gateway.y + 3), gateway, &end2Geo, candidates);
+			addWallOption(BWAPI::TilePosition(gateway.x + 1, gateway.y + 3), gateway, &end2Geo, candidates);
+			addWallOption(BWAPI::TilePosition(gateway.x + 2, gateway.y + 3), gateway, &end2Geo, candidates);
 		}
 
 		// Gateway on end2 side, forge below gateway
 		for (BWAPI::TilePosition gateway : end2GatewayOptions)
 		{
-			addWallOption(BWAPI::TilePosition(gateway.x - 2, gateway.y + 3), gateway, &end1Geo, wallOptions);
-			addWallOption(BWAPI::TilePosition(gateway.x - 1, gateway.y + 3), gateway, &end1Geo, wallOptions);
-			addWallOption(BWAPI::TilePosition(gateway.x, gateway.y + 3), gateway, &end1Geo, wallOptions);
-			addWallOption(BWAPI::TilePosition(gateway.x + 1, gateway.y + 3), gateway, &end1Geo, wallOptions);
-			addWallOption(BWAPI::TilePosition(gateway.x + 2, gateway.y + 3), gateway, &end1Geo, wallOptions);
+			addWallOption(BWAPI::TilePosition(gateway.x - 2, gateway.y + 3), gateway, &end1Geo, candidates);
+			addWallOption(BWAPI::TilePosition(gateway.x - 1, gateway.y + 3), gateway, &end1Geo, candidates);
+			addWallOption(BWAPI::TilePosition(gateway.x, gateway.y + 3), gateway, &end1Geo, candidates);
+			addWallOption(BWAPI::TilePosition(gateway.x + 1, gateway.y + 3), gateway, &end1Geo, candidates);
+			addWallOption(BWAPI::TilePosition(gateway.x + 2, gateway.y + 3), gateway, &end1Geo, candidates);
 		}
 
-		// Prune invalid options from the vector, we don't need to store them any more
-		auto it = wallOptions.begin();
-		for (; it != wallOptions.end(); )
-			if (it->gapCenter == BWAPI::Positions::Invalid || it->gapSize > maxGapSize)
-				it = wallOptions.erase(it);
-			else
-				++it;
+		// Skip candidates whose gap is sure to be too large, and buildings that cannot be placed
+		// Placement queries BWAPI, so we do it here rather than in the concurrent scoring
+		GeoBox end1GeoBox = geoBox(end1Geo);
+		GeoBox end2GeoBox = geoBox(end2Geo);
+		std::vector<bool> placeable(candidates.ordered.size());
+		for (size_t i = 0; i < candidates.ordered.size(); i++)
+		{
+			auto const & candidate = candidates.ordered[i];
+			placeable[i] =
+				mayFitGap(candidate, candidate.geo == &end1Geo ? end1GeoBox : end2GeoBox, maxGapSize) &&
+				bwebMap.isPlaceable(BWAPI::UnitTypes::Protoss_Forge, candidate.forge) &&
+				!bwebMap.overlapsAnything(candidate.forge, BWAPI::UnitTypes::Protoss_Forge.tileWidth(), BWAPI::UnitTypes::Protoss_Forge.tileHeight(), true) &&
+				bwebMap.isPlaceable(BWAPI::UnitTypes::Protoss_Gateway, candidate.gateway) &&
+				!bwebMap.overlapsAnything(candidate.gateway, BWAPI::UnitTypes::Protoss_Gateway.tileWidth(), BWAPI::UnitTypes::Protoss_Gateway.tileHeight(), true);
+		}
+
+		// Score the gaps of the candidates in parallel
+		// Each candidate writes to its own slot, so the options keep the order they were generated in
+		BWAPI::Position natCenter = BWAPI::Position(bwebMap.getNatural()) + BWAPI::Position(64, 48);
+		std::vector<ForgeGatewayWallOption> scoredOptions(candidates.ordered.size());
+		JobSystem::Instance().parallelFor((int)candidates.ordered.size(), [&](int i)
+		{
+			auto const & candidate = candidates.ordered[i];
+			scoredOptions[i] = placeable[i]
+				? scoreWallOption(candidate, natCenter)
+				: ForgeGatewayWallOption(candidate.forge, candidate.gateway);
+		});
+
+		// Keep the valid options, we don't need to store the others
+		for (auto const & option : scoredOptions)
+		{
+			if (option.gapCenter == BWAPI::Positions::Invalid || option.gapSize > maxGapSize) continue;
+
+			LOG_DEBUG << "Scored wall forge " << option.forge << ", gateway " << option.gateway << ", gap " << option.gapSize << ", center " << BWAPI::TilePosition(option.gapCenter);
+			wallOptions.push_back(option);
+		}
 	}
 
 	BWAPI::TilePosition getPylonPlacement(LocutusWall& wall, int optimalPathLength, bool returnFirst = false)
@@ -777,13 +864,13 @@ namespace UAlbertaBot
                 if (sideOfLine(forgeCenter, gatewayCenter, pylonCenter) != natSideOfForgeGatewayLine
                     && sideOfLine(wall.gapEnd1, wall.gapEnd2, pylonCenter) != natSideOfGapLine)
                 {
-                    Log().Debug() << "Pylon " << tile << " rejected for being on the wrong side of the line";
+                    LOG_DEBUG << "Pylon " << tile << " rejected for being on the wrong side of the line";
                     continue;
                 }
 
                 if (pylonCenter.getDistance(natCenter) > distCentroidNat)
                 {
-                    Log().Debug() << "Pylon " << tile << " rejected for being further away from the natural";
+                    LOG_DEBUG << "Pylon " << tile << " rejected for being further away from the natural";
                     continue;
                 }
 
@@ -797,7 +884,7 @@ namespace UAlbertaBot
 					// Ensure there is a valid path through the wall
                     if (!checkPath(tile, optimalPathLength * 2))
                     {
-                        Log().Debug() << "Pylon " << tile << " rejected for not having a valid main path";
+                        LOG_DEBUG << "Pylon " << tile << " rejected for not having a valid main path";
                         continue;
                     }
 
@@ -810,7 +897,7 @@ namespace UAlbertaBot
 
                         if (path.empty())
                         {
-                            Log().Debug() << "Pylon " << tile << " rejected for not having a path from gateway spawn position";
+                            LOG_DEBUG << "Pylon " << tile << " rejected for not having a path from gateway spawn position";
                             continue;
                         }
 					}
@@ -828,15 +915,18 @@ namespace UAlbertaBot
 
 	ForgeGatewayWallOption getBestWallOption(std::vector<ForgeGatewayWallOption> & wallOptions, int optimalPathLength)
 	{
-		ForgeGatewayWallOption bestWallOption;
-
 		BWAPI::Position mapCenter = bwemMap.Center();
 		BWAPI::Position startTileCenter = BWAPI::Position(bwebMap.startTile) + BWAPI::Position(16, 16);
 		BWAPI::Position natCenter = BWAPI::Position(bwebMap.getNatural()) + BWAPI::Position(64, 48);
 
-		double bestWallQuality = DBL_MAX;
-		double bestDistCentroid = 0;
-		BWAPI::Position bestCentroid;
+		// Score all of the options first
+		struct ScoredOption
+		{
+			const ForgeGatewayWallOption * wall;
+			double wallQuality;
+			double distCentroidNat;
+		};
+		std::vector<ScoredOption> scoredOptions;
 
 		for (auto const& wall : wallOptions)
 		{
@@ -872,35 +962,45 @@ namespace UAlbertaBot
 			double distCentroidNat = centroid.getDistance(natCenter);
 			if (distCentroidNat < 192.0) continue;
 
-			Log().Debug() << "Considering forge=" << wall.forge << ";gateway=" << wall.gateway << ";gapc=" << BWAPI::TilePosition(wall.gapCenter) << ";gapw=" << wall.gapSize << ";dchoke=" << distChoke << ";straightness=" << straightness << ";qualityFactor=" << wallQuality << ";dcentroid=" << distCentroidNat;
+			LOG_DEBUG << "Considering forge=" << wall.forge << ";gateway=" << wall.gateway << ";gapc=" << BWAPI::TilePosition(wall.gapCenter) << ";gapw=" << wall.gapSize << ";dchoke=" << distChoke << ";straightness=" << straightness << ";qualityFactor=" << wallQuality << ";dcentroid=" << distCentroidNat;
 
-			if (wallQuality < bestWallQuality
-				|| (wallQuality == bestWallQuality && distCentroidNat > bestDistCentroid))
-			{
-				// Make sure there is at least one valid pylon to power this wall
-				bwebMap.addOverlap(wall.forge, BWAPI::UnitTypes::Protoss_Forge.tileWidth(), BWAPI::UnitTypes::Protoss_Forge.tileHeight());
-				bwebMap.addOverlap(wall.gateway, BWAPI::UnitTypes::Protoss_Gateway.tileWidth(), BWAPI::UnitTypes::Protoss_Gateway.tileHeight());
+			scoredOptions.push_back(ScoredOption{ &wall, wallQuality, distCentroidNat });
+		}
 
-				bool hasPylon = getPylonPlacement(LocutusWall(wall), optimalPathLength, true).isValid();
+		// Order the options from best to worst
+		// The sort is stable, so equally-scored options keep their original order and the first one wins
+		std::stable_sort(scoredOptions.begin(), scoredOptions.end(), [](const ScoredOption & a, const ScoredOption & b)
+		{
+			return a.wallQuality < b.wallQuality
+				|| (a.wallQuality == b.wallQuality && a.distCentroidNat > b.distCentroidNat);
+		});
 
-				removeOverlap(wall.forge, BWAPI::UnitTypes::Protoss_Forge.tileWidth(), BWAPI::UnitTypes::Protoss_Forge.tileHeight());
-				removeOverlap(wall.gateway, BWAPI::UnitTypes::Protoss_Gateway.tileWidth(), BWAPI::UnitTypes::Protoss_Gateway.tileHeight());
+		// The best option is the first one that can be powered by a pylon
+		// Checking for a pylon requires path finding, so this avoids doing it for options that can never be chosen
+		for (auto const & option : scoredOptions)
+		{
+			auto const & wall = *option.wall;
 
-				if (!hasPylon)
-				{
-					Log().Debug() << "Rejected as no valid pylon";
-					continue;
-				}
+			// Make sure there is at least one valid pylon to power this wall
+			bwebMap.addOverlap(wall.forge, BWAPI::UnitTypes::Protoss_Forge.tileWidth(), BWAPI::UnitTypes::Protoss_Forge.tileHeight());
+			bwebMap.addOverlap(wall.gateway, BWAPI::UnitTypes::Protoss_Gateway.tileWidth(), BWAPI::UnitTypes::Protoss_Gateway.tileHeight());
+
+			bool hasPylon = getPylonPlacement(LocutusWall(wall), optimalPathLength, true).isValid();
+
+			removeOverlap(wall.forge, BWAPI::UnitTypes::Protoss_Forge.tileWidth(), BWAPI::UnitTypes::Protoss_Forge.tileHeight());
+			removeOverlap(wall.gateway, BWAPI::UnitTypes::Protoss_Gateway.tileWidth(), BWAPI::UnitTypes::Protoss_Gateway.tileHeight());
 
-				bestWallOption = wall;
-				bestWallQuality = wallQuality;
-				bestDistCentroid = distCentroidNat;
-				bestCentroid = centroid;
-				Log().Debug() << "(best)";
+			if (!hasPylon)
+			{
+				LOG_DEBUG << "Rejected forge=" << wall.forge << ";gateway=" << wall.gateway << " as no valid pylon";
+				continue;
 			}
+
+			LOG_DEBUG << "Best forge=" << wall.forge << ";gateway=" << wall.gateway;
+			return wall;
 		}
 
-		return bestWallOption;
+		return ForgeGatewayWallOption();
 	}
 
 	BWAPI::TilePosition getCannonPlacement(LocutusWall& wall, int optimalPathLength)
@@ -934,7 +1034,7 @@ namespace UAlbertaBot
 					|| sideOfLine(forgeCenter, gatewayCenter, cannonCenter + BWAPI::Position(-16, 16)) != natSideOfForgeGatewayLine
 					|| sideOfLine(forgeCenter, gatewayCenter, cannonCenter + BWAPI::Position(-16, -16)) != natSideOfForgeGatewayLine)
 				{
-					Log().Debug() << "Cannon " << tile << " rejected because on wrong side of line";
+					LOG_DEBUG << "Cannon " << tile << " rejected because on wrong side of line";
 					continue;
 				}
 
@@ -965,14 +1065,14 @@ namespace UAlbertaBot
 				// Putting it all together
 				double dist = 1.0 / (distToWall * distToDoor * borderingFactor);
 
-				Log().Debug() << "Considering cannon @ " << tile << ";overall=" << dist << ";walldist=" << distToWall << ";doordistfactor=" << distToDoor << ";borderfactor=" << borderingFactor << ";bordering=" << borderingTiles;
+				LOG_DEBUG << "Considering cannon @ " << tile << ";overall=" << dist << ";walldist=" << distToWall << ";doordistfactor=" << distToDoor << ";borderfactor=" << borderingFactor << ";bordering=" << borderingTiles;
 
 				if (dist > distBest)
 				{
 					// Ensure there is still a valid path through the wall
 					if (!checkPath(tile, optimalPathLength * 3))
 					{
-						Log().Debug() << "(rejected as blocks path)";
+						LOG_DEBUG << "(rejected as blocks path)";
 						continue;
 					}
 
@@ -985,7 +1085,7 @@ namespace UAlbertaBot
 
 						if (path.empty())
 						{
-							Log().Debug() << "(rejected as blocks path from gateway spawn point)";
+							LOG_DEBUG << "(rejected as blocks path from gateway spawn point)";
 							continue;
 						}
 					}
@@ -993,7 +1093,7 @@ namespace UAlbertaBot
 					tileBest = tile;
 					distBest = dist;
 
-					Log().Debug() << "(best)";
+					LOG_DEBUG << "(best)";
 				}
 			}
 		}
@@ -1255,7 +1355,7 @@ namespace UAlbertaBot
 	{
         // Initialize pathfinding
         int optimalPathLength = BWEB::Map::Instance().findPath(bwemMap, BWEB::Map::Instance(), bwebMap.startTile, bwebMap.endTile).size();
-        Log().Debug() << "Pathfinding between " << bwebMap.startTile << " and " << bwebMap.endTile << ", initial length " << optimalPathLength;
+        LOG_DEBUG << "Pathfinding between " << bwebMap.startTile << " and " << bwebMap.endTile << ", initial length " << optimalPathLength;
 
 		// Step 1: Analyze choke geo and find potential forge and gateway options
 		std::vector<BWAPI::Position> end1Geo;
@@ -1296,7 +1396,7 @@ namespace UAlbertaBot
 				bwebMap.addOverlap(cannon, BWAPI::UnitTypes::Protoss_Photon_Cannon.tileWidth(), BWAPI::UnitTypes::Protoss_Photon_Cannon.tileHeight());
 				bestWall.cannons.push_back(cannon);
 
-				Log().Debug() << "Added cannon @ " << cannon;
+				LOG_DEBUG << "Added cannon @ " << cannon;
 			}
 		}
 
@@ -1312,7 +1412,7 @@ namespace UAlbertaBot
 			bestWall.cannons.pop_back();
 			removeOverlap(cannon, BWAPI::UnitTypes::Protoss_Photon_Cannon.tileWidth(), BWAPI::UnitTypes::Protoss_Photon_Cannon.tileHeight());
 
-			Log().Debug() << "Removed cannon @ " << cannon;
+			LOG_DEBUG << "Removed cannon @ " << cannon;
 
 			pylon = getPylonPlacement(bestWall, optimalPathLength);
 		}
@@ -1320,13 +1420,13 @@ namespace UAlbertaBot
 		// Return invalid wall if no pylon location can be found
 		if (!pylon.isValid())
 		{
-            Log().Debug() << "ERROR: Could not find valid pylon, but this should have been checked when picking the best wall";
+            LOG_DEBUG << "ERROR: Could not find valid pylon, but this should have been checked when picking the best wall";
 			removeOverlap(bestWall.forge, BWAPI::UnitTypes::Protoss_Forge.tileWidth(), BWAPI::UnitTypes::Protoss_Forge.tileHeight());
 			removeOverlap(bestWall.gateway, BWAPI::UnitTypes::Protoss_Gateway.tileWidth(), BWAPI::UnitTypes::Protoss_Gateway.tileHeight());
 			return LocutusWall();
 		}
 
-        Log().Debug() << "Added pylon @ " << pylon;
+        LOG_DEBUG << "Added pylon @ " << pylon;
 		bestWall.pylon = pylon;
 		bwebMap.addOverlap(bestWall.pylon, BWAPI::UnitTypes::Protoss_Pylon.tileWidth(), BWAPI::UnitTypes::Protoss_Pylon.tileHeight());
 
@@ -1347,7 +1447,7 @@ namespace UAlbertaBot
 			bwebMap.addOverlap(cannon, BWAPI::UnitTypes::Protoss_Photon_Cannon.tileWidth(), BWAPI::UnitTypes::Protoss_Photon_Cannon.tileHeight());
 			bestWall.cannons.push_back(cannon);
 
-			Log().Debug() << "Added cannon @ " << cannon;
+			LOG_DEBUG << "Added cannon @ " << cannon;
 		}
 
 		return bestWall;
@@ -1355,7 +1455,7 @@ namespace UAlbertaBot
 
 	LocutusWall LocutusWall::CreateForgeGatewayWall(bool tight)
 	{
-		Log().Debug() << "Creating wall; tight=" << tight;
+		LOG_DEBUG << "Creating wall; tight=" << tight;
 
         // Map-specific hard-coded walls
 		if (BWAPI::Broodwar->mapHash() == "8000dc6116e405ab878c14bb0f0cde8efa4d640c") return LocutusWall(); // Alchemist
@@ -1379,16 +1479,29 @@ namespace UAlbertaBot
         initializeEndTile();
         bwebMap.startTile = (BWAPI::TilePosition(bwebMap.mainChoke->Center()) + BWAPI::TilePosition(bwebMap.mainChoke->Center()) + BWAPI::TilePosition(bwebMap.mainChoke->Center()) + bwebMap.naturalTile) / 4;
         bwebMap.setStartTile();
-        Log().Debug() << "Start tile: " << bwebMap.startTile;
+        LOG_DEBUG << "Start tile: " << bwebMap.startTile;
+
+        // Use the wall from a previous game on this map if we have one
+        LocutusWall cachedWall;
+        if (MapAnalysisCache::getWall(tight, cachedWall))
+        {
+            LOG_DEBUG << "Cached wall: " << cachedWall;
+
+            for (const auto & placement : cachedWall.placements())
+                bwebMap.addOverlap(placement.second, placement.first.tileWidth(), placement.first.tileHeight());
+            registerWallWithBWEB(cachedWall);
+
+            return cachedWall;
+        }
 
         // Create the wall
-		Log().Debug() << "Creating wall; tight=" << tight;
+		LOG_DEBUG << "Creating wall; tight=" << tight;
 		LocutusWall wall = createForgeGatewayWall(tight);
 
 		// Fall back to non-tight if a tight wall could not be found
 		if (tight && !wall.isValid())
 		{
-			Log().Debug() << "Tight wall invalid, trying with loose";
+			LOG_DEBUG << "Tight wall invalid, trying with loose";
 
 			wall = createForgeGatewayWall(false);
 		}
@@ -1396,7 +1509,7 @@ namespace UAlbertaBot
 		// If a tight wall has a large gap, check if a loose wall is better
 		else if (tight && wall.gapSize >= 5)
 		{
-			Log().Debug() << "Tight wall has large gap, trying with loose";
+			LOG_DEBUG << "Tight wall has large gap, trying with loose";
 
 			// Remove overlap while we're testing a new wall
 			for (const auto & placement : wall.placements())
@@ -1406,7 +1519,7 @@ namespace UAlbertaBot
 			LocutusWall looseWall = createForgeGatewayWall(false, wall.gapSize - 3);
 			if (looseWall.isValid())
 			{
-				Log().Debug() << "Using loose wall";
+				LOG_DEBUG << "Using loose wall";
 
 				wall = looseWall;
 			}
@@ -1414,7 +1527,7 @@ namespace UAlbertaBot
 			// The loose wall wasn't better, so reset the overlap
 			else
 			{
-                Log().Debug() << "Using tight wall";
+                LOG_DEBUG << "Using tight wall";
 
 				for (const auto & placement : wall.placements())
 					bwebMap.addOverlap(placement.second, placement.first.tileWidth(), placement.first.tileHeight());
@@ -1424,12 +1537,15 @@ namespace UAlbertaBot
 		// If we got a valid wall, register it with BWEB
 		if (wall.isValid())
 		{
-			Log().Debug() << "Wall: " << wall;
+			LOG_DEBUG << "Wall: " << wall;
 
 			registerWallWithBWEB(wall);
+
+			// Only valid walls are cached, so maps without a wall are re-analyzed every game
+			MapAnalysisCache::storeWall(tight, wall);
 		}
 		else
-			Log().Debug() << "Could not find wall";
+			LOG_DEBUG << "Could not find wall";
 
 		return wall;
 	}
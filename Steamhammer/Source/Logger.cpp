@@ -3,11 +3,208 @@
 #include <stdarg.h>
 #include <cstdio>
 #include <sstream>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 using namespace UAlbertaBot;
 
-std::ofstream* normalLog = nullptr;
-std::ofstream* debugLog = nullptr;
+namespace
+{
+	enum LogFile { NormalLog, DebugLog, NumLogFiles };
+
+	const char * const LogFilenames[NumLogFiles] =
+	{
+		"bwapi-data/write/Locutus_log.txt",
+		"bwapi-data/write/Locutus_debuglog.txt"
+	};
+
+	// Log messages are queued by the threads that log them and written out by a background
+	// thread, so that logging never waits on the disk. The queue is a fixed ring of slots.
+	// Each slot has a sequence number that says whether it is free for the next message to
+	// go in or holds a message ready to be written, so any thread can log without a lock.
+	// If the writer falls so far behind that the ring fills, messages are dropped and counted
+	// rather than making the game wait.
+	class LogWriter
+	{
+		static const size_t Capacity = 1 << 12;		// must be a power of 2
+
+		struct Slot
+		{
+			std::atomic<size_t>	sequence;
+			LogFile				file;
+			std::string			text;
+		};
+
+		std::unique_ptr<Slot[]>	_slots;
+		std::atomic<size_t>		_enqueuePos;
+		size_t					_dequeuePos;		// only the writer takes messages
+		std::atomic<int>		_dropped;
+
+		std::once_flag			_started;
+		std::atomic<bool>		_running;
+		std::atomic<bool>		_stopped;
+		std::thread				_thread;
+
+		std::ofstream			_files[NumLogFiles];	// opened by the writer as needed
+
+		bool push(LogFile file, std::string && text)
+		{
+			size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				Slot & slot = _slots[pos & (Capacity - 1)];
+				const std::ptrdiff_t diff = std::ptrdiff_t(slot.sequence.load(std::memory_order_acquire) - pos);
+				if (diff == 0)
+				{
+					if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					{
+						slot.file = file;
+						slot.text = std::move(text);
+						slot.sequence.store(pos + 1, std::memory_order_release);
+						return true;
+					}
+				}
+				else if (diff < 0)
+				{
+					return false;		// the ring is full
+				}
+				else
+				{
+					pos = _enqueuePos.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		bool pop(LogFile & file, std::string & text)
+		{
+			Slot & slot = _slots[_dequeuePos & (Capacity - 1)];
+			if (slot.sequence.load(std::memory_order_acquire) != _dequeuePos + 1)
+			{
+				return false;
+			}
+			file = slot.file;
+			text = std::move(slot.text);
+			slot.sequence.store(_dequeuePos + Capacity, std::memory_order_release);
+			++_dequeuePos;
+			return true;
+		}
+
+		std::ofstream & stream(LogFile file)
+		{
+			if (!_files[file].is_open())
+			{
+				_files[file].open(LogFilenames[file], std::ofstream::app);
+			}
+			return _files[file];
+		}
+
+		// Write the queued messages. Return false if there were none.
+		bool writeQueued()
+		{
+			LogFile file;
+			std::string text;
+			bool wrote = false;
+			while (pop(file, text))
+			{
+				stream(file) << text;
+				wrote = true;
+			}
+
+			const int dropped = _dropped.exchange(0);
+			if (dropped > 0)
+			{
+				stream(NormalLog) << dropped << " log messages dropped, the writer fell behind\n";
+				wrote = true;
+			}
+
+			if (wrote)
+			{
+				for (std::ofstream & f : _files)
+				{
+					if (f.is_open()) f.flush();
+				}
+			}
+			return wrote;
+		}
+
+		void run()
+		{
+			while (_running.load())
+			{
+				if (!writeQueued())
+				{
+					std::this_thread::sleep_for(std::chrono::milliseconds(2));
+				}
+			}
+		}
+
+	public:
+
+		LogWriter()
+			: _slots(new Slot[Capacity])
+			, _enqueuePos(0)
+			, _dequeuePos(0)
+			, _dropped(0)
+			, _running(false)
+			, _stopped(false)
+		{
+			for (size_t i = 0; i < Capacity; ++i)
+			{
+				_slots[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		void write(LogFile file, std::string && text)
+		{
+			if (_stopped.load())
+			{
+				std::ofstream direct(LogFilenames[file], std::ofstream::app);
+				direct << text;
+				return;
+			}
+
+			// Start the thread on first use, not while the DLL is loading.
+			std::call_once(_started, [this]()
+			{
+				_running = true;
+				_thread = std::thread(&LogWriter::run, this);
+			});
+
+			if (!push(file, std::move(text)))
+			{
+				++_dropped;
+			}
+		}
+
+		void stop()
+		{
+			if (_stopped.exchange(true))
+			{
+				return;
+			}
+			_running = false;
+			if (_thread.joinable())
+			{
+				_thread.join();
+			}
+			writeQueued();
+			for (std::ofstream & f : _files)
+			{
+				if (f.is_open()) f.close();
+			}
+		}
+	};
+
+	// Never destroyed. Joining a thread in a static destructor, while the DLL unloads, can hang.
+	LogWriter & writer()
+	{
+		static LogWriter * instance = new LogWriter();
+		return *instance;
+	}
+}
 
 void Logger::LogAppendToFile(const std::string & logFile, const std::string & msg)
 {
@@ -43,6 +240,11 @@ void Logger::LogOverwriteToFile(const std::string & logFile, const std::string &
     logStream.close();
 }
 
+void Logger::Flush()
+{
+	writer().stop();
+}
+
 std::string FileUtils::ReadFile(const std::string & filename)
 {
     std::stringstream ss;
@@ -89,6 +291,12 @@ std::ostringstream& Log::Get()
 std::ostringstream& Log::Debug()
 {
 	debug = true;
+	if (!DebugEnabled())
+	{
+		// Nothing will be written, so don't format anything.
+		os.setstate(std::ios::badbit);
+		return os;
+	}
 	auto t = std::time(nullptr);
 	os << t << ": " << BWAPI::Broodwar->getFrameCount();
     appendTime(os);
@@ -96,19 +304,15 @@ std::ostringstream& Log::Debug()
 	return os;
 }
 
+bool Log::DebugEnabled()
+{
+	return Config::Debug::LogDebug;
+}
+
 Log::~Log()
 {
-    if (debug && !Config::Debug::LogDebug) return;
+    if (debug && !DebugEnabled()) return;
 
 	os << "\n";
-    std::ofstream*& stream = debug ? debugLog : normalLog;
-
-    if (!stream)
-    {
-        stream = new std::ofstream();
-        stream->open(debug ? "bwapi-data/write/Locutus_debuglog.txt" : "bwapi-data/write/Locutus_log.txt", std::ofstream::app);
-    }
-
-    (*stream) << os.str();
-    stream->flush();
+	writer().write(debug ? DebugLog : NormalLog, os.str());
 }
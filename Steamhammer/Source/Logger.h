@@ -12,6 +12,10 @@ namespace Logger
     void LogAppendToFile(const std::string & logFile, const std::string & msg);
 	void LogAppendToFile(const std::string & logFile, const char *fmt, ...);
     void LogOverwriteToFile(const std::string & logFile, const std::string & msg);
+
+	// Wait until everything logged through Log() is written, and stop the writer thread.
+	// Call at the end of the game. Logging after this writes directly to the files.
+	void Flush();
 };
 
 namespace FileUtils
@@ -27,10 +31,21 @@ public:
 	virtual ~Log();
 	std::ostringstream& Get();
 	std::ostringstream& Debug();
+
+	static bool DebugEnabled();
 protected:
 	std::ostringstream os;
 	bool debug;
 private:
 	Log(const Log&);
 	Log& operator =(const Log&);
-};
\ No newline at end of file
+};
+
+// Use LOG_DEBUG << ... instead of Log().Debug() << ...
+// When debug logging is off, the message is neither formatted nor are its parts evaluated.
+// Defining LOCUTUS_NO_DEBUG_LOG removes debug logging from the build altogether.
+#ifdef LOCUTUS_NO_DEBUG_LOG
+#define LOG_DEBUG if (true) {} else Log().Debug()
+#else
+#define LOG_DEBUG if (!Log::DebugEnabled()) {} else Log().Debug()
+#endif
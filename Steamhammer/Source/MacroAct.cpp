@@ -178,7 +178,7 @@ MacroAct::MacroAct(const std::string & name)
 	// It's meaningless and ignored for anything except a building.
 	// Here we parse out the building and its location.
 	// Since buildings are units, only UnitType below sets _macroLocation.
-	std::regex macroLocationRegex("([a-zA-Z_ ]+[a-zA-Z])\\s+\\@\\s+([a-zA-Z][a-zA-Z ]+)");
+	static const std::regex macroLocationRegex("([a-zA-Z_ ]+[a-zA-Z])\\s+\\@\\s+([a-zA-Z][a-zA-Z ]+)");
 	std::smatch m;
 	if (std::regex_match(inputName, m, macroLocationRegex)) {
 		specifiedMacroLocation = getMacroLocationFromString(m[2].str());
@@ -0,0 +1,238 @@
+#include "MapAnalysisCache.h"
+
+#include <fstream>
+
+namespace { auto & bwemMap = BWEM::Map::Instance(); }
+
+namespace MapAnalysisCache
+{
+#ifndef _DEBUG
+    namespace
+    {
+#endif
+
+        // Bump this whenever the file layout or the analysis producing the cached data changes
+        const int CACHE_FILE_VERSION = 1;
+        const char CACHE_FILE_MAGIC[4] = { 'L', 'M', 'A', 'C' };
+
+        std::vector<BWEM::altitude_t> altitudes;
+
+        // Walls keyed by our start location and whether the wall was requested to be tight
+        std::map<std::pair<BWAPI::TilePosition, bool>, UAlbertaBot::LocutusWall> walls;
+
+        bool dirty = false;
+
+        std::string cacheFilename(const std::string & dir)
+        {
+            std::ostringstream filename;
+            filename << dir << BWAPI::Broodwar->mapHash() << "_mapAnalysis.bin";
+            return filename.str();
+        }
+
+        // Simple binary readers and writers
+        // The file is only ever read on the same platform it was written on, so we don't bother with endianness
+
+        template<typename T>
+        void writeValue(std::ostream & out, T value)
+        {
+            out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+        template<typename T>
+        T readValue(std::istream & in)
+        {
+            T value;
+            in.read(reinterpret_cast<char *>(&value), sizeof(T));
+            if (!in) throw std::runtime_error("unexpected end of file");
+            return value;
+        }
+
+        void writeTile(std::ostream & out, BWAPI::TilePosition tile)
+        {
+            writeValue<int>(out, tile.x);
+            writeValue<int>(out, tile.y);
+        }
+
+        BWAPI::TilePosition readTile(std::istream & in)
+        {
+            int x = readValue<int>(in);
+            int y = readValue<int>(in);
+            return BWAPI::TilePosition(x, y);
+        }
+
+        void writePosition(std::ostream & out, BWAPI::Position position)
+        {
+            writeValue<int>(out, position.x);
+            writeValue<int>(out, position.y);
+        }
+
+        BWAPI::Position readPosition(std::istream & in)
+        {
+            int x = readValue<int>(in);
+            int y = readValue<int>(in);
+            return BWAPI::Position(x, y);
+        }
+
+        void writeTileSet(std::ostream & out, const std::set<BWAPI::TilePosition> & tiles)
+        {
+            writeValue<int>(out, tiles.size());
+            for (auto tile : tiles) writeTile(out, tile);
+        }
+
+        void readTileSet(std::istream & in, std::set<BWAPI::TilePosition> & tiles)
+        {
+            int count = readValue<int>(in);
+            for (int i = 0; i < count; i++) tiles.insert(readTile(in));
+        }
+
+        void writeWall(std::ostream & out, const UAlbertaBot::LocutusWall & wall)
+        {
+            writeTile(out, wall.forge);
+            writeTile(out, wall.gateway);
+            writeTile(out, wall.pylon);
+            writeValue<int>(out, wall.cannons.size());
+            for (auto tile : wall.cannons) writeTile(out, tile);
+
+            writeValue<int>(out, wall.gapSize);
+            writePosition(out, wall.gapCenter);
+            writePosition(out, wall.gapEnd1);
+            writePosition(out, wall.gapEnd2);
+
+            writeTileSet(out, wall.tilesInsideWall);
+            writeTileSet(out, wall.tilesOutsideWall);
+            writeTileSet(out, wall.tilesOutsideButCloseToWall);
+        }
+
+        UAlbertaBot::LocutusWall readWall(std::istream & in)
+        {
+            UAlbertaBot::LocutusWall wall;
+            wall.forge = readTile(in);
+            wall.gateway = readTile(in);
+            wall.pylon = readTile(in);
+            int cannons = readValue<int>(in);
+            for (int i = 0; i < cannons; i++) wall.cannons.push_back(readTile(in));
+
+            wall.gapSize = readValue<int>(in);
+            wall.gapCenter = readPosition(in);
+            wall.gapEnd1 = readPosition(in);
+            wall.gapEnd2 = readPosition(in);
+
+            readTileSet(in, wall.tilesInsideWall);
+            readTileSet(in, wall.tilesOutsideWall);
+            readTileSet(in, wall.tilesOutsideButCloseToWall);
+            return wall;
+        }
+
+        bool readFile(const std::string & filename)
+        {
+            std::ifstream file(filename, std::ios::binary);
+            if (!file.good()) return false;
+
+            try
+            {
+                char magic[4];
+                file.read(magic, 4);
+                if (!file || !std::equal(magic, magic + 4, CACHE_FILE_MAGIC)) return false;
+                if (readValue<int>(file) != CACHE_FILE_VERSION) return false;
+
+                int hashLength = readValue<int>(file);
+                if (hashLength <= 0 || hashLength > 256) return false;
+                std::string hash(hashLength, ' ');
+                file.read(&hash[0], hashLength);
+                if (hash != BWAPI::Broodwar->mapHash()) return false;
+
+                int altitudeCount = readValue<int>(file);
+                if (altitudeCount != BWAPI::Broodwar->mapWidth() * BWAPI::Broodwar->mapHeight() * 16) return false;
+                altitudes.resize(altitudeCount);
+                file.read(reinterpret_cast<char *>(altitudes.data()), altitudeCount * sizeof(BWEM::altitude_t));
+                if (!file) throw std::runtime_error("unexpected end of file");
+
+                int wallCount = readValue<int>(file);
+                for (int i = 0; i < wallCount; i++)
+                {
+                    BWAPI::TilePosition startLocation = readTile(file);
+                    bool tight = readValue<char>(file) != 0;
+                    walls[std::make_pair(startLocation, tight)] = readWall(file);
+                }
+
+                Log().Get() << "Read map analysis cache " << filename << " with " << wallCount << " walls";
+                return true;
+            }
+            catch (std::exception & ex)
+            {
+                Log().Get() << "Exception caught reading map analysis cache " << filename << ": " << ex.what();
+            }
+
+            altitudes.clear();
+            walls.clear();
+            return false;
+        }
+
+#ifndef _DEBUG
+    }
+#endif
+
+    void initialize()
+    {
+        altitudes.clear();
+        walls.clear();
+        dirty = false;
+
+        if (!readFile(cacheFilename(Config::IO::ReadDir)))
+            readFile(cacheFilename(Config::IO::WriteDir));
+
+        if (!altitudes.empty())
+            bwemMap.SetPrecomputedAltitudes(altitudes);
+    }
+
+    void onBWEMInitialized()
+    {
+        if (!altitudes.empty()) return;
+
+        altitudes = bwemMap.ExportAltitudes();
+        dirty = true;
+    }
+
+    bool getWall(bool tight, UAlbertaBot::LocutusWall & wall)
+    {
+        auto it = walls.find(std::make_pair(BWAPI::Broodwar->self()->getStartLocation(), tight));
+        if (it == walls.end()) return false;
+
+        wall = it->second;
+        return true;
+    }
+
+    void storeWall(bool tight, const UAlbertaBot::LocutusWall & wall)
+    {
+        walls[std::make_pair(BWAPI::Broodwar->self()->getStartLocation(), tight)] = wall;
+        dirty = true;
+    }
+
+    void write()
+    {
+        if (!dirty) return;
+
+        std::ofstream file(cacheFilename(Config::IO::WriteDir), std::ios::binary | std::ios::trunc);
+        if (!file.good()) return;
+
+        file.write(CACHE_FILE_MAGIC, 4);
+        writeValue<int>(file, CACHE_FILE_VERSION);
+
+        std::string hash = BWAPI::Broodwar->mapHash();
+        writeValue<int>(file, hash.size());
+        file.write(hash.data(), hash.size());
+
+        writeValue<int>(file, altitudes.size());
+        file.write(reinterpret_cast<const char *>(altitudes.data()), altitudes.size() * sizeof(BWEM::altitude_t));
+
+        writeValue<int>(file, walls.size());
+        for (auto const & startAndWall : walls)
+        {
+            writeTile(file, startAndWall.first.first);
+            writeValue<char>(file, startAndWall.first.second ? 1 : 0);
+            writeWall(file, startAndWall.second);
+        }
+
+        dirty = false;
+    }
+}
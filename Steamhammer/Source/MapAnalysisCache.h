@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Common.h"
+#include "LocutusWall.h"
+
+// Persistent cache of the map analysis that only depends on the map, so later games on the same map can
+// skip the expensive parts of startup.
+// The cache is a versioned binary file per map hash. It is read from the read directory and written to the
+// write directory whenever a game computes something the cache did not have.
+namespace MapAnalysisCache
+{
+    // Reads the cache file for the current map and gives BWEM any precomputed data it can use.
+    // Must be called before BWEM is initialized.
+    void initialize();
+
+    // Stores anything BWEM computed that the cache did not already have.
+    // Call right after BWEM is initialized.
+    void onBWEMInitialized();
+
+    // Gets the wall previously created for our start location, returning false if there is none cached.
+    bool getWall(bool tight, UAlbertaBot::LocutusWall & wall);
+    void storeWall(bool tight, const UAlbertaBot::LocutusWall & wall);
+
+    // Writes the cache file if anything new was added to it this game.
+    void write();
+}
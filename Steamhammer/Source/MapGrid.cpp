@@ -162,19 +162,71 @@ BWAPI::Position MapGrid::getCellCenter(int row, int col)
 	return getCellByIndex(row, col).center;
 }
 
-// clear the vectors in the grid
-void MapGrid::clearGrid() { 
+// Move the unit to the given cell, or remove it from the grid if the cell index is -1.
+// Does nothing if the unit is already in that cell.
+void MapGrid::placeUnit(BWAPI::Unit unit, int cellIndex, bool ours)
+{
+	UnitPlacement & placement = ours ? ourPlacement : oppPlacement;
+
+	int id = unit->getID();
+	if (id >= int(placement.cellOf.size()))
+	{
+		placement.cellOf.resize(id + 1, -1);
+		placement.lastSeen.resize(id + 1, -1);
+	}
+
+	int & current = placement.cellOf[id];
+	if (current == cellIndex) return;
+
+	if (current != -1)
+	{
+		auto & cellUnits = ours ? cells[current].ourUnits : cells[current].oppUnits;
+		auto it = std::find(cellUnits.begin(), cellUnits.end(), unit);
+		*it = cellUnits.back();
+		cellUnits.pop_back();
+	}
+
+	if (cellIndex != -1)
+	{
+		auto & cellUnits = ours ? cells[cellIndex].ourUnits : cells[cellIndex].oppUnits;
+		cellUnits.push_back(unit);
+	}
+
+	if (current == -1)
+	{
+		placement.units.push_back(unit);
+	}
+	else if (cellIndex == -1)
+	{
+		placement.units.erase(std::find(placement.units.begin(), placement.units.end(), unit));
+	}
+
+	current = cellIndex;
+}
+
+// Remove units that did not qualify for the grid this frame: they are dead, or enemy units that went out of sight.
+void MapGrid::removeStaleUnits(int frame, bool ours)
+{
+	UnitPlacement & placement = ours ? ourPlacement : oppPlacement;
 
-	for (size_t i(0); i<cells.size(); ++i) 
+	for (size_t i = 0; i < placement.units.size(); )
 	{
-		cells[i].ourUnits.clear();
-		cells[i].oppUnits.clear();
+		BWAPI::Unit unit = placement.units[i];
+		if (placement.lastSeen[unit->getID()] == frame)
+		{
+			++i;
+			continue;
+		}
+
+		// placeUnit removes the unit from the list, so the next unit moves into slot i
+		placeUnit(unit, -1, ours);
 	}
 }
 
-// Populate the grid with units.
+// Update the grid with units.
 // Include all buildings, but other units only if they are completed.
 // For the enemy, only include visible units (InformationManager remembers units which are out of sight).
+// Only units which have changed cells, or appeared or disappeared, cause any change to the grid.
 void MapGrid::update() 
 {
     if (Config::Debug::DrawMapGrid) 
@@ -201,16 +253,22 @@ void MapGrid::update()
 	    }
     }
 
-	clearGrid();
-
 	//BWAPI::Broodwar->printf("MapGrid info: WH(%d, %d)  CS(%d)  RC(%d, %d)  C(%d)", mapWidth, mapHeight, cellSize, rows, cols, cells.size());
 
+	const int frame = BWAPI::Broodwar->getFrameCount();
+
 	for (const auto unit : BWAPI::Broodwar->self()->getUnits()) 
 	{
 		if (unit->isCompleted() || unit->getType().isBuilding())
 		{
-			getCell(unit).ourUnits.insert(unit);
-			getCell(unit).timeLastVisited = BWAPI::Broodwar->getFrameCount();
+			int cellIndex = getCellIndex(unit->getPosition());
+			placeUnit(unit, cellIndex, true);
+			ourPlacement.lastSeen[unit->getID()] = frame;
+			cells[cellIndex].timeLastVisited = frame;
+		}
+		else
+		{
+			placeUnit(unit, -1, true);
 		}
 	}
 
@@ -221,13 +279,24 @@ void MapGrid::update()
 			(unit->getHitPoints() > 0 || UnitUtil::IsUndetected(unit)) &&
 			unit->getType() != BWAPI::UnitTypes::Unknown) 
 		{
-			getCell(unit).oppUnits.insert(unit);
-			getCell(unit).timeLastOpponentSeen = BWAPI::Broodwar->getFrameCount();
+			int cellIndex = getCellIndex(unit->getPosition());
+			placeUnit(unit, cellIndex, false);
+			oppPlacement.lastSeen[unit->getID()] = frame;
+			cells[cellIndex].timeLastOpponentSeen = frame;
+		}
+		else
+		{
+			placeUnit(unit, -1, false);
 		}
 	}
+
+	removeStaleUnits(frame, true);
+	removeStaleUnits(frame, false);
 }
 
-void MapGrid::getUnits(BWAPI::Unitset & units, BWAPI::Position center, int radius, bool ourUnits, bool oppUnits)
+// Call f on each unit within the radius. Each unit is in one cell, so it comes up once.
+template <class Func>
+void MapGrid::forUnitsNear(BWAPI::Position center, int radius, bool ourUnits, bool oppUnits, Func f)
 {
 	const int x0(std::max( (center.x - radius) / cellSize, 0));
 	const int x1(std::min( (center.x + radius) / cellSize, cols-1));
@@ -249,10 +318,7 @@ void MapGrid::getUnits(BWAPI::Unitset & units, BWAPI::Position center, int radiu
 					BWAPI::Position d(unit->getPosition() - center);
 					if(d.x * d.x + d.y * d.y <= radiusSq)
 					{
-						if (!units.contains(unit)) 
-						{
-							units.insert(unit);
-						}
+						f(unit);
 					}
 				}
 			}
@@ -263,10 +329,7 @@ void MapGrid::getUnits(BWAPI::Unitset & units, BWAPI::Position center, int radiu
 					BWAPI::Position d(unit->getPosition() - center);
 					if(d.x * d.x + d.y * d.y <= radiusSq)
 					{
-						if (!units.contains(unit))
-						{ 
-							units.insert(unit); 
-						}
+						f(unit);
 					}
 				}
 			}
@@ -274,6 +337,17 @@ void MapGrid::getUnits(BWAPI::Unitset & units, BWAPI::Position center, int radiu
 	}
 }
 
+void MapGrid::getUnits(BWAPI::Unitset & units, BWAPI::Position center, int radius, bool ourUnits, bool oppUnits)
+{
+	forUnitsNear(center, radius, ourUnits, oppUnits, [&](BWAPI::Unit unit) { units.insert(unit); });
+}
+
+// The same, without a hash set, for callers that only loop over the units.
+void MapGrid::getUnits(FrameVector<BWAPI::Unit> & units, BWAPI::Position center, int radius, bool ourUnits, bool oppUnits)
+{
+	forUnitsNear(center, radius, ourUnits, oppUnits, [&](BWAPI::Unit unit) { units.push_back(unit); });
+}
+
 // The bot scanned the given position. Record it so we don't scan the same position
 // again before it wears off.
 void MapGrid::scanAtPosition(const BWAPI::Position & pos)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Common.h>
+#include "FrameArena.h"
 #include "MicroManager.h"
 
 namespace UAlbertaBot
@@ -13,8 +14,8 @@ public:
 	int             timeLastVisited;
     int             timeLastOpponentSeen;
 	int				timeLastScan;
-	BWAPI::Unitset  ourUnits;
-	BWAPI::Unitset  oppUnits;
+	std::vector<BWAPI::Unit> ourUnits;
+	std::vector<BWAPI::Unit> oppUnits;
 	BWAPI::Position center;
 
 	// Not the ideal place for this constant, but this is where it is used.
@@ -41,11 +42,28 @@ class MapGrid
 
 	std::vector< GridCell >		cells;
 
+	// The grid is updated incrementally: a unit is only moved when its cell changes.
+	// This tracks where each unit is, for one player's units.
+	struct UnitPlacement
+	{
+		std::vector<int>			cellOf;		// by unit ID: index of the unit's cell, or -1 if not in the grid
+		std::vector<int>			lastSeen;	// by unit ID: frame the unit last qualified for the grid
+		std::vector<BWAPI::Unit>	units;		// units currently in the grid
+	};
+
+	UnitPlacement				ourPlacement;
+	UnitPlacement				oppPlacement;
+
 	void						calculateCellCenters();
 
-	void						clearGrid();
+	int							getCellIndex(BWAPI::Position pos) const { return (pos.y / cellSize) * cols + pos.x / cellSize; }
+	void						placeUnit(BWAPI::Unit unit, int cellIndex, bool ours);
+	void						removeStaleUnits(int frame, bool ours);
 	BWAPI::Position				getCellCenter(int x, int y);
 
+	template <class Func>
+	void						forUnitsNear(BWAPI::Position center, int radius, bool ourUnits, bool oppUnits, Func f);
+
 public:
 
 	// yay for singletons!
@@ -53,6 +71,7 @@ public:
 
 	void				update();
 	void				getUnits(BWAPI::Unitset & units, BWAPI::Position center, int radius, bool ourUnits, bool oppUnits);
+	void				getUnits(FrameVector<BWAPI::Unit> & units, BWAPI::Position center, int radius, bool ourUnits, bool oppUnits);
 	BWAPI::Position		getLeastExplored(bool byGround);
 	BWAPI::Position		getLeastExploredInRegion(BWAPI::Position target, int* lastExplored);
 
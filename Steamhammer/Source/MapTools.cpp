@@ -585,10 +585,10 @@ void MapTools::findPath(BWAPI::Position start, BWAPI::Position end, std::vector<
 void MapTools::setBWAPIMapData()
 {
 	// 1. Mark all tiles walkable and buildable at first.
-	_terrainWalkable = std::vector< std::vector<bool> >(BWAPI::Broodwar->mapWidth(), std::vector<bool>(BWAPI::Broodwar->mapHeight(), true));
-	_walkable = std::vector< std::vector<bool> >(BWAPI::Broodwar->mapWidth(), std::vector<bool>(BWAPI::Broodwar->mapHeight(), true));
-	_buildable = std::vector< std::vector<bool> >(BWAPI::Broodwar->mapWidth(), std::vector<bool>(BWAPI::Broodwar->mapHeight(), true));
-	_depotBuildable = std::vector< std::vector<bool> >(BWAPI::Broodwar->mapWidth(), std::vector<bool>(BWAPI::Broodwar->mapHeight(), true));
+	_terrainWalkable = TileBitGrid(BWAPI::Broodwar->mapWidth(), BWAPI::Broodwar->mapHeight(), true);
+	_walkable = TileBitGrid(BWAPI::Broodwar->mapWidth(), BWAPI::Broodwar->mapHeight(), true);
+	_buildable = TileBitGrid(BWAPI::Broodwar->mapWidth(), BWAPI::Broodwar->mapHeight(), true);
+	_depotBuildable = TileBitGrid(BWAPI::Broodwar->mapWidth(), BWAPI::Broodwar->mapHeight(), true);
 
 	// 2. Check terrain: Is it buildable? Is it walkable?
 	// This sets _walkable and _terrainWalkable identically.
@@ -598,8 +598,8 @@ void MapTools::setBWAPIMapData()
 		{
 			// This initializes all cells of _buildable and _depotBuildable.
 			bool buildable = BWAPI::Broodwar->isBuildable(BWAPI::TilePosition(x, y), false);
-			_buildable[x][y] = buildable;
-			_depotBuildable[x][y] = buildable;
+			_buildable.set(x, y, buildable);
+			_depotBuildable.set(x, y, buildable);
 
 			bool walkable = true;
 
@@ -617,8 +617,8 @@ void MapTools::setBWAPIMapData()
             if (walkableWalkPositions < 16 &&
                 (BWAPI::Broodwar->mapHash() != "6f5295624a7e3887470f3f2e14727b1411321a67" || walkableWalkPositions < 10))
             {
-                _terrainWalkable[x][y] = false;
-                _walkable[x][y] = false;
+                _terrainWalkable.set(x, y, false);
+                _walkable.set(x, y, false);
             }
 		}
 	}
@@ -643,7 +643,7 @@ void MapTools::setBWAPIMapData()
 				{
 					if (BWAPI::TilePosition(x, y).isValid())   // assume it may be partly off the edge
 					{
-						_walkable[x][y] = false;
+						_walkable.set(x, y, false);
 					}
 				}
 			}
@@ -661,28 +661,13 @@ void MapTools::setBWAPIMapData()
 		int tileX = resource->getTilePosition().x;
 		int tileY = resource->getTilePosition().y;
 
-		for (int x = tileX; x<tileX + resource->getType().tileWidth(); ++x)
-		{
-			for (int y = tileY; y<tileY + resource->getType().tileHeight(); ++y)
-			{
-				_buildable[x][y] = false;
+		int width = resource->getType().tileWidth();
+		int height = resource->getType().tileHeight();
 
-				// depots can't be built within 3 tiles of any resource
-				// TODO rewrite this to be less disgusting
-				for (int dx = -3; dx <= 3; dx++)
-				{
-					for (int dy = -3; dy <= 3; dy++)
-					{
-						if (!BWAPI::TilePosition(x + dx, y + dy).isValid())
-						{
-							continue;
-						}
+		_buildable.setRect(tileX, tileY, width, height, false);
 
-						_depotBuildable[x + dx][y + dy] = false;
-					}
-				}
-			}
-		}
+		// depots can't be built within 3 tiles of any resource
+		_depotBuildable.setRect(tileX - 3, tileY - 3, width + 6, height + 6, false);
 	}
 }
 
@@ -757,25 +742,12 @@ bool MapTools::isBuildable(BWAPI::TilePosition tile, BWAPI::UnitType type) const
 		return false;
 	}
 
-	int startX = tile.x;
-	int endX = tile.x + type.tileWidth();
-	int startY = tile.y;
-	int endY = tile.y + type.tileHeight();
-
-	for (int x = startX; x<endX; ++x)
+	if (!_buildable.allInRect(tile.x, tile.y, type.tileWidth(), type.tileHeight()))
 	{
-		for (int y = startY; y<endY; ++y)
-		{
-			BWAPI::TilePosition tile(x, y);
-
-			if (!tile.isValid() || !isBuildable(tile) || type.isResourceDepot() && !isDepotBuildable(tile))
-			{
-				return false;
-			}
-		}
+		return false;
 	}
 
-	return true;
+	return !type.isResourceDepot() || _depotBuildable.allInRect(tile.x, tile.y, type.tileWidth(), type.tileHeight());
 }
 
 void MapTools::drawHomeDistanceMap()
@@ -5,6 +5,7 @@
 
 #include "Common.h"
 #include "DistanceMap.h"
+#include "TileBitGrid.h"
 
 // Keep track of map information, like what tiles are walkable or buildable.
 
@@ -47,14 +48,10 @@ class MapTools
 
 	std::map<BWAPI::TilePosition, DistanceMap>
 						_allMaps;			// a cache of already computed distance maps
-	std::vector< std::vector<bool> >
-						_terrainWalkable;	// walkable considering terrain only
-	std::vector< std::vector<bool> >
-						_walkable;			// walkable considering terrain and neutral units
-	std::vector< std::vector<bool> >
-						_buildable;
-	std::vector< std::vector<bool> >
-						_depotBuildable;
+	TileBitGrid			_terrainWalkable;	// walkable considering terrain only
+	TileBitGrid			_walkable;			// walkable considering terrain and neutral units
+	TileBitGrid			_buildable;
+	TileBitGrid			_depotBuildable;
 	bool				_hasIslandBases;
 	bool				_hasMineralWalkChokes;
 	int				    _minChokeWidth;
@@ -86,10 +83,10 @@ public:
     int     closestBaseDistance(BWTA::BaseLocation * base, std::vector<BWTA::BaseLocation*> bases);
 
 	// Pass only valid tiles to these routines!
-	bool	isTerrainWalkable(BWAPI::TilePosition tile) const { return _terrainWalkable[tile.x][tile.y]; };
-	bool	isWalkable(BWAPI::TilePosition tile) const { return _walkable[tile.x][tile.y]; };
-	bool	isBuildable(BWAPI::TilePosition tile) const { return _buildable[tile.x][tile.y]; };
-	bool	isDepotBuildable(BWAPI::TilePosition tile) const { return _depotBuildable[tile.x][tile.y]; };
+	bool	isTerrainWalkable(BWAPI::TilePosition tile) const { return _terrainWalkable.get(tile); };
+	bool	isWalkable(BWAPI::TilePosition tile) const { return _walkable.get(tile); };
+	bool	isBuildable(BWAPI::TilePosition tile) const { return _buildable.get(tile); };
+	bool	isDepotBuildable(BWAPI::TilePosition tile) const { return _depotBuildable.get(tile); };
 
 	bool	isBuildable(BWAPI::TilePosition tile, BWAPI::UnitType type) const;
 
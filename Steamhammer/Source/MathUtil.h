@@ -6,11 +6,75 @@
 namespace UAlbertaBot
 {
 namespace MathUtil
-{      
-    int EdgeToEdgeDistance(BWAPI::UnitType firstType, BWAPI::Position firstCenter, BWAPI::UnitType secondType, BWAPI::Position secondCenter);
-    int EdgeToPointDistance(BWAPI::UnitType type, BWAPI::Position center, BWAPI::Position point);
-    bool Overlaps(BWAPI::UnitType firstType, BWAPI::Position firstCenter, BWAPI::UnitType secondType, BWAPI::Position secondCenter);
-    bool Overlaps(BWAPI::UnitType type, BWAPI::Position center, BWAPI::Position point);
+{
+    // Unit type dimensions, read from BWAPI once into a table indexed by type ID.
+    // The distance functions below run in the innermost loops of the combat sim and micro,
+    // where going through the UnitType accessors each time shows up.
+    struct TypeDimensions
+    {
+        int left;
+        int up;
+        int right;
+        int down;
+    };
+
+    const TypeDimensions * TypeDimensionTable();
+
+    inline const TypeDimensions & Dimensions(BWAPI::UnitType type) { return TypeDimensionTable()[type.getID()]; }
+
+    // Same as BWAPI::Position::getApproxDistance() for the offset (dx, dy)
+    inline int ApproxDistance(int dx, int dy)
+    {
+        unsigned int max = abs(dx);
+        unsigned int min = abs(dy);
+        if (max < min) std::swap(min, max);
+
+        if (min <= (max >> 2)) return max;
+
+        unsigned int minCalc = (3 * min) >> 3;
+        return (minCalc >> 5) + minCalc + max - (max >> 4) - (max >> 6);
+    }
+
+    inline int EdgeToEdgeDistance(BWAPI::UnitType firstType, BWAPI::Position firstCenter, BWAPI::UnitType secondType, BWAPI::Position secondCenter)
+    {
+        const TypeDimensions & first = Dimensions(firstType);
+        const TypeDimensions & second = Dimensions(secondType);
+
+        // Compute offsets between the bounding boxes
+        int xDist = (std::max)({ (firstCenter.x - first.left) - (secondCenter.x + second.right) - 1, (secondCenter.x - second.left) - (firstCenter.x + first.right) - 1, 0 });
+        int yDist = (std::max)({ (firstCenter.y - first.up) - (secondCenter.y + second.down) - 1, (secondCenter.y - second.up) - (firstCenter.y + first.down) - 1, 0 });
+
+        return ApproxDistance(xDist, yDist);
+    }
+
+    inline int EdgeToPointDistance(BWAPI::UnitType type, BWAPI::Position center, BWAPI::Position point)
+    {
+        const TypeDimensions & dim = Dimensions(type);
+
+        // Compute offsets between the bounding box and the point
+        int xDist = (std::max)({ (center.x - dim.left) - point.x - 1, point.x - (center.x + dim.right) - 1, 0 });
+        int yDist = (std::max)({ (center.y - dim.up) - point.y - 1, point.y - (center.y + dim.down) - 1, 0 });
+
+        return ApproxDistance(xDist, yDist);
+    }
+
+    inline bool Overlaps(BWAPI::UnitType firstType, BWAPI::Position firstCenter, BWAPI::UnitType secondType, BWAPI::Position secondCenter)
+    {
+        const TypeDimensions & first = Dimensions(firstType);
+        const TypeDimensions & second = Dimensions(secondType);
+
+        return firstCenter.x + first.right >= secondCenter.x - second.left && secondCenter.x + second.right >= firstCenter.x - first.left &&
+            firstCenter.y + first.down >= secondCenter.y - second.up && secondCenter.y + second.down >= firstCenter.y - first.up;
+    }
+
+    inline bool Overlaps(BWAPI::UnitType type, BWAPI::Position center, BWAPI::Position point)
+    {
+        const TypeDimensions & dim = Dimensions(type);
+
+        return center.x + dim.right >= point.x && point.x >= center.x - dim.left &&
+            center.y + dim.down >= point.y && point.y >= center.y - dim.up;
+    }
+
     bool Walkable(BWAPI::UnitType type, BWAPI::Position center);
 };
-}
\ No newline at end of file
+}
@@ -0,0 +1,171 @@
+#include "MemoryTracker.h"
+
+#include "Common.h"
+
+#include <cstdlib>
+#include <new>
+
+using namespace UAlbertaBot;
+
+namespace
+{
+	// Each block starts with its size, padded to keep the caller's memory aligned.
+	const std::size_t HeaderSize =
+		alignof(std::max_align_t) > sizeof(std::size_t) ? alignof(std::max_align_t) : sizeof(std::size_t);
+
+	// The main thread's tag, or -1 on other threads.
+	thread_local int currentTag = -1;
+}
+
+std::atomic<long long> MemoryTracker::_liveBytes(0);
+std::atomic<long long> MemoryTracker::_peakBytes(0);
+std::atomic<long long> MemoryTracker::_allocations(0);
+std::atomic<long long> MemoryTracker::_allocatedBytes(0);
+
+MemoryTracker::Counts MemoryTracker::_tagCounts[MemoryTracker::MaxTags];
+
+long long MemoryTracker::_frames = 0;
+long long MemoryTracker::_frameAllocations = 0;
+long long MemoryTracker::_maxFrameAllocations = 0;
+long long MemoryTracker::_lastFrameAllocations = 0;
+bool MemoryTracker::_overCeiling = false;
+
+// Must not allocate.
+void * MemoryTracker::allocate(std::size_t size)
+{
+	char * block = static_cast<char *>(std::malloc(size + HeaderSize));
+	if (!block)
+	{
+		return nullptr;
+	}
+	*reinterpret_cast<std::size_t *>(block) = size;
+
+	const long long bytes = (long long)(size);
+	const long long live = _liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+	long long peak = _peakBytes.load(std::memory_order_relaxed);
+	while (live > peak && !_peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+	{
+	}
+	_allocations.fetch_add(1, std::memory_order_relaxed);
+	_allocatedBytes.fetch_add(bytes, std::memory_order_relaxed);
+
+	if (currentTag >= 0)
+	{
+		++_tagCounts[currentTag].allocations;
+		_tagCounts[currentTag].bytes += bytes;
+	}
+
+	return block + HeaderSize;
+}
+
+void MemoryTracker::deallocate(void * p)
+{
+	if (!p)
+	{
+		return;
+	}
+	char * block = static_cast<char *>(p) - HeaderSize;
+	_liveBytes.fetch_sub((long long)(*reinterpret_cast<std::size_t *>(block)), std::memory_order_relaxed);
+	std::free(block);
+}
+
+void MemoryTracker::setTag(int tag)
+{
+	currentTag = tag >= 0 && tag < MaxTags ? tag : 0;
+}
+
+MemoryTracker::Counts MemoryTracker::takeTagCounts(int tag)
+{
+	if (tag < 0 || tag >= MaxTags)
+	{
+		return Counts{ 0, 0 };
+	}
+	const Counts counts = _tagCounts[tag];
+	_tagCounts[tag] = Counts{ 0, 0 };
+	return counts;
+}
+
+void MemoryTracker::endFrame()
+{
+	const long long allocations = _allocations;
+	_lastFrameAllocations = allocations - _frameAllocations;
+	_frameAllocations = allocations;
+	_maxFrameAllocations = (std::max)(_maxFrameAllocations, _lastFrameAllocations);
+	++_frames;
+
+	const long long ceiling = (long long)(Config::Debug::MemoryCeilingMB) << 20;
+	const bool over = ceiling > 0 && _liveBytes > ceiling;
+	if (over && !_overCeiling)
+	{
+		Log().Get() << "Memory over the ceiling: " << (_liveBytes >> 20) << "MB live, ceiling " << Config::Debug::MemoryCeilingMB << "MB";
+	}
+	_overCeiling = over;
+}
+
+void MemoryTracker::logSummary()
+{
+	std::ostringstream msg;
+	msg << "Memory: live " << (_liveBytes >> 20) << "MB, peak " << (_peakBytes >> 20) << "MB"
+		<< ", allocations " << _allocations << " (" << (_allocatedBytes >> 20) << "MB)"
+		<< ", per frame mean " << (_frames ? _allocations / _frames : 0) << " / max " << _maxFrameAllocations;
+	Log().Get() << msg.str();
+}
+
+#ifdef LOCUTUS_MEMORY_TRACKING
+
+void * operator new(std::size_t size)
+{
+	void * p = MemoryTracker::allocate(size);
+	if (!p)
+	{
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void * operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void * operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+	return MemoryTracker::allocate(size);
+}
+
+void * operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+	return MemoryTracker::allocate(size);
+}
+
+void operator delete(void * p) noexcept
+{
+	MemoryTracker::deallocate(p);
+}
+
+void operator delete[](void * p) noexcept
+{
+	MemoryTracker::deallocate(p);
+}
+
+void operator delete(void * p, std::size_t) noexcept
+{
+	MemoryTracker::deallocate(p);
+}
+
+void operator delete[](void * p, std::size_t) noexcept
+{
+	MemoryTracker::deallocate(p);
+}
+
+void operator delete(void * p, const std::nothrow_t &) noexcept
+{
+	MemoryTracker::deallocate(p);
+}
+
+void operator delete[](void * p, const std::nothrow_t &) noexcept
+{
+	MemoryTracker::deallocate(p);
+}
+
+#endif
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// Counts heap allocations, through a replacement of the global operator new and delete.
+// We keep the live bytes and their peak, and the allocations and bytes allocated per frame.
+// Allocations on the main thread are also counted against a tag, which the Profiler sets to
+// the innermost open zone, so the profiler can report which zones allocate the most.
+// Allocations on other threads, and tags past MaxTags, count only in the totals.
+// If Config::Debug::MemoryCeilingMB is set, going over it is logged.
+// The replacement is only compiled in if LOCUTUS_MEMORY_TRACKING is defined; otherwise
+// operator new is left alone and every count is zero.
+// NOTE Do not define it for the bot DLL, and never for a tournament build. Every block from
+// the replacement starts with a size header, but memory allocated by BWAPI.dll and freed by
+// us has none, and freeing it here corrupts the heap. LocutusTest defines it, since there
+// BWAPI is compiled into the program and all memory goes through the replacement.
+
+namespace UAlbertaBot
+{
+
+class MemoryTracker
+{
+public:
+	static const int MaxTags = 1024;
+
+	struct Counts
+	{
+		long long	allocations;
+		long long	bytes;
+	};
+
+private:
+	static std::atomic<long long>	_liveBytes;
+	static std::atomic<long long>	_peakBytes;
+	static std::atomic<long long>	_allocations;		// over the game
+	static std::atomic<long long>	_allocatedBytes;
+
+	// The main thread's counts this frame, by tag.
+	static Counts	_tagCounts[MaxTags];
+
+	// Per frame, over the game.
+	static long long	_frames;
+	static long long	_frameAllocations;		// at the start of this frame
+	static long long	_maxFrameAllocations;
+	static long long	_lastFrameAllocations;
+	static bool			_overCeiling;
+
+public:
+
+	static void *	allocate(std::size_t size);
+	static void		deallocate(void * p);
+
+	// Set on the main thread only. Other threads have no tag.
+	static void		setTag(int tag);
+
+	// The tag's counts this frame, then clear them.
+	static Counts	takeTagCounts(int tag);
+
+	static void		endFrame();
+	static void		logSummary();
+
+	static long long	liveBytes()				{ return _liveBytes; };
+	static long long	peakBytes()				{ return _peakBytes; };
+	static long long	lastFrameAllocations()	{ return _lastFrameAllocations; };
+};
+
+}
@@ -1,5 +1,6 @@
 #include "MicroAirToAir.h"
 #include "UnitUtil.h"
+#include "DamageAssignment.h"
 
 using namespace UAlbertaBot;
 
@@ -57,6 +58,7 @@ void MicroAirToAir::assignTargets(const BWAPI::Unitset & targets)
 				}
 
 				Micro::AttackUnit(airUnit, target);
+				DamageAssignment::Instance().addAttack(airUnit, target);
 			}
 			else
 			{
@@ -128,6 +130,12 @@ BWAPI::Unit MicroAirToAir::getTarget(BWAPI::Unit airUnit, const BWAPI::Unitset &
 
 		// TODO prefer targets in groups, so they'll all get splashed
 
+		// Leave targets that attacks by other units will already kill.
+		if (DamageAssignment::Instance().isOverkill(airUnit, target))
+		{
+			score -= DamageAssignment::OverkillPenalty;
+		}
+
 		if (score > bestScore)
 		{
 			bestScore = score;
@@ -184,7 +184,7 @@ void MicroBunkerAttackSquad::initialize(BWAPI::Position bunkerPosition)
             it++;
     }
 
-    Log().Debug() << "Initialized bunker attack squad with " << attackPositions.size() << " attack positions";
+    LOG_DEBUG << "Initialized bunker attack squad with " << attackPositions.size() << " attack positions";
     _initialized = true;
 }
 
@@ -211,7 +211,7 @@ void MicroBunkerAttackSquad::assignToPosition(BWAPI::Unit unit, std::set<BWAPI::
 
     if (!posBest.isValid()) return;
 
-    Log().Debug() << "Assigning " << unit->getID() << " @ " << unit->getPosition() << " to " << posBest;
+    LOG_DEBUG << "Assigning " << unit->getID() << " @ " << unit->getPosition() << " to " << posBest;
 
     // Move the unit currently occupying the position
     auto it = assignedPositionToUnit.find(posBest);
@@ -311,7 +311,7 @@ BWAPI::Position computeRunByPosition(BWAPI::Position unitPosition, BWAPI::Positi
     BWAPI::Position intersect1(x2 + rx, y2 + ry);
     BWAPI::Position intersect2(x2 - rx, y2 - ry);
 
-    //Log().Debug() << "Bunker @ " << bunker->getPosition() << "; order position " << orderPosition << "; unit @ " << unit->getPosition() << "; intersections " << intersect1 << " " << intersect2;
+    //LOG_DEBUG << "Bunker @ " << bunker->getPosition() << "; order position " << orderPosition << "; unit @ " << unit->getPosition() << "; intersections " << intersect1 << " " << intersect2;
 
     // Return the order position if neither intersection is valid
     if (!intersect1.isValid() && !intersect2.isValid()) return orderPosition;
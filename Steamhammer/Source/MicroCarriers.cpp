@@ -11,8 +11,8 @@ void MicroCarriers::executeMicro(const BWAPI::Unitset & targets)
     const BWAPI::Unitset & carriers = getUnits();
 
 	// The set of potential targets.
-	BWAPI::Unitset carrierTargets;
-    std::copy_if(targets.begin(), targets.end(), std::inserter(carrierTargets, carrierTargets.end()),
+	FrameVector<BWAPI::Unit> carrierTargets;
+    std::copy_if(targets.begin(), targets.end(), std::back_inserter(carrierTargets),
 		[](BWAPI::Unit u) {
 		return
 			u->isVisible() &&
@@ -21,6 +21,7 @@ void MicroCarriers::executeMicro(const BWAPI::Unitset & targets)
 			u->getType() != BWAPI::UnitTypes::Zerg_Egg &&
 			!u->isStasised();
 	});
+	_targets.build(carrierTargets, order.getPosition());
 
     for (const auto carrier : carriers)
 	{
@@ -59,7 +60,7 @@ void MicroCarriers::executeMicro(const BWAPI::Unitset & targets)
             }
 
 			// If a target is found,
-			BWAPI::Unit target = getTarget(carrier, carrierTargets);
+			BWAPI::Unit target = getTarget(carrier, _targets);
 			if (target)
 			{
 				if (Config::Debug::DrawUnitTargetInfo)
@@ -2,11 +2,23 @@
 
 #include "InformationManager.h"
 #include "CombatCommander.h"
+#include "DamageAssignment.h"
 #include "UnitUtil.h"
 #include "MathUtil.h"
 
 using namespace UAlbertaBot;
 
+namespace
+{
+    // Prefix for the debug log lines about a unit. Only called when debug logging is on.
+    std::string debugPrefix(BWAPI::Unit unit)
+    {
+        std::ostringstream prefix;
+        prefix << "DT micro: " << unit->getID() << " @ " << unit->getTilePosition() << ": ";
+        return prefix.str();
+    }
+}
+
 MicroDarkTemplar::MicroDarkTemplar()
 { 
 }
@@ -73,15 +85,11 @@ void MicroDarkTemplar::executeMicro(const BWAPI::Unitset & targets)
 
     auto & enemyUnitGrid = InformationManager::Instance().getEnemyUnitGrid();
 
-    std::ostringstream debug;
-    debug << "DT micro:";
 	for (const auto meleeUnit : meleeUnits)
 	{
-        debug << "\n" << meleeUnit->getID() << " @ " << meleeUnit->getTilePosition() << ": ";
-
         if (unstickStuckUnit(meleeUnit))
         {
-            debug << "unstick";
+            LOG_DEBUG << debugPrefix(meleeUnit) << "unstick";
             continue;
         }
 
@@ -113,7 +121,7 @@ void MicroDarkTemplar::executeMicro(const BWAPI::Unitset & targets)
         breakLoop:;
             if (fleeTo.isValid())
             {
-                debug << "detected, fleeing to " << BWAPI::TilePosition(fleeTo);
+                LOG_DEBUG << debugPrefix(meleeUnit) << "detected, fleeing to " << BWAPI::TilePosition(fleeTo);
                 InformationManager::Instance().getLocutusUnit(meleeUnit).moveTo(BWAPI::Position(fleeTo) + BWAPI::Position(4, 4));
                 continue; // next unit
             }
@@ -122,8 +130,9 @@ void MicroDarkTemplar::executeMicro(const BWAPI::Unitset & targets)
 		BWAPI::Unit target = getTarget(meleeUnit, meleeUnitTargets, enemyUnitGrid, attackSquad);
         if (target)
         {
-            debug << "attacking target " << target->getType() << " @ " << target->getTilePosition();
+            LOG_DEBUG << debugPrefix(meleeUnit) << "attacking target " << target->getType() << " @ " << target->getTilePosition();
             Micro::AttackUnit(meleeUnit, target);
+            DamageAssignment::Instance().addAttack(meleeUnit, target);
             continue;
         }
 
@@ -131,8 +140,9 @@ void MicroDarkTemplar::executeMicro(const BWAPI::Unitset & targets)
         auto base = InformationManager::Instance().baseAt(BWAPI::TilePosition(order.getPosition()));
         if (base && base->getOwner() == BWAPI::Broodwar->enemy())
         {
-            debug << "moving towards order position " << BWAPI::TilePosition(order.getPosition());
-            InformationManager::Instance().getLocutusUnit(meleeUnit).moveTo(order.getPosition());
+            // Route around detected threat coverage when a safe path is available
+            LOG_DEBUG << debugPrefix(meleeUnit) << "moving safely towards order position " << BWAPI::TilePosition(order.getPosition());
+            InformationManager::Instance().getLocutusUnit(meleeUnit).moveToSafely(order.getPosition());
             continue;
         }
 
@@ -142,7 +152,7 @@ void MicroDarkTemplar::executeMicro(const BWAPI::Unitset & targets)
                 ui.second.lastPosition.isValid() && !ui.second.goneFromLastPosition &&
                 BWTA::getRegion(BWAPI::TilePosition(ui.second.lastPosition)) == BWTA::getRegion(BWAPI::TilePosition(order.getPosition())))
             {
-                debug << "moving towards " << ui.second.type << " @ " << BWAPI::TilePosition(ui.second.lastPosition);
+                LOG_DEBUG << debugPrefix(meleeUnit) << "moving towards " << ui.second.type << " @ " << BWAPI::TilePosition(ui.second.lastPosition);
                 InformationManager::Instance().getLocutusUnit(meleeUnit).moveTo(ui.second.lastPosition);
                 goto nextUnit;
             }
@@ -157,12 +167,12 @@ void MicroDarkTemplar::executeMicro(const BWAPI::Unitset & targets)
         }
         if (exploreTo.isValid())
         {
-            debug << "exploring towards " << BWAPI::TilePosition(exploreTo);
+            LOG_DEBUG << debugPrefix(meleeUnit) << "exploring towards " << BWAPI::TilePosition(exploreTo);
             InformationManager::Instance().getLocutusUnit(meleeUnit).moveTo(exploreTo);
             continue;
         }
 
-        debug << "doing nothing";
+        LOG_DEBUG << debugPrefix(meleeUnit) << "doing nothing";
 
 		if (Config::Debug::DrawUnitTargetInfo)
 		{
@@ -171,8 +181,6 @@ void MicroDarkTemplar::executeMicro(const BWAPI::Unitset & targets)
 		}
     nextUnit:;
 	}
-
-    Log().Debug() << debug.str();
 }
 
 // Choose a target from the set, or null if we don't want to attack anything
@@ -183,17 +191,12 @@ BWAPI::Unit MicroDarkTemplar::getTarget(BWAPI::Unit meleeUnit, const BWAPI::Unit
 
     BWAPI::Position myPositionInFiveFrames = InformationManager::Instance().predictUnitPosition(meleeUnit, 5);
 
-    std::ostringstream debug;
-    debug << "Getting target for " << meleeUnit->getID();
-
 	for (const auto target : targets)
 	{
-        debug << "\n" << target->getType() << " @ " << target->getTilePosition() << ": ";
-
         // If the rest of the squad is regrouping, avoid attacking anything covered by detection
         if (!attackSquad && attackOrder() && isVulnerable(target->getPosition(), enemyUnitGrid))
         {
-            debug << "covered by detection";
+            LOG_DEBUG << debugPrefix(meleeUnit) << target->getType() << " @ " << target->getTilePosition() << ": covered by detection";
             continue;
         }
 
@@ -205,7 +208,7 @@ BWAPI::Unit MicroDarkTemplar::getTarget(BWAPI::Unit meleeUnit, const BWAPI::Unit
 		// Skip targets that are too far away to worry about.
 		if (range >= 13 * 32)
 		{
-            debug << "too far away";
+            LOG_DEBUG << debugPrefix(meleeUnit) << target->getType() << " @ " << target->getTilePosition() << ": too far away";
 			continue;
 		}
 
@@ -299,10 +302,16 @@ BWAPI::Unit MicroDarkTemplar::getTarget(BWAPI::Unit meleeUnit, const BWAPI::Unit
 			score += 24;
 		}
 
-        debug << score;
+		// Leave targets that attacks by other units will already kill.
+		if (DamageAssignment::Instance().isOverkill(meleeUnit, target))
+		{
+			score -= DamageAssignment::OverkillPenalty;
+		}
+
+        LOG_DEBUG << debugPrefix(meleeUnit) << target->getType() << " @ " << target->getTilePosition() << ": " << score
+            << (score > bestScore ? " (best)" : "");
 		if (score > bestScore)
 		{
-            debug << " (best)";
 			bestScore = score;
 			bestTarget = target;
 		}
@@ -310,12 +319,10 @@ BWAPI::Unit MicroDarkTemplar::getTarget(BWAPI::Unit meleeUnit, const BWAPI::Unit
 
     if (shouldIgnoreTarget(meleeUnit, bestTarget))
     {
-        debug << "\nIgnoring best target";
-        Log().Debug() << debug.str();
+        LOG_DEBUG << debugPrefix(meleeUnit) << "ignoring best target";
         return nullptr;
     }
 
-    Log().Debug() << debug.str();
     return bestTarget;
 }
 
@@ -5,6 +5,7 @@
 #include "UnitUtil.h"
 #include "MathUtil.h"
 #include "PathFinding.h"
+#include "Profiler.h"
 
 using namespace UAlbertaBot;
 
@@ -43,6 +44,8 @@ void MicroManager::setOrder(const SquadOrder & inputOrder)
 
 void MicroManager::execute()
 {
+	PROFILE_ZONE("Micro");
+
 	// Nothing to do if we have no units.
 	if (_units.empty())
 	{
@@ -4,6 +4,7 @@
 #include "BuildingPlacer.h"
 #include "StrategyManager.h"
 #include "CombatCommander.h"
+#include "DamageAssignment.h"
 
 namespace { auto & bwemMap = BWEM::Map::Instance(); }
 namespace { auto & bwebMap = BWEB::Map::Instance(); }
@@ -48,7 +49,7 @@ void MicroMelee::executeMicro(const BWAPI::Unitset & targets)
     if (order.getType() == SquadOrderTypes::Defend)
     {
         BWAPI::Position squadCenter = CombatCommander::Instance().getSquadData().getSquad(this).calcCenter();
-        Log().Debug() << "center: " << squadCenter << "; main choke: " << BWAPI::Position(bwebMap.mainChoke->Center()) << " = " << BWAPI::Position(bwebMap.mainChoke->Center()).getApproxDistance(squadCenter);
+        LOG_DEBUG << "center: " << squadCenter << "; main choke: " << BWAPI::Position(bwebMap.mainChoke->Center()) << " = " << BWAPI::Position(bwebMap.mainChoke->Center()).getApproxDistance(squadCenter);
 
         // Try to find a choke close to where the squad is defending
         const BWEM::ChokePoint* defendingChoke = nullptr;
@@ -98,7 +99,7 @@ void MicroMelee::assignTargets(const BWAPI::Unitset & targets)
     const BWAPI::Unitset & meleeUnits = getUnits();
     Squad & squad = CombatCommander::Instance().getSquadData().getSquad(this);
 
-	BWAPI::Unitset meleeUnitTargets;
+	FrameVector<BWAPI::Unit> meleeUnitTargets;
 	for (const auto target : targets) 
 	{
 		if (target->isVisible() &&
@@ -110,10 +111,13 @@ void MicroMelee::assignTargets(const BWAPI::Unitset & targets)
 			!target->isStasised() &&
 			!target->isUnderDisruptionWeb())             // melee unit can't attack under dweb
 		{
-			meleeUnitTargets.insert(target);
+			meleeUnitTargets.push_back(target);
 		}
 	}
 
+	// Read the targets once for all our units.
+	_targets.build(meleeUnitTargets, order.getPosition());
+
 	for (const auto meleeUnit : meleeUnits)
 	{
         // We may have issued a command to this unit earlier when defending a narrow choke
@@ -161,7 +165,7 @@ void MicroMelee::assignTargets(const BWAPI::Unitset & targets)
             }
 			else
 			{
-				BWAPI::Unit target = getTarget(meleeUnit, meleeUnitTargets);
+				BWAPI::Unit target = getTarget(meleeUnit, _targets);
 				if (target)
 				{
                     // Bunkers are handled by a special micro manager
@@ -171,7 +175,10 @@ void MicroMelee::assignTargets(const BWAPI::Unitset & targets)
                         squad.addUnitToBunkerAttackSquad(target->getPosition(), meleeUnit);
                     }
                     else
+                    {
                         Micro::AttackUnit(meleeUnit, target);
+                        DamageAssignment::Instance().addAttack(meleeUnit, target);
+                    }
 				}
                 // There are no targets. Move to the order position if not already close.
                 else if (meleeUnit->getDistance(order.getPosition()) > 96)
@@ -205,7 +212,7 @@ void MicroMelee::assignTargets(const BWAPI::Unitset & targets)
 }
 
 // Choose a target from the set. Never return null!
-BWAPI::Unit MicroMelee::getTarget(BWAPI::Unit meleeUnit, const BWAPI::Unitset & targets)
+BWAPI::Unit MicroMelee::getTarget(BWAPI::Unit meleeUnit, const TargetSnapshot & targets)
 {
 	int bestScore = -999999;
 	BWAPI::Unit bestTarget = nullptr;
@@ -213,12 +220,18 @@ BWAPI::Unit MicroMelee::getTarget(BWAPI::Unit meleeUnit, const BWAPI::Unitset &
     BWAPI::Position myPositionInFiveFrames = InformationManager::Instance().predictUnitPosition(meleeUnit, 5);
     bool inOrderPositionArea = bwemMap.GetArea(meleeUnit->getTilePosition()) == bwemMap.GetArea(BWAPI::TilePosition(order.getPosition()));
 
-	for (const auto target : targets)
+	// Everything about our unit and the situation that does not depend on the target.
+	const BWAPI::UnitType meleeType = meleeUnit->getType();
+	const double meleeSpeed = meleeType.topSpeed();
+	const int meleeGoalDistance = targets.goalDistanceFrom(meleeUnit);
+	const bool rushing = StrategyManager::Instance().isRushing();
+	const bool ignoreTierTwo = rushing || order.getType() == SquadOrderTypes::KamikazeAttack;
+
+	targets.distancesFrom(meleeUnit, _targetDistances);
+
+	for (int i = 0; i < targets.size(); ++i)
 	{
-		const int priority = getAttackPriority(meleeUnit, target);		// 0..12
-		const int range = meleeUnit->getDistance(target);				// 0..map size in pixels
-		const int closerToGoal =										// positive if target is closer than us to the goal
-			meleeUnit->getDistance(order.getPosition()) - target->getDistance(order.getPosition());
+		const int range = _targetDistances[i];							// 0..map size in pixels
 
 		// Skip targets that are too far away to worry about.
 		if (range >= 13 * 32)
@@ -226,15 +239,22 @@ BWAPI::Unit MicroMelee::getTarget(BWAPI::Unit meleeUnit, const BWAPI::Unitset &
 			continue;
 		}
 
-		// Let's say that 1 priority step is worth 64 pixels (2 tiles).
-		// We care about unit-target range and target-order position distance.
-		int score = 2 * 32 * priority - range;
+		// Workers can't hit under dark swarm. Skip this target.
+		if (targets.underDarkSwarm[i] && meleeType.isWorker())
+		{
+			continue;
+		}
+
+		const BWAPI::Unit target = targets.unit[i];
+		const BWAPI::UnitType targetType = targets.type[i];
+		const int closerToGoal =										// positive if target is closer than us to the goal
+			meleeGoalDistance - targets.goalDistance[i];
 
         // Kamikaze and rush attacks ignore all tier 2+ combat units unless they are closer to the order position and in weapon range
-        if ((StrategyManager::Instance().isRushing() || order.getType() == SquadOrderTypes::KamikazeAttack) &&
+        if (ignoreTierTwo &&
             UnitUtil::IsCombatUnit(target) && 
-            !UnitUtil::IsTierOneCombatUnit(target->getType()) &&
-            !target->getType().isWorker() &&
+            !UnitUtil::IsTierOneCombatUnit(targetType) &&
+            !targetType.isWorker() &&
             (range > UnitUtil::GetAttackRange(meleeUnit, target) || closerToGoal < 0))
         {
             continue;
@@ -245,27 +265,35 @@ BWAPI::Unit MicroMelee::getTarget(BWAPI::Unit meleeUnit, const BWAPI::Unitset &
         if (!inWeaponRange && order.getType() != SquadOrderTypes::Defend)
         {
             // Never chase units that can kite us easily
-            if (target->getType() == BWAPI::UnitTypes::Protoss_Dragoon ||
-                target->getType() == BWAPI::UnitTypes::Terran_Vulture) continue;
+            if (targetType == BWAPI::UnitTypes::Protoss_Dragoon ||
+                targetType == BWAPI::UnitTypes::Terran_Vulture) continue;
 
             // Check if the target is moving away from us
-            BWAPI::Position targetPositionInFiveFrames = InformationManager::Instance().predictUnitPosition(target, 5);
-            if (target->isMoving() && 
-                range <= MathUtil::EdgeToEdgeDistance(meleeUnit->getType(), myPositionInFiveFrames, target->getType(), targetPositionInFiveFrames))
+            if (targets.motion[i] != TargetSnapshot::Still && targets.motion[i] != TargetSnapshot::StillSieged)
             {
-                // Never chase workers
-                if (target->getType().isWorker()) continue;
+                BWAPI::Position targetPositionInFiveFrames = InformationManager::Instance().predictUnitPosition(target, 5);
+                if (range <= MathUtil::EdgeToEdgeDistance(meleeType, myPositionInFiveFrames, targetType, targetPositionInFiveFrames))
+                {
+                    // Never chase workers
+                    if (targetType.isWorker()) continue;
 
-                // When rushing, don't chase anything when outside the order position area
-                if (StrategyManager::Instance().isRushing() && !inOrderPositionArea) continue;
+                    // When rushing, don't chase anything when outside the order position area
+                    if (rushing && !inOrderPositionArea) continue;
+                }
             }
 
             // Skip targets behind a wall
             if (InformationManager::Instance().isBehindEnemyWall(meleeUnit, target)) continue;
         }
 
+		const int priority = getAttackPriority(meleeUnit, target);		// 0..12
+
+		// Let's say that 1 priority step is worth 64 pixels (2 tiles).
+		// We care about unit-target range and target-order position distance.
+		int score = 2 * 32 * priority - range;
+
         // When rushing, prioritize workers that are building something
-        if (StrategyManager::Instance().isRushing() && target->getType().isWorker() && target->isConstructing())
+        if (rushing && targetType.isWorker() && target->isConstructing())
         {
             score += 4 * 32;
         }
@@ -273,13 +301,8 @@ BWAPI::Unit MicroMelee::getTarget(BWAPI::Unit meleeUnit, const BWAPI::Unitset &
 		// Adjust for special features.
 
 		// Prefer targets under dark swarm, on the expectation that then we'll be under it too.
-		if (target->isUnderDarkSwarm())
+		if (targets.underDarkSwarm[i])
 		{
-			if (meleeUnit->getType().isWorker())
-			{
-				// Workers can't hit under dark swarm. Skip this target.
-				continue;
-			}
 			score += 4 * 32;
 		}
 
@@ -293,7 +316,7 @@ BWAPI::Unit MicroMelee::getTarget(BWAPI::Unit meleeUnit, const BWAPI::Unitset &
 		// This could adjust for relative speed and direction, so that we don't chase what we can't catch.
 		if (inWeaponRange)
 		{
-			if (meleeUnit->getType() == BWAPI::UnitTypes::Zerg_Ultralisk)
+			if (meleeType == BWAPI::UnitTypes::Zerg_Ultralisk)
 			{
 				score += 12 * 32;   // because they're big and awkward
 			}
@@ -302,57 +325,43 @@ BWAPI::Unit MicroMelee::getTarget(BWAPI::Unit meleeUnit, const BWAPI::Unitset &
 				score += 4 * 32;
 			}
 		}
-		else if (!target->isMoving())
+		else if (targets.motion[i] == TargetSnapshot::StillSieged)
 		{
-			if (target->isSieged() ||
-				target->getOrder() == BWAPI::Orders::Sieging ||
-				target->getOrder() == BWAPI::Orders::Unsieging)
-			{
-				score += 48;
-			}
-			else
-			{
-				score += 32;
-			}
+			score += 48;
+		}
+		else if (targets.motion[i] == TargetSnapshot::Still)
+		{
+			score += 32;
 		}
-		else if (target->isBraking())
+		else if (targets.motion[i] == TargetSnapshot::Braking)
 		{
 			score += 16;
 		}
-		else if (target->getType().topSpeed() >= meleeUnit->getType().topSpeed())
+		else if (targetType.topSpeed() >= meleeSpeed)
 		{
 			score -= 2 * 32;
 		}
 
-		if (target->isUnderStorm())
+		if (targets.underStorm[i])
 		{
 			score -= 4 * 32;
 		}
 
 		// Prefer targets that are already hurt.
-		if (target->getType().getRace() == BWAPI::Races::Protoss && target->getShields() <= 5)
-		{
-			score += 32;
-            if (target->getHitPoints() < (target->getType().maxHitPoints() / 3))
-            {
-                score += 24;
-            }
-		}
-		else if (target->getHitPoints() < target->getType().maxHitPoints())
-		{
-			score += 24;
-            if (target->getHitPoints() < (target->getType().maxHitPoints() / 3))
-            {
-                score += 24;
-            }
-        }
+		score += targets.hurtBonus[i];
 
         // Avoid defensive matrix
-        if (target->isDefenseMatrixed())
+        if (targets.defenseMatrixed[i])
         {
             score -= 4 * 32;
         }
 
+		// Leave targets that attacks by other units will already kill.
+		if (DamageAssignment::Instance().isOverkill(meleeUnit, target))
+		{
+			score -= DamageAssignment::OverkillPenalty;
+		}
+
 		if (score > bestScore)
 		{
 			bestScore = score;
@@ -2,6 +2,7 @@
 
 #include <Common.h>
 #include "MicroManager.h"
+#include "TargetSnapshot.h"
 
 namespace UAlbertaBot
 {
@@ -9,6 +10,8 @@ class MicroManager;
 
 class MicroMelee : public MicroManager
 {
+	TargetSnapshot		_targets;
+	std::vector<int>	_targetDistances;		// scratch space for getTarget()
 
 public:
 
@@ -19,7 +22,7 @@ public:
 	void assignTargets(const BWAPI::Unitset & targets);
 
 	int getAttackPriority(BWAPI::Unit attacker, BWAPI::Unit unit) const;
-	BWAPI::Unit getTarget(BWAPI::Unit meleeUnit, const BWAPI::Unitset & targets);
+	BWAPI::Unit getTarget(BWAPI::Unit meleeUnit, const TargetSnapshot & targets);
 	bool meleeUnitShouldRetreat(BWAPI::Unit meleeUnit, const BWAPI::Unitset & targets);
 };
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "CombatCommander.h"
 #include "UnitUtil.h"
 #include "BuildingPlacer.h"
+#include "DamageAssignment.h"
 
 const double pi = 3.14159265358979323846;
 
@@ -75,8 +76,8 @@ void MicroRanged::assignTargets(const BWAPI::Unitset & targets)
     Squad & squad = CombatCommander::Instance().getSquadData().getSquad(this);
 
 	// The set of potential targets.
-	BWAPI::Unitset rangedUnitTargets;
-    std::copy_if(targets.begin(), targets.end(), std::inserter(rangedUnitTargets, rangedUnitTargets.end()),
+	FrameVector<BWAPI::Unit> rangedUnitTargets;
+    std::copy_if(targets.begin(), targets.end(), std::back_inserter(rangedUnitTargets),
 		[](BWAPI::Unit u) {
 		return
 			u->isVisible() &&
@@ -92,7 +93,7 @@ void MicroRanged::assignTargets(const BWAPI::Unitset & targets)
 		LocutusWall & wall = BuildingPlacer::Instance().getWall();
 
 		// Populate the set of available tiles inside the wall
-		std::set<std::pair<BWAPI::TilePosition, double>, CompareTiles> availableTilesInside;
+		FrameSet<std::pair<BWAPI::TilePosition, double>, CompareTiles> availableTilesInside;
 		for (const auto& tile : wall.tilesInsideWall)
 			if (!BWEB::Map::Instance().overlapsAnything(tile))
 			{
@@ -102,7 +103,7 @@ void MicroRanged::assignTargets(const BWAPI::Unitset & targets)
 			}
 
 		// Populate the set of available tiles outside the wall
-		std::set<std::pair<BWAPI::TilePosition, double>, CompareTiles> availableTilesOutside;
+		FrameSet<std::pair<BWAPI::TilePosition, double>, CompareTiles> availableTilesOutside;
 		for (const auto& tile : wall.tilesOutsideWall)
 			if (!BWEB::Map::Instance().overlapsAnything(tile))
 			{
@@ -112,8 +113,8 @@ void MicroRanged::assignTargets(const BWAPI::Unitset & targets)
 			}
 
 		// Remove the occupied tiles and populate unit sets
-		std::set<std::pair<BWAPI::Unit, double>> insideUnitsByDistanceToDoor;
-		std::set<std::pair<BWAPI::Unit, double>> outsideUnitsByDistanceToDoor;
+		FrameSet<std::pair<BWAPI::Unit, double>> insideUnitsByDistanceToDoor;
+		FrameSet<std::pair<BWAPI::Unit, double>> outsideUnitsByDistanceToDoor;
 		BWAPI::Position closestTileInside = center(availableTilesInside.begin()->first);
 		BWAPI::Position closestTileOutside = center(availableTilesInside.begin()->first);
 		for (const auto & rangedUnit : rangedUnits)
@@ -187,6 +188,9 @@ void MicroRanged::assignTargets(const BWAPI::Unitset & targets)
 		return;
 	}
 
+	// Read the targets once for all our units.
+	_targets.build(rangedUnitTargets, order.getPosition());
+
     for (const auto rangedUnit : rangedUnits)
 	{
 		if (buildScarabOrInterceptor(rangedUnit))
@@ -232,7 +236,7 @@ void MicroRanged::assignTargets(const BWAPI::Unitset & targets)
 			}
 
 			// If a target is found,
-			BWAPI::Unit target = getTarget(rangedUnit, rangedUnitTargets);
+			BWAPI::Unit target = getTarget(rangedUnit, _targets);
 			if (target)
 			{
 				if (Config::Debug::DrawUnitTargetInfo)
@@ -249,11 +253,15 @@ void MicroRanged::assignTargets(const BWAPI::Unitset & targets)
                 }
 				else if (Config::Micro::KiteWithRangedUnits)
 				{
-					kite(rangedUnit, target);
+					if (kite(rangedUnit, target))
+					{
+						DamageAssignment::Instance().addAttack(rangedUnit, target);
+					}
 				}
 				else
 				{
 					Micro::AttackUnit(rangedUnit, target);
+					DamageAssignment::Instance().addAttack(rangedUnit, target);
 				}
 			}
 			else
@@ -279,31 +287,40 @@ void MicroRanged::assignTargets(const BWAPI::Unitset & targets)
 }
 
 // This can return null if no target is worth attacking.
-BWAPI::Unit MicroRanged::getTarget(BWAPI::Unit rangedUnit, const BWAPI::Unitset & targets)
+BWAPI::Unit MicroRanged::getTarget(BWAPI::Unit rangedUnit, const TargetSnapshot & targets)
 {
 	int bestScore = -999999;
 	BWAPI::Unit bestTarget = nullptr;
 	int bestPriority = -1;   // TODO debug only
 
-	for (const auto target : targets)
+	// Everything about our unit that does not depend on the target.
+	const BWAPI::UnitType rangedType = rangedUnit->getType();
+	const bool darkSwarmOK = goodUnderDarkSwarm(rangedType);
+	const bool rangedFlying = rangedUnit->isFlying();
+	const double rangedSpeed = rangedType.topSpeed();
+	const int rangedGoalDistance = targets.goalDistanceFrom(rangedUnit);
+
+	targets.distancesFrom(rangedUnit, _targetDistances);
+
+	for (int i = 0; i < targets.size(); ++i)
 	{
-		// Skip targets under dark swarm that we can't hit.
-		if (target->isUnderDarkSwarm() && !goodUnderDarkSwarm(rangedUnit->getType()))
+		const int range = _targetDistances[i];							// 0..map diameter in pixels
+
+		// Skip targets that are too far away to worry about--outside tank range.
+		if (range >= 13 * 32)
 		{
 			continue;
 		}
 
-		const int priority = getAttackPriority(rangedUnit, target);		// 0..12
-		const int range = rangedUnit->getDistance(target);				// 0..map diameter in pixels
-		const int closerToGoal =										// positive if target is closer than us to the goal
-			rangedUnit->getDistance(order.getPosition()) - target->getDistance(order.getPosition());
-		
-		// Skip targets that are too far away to worry about--outside tank range.
-		if (range >= 13 * 32)
+		// Skip targets under dark swarm that we can't hit.
+		if (targets.underDarkSwarm[i] && !darkSwarmOK)
 		{
 			continue;
 		}
 
+		const BWAPI::Unit target = targets.unit[i];
+		const BWAPI::UnitType targetType = targets.type[i];
+
         // Skip targets safe behind a wall
         if (range > UnitUtil::GetAttackRange(rangedUnit, target) &&
             InformationManager::Instance().isBehindEnemyWall(rangedUnit, target))
@@ -311,6 +328,10 @@ BWAPI::Unit MicroRanged::getTarget(BWAPI::Unit rangedUnit, const BWAPI::Unitset
             continue;
         }
 
+		const int priority = getAttackPriority(rangedUnit, target);		// 0..12
+		const int closerToGoal =										// positive if target is closer than us to the goal
+			rangedGoalDistance - targets.goalDistance[i];
+
 		// Let's say that 1 priority step is worth 160 pixels (5 tiles).
 		// We care about unit-target range and target-order position distance.
 		int score = 5 * 32 * priority - range;
@@ -323,7 +344,8 @@ BWAPI::Unit MicroRanged::getTarget(BWAPI::Unit rangedUnit, const BWAPI::Unitset
 			score += 2 * 32;
 		}
 
-		const bool isThreat = UnitUtil::CanAttack(target, rangedUnit);   // may include workers as threats
+		const bool isThreat =											// may include workers as threats
+			rangedFlying ? UnitUtil::TypeCanAttackAir(targetType) : UnitUtil::TypeCanAttackGround(targetType);
 		const bool canShootBack = isThreat && target->isInWeaponRange(rangedUnit);
 
 		if (isThreat)
@@ -342,94 +364,80 @@ BWAPI::Unit MicroRanged::getTarget(BWAPI::Unit rangedUnit, const BWAPI::Unitset
 			}
 		}
 		// This could adjust for relative speed and direction, so that we don't chase what we can't catch.
-		else if (!target->isMoving())
+		else if (targets.motion[i] == TargetSnapshot::StillSieged)
 		{
-			if (target->isSieged() ||
-				target->getOrder() == BWAPI::Orders::Sieging ||
-				target->getOrder() == BWAPI::Orders::Unsieging)
-			{
-				score += 48;
-			}
-			else
-			{
-				score += 24;
-			}
+			score += 48;
+		}
+		else if (targets.motion[i] == TargetSnapshot::Still)
+		{
+			score += 24;
 		}
-		else if (target->isBraking())
+		else if (targets.motion[i] == TargetSnapshot::Braking)
 		{
 			score += 16;
 		}
-		else if (target->getType().topSpeed() >= rangedUnit->getType().topSpeed())
+		else if (targetType.topSpeed() >= rangedSpeed)
 		{
 			score -= 4 * 32;
 		}
 		
 		// Prefer targets that are already hurt.
-        if (target->getType().getRace() == BWAPI::Races::Protoss && target->getShields() <= 5)
-        {
-            score += 32;
-            if (target->getHitPoints() < (target->getType().maxHitPoints() / 3))
-            {
-                score += 24;
-            }
-        }
-        else if (target->getHitPoints() < target->getType().maxHitPoints())
-        {
-            score += 24;
-            if (target->getHitPoints() < (target->getType().maxHitPoints() / 3))
-            {
-                score += 24;
-            }
-        }
+		score += targets.hurtBonus[i];
 
         // Avoid defensive matrix
-        if (target->isDefenseMatrixed())
+        if (targets.defenseMatrixed[i])
         {
             score -= 4 * 32;
         }
 
 		// Prefer to hit air units that have acid spores on them from devourers.
-		if (target->getAcidSporeCount() > 0)
+		if (targets.acidSpores[i] > 0)
 		{
 			// Especially if we're a mutalisk with a bounce attack.
-			if (rangedUnit->getType() == BWAPI::UnitTypes::Zerg_Mutalisk)
+			if (rangedType == BWAPI::UnitTypes::Zerg_Mutalisk)
 			{
-				score += 16 * target->getAcidSporeCount();
+				score += 16 * targets.acidSpores[i];
 			}
 			else
 			{
-				score += 8 * target->getAcidSporeCount();
+				score += 8 * targets.acidSpores[i];
 			}
 		}
 
 		// Take the damage type into account.
-		BWAPI::DamageType damage = UnitUtil::GetWeapon(rangedUnit, target).damageType();
+		BWAPI::DamageType damage = UnitUtil::GetWeapon(rangedType, target).damageType();
 		if (damage == BWAPI::DamageTypes::Explosive)
 		{
-			if (target->getType().size() == BWAPI::UnitSizeTypes::Large)
+			if (targetType.size() == BWAPI::UnitSizeTypes::Large)
 			{
 				score += 32;
 			}
 		}
 		else if (damage == BWAPI::DamageTypes::Concussive)
 		{
-			if (target->getType().size() == BWAPI::UnitSizeTypes::Small)
+			if (targetType.size() == BWAPI::UnitSizeTypes::Small)
 			{
 				score += 32;
 			}
-			else if (target->getType().size() == BWAPI::UnitSizeTypes::Large)
+			else if (targetType.size() == BWAPI::UnitSizeTypes::Large)
 			{
 				score -= 32;
 			}
 		}
 
         // For wall buildings, prefer the ones with lower health
-        if (InformationManager::Instance().isEnemyWallBuilding(target) &&
-            target->getType() == BWAPI::UnitTypes::Terran_Supply_Depot)
+        if (targetType == BWAPI::UnitTypes::Terran_Supply_Depot &&
+            InformationManager::Instance().isEnemyWallBuilding(target))
         {
             score += 128;
         }
 
+		// Leave targets that attacks by other units will already kill.
+		if (DamageAssignment::Instance().isOverkill(rangedUnit, target))
+		{
+			score -= DamageAssignment::OverkillPenalty;
+		}
+
 		if (score > bestScore)
 		{
 			bestScore = score;
@@ -702,18 +710,20 @@ int MicroRanged::getAttackPriority(BWAPI::Unit rangedUnit, BWAPI::Unit target)
 	return 1;
 }
 
-void MicroRanged::kite(BWAPI::Unit rangedUnit, BWAPI::Unit target)
+// Kite the target, or attack it when kiting does not pay.
+// Returns whether an attack command was given.
+bool MicroRanged::kite(BWAPI::Unit rangedUnit, BWAPI::Unit target)
 {
     // If the unit is still in its attack animation, don't touch it
     if (!InformationManager::Instance().getLocutusUnit(rangedUnit).isReady())
-        return;
+        return false;
 
     // If the unit can't move, don't kite
     double speed = rangedUnit->getType().topSpeed();
     if (speed < 0.001)
     {
         Micro::AttackUnit(rangedUnit, target);
-        return;
+        return true;
     }
 
     // Our unit range
@@ -732,14 +742,14 @@ void MicroRanged::kite(BWAPI::Unit rangedUnit, BWAPI::Unit target)
     if (cooldown <= framesToFiringRange)
     {
         Micro::AttackUnit(rangedUnit, target);
-        return;
+        return true;
     }
 
     // If the target is behind a wall, don't kite
     if (InformationManager::Instance().isBehindEnemyWall(rangedUnit, target))
     {
         Micro::AttackUnit(rangedUnit, target);
-        return;
+        return true;
     }
 
     // Compute target unit range
@@ -851,22 +861,20 @@ void MicroRanged::kite(BWAPI::Unit rangedUnit, BWAPI::Unit target)
         if (distToTarget > 16)
         {
             InformationManager::Instance().getLocutusUnit(rangedUnit).moveTo(target->getPosition());
-        }
-        else
-        {
-            Micro::AttackUnit(rangedUnit, target);
+            return false;
         }
 
-        return;
+        Micro::AttackUnit(rangedUnit, target);
+        return true;
     }
 
     // Execute kite
     if (kite)
     {
         InformationManager::Instance().getLocutusUnit(rangedUnit).fleeFrom(target->getPosition());
+        return false;
     }
-    else
-    {
-        Micro::AttackUnit(rangedUnit, target);
-    }
+
+    Micro::AttackUnit(rangedUnit, target);
+    return true;
 }
@@ -2,6 +2,7 @@
 
 #include <Common.h>
 #include "MicroManager.h"
+#include "TargetSnapshot.h"
 
 namespace UAlbertaBot
 {
@@ -12,7 +13,13 @@ private:
 	// Ranged ground weapon does splash damage, so it works under dark swarm.
 	bool goodUnderDarkSwarm(BWAPI::UnitType type);
 
-    void kite(BWAPI::Unit rangedUnit, BWAPI::Unit target);
+    bool kite(BWAPI::Unit rangedUnit, BWAPI::Unit target);
+
+	std::vector<int>	_targetDistances;		// scratch space for getTarget()
+
+protected:
+
+	TargetSnapshot		_targets;
 
 public:
 
@@ -23,6 +30,6 @@ public:
 	void assignTargets(const BWAPI::Unitset & targets);
 
 	int getAttackPriority(BWAPI::Unit rangedUnit, BWAPI::Unit target);
-	BWAPI::Unit getTarget(BWAPI::Unit rangedUnit, const BWAPI::Unitset & targets);
+	BWAPI::Unit getTarget(BWAPI::Unit rangedUnit, const TargetSnapshot & targets);
 };
 }
\ No newline at end of file
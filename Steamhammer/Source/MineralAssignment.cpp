@@ -0,0 +1,203 @@
+#include "MineralAssignment.h"
+
+#include <limits>
+
+using namespace UAlbertaBot;
+
+namespace
+{
+	// The timings are rough. They only rank patches and moves against each other; BOSS plans with
+	// the income that WorkerManager measures.
+	const int MineralsPerLoad = 8;
+	const int MiningFrames = 80;			// approximate time a worker spends at the patch
+	const int TurnaroundFrames = 20;		// approximate time lost to stopping and turning at each end
+	const int ResendFrames = 10;			// approximate time lost when a worker is sent to another patch
+	const int HorizonFrames = 24 * 60;		// how far ahead income is weighed against the cost of moving workers
+
+	// Min-cost assignment of rows to distinct columns, with rows <= cols (Hungarian algorithm).
+	// cost is row-major. Returns the column assigned to each row.
+	std::vector<int> minCostAssignment(const std::vector<double> & cost, int rows, int cols)
+	{
+		const double inf = (std::numeric_limits<double>::max)();
+
+		// Potentials and matching are 1-based; column 0 is a sentinel.
+		std::vector<double> u(rows + 1, 0.0);
+		std::vector<double> v(cols + 1, 0.0);
+		std::vector<int> rowOfCol(cols + 1, 0);
+		std::vector<int> way(cols + 1, 0);
+
+		for (int row = 1; row <= rows; ++row)
+		{
+			rowOfCol[0] = row;
+			int col0 = 0;
+			std::vector<double> minv(cols + 1, inf);
+			std::vector<bool> used(cols + 1, false);
+			do
+			{
+				used[col0] = true;
+				int row0 = rowOfCol[col0];
+				int col1 = 0;
+				double delta = inf;
+				for (int col = 1; col <= cols; ++col)
+				{
+					if (used[col]) continue;
+					double cur = cost[(row0 - 1) * cols + col - 1] - u[row0] - v[col];
+					if (cur < minv[col])
+					{
+						minv[col] = cur;
+						way[col] = col0;
+					}
+					if (minv[col] < delta)
+					{
+						delta = minv[col];
+						col1 = col;
+					}
+				}
+				for (int col = 0; col <= cols; ++col)
+				{
+					if (used[col])
+					{
+						u[rowOfCol[col]] += delta;
+						v[col] -= delta;
+					}
+					else
+					{
+						minv[col] -= delta;
+					}
+				}
+				col0 = col1;
+			} while (rowOfCol[col0] != 0);
+
+			do
+			{
+				int col1 = way[col0];
+				rowOfCol[col0] = rowOfCol[col1];
+				col0 = col1;
+			} while (col0 != 0);
+		}
+
+		std::vector<int> result(rows, -1);
+		for (int col = 1; col <= cols; ++col)
+		{
+			if (rowOfCol[col] != 0) result[rowOfCol[col] - 1] = col - 1;
+		}
+		return result;
+	}
+
+	double workerSpeed()
+	{
+		return BWAPI::Broodwar->self()->getRace().getWorker().topSpeed();
+	}
+}
+
+MineralAssignment::MineralAssignment(BWAPI::Unit depot)
+	: _depot(depot)
+	, _dirty(true)
+{
+}
+
+// A patch is busy for MiningFrames of each trip, so extra workers past trip / MiningFrames only wait.
+double MineralAssignment::income(int tripFrames, int workers)
+{
+	if (workers <= 0 || tripFrames <= 0) return 0.0;
+
+	return double(MineralsPerLoad) * (std::min)(double(workers) / tripFrames, 1.0 / MiningFrames);
+}
+
+const MineralAssignment::Patch * MineralAssignment::getPatch(BWAPI::Unit patch) const
+{
+	for (const Patch & p : _patches)
+	{
+		if (p.unit == patch) return &p;
+	}
+	return nullptr;
+}
+
+// Income lost by moving a worker from one of our patches to another.
+double MineralAssignment::moveCost(BWAPI::Unit from, const Patch & to) const
+{
+	if (!from || from == to.unit || !getPatch(from)) return 0.0;
+
+	double framesLost = from->getDistance(to.unit) / workerSpeed() + ResendFrames;
+	return framesLost * MineralsPerLoad / to.tripFrames;
+}
+
+void MineralAssignment::setPatches(const BWAPI::Unitset & patches)
+{
+	bool same = patches.size() == _patches.size();
+	for (const Patch & p : _patches)
+	{
+		if (!same) break;
+		same = patches.contains(p.unit);
+	}
+	if (same) return;
+
+	_patches.clear();
+	double speed = workerSpeed();
+	for (const auto patch : patches)
+	{
+		int tripFrames = MiningFrames + TurnaroundFrames + int(2.0 * patch->getDistance(_depot) / speed + 0.5);
+		_patches.push_back(Patch{ patch, tripFrames });
+	}
+
+	_dirty = true;
+}
+
+bool MineralAssignment::isDirty() const
+{
+	if (_dirty) return true;
+
+	for (const Patch & p : _patches)
+	{
+		if (!p.unit->exists()) return true;
+	}
+	return false;
+}
+
+void MineralAssignment::solve(const std::vector<BWAPI::Unit> & workers, std::vector<BWAPI::Unit> & patchOf)
+{
+	_dirty = false;
+
+	if (workers.empty() || _patches.empty()) return;
+
+	// Each patch offers slots for its 1st, 2nd, ... worker. The value of a slot is the income it adds.
+	// Patches rarely want more than 3 workers, but every worker must get a slot.
+	const int nWorkers = workers.size();
+	const int nPatches = _patches.size();
+	const int slotsPerPatch = (std::min)(nWorkers, (std::max)(3, (nWorkers + nPatches - 1) / nPatches));
+
+	std::vector<int> slotPatch;
+	std::vector<double> slotGain;
+	double bestGain = 0.0;
+	for (int i = 0; i < nPatches; ++i)
+	{
+		for (int k = 1; k <= slotsPerPatch; ++k)
+		{
+			double gain = income(_patches[i].tripFrames, k) - income(_patches[i].tripFrames, k - 1);
+			slotPatch.push_back(i);
+			slotGain.push_back(gain);
+			bestGain = (std::max)(bestGain, gain);
+		}
+	}
+
+	// Cost of putting a worker in a slot: the income the slot gives up against the best slot,
+	// plus the income lost while the worker moves there from its current patch.
+	// Since later slots of a patch are never worth more, a patch's workers fill its slots in order.
+	const int nSlots = slotPatch.size();
+	std::vector<double> cost(nWorkers * nSlots);
+	for (int w = 0; w < nWorkers; ++w)
+	{
+		for (int s = 0; s < nSlots; ++s)
+		{
+			const Patch & patch = _patches[slotPatch[s]];
+			cost[w * nSlots + s] = (bestGain - slotGain[s]) * HorizonFrames + moveCost(patchOf[w], patch);
+		}
+	}
+
+	std::vector<int> slotOf = minCostAssignment(cost, nWorkers, nSlots);
+
+	for (int w = 0; w < nWorkers; ++w)
+	{
+		patchOf[w] = _patches[slotPatch[slotOf[w]]].unit;
+	}
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Common.h"
+
+// Assigns the mineral workers of one base to its mineral patches.
+// Each patch has an estimated round trip time, and a patch can only be mined by one worker at a time,
+// so the income from a patch grows with its workers until the patch is busy all the time.
+// The assignment is solved as a min-cost matching of workers to patch slots, re-solved only when
+// the workers or patches of the base change.
+
+namespace UAlbertaBot
+{
+
+class MineralAssignment
+{
+	struct Patch
+	{
+		BWAPI::Unit	unit;
+		int			tripFrames;		// frames for one worker to mine a load and bring it back
+	};
+
+	BWAPI::Unit			_depot;
+	std::vector<Patch>	_patches;
+	bool				_dirty;
+
+	const Patch *	getPatch(BWAPI::Unit patch) const;
+	double			moveCost(BWAPI::Unit from, const Patch & to) const;
+
+public:
+
+	MineralAssignment(BWAPI::Unit depot);
+
+	// Minerals per frame gathered from a patch with the given round trip time and number of workers
+	static double	income(int tripFrames, int workers);
+
+	void			setPatches(const BWAPI::Unitset & patches);
+	void			setDirty() { _dirty = true; };
+	bool			isDirty() const;
+
+	// The patch that adds the most income for one more worker.
+	// workersOn(patch) gives the number of workers already on the patch.
+	template<class CountFunc>
+	BWAPI::Unit choosePatch(CountFunc workersOn) const
+	{
+		BWAPI::Unit best = nullptr;
+		double bestGain = -1.0;
+		int bestDist = 0;
+		for (const Patch & patch : _patches)
+		{
+			int n = workersOn(patch.unit);
+			double gain = income(patch.tripFrames, n + 1) - income(patch.tripFrames, n);
+			int dist = patch.unit->getDistance(_depot);
+			if (gain > bestGain + 1e-9 || gain > bestGain - 1e-9 && dist < bestDist)
+			{
+				best = patch.unit;
+				bestGain = gain;
+				bestDist = dist;
+			}
+		}
+		return best;
+	};
+
+	// Re-solve the assignment. On entry patchOf holds each worker's current patch (or nullptr),
+	// on exit the patch it should mine.
+	void			solve(const std::vector<BWAPI::Unit> & workers, std::vector<BWAPI::Unit> & patchOf);
+};
+
+}
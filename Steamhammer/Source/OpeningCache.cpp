@@ -0,0 +1,194 @@
+#include "OpeningCache.h"
+
+#include <fstream>
+
+using namespace UAlbertaBot;
+
+namespace OpeningCache
+{
+    namespace
+    {
+        // Bump this whenever the file layout or the way openings are parsed changes
+        const int CACHE_FILE_VERSION = 1;
+        const char CACHE_FILE_MAGIC[4] = { 'L', 'O', 'P', 'C' };
+
+        std::string cacheFilename(const std::string & dir)
+        {
+            return dir + "openings.bin";
+        }
+
+        // Simple binary readers and writers, as in MapAnalysisCache
+
+        template<typename T>
+        void writeValue(std::ostream & out, T value)
+        {
+            out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+        template<typename T>
+        T readValue(std::istream & in)
+        {
+            T value;
+            in.read(reinterpret_cast<char *>(&value), sizeof(T));
+            if (!in) throw std::runtime_error("unexpected end of file");
+            return value;
+        }
+
+        void writeString(std::ostream & out, const std::string & s)
+        {
+            writeValue<int>(out, s.size());
+            out.write(s.data(), s.size());
+        }
+
+        std::string readString(std::istream & in)
+        {
+            int length = readValue<int>(in);
+            if (length < 0 || length > 4096) throw std::runtime_error("bad string length");
+            std::string s(length, ' ');
+            in.read(&s[0], length);
+            if (!in) throw std::runtime_error("unexpected end of file");
+            return s;
+        }
+
+        // Only what a MacroAct parsed from the config file can hold.
+        void writeAct(std::ostream & out, const MacroAct & act)
+        {
+            writeValue<int>(out, act.type());
+            if (act.isUnit())
+            {
+                writeValue<int>(out, act.getUnitType().getID());
+                writeValue<int>(out, int(act.getMacroLocation()));
+            }
+            else if (act.isTech())
+            {
+                writeValue<int>(out, act.getTechType().getID());
+            }
+            else if (act.isUpgrade())
+            {
+                writeValue<int>(out, act.getUpgradeType().getID());
+            }
+            else if (act.isCommand())
+            {
+                writeValue<int>(out, int(act.getCommandType().getType()));
+                writeValue<int>(out, act.getCommandType().getAmount());
+            }
+
+            writeValue<char>(out, act.hasThen() ? 1 : 0);
+            if (act.hasThen()) writeAct(out, act.getThen());
+        }
+
+        MacroAct readAct(std::istream & in)
+        {
+            MacroAct act;
+            int type = readValue<int>(in);
+            if (type == MacroActs::Unit)
+            {
+                BWAPI::UnitType unitType(readValue<int>(in));
+                act = MacroAct(unitType, MacroLocation(readValue<int>(in)));
+            }
+            else if (type == MacroActs::Tech)
+            {
+                act = MacroAct(BWAPI::TechType(readValue<int>(in)));
+            }
+            else if (type == MacroActs::Upgrade)
+            {
+                act = MacroAct(BWAPI::UpgradeType(readValue<int>(in)));
+            }
+            else if (type == MacroActs::Command)
+            {
+                MacroCommandType commandType = MacroCommandType(readValue<int>(in));
+                int amount = readValue<int>(in);
+                act = MacroCommand::hasArgument(commandType) ? MacroAct(commandType, amount) : MacroAct(commandType);
+            }
+            else
+            {
+                throw std::runtime_error("bad macro act type");
+            }
+
+            if (readValue<char>(in) != 0)
+            {
+                MacroAct then = readAct(in);
+                act.setThen(then);
+            }
+            return act;
+        }
+
+        bool readFile(const std::string & filename, unsigned long long configHash, std::vector<Strategy> & openings)
+        {
+            std::ifstream file(filename, std::ios::binary);
+            if (!file.good()) return false;
+
+            try
+            {
+                char magic[4];
+                file.read(magic, 4);
+                if (!file || !std::equal(magic, magic + 4, CACHE_FILE_MAGIC)) return false;
+                if (readValue<int>(file) != CACHE_FILE_VERSION) return false;
+                if (readValue<unsigned long long>(file) != configHash) return false;
+
+                int openingCount = readValue<int>(file);
+                for (int i = 0; i < openingCount; i++)
+                {
+                    std::string name = readString(file);
+                    BWAPI::Race race(readValue<int>(file));
+                    std::string openingGroup = readString(file);
+
+                    BuildOrder buildOrder(race);
+                    int actCount = readValue<int>(file);
+                    for (int j = 0; j < actCount; j++) buildOrder.add(readAct(file));
+
+                    openings.push_back(Strategy(name, race, openingGroup, buildOrder));
+                }
+
+                Log().Get() << "Read opening cache " << filename << " with " << openingCount << " openings";
+                return true;
+            }
+            catch (std::exception & ex)
+            {
+                Log().Get() << "Exception caught reading opening cache " << filename << ": " << ex.what();
+            }
+
+            openings.clear();
+            return false;
+        }
+    }
+
+    // 64-bit FNV-1a.
+    unsigned long long hash(const std::string & config)
+    {
+        unsigned long long h = 14695981039346656037ULL;
+        for (const char c : config)
+        {
+            h = (h ^ (unsigned char)(c)) * 1099511628211ULL;
+        }
+        return h;
+    }
+
+    bool read(unsigned long long configHash, std::vector<Strategy> & openings)
+    {
+        return
+            readFile(cacheFilename(Config::IO::ReadDir), configHash, openings) ||
+            readFile(cacheFilename(Config::IO::WriteDir), configHash, openings);
+    }
+
+    void write(unsigned long long configHash, const std::vector<Strategy> & openings)
+    {
+        std::ofstream file(cacheFilename(Config::IO::WriteDir), std::ios::binary | std::ios::trunc);
+        if (!file.good()) return;
+
+        file.write(CACHE_FILE_MAGIC, 4);
+        writeValue<int>(file, CACHE_FILE_VERSION);
+        writeValue<unsigned long long>(file, configHash);
+
+        writeValue<int>(file, openings.size());
+        for (const Strategy & opening : openings)
+        {
+            writeString(file, opening._name);
+            writeValue<int>(file, opening._race.getID());
+            writeString(file, opening._openingGroup);
+
+            writeValue<int>(file, opening._buildOrder.size());
+            for (size_t i = 0; i < opening._buildOrder.size(); i++) writeAct(file, opening._buildOrder[i]);
+        }
+    }
+}
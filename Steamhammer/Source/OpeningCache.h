@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Common.h"
+#include "StrategyManager.h"
+
+// Persistent cache of the openings from the config file, already resolved into MacroActs, so later games
+// can skip turning every build order item string into a MacroAct at startup.
+// The cache is a versioned binary file keyed by a hash of the config file text, so any edit to the config
+// file makes it stale. It is read from the read directory or the write directory, and written to the
+// write directory whenever the openings had to be parsed.
+namespace OpeningCache
+{
+    // Hash of the config file text, computed before parsing it.
+    unsigned long long hash(const std::string & config);
+
+    // Gets the openings of every race, returning false if there is no cache made from this config file.
+    bool read(unsigned long long configHash, std::vector<UAlbertaBot::Strategy> & openings);
+
+    void write(unsigned long long configHash, const std::vector<UAlbertaBot::Strategy> & openings);
+}
@@ -2,8 +2,28 @@
 #include "OpponentModel.h"
 #include "Random.h"
 
+#include <iterator>
+
 using namespace UAlbertaBot;
 
+namespace
+{
+	// Binary opponent model file: the magic string, the format version, then the game records
+	// in order from oldest to newest. Each record is its length in bytes followed by the record
+	// from GameRecord::writeBinary(). The length prefixes let us find, skip, or copy records
+	// without decoding them, and new records are appended to the end.
+	const std::string BinaryFileMagic = "LOMB";
+	const int BinaryFileVersion = 1;
+
+	void appendBinaryRecord(std::string & output, GameRecord & record)
+	{
+		std::string bytes;
+		record.writeBinary(bytes);
+		GameRecord::putNumber(output, int(bytes.size()));
+		output += bytes;
+	}
+}
+
 OpeningPlan OpponentModel::predictEnemyPlan() const
 {
 	struct PlanInfo
@@ -44,7 +64,7 @@ OpeningPlan OpponentModel::predictEnemyPlan() const
         for (auto & win : plan.second.playedAfterLoss)
             log << "\n" << OpeningPlanString(win.first) << ": " << win.second;
     }
-    Log().Debug() << log.str();
+    LOG_DEBUG << log.str();
 
     // Step 2: predict most likely plan based on what happened in the last game
     OpeningPlan expectedEnemyPlan = OpeningPlan::Unknown;
@@ -87,7 +107,7 @@ OpeningPlan OpponentModel::predictEnemyPlan() const
         break;
     }
 
-    Log().Debug() << "Decided on " << OpeningPlanString(expectedEnemyPlan);
+    LOG_DEBUG << "Decided on " << OpeningPlanString(expectedEnemyPlan);
 
 	return expectedEnemyPlan;
 }
@@ -447,23 +467,80 @@ void OpponentModel::considerGasSteal()
 	_recommendGasSteal = stealUCB > plainUCB;
 }
 
+// Collect the past game records in the same matchup that have snapshots to compare,
+// in order of their distance on map and opening.
+// The enemy race may become known and the opening may be set after the start of the game,
+// so rebuild the index when either changes.
+void OpponentModel::indexMatchCandidates()
+{
+	_matchCandidates.clear();
+	_matchCandidatesEnemyRace = _gameRecord.getEnemyRace();
+	_matchCandidatesOpening = _gameRecord.getOpeningName();
+
+	for (size_t i = 0; i < _pastGameRecords.size(); ++i)
+	{
+		GameRecord * record = _pastGameRecords[i];
+		if (record->getOurRace() == _gameRecord.getOurRace() &&
+			record->getEnemyRace() == _gameRecord.getEnemyRace() &&
+			record->getNumSnapshots() > 0)
+		{
+			_matchCandidates.push_back(MatchCandidate{ record, int(i), _gameRecord.mapOpeningDistance(*record), 0, 0 });
+		}
+	}
+
+	std::stable_sort(_matchCandidates.begin(), _matchCandidates.end(),
+		[](const MatchCandidate & a, const MatchCandidate & b) { return a.baseDistance < b.baseDistance; });
+}
+
 // Find the past game record which best matches the current game and remember it.
+// This gives the same result as taking the record with the least _gameRecord.distance(),
+// the first one in case of ties, but only compares snapshots that are new since the last call,
+// and skips records that cannot beat the best so far.
 void OpponentModel::setBestMatch()
 {
+	if (_matchCandidatesEnemyRace != _gameRecord.getEnemyRace() ||
+		_matchCandidatesOpening != _gameRecord.getOpeningName())
+	{
+		indexMatchCandidates();
+	}
+
+	const int nSnapshots = _gameRecord.getNumSnapshots();
+
 	int bestScore = -1;
-	GameRecord * bestRecord = nullptr;
+	const MatchCandidate * best = nullptr;
 
-	for (GameRecord * record : _pastGameRecords)
+	for (MatchCandidate & candidate : _matchCandidates)
 	{
-		int score = _gameRecord.distance(*record);
-		if (score != -1 && (!bestRecord || score < bestScore))
+		// The distance so far is a lower bound; comparing more snapshots can only add to it.
+		if (best && candidate.baseDistance > bestScore)
+		{
+			break;
+		}
+		if (best && candidate.baseDistance + candidate.snapshotDistance > bestScore)
+		{
+			continue;
+		}
+
+		const int n = (std::min)(nSnapshots, candidate.record->getNumSnapshots());
+		if (!candidate.record->coversNow(n))
+		{
+			continue;
+		}
+
+		for (; candidate.nCompared < n; ++candidate.nCompared)
+		{
+			candidate.snapshotDistance += _gameRecord.snapshotDistance(candidate.nCompared, *candidate.record);
+		}
+
+		const int score = candidate.baseDistance + candidate.snapshotDistance;
+		if (!best || score < bestScore || score == bestScore && candidate.index < best->index)
 		{
 			bestScore = score;
-			bestRecord = record;
+			best = &candidate;
 		}
 	}
 
-	_bestMatch = bestRecord;
+	_bestMatch = best ? best->record : nullptr;
 }
 
 // We expect the enemy to follow the given opening plan.
@@ -483,6 +560,8 @@ std::string OpponentModel::getOpeningForEnemyPlan(OpeningPlan enemyPlan)
 
 OpponentModel::OpponentModel()
 	: _bestMatch(nullptr)
+	, _matchCandidatesEnemyRace(BWAPI::Races::None)
+	, _binaryRecordsComplete(false)
 	, _singleStrategy(false)
 	, _initialExpectedEnemyPlan(OpeningPlan::Unknown)
 	, _expectedEnemyPlan(OpeningPlan::Unknown)
@@ -494,6 +573,7 @@ OpponentModel::OpponentModel()
 	, _pylonHarassBehaviour(0)
 {
 	_filename = "om_" + InformationManager::Instance().getEnemyName() + ".txt";
+	_binaryFilename = "om_" + InformationManager::Instance().getEnemyName() + ".bin";
 }
 
 void OpponentModel::readFile(std::string filename)
@@ -524,20 +604,110 @@ void OpponentModel::readFile(std::string filename)
     inFile.close();
 }
 
+// Read past game records from a binary opponent model file.
+// Return false if there is no such file, or it is not in a format we know.
+bool OpponentModel::readBinaryFile(const std::string & filename)
+{
+	// Forget any file read before, so that records of two files are never mixed.
+	_binaryReadPath.clear();
+	_binaryRecords.clear();
+	_binaryRecordOffsets.clear();
+	_binaryRecordsComplete = false;
+
+	std::ifstream inFile(filename, std::ios::binary);
+	if (!inFile.is_open())
+	{
+		return false;
+	}
+
+	// Read the whole file with one call and decode the records from memory.
+	std::string bytes((std::istreambuf_iterator<char>(inFile)), std::istreambuf_iterator<char>());
+	inFile.close();
+
+	if (bytes.compare(0, BinaryFileMagic.size(), BinaryFileMagic) != 0)
+	{
+		Log().Get() << "Opponent model file " << filename << " is not in the binary format; it will be overwritten at the end of the game";
+		return false;
+	}
+
+	const char * data = bytes.data() + BinaryFileMagic.size();
+	const char * end = bytes.data() + bytes.size();
+	const char * recordsBegin = nullptr;
+	const char * recordsEnd = nullptr;          // end of the last complete record
+	try
+	{
+		const int version = GameRecord::getNumber(data, end);
+		if (version != BinaryFileVersion)
+		{
+			Log().Get() << "Opponent model file " << filename << " has unknown version " << version << "; it will be overwritten at the end of the game";
+			return false;
+		}
+		recordsBegin = recordsEnd = data;
+
+		while (data != end)
+		{
+			const int length = GameRecord::getNumber(data, end);
+			if (end - data < length)
+			{
+				break;
+			}
+
+			// NOTE We allocate records here and never free them if valid.
+			//      Their lifetime is the whole game.
+			GameRecord * record = new GameRecord(data, data + length);
+			if (record->isValid())
+			{
+				_pastGameRecords.push_back(record);
+			}
+			else
+			{
+				delete record;
+			}
+
+			_binaryRecordOffsets.push_back(recordsEnd - recordsBegin);
+			data += length;
+			recordsEnd = data;
+		}
+	}
+	catch (const game_record_read_error &)
+	{
+		// The file ends partway through a number. Keep any complete records.
+		if (!recordsBegin)
+		{
+			Log().Get() << "Opponent model file " << filename << " ends before its version; it will be overwritten at the end of the game";
+			return false;
+		}
+	}
+
+	_binaryReadPath = filename;
+	_binaryRecords.assign(recordsBegin, recordsEnd);
+	_binaryRecordsComplete = recordsEnd == end;
+	return true;
+}
+
+// Read past game records from the given directory, preferring the binary file.
+void OpponentModel::readFiles(const std::string & directory)
+{
+	if (!readBinaryFile(directory + _binaryFilename))
+	{
+		readFile(directory + _filename);
+	}
+}
+
 // Read past game records from the opponent model file, and do initial analysis.
 void OpponentModel::read()
 {
 	if (Config::IO::ReadOpponentModel)
 	{
         // Usually the data is in the read directory
-        readFile(Config::IO::ReadDir + _filename);
+        readFiles(Config::IO::ReadDir);
 
         // For tournaments, we might not have access to put pre-trained data into the read directory
         // So if we don't have any data, check if there is anything in the AI directory
         // We will write out the entire data set at the end of the game, so we only have to do this once
         if (_pastGameRecords.empty())
         {
-            readFile(Config::IO::AIDir + _filename);
+            readFiles(Config::IO::AIDir);
         }
 	}
 
@@ -733,38 +903,77 @@ void OpponentModel::write()
 {
 	if (Config::IO::WriteOpponentModel)
 	{
-		std::ofstream outFile(Config::IO::WriteDir + _filename, std::ios::trunc);
+		const std::string filename = Config::IO::WriteDir + _binaryFilename;
+		const bool fromBinary = !_binaryReadPath.empty();
 
-		// If it fails, there's not much we can do about it.
-		if (outFile.bad())
+		// The number of initial game records to skip over without rewriting.
+		// In normal operation, nToSkip is 0 or 1.
+		const int nRecords = fromBinary ? int(_binaryRecordOffsets.size()) : int(_pastGameRecords.size());
+		int nToSkip = 0;
+		if (nRecords >= Config::IO::MaxGameRecords)
 		{
+			nToSkip = nRecords - Config::IO::MaxGameRecords + 1;
+		}
+
+		std::string newRecord;
+		appendBinaryRecord(newRecord, _gameRecord);
+
+		// If we read the same file we are writing and nothing is dropped, only append this game.
+		if (fromBinary && _binaryReadPath == filename && nToSkip == 0 && _binaryRecordsComplete)
+		{
+			std::ofstream outFile(filename, std::ios::binary | std::ios::app);
+			if (outFile.bad())
+			{
+				return;
+			}
+			outFile.write(newRecord.data(), newRecord.size());
+			outFile.close();
 			return;
 		}
 
-		// The number of initial game records to skip over without rewriting.
-		// In normal operation, nToSkip is 0 or 1.
-		int nToSkip = 0;
-		if (int(_pastGameRecords.size()) >= Config::IO::MaxGameRecords)
+		std::ofstream outFile(filename, std::ios::binary | std::ios::trunc);
+
+		// If it fails, there's not much we can do about it.
+		if (outFile.bad())
 		{
-			nToSkip = _pastGameRecords.size() - Config::IO::MaxGameRecords + 1;
+			return;
 		}
 
+		std::string header = BinaryFileMagic;
+		GameRecord::putNumber(header, BinaryFileVersion);
+		outFile.write(header.data(), header.size());
+
 		// Rewrite any old records that were read in.
 		// Not needed for local testing or for SSCAIT, necessary for other competitions.
-		for (auto record : _pastGameRecords)
+		if (fromBinary)
 		{
-			if (nToSkip > 0)
+			// Copy the bytes as read, starting from the first record we keep.
+			if (nToSkip < nRecords)
 			{
-				--nToSkip;
+				const size_t start = _binaryRecordOffsets[nToSkip];
+				outFile.write(_binaryRecords.data() + start, _binaryRecords.size() - start);
 			}
-			else
+		}
+		else
+		{
+			// Convert records read from a text file.
+			std::string records;
+			for (auto record : _pastGameRecords)
 			{
-				record->write(outFile);
+				if (nToSkip > 0)
+				{
+					--nToSkip;
+				}
+				else
+				{
+					appendBinaryRecord(records, *record);
+				}
 			}
+			outFile.write(records.data(), records.size());
 		}
 
 		// And write the record of this game.
-		_gameRecord.write(outFile);
+		outFile.write(newRecord.data(), newRecord.size());
 
 		outFile.close();
 	}
@@ -779,24 +988,28 @@ void OpponentModel::update()
 	{
 		_gameRecord.update();
 
-		// TODO the rest is turned off for now, not currently useful
-		return;
-
-		if (BWAPI::Broodwar->getFrameCount() % 32 == 31)
+		if (Config::Debug::DrawStrategyBossInfo)
 		{
-			setBestMatch();
+			if (_bestMatch)
+			{
+				//_bestMatch->debugLog();
+				//BWAPI::Broodwar->drawTextScreen(200, 10, "%cmatch %s %s", white, _bestMatch->mapName, _bestMatch->openingName);
+				BWAPI::Broodwar->drawTextScreen(220, 6, "%cmatch", white);
+			}
+			else
+			{
+				BWAPI::Broodwar->drawTextScreen(220, 6, "%cno best match", white);
+			}
 		}
+	}
+}
 
-		if (_bestMatch)
-		{
-			//_bestMatch->debugLog();
-			//BWAPI::Broodwar->drawTextScreen(200, 10, "%cmatch %s %s", white, _bestMatch->mapName, _bestMatch->openingName);
-			BWAPI::Broodwar->drawTextScreen(220, 6, "%cmatch", white);
-		}
-		else
-		{
-			BWAPI::Broodwar->drawTextScreen(220, 6, "%cno best match", white);
-		}
+// Find the best-matching past game. The frame scheduler calls this every 32 frames or so.
+void OpponentModel::updateBestMatch()
+{
+	if (Config::IO::ReadOpponentModel || Config::IO::WriteOpponentModel)
+	{
+		setBestMatch();
 	}
 }
 
@@ -935,7 +1148,7 @@ std::map<std::string, double> OpponentModel::getStrategyWeightFactors() const
         }
     }
 
-    Log().Debug() << log.str();
+    LOG_DEBUG << log.str();
 
 	return result;
 }
@@ -23,12 +23,36 @@ namespace UAlbertaBot
 
 		OpponentPlan _planRecognizer;
 
-		std::string _filename;
+		std::string _filename;					// text format, read only, to convert old files
+		std::string _binaryFilename;
+
+		// The binary file that the past game records were read from, if any, and its records
+		// as read. At the end of the game the records are copied or appended to, not re-encoded.
+		std::string _binaryReadPath;
+		std::string _binaryRecords;
+		std::vector<size_t> _binaryRecordOffsets;	// start of each record in _binaryRecords
+		bool _binaryRecordsComplete;				// false if the file ended partway through a record
 		GameRecord _gameRecord;
 		std::vector<GameRecord *> _pastGameRecords;
 
 		GameRecord * _bestMatch;
 
+		// Past game records that can be compared with this game, for the best-match search.
+		// Records are in order of their distance on map and opening, which does not change
+		// during the game, so that the search can stop early. The distance over the snapshots
+		// compared so far is kept, since past snapshots do not change either.
+		struct MatchCandidate
+		{
+			GameRecord *	record;
+			int				index;				// in _pastGameRecords, to break ties in file order
+			int				baseDistance;		// from map and opening
+			int				snapshotDistance;	// sum over the first nCompared snapshots
+			int				nCompared;
+		};
+		std::vector<MatchCandidate> _matchCandidates;
+		BWAPI::Race _matchCandidatesEnemyRace;	// the index is rebuilt if these change
+		std::string _matchCandidatesOpening;
+
 		// Advice for the rest of the bot.
 		bool _singleStrategy;					// enemy seems to always do the same thing, false until proven true
 		OpeningPlan _initialExpectedEnemyPlan;  // first predicted enemy plan, before play starts
@@ -47,11 +71,14 @@ namespace UAlbertaBot
 		OpeningPlan predictEnemyPlan() const;
 
         void readFile(std::string filename);
+		bool readBinaryFile(const std::string & filename);
+		void readFiles(const std::string & directory);
 
 		void considerSingleStrategy();
 		void considerOpenings();
 		void reconsiderEnemyPlan();
 		void considerGasSteal();
+		void indexMatchCandidates();
 		void setBestMatch();
 
 		std::string getOpeningForEnemyPlan(OpeningPlan enemyPlan);
@@ -66,6 +93,7 @@ namespace UAlbertaBot
 		void write();
 
 		void update();
+		void updateBestMatch();
 
 		void predictEnemy(int lookaheadFrames, PlayerSnapshot & snap) const;
 
@@ -2,11 +2,15 @@
 #include "JSONTools.h"
 
 #include "BuildOrder.h"
+#include "JobSystem.h"
+#include "OpeningCache.h"
 #include "OpponentModel.h"
 #include "Random.h"
 #include "StrategyManager.h"
 
+#include <functional>
 #include <regex>
+#include <unordered_map>
 
 // Parse the configuration file.
 // Parse manual commands.
@@ -14,6 +18,44 @@
 
 using namespace UAlbertaBot;
 
+namespace
+{
+	void ParseIO(const rapidjson::Value & io)
+	{
+		JSONTools::ReadString("AIDirectory", io, Config::IO::AIDir);
+		JSONTools::ReadString("ReadDirectory", io, Config::IO::ReadDir);
+		JSONTools::ReadString("WriteDirectory", io, Config::IO::WriteDir);
+
+		JSONTools::ReadInt("MaxGameRecords", io, Config::IO::MaxGameRecords);
+
+		Config::IO::ReadOpponentModel = ParseUtils::GetBoolByRace("ReadOpponentModel", io);
+		Config::IO::WriteOpponentModel = ParseUtils::GetBoolByRace("WriteOpponentModel", io);
+	}
+}
+
+// Parse only the IO options of the configuration file.
+// The map analysis cache needs the directories before the map is analyzed, and the rest
+// of the config can only be read after.
+void ParseUtils::ParseIOConfigFile(const std::string & filename)
+{
+	std::string config = FileUtils::ReadFile(filename);
+	if (config.length() == 0)
+	{
+		return;
+	}
+
+	rapidjson::Document doc;
+	if (doc.ParseInsitu(&config[0]).HasParseError())
+	{
+		return;
+	}
+
+	if (doc.HasMember("IO") && doc["IO"].IsObject())
+	{
+		ParseIO(doc["IO"]);
+	}
+}
+
 // Parse the JSON configuration file into Config:: variables.
 void ParseUtils::ParseConfigFile(const std::string & filename)
 {
@@ -45,7 +87,11 @@ void ParseUtils::ParseConfigFile(const std::string & filename)
 
     Config::ConfigFile::ConfigFileFound = true;
 
-    bool parsingFailed = doc.Parse(config.c_str()).HasParseError();
+	// Hash the text before the in-place parse below rewrites it.
+	const unsigned long long configHash = OpeningCache::hash(config);
+
+	// Parse in place: the document's strings point into config instead of being copied.
+    bool parsingFailed = doc.ParseInsitu(&config[0]).HasParseError();
     if (parsingFailed)
     {
         return;
@@ -104,6 +150,10 @@ void ParseUtils::ParseConfigFile(const std::string & filename)
     {
         const rapidjson::Value & debug = doc["Debug"];
         JSONTools::ReadString("ErrorLogFilename", debug, Config::Debug::ErrorLogFilename);
+        JSONTools::ReadString("ProfileTraceFilename", debug, Config::Debug::ProfileTraceFilename);
+        JSONTools::ReadString("FrameRecordFilename", debug, Config::Debug::FrameRecordFilename);
+        JSONTools::ReadInt("MemoryCeilingMB", debug, Config::Debug::MemoryCeilingMB);
+        JSONTools::ReadBool("DeterministicJobs", debug, Config::Debug::DeterministicJobs);
         JSONTools::ReadBool("LogAssertToErrorFile", debug, Config::Debug::LogAssertToErrorFile);
         JSONTools::ReadBool("LogDebug", debug, Config::Debug::LogDebug);
         JSONTools::ReadBool("DrawGameInfo", debug, Config::Debug::DrawGameInfo);
@@ -131,6 +181,14 @@ void ParseUtils::ParseConfigFile(const std::string & filename)
         JSONTools::ReadBool("DrawBOSSStateInfo", debug, Config::Debug::DrawBOSSStateInfo); 
     }
 
+    // Parse the Tournament Options
+    if (doc.HasMember("Tournament") && doc["Tournament"].IsObject())
+    {
+        const rapidjson::Value & tournament = doc["Tournament"];
+
+        JSONTools::ReadInt("FrameBudgetMs", tournament, Config::Tournament::FrameBudgetMs);
+    }
+
     // Parse the Tool Options
     if (doc.HasMember("Tools") && doc["Tools"].IsObject())
     {
@@ -142,16 +200,7 @@ void ParseUtils::ParseConfigFile(const std::string & filename)
 	// Parse the IO options.
 	if (doc.HasMember("IO") && doc["IO"].IsObject())
 	{
-		const rapidjson::Value & io = doc["IO"];
-
-		JSONTools::ReadString("AIDirectory", io, Config::IO::AIDir);
-		JSONTools::ReadString("ReadDirectory", io, Config::IO::ReadDir);
-		JSONTools::ReadString("WriteDirectory", io, Config::IO::WriteDir);
-
-		JSONTools::ReadInt("MaxGameRecords", io, Config::IO::MaxGameRecords);
-
-		Config::IO::ReadOpponentModel = GetBoolByRace("ReadOpponentModel", io);
-		Config::IO::WriteOpponentModel = GetBoolByRace("WriteOpponentModel", io);
+		ParseIO(doc["IO"]);
 	}
 
 	// We do this here because opening selection may depend on the results.
@@ -181,78 +230,26 @@ void ParseUtils::ParseConfigFile(const std::string & filename)
 
 		// 0. Parse all the openings.
 		// Besides making them all available, this checks that they are syntatically valid.
-		std::vector<std::string> openingNames;		// in case we want to make a random choice
-		if (strategy.HasMember("Strategies") && strategy["Strategies"].IsObject())
+		// Resolving the build orders into MacroActs is the slow part, so the results are cached
+		// across games for as long as the config file does not change.
+		std::vector<Strategy> openings;
+		if (!OpeningCache::read(configHash, openings))
 		{
-			const rapidjson::Value & strategies = strategy["Strategies"];
-			for (rapidjson::Value::ConstMemberIterator itr = strategies.MemberBegin(); itr != strategies.MemberEnd(); ++itr)
+			if (strategy.HasMember("Strategies") && strategy["Strategies"].IsObject())
 			{
-				const std::string &		 name = itr->name.GetString();
-				const rapidjson::Value & val = itr->value;
-
-				BWAPI::Race strategyRace;
-				if (val.HasMember("Race") && val["Race"].IsString())
-				{
-					strategyRace = GetRace(val["Race"].GetString());
-				}
-				else
-				{
-					UAB_ASSERT_WARNING(false, "Strategy must have a Race string. Skipping %s", name.c_str());
-					continue;
-				}
-
-				std::string openingGroup("");
-				if (val.HasMember("OpeningGroup") && val["OpeningGroup"].IsString())
-				{
-					openingGroup = val["OpeningGroup"].GetString();
-				}
-
-				BuildOrder buildOrder(strategyRace);
-				if (val.HasMember("OpeningBuildOrder") && val["OpeningBuildOrder"].IsArray())
-				{
-					const rapidjson::Value & build = val["OpeningBuildOrder"];
-
-					for (size_t b(0); b < build.Size(); ++b)
-					{
-						if (build[b].IsString())
-						{
-							std::string itemName = build[b].GetString();
-
-							int unitCount = 1;    // the default count
-
-							// You can specify a count, like "6 x mutalisk". The spaces are required.
-							// Mostly useful for units, but "2 x creep colony @ natural" also works.
-							std::regex countRegex("([0-9]+)\\s+x\\s+([a-zA-Z_ ]+(\\s+@\\s+[a-zA-Z_ ]+)?)");
-							std::smatch m;
-							if (std::regex_match(itemName, m, countRegex)) {
-								unitCount = GetIntFromString(m[1].str());
-								itemName = m[2].str();
-							}
-
-							MacroAct act(itemName);
-
-							if (act.getRace() != BWAPI::Races::None || act.isCommand())
-							{
-								for (int i = 0; i < unitCount; ++i)
-								{
-									buildOrder.add(act);
-								}
-							}
-						}
-						else
-						{
-							UAB_ASSERT_WARNING(false, "Build order item must be a string %s", name.c_str());
-							continue;
-						}
-					}
-				}
+				_ParseOpenings(strategy["Strategies"], openings);
+			}
+			OpeningCache::write(configHash, openings);
+		}
 
-				// Only remember the ones that are for our current race.
-				if (strategyRace == BWAPI::Broodwar->self()->getRace())
-				{
-					StrategyManager::Instance().addStrategy(name, Strategy(name, strategyRace, openingGroup, buildOrder));
-					openingNames.push_back(name);
-				}
+		// Only remember the ones that are for our current race.
+		std::vector<std::string> openingNames;		// in case we want to make a random choice
+		for (Strategy & opening : openings)
+		{
+			if (opening._race == BWAPI::Broodwar->self()->getRace())
+			{
+				StrategyManager::Instance().addStrategy(opening._name, opening);
+				openingNames.push_back(opening._name);
 			}
 		}
 
@@ -406,6 +403,63 @@ void ParseUtils::ParseConfigFile(const std::string & filename)
     Config::ConfigFile::ConfigFileParsed = true;
 }
 
+namespace
+{
+	typedef std::function<void(const std::string &)> Setter;
+
+	// What /set does for each variable, by its lowercase name.
+	const std::unordered_map<std::string, Setter> & setters()
+	{
+		static const std::unordered_map<std::string, Setter> table =
+		{
+			// BWAPI options
+			{ "setlocalspeed", [](const std::string & val) { Config::BWAPIOptions::SetLocalSpeed = GetIntFromString(val); BWAPI::Broodwar->setLocalSpeed(Config::BWAPIOptions::SetLocalSpeed); } },
+			{ "setframeskip", [](const std::string & val) { Config::BWAPIOptions::SetFrameSkip = GetIntFromString(val); BWAPI::Broodwar->setFrameSkip(Config::BWAPIOptions::SetFrameSkip); } },
+			{ "userinput", [](const std::string & val) { Config::BWAPIOptions::EnableUserInput = ParseUtils::GetBoolFromString(val); if (Config::BWAPIOptions::EnableUserInput) BWAPI::Broodwar->enableFlag(BWAPI::Flag::UserInput); } },
+			{ "completemapinformation", [](const std::string & val) { Config::BWAPIOptions::EnableCompleteMapInformation = ParseUtils::GetBoolFromString(val); if (Config::BWAPIOptions::EnableCompleteMapInformation) BWAPI::Broodwar->enableFlag(BWAPI::Flag::UserInput); } },
+
+			// Micro Options
+			{ "workersdefendrush", [](const std::string & val) { Config::Micro::WorkersDefendRush = ParseUtils::GetBoolFromString(val); } },
+			{ "combatsimradius", [](const std::string & val) { Config::Micro::CombatSimRadius = GetIntFromString(val); } },
+			{ "unitnearenemyradius", [](const std::string & val) { Config::Micro::UnitNearEnemyRadius = GetIntFromString(val); } },
+
+			// Macro Options
+			{ "absolutemaxworkers", [](const std::string & val) { Config::Macro::AbsoluteMaxWorkers = GetIntFromString(val); } },
+			{ "buildingspacing", [](const std::string & val) { Config::Macro::BuildingSpacing = GetIntFromString(val); } },
+			{ "pylonspacing", [](const std::string & val) { Config::Macro::PylonSpacing = GetIntFromString(val); } },
+
+			// Debug Options
+			{ "errorlogfilename", [](const std::string & val) { Config::Debug::ErrorLogFilename = val; } },
+			{ "profiletracefilename", [](const std::string & val) { Config::Debug::ProfileTraceFilename = val; } },
+			{ "framerecordfilename", [](const std::string & val) { Config::Debug::FrameRecordFilename = val; } },
+			{ "memoryceilingmb", [](const std::string & val) { Config::Debug::MemoryCeilingMB = GetIntFromString(val); } },
+			{ "deterministicjobs", [](const std::string & val) { Config::Debug::DeterministicJobs = ParseUtils::GetBoolFromString(val); JobSystem::Instance().setDeterministic(Config::Debug::DeterministicJobs); } },
+			{ "drawgameinfo", [](const std::string & val) { Config::Debug::DrawGameInfo = ParseUtils::GetBoolFromString(val); } },
+			{ "drawunithealthbars", [](const std::string & val) { Config::Debug::DrawUnitHealthBars = ParseUtils::GetBoolFromString(val); } },
+			{ "drawproductioninfo", [](const std::string & val) { Config::Debug::DrawProductionInfo = ParseUtils::GetBoolFromString(val); } },
+			{ "drawbuildordersearchinfo", [](const std::string & val) { Config::Debug::DrawBuildOrderSearchInfo = ParseUtils::GetBoolFromString(val); } },
+			{ "drawenemyunitinfo", [](const std::string & val) { Config::Debug::DrawEnemyUnitInfo = ParseUtils::GetBoolFromString(val); } },
+			{ "drawmoduletimers", [](const std::string & val) { Config::Debug::DrawModuleTimers = ParseUtils::GetBoolFromString(val); } },
+			{ "drawresourceinfo", [](const std::string & val) { Config::Debug::DrawResourceInfo = ParseUtils::GetBoolFromString(val); } },
+			{ "drawcombatsiminfo", [](const std::string & val) { Config::Debug::DrawCombatSimulationInfo = ParseUtils::GetBoolFromString(val); } },
+			{ "drawunittargetinfo", [](const std::string & val) { Config::Debug::DrawUnitTargetInfo = ParseUtils::GetBoolFromString(val); } },
+			{ "drawunitorders", [](const std::string & val) { Config::Debug::DrawUnitOrders = ParseUtils::GetBoolFromString(val); } },
+			{ "drawmapinfo", [](const std::string & val) { Config::Debug::DrawMapInfo = ParseUtils::GetBoolFromString(val); } },
+			{ "drawmapgrid", [](const std::string & val) { Config::Debug::DrawMapGrid = ParseUtils::GetBoolFromString(val); } },
+			{ "drawmapdistances", [](const std::string & val) { Config::Debug::DrawMapDistances = ParseUtils::GetBoolFromString(val); } },
+			{ "drawbaseinfo", [](const std::string & val) { Config::Debug::DrawBaseInfo = ParseUtils::GetBoolFromString(val); } },
+			{ "drawstrategybossinfo", [](const std::string & val) { Config::Debug::DrawStrategyBossInfo = ParseUtils::GetBoolFromString(val); } },
+			{ "drawsquadinfo", [](const std::string & val) { Config::Debug::DrawSquadInfo = ParseUtils::GetBoolFromString(val); } },
+			{ "drawworkerinfo", [](const std::string & val) { Config::Debug::DrawWorkerInfo = ParseUtils::GetBoolFromString(val); } },
+			{ "drawmousecursorinfo", [](const std::string & val) { Config::Debug::DrawMouseCursorInfo = ParseUtils::GetBoolFromString(val); } },
+			{ "drawbuildinginfo", [](const std::string & val) { Config::Debug::DrawBuildingInfo = ParseUtils::GetBoolFromString(val); } },
+			{ "drawreservedbuildingtiles", [](const std::string & val) { Config::Debug::DrawReservedBuildingTiles = ParseUtils::GetBoolFromString(val); } },
+			{ "drawbossstateinfo", [](const std::string & val) { Config::Debug::DrawBOSSStateInfo = ParseUtils::GetBoolFromString(val); } }
+		};
+		return table;
+	}
+}
+
 void ParseUtils::ParseTextCommand(const std::string & commandString)
 {
     std::stringstream ss(commandString);
@@ -424,46 +478,8 @@ void ParseUtils::ParseTextCommand(const std::string & commandString)
 
     if (command == "/set")
     {
-        // BWAPI options
-        if (variableName == "setlocalspeed") { Config::BWAPIOptions::SetLocalSpeed = GetIntFromString(val); BWAPI::Broodwar->setLocalSpeed(Config::BWAPIOptions::SetLocalSpeed); }
-        else if (variableName == "setframeskip") { Config::BWAPIOptions::SetFrameSkip = GetIntFromString(val); BWAPI::Broodwar->setFrameSkip(Config::BWAPIOptions::SetFrameSkip); }
-        else if (variableName == "userinput") { Config::BWAPIOptions::EnableUserInput = GetBoolFromString(val); if (Config::BWAPIOptions::EnableUserInput) BWAPI::Broodwar->enableFlag(BWAPI::Flag::UserInput); }
-        else if (variableName == "completemapinformation") { Config::BWAPIOptions::EnableCompleteMapInformation = GetBoolFromString(val); if (Config::BWAPIOptions::EnableCompleteMapInformation) BWAPI::Broodwar->enableFlag(BWAPI::Flag::UserInput); }
-        
-        // Micro Options
-        else if (variableName == "workersdefendrush") { Config::Micro::WorkersDefendRush = GetBoolFromString(val); }
-		else if (variableName == "combatsimradius") { Config::Micro::CombatSimRadius = GetIntFromString(val); }
-        else if (variableName == "unitnearenemyradius") { Config::Micro::UnitNearEnemyRadius = GetIntFromString(val); }
-
-        // Macro Options
-		else if (variableName == "absolutemaxworkers") { Config::Macro::AbsoluteMaxWorkers = GetIntFromString(val); }
-		else if (variableName == "buildingspacing") { Config::Macro::BuildingSpacing = GetIntFromString(val); }
-        else if (variableName == "pylonspacing") { Config::Macro::PylonSpacing = GetIntFromString(val); }
-
-        // Debug Options
-        else if (variableName == "errorlogfilename") { Config::Debug::ErrorLogFilename = val; }
-		else if (variableName == "drawgameinfo") { Config::Debug::DrawGameInfo = GetBoolFromString(val); }
-		else if (variableName == "drawunithealthbars") { Config::Debug::DrawUnitHealthBars = GetBoolFromString(val); }
-		else if (variableName == "drawproductioninfo") { Config::Debug::DrawProductionInfo = GetBoolFromString(val); }
-		else if (variableName == "drawbuildordersearchinfo") { Config::Debug::DrawBuildOrderSearchInfo = GetBoolFromString(val); }
-        else if (variableName == "drawenemyunitinfo") { Config::Debug::DrawEnemyUnitInfo = GetBoolFromString(val); }
-        else if (variableName == "drawmoduletimers") { Config::Debug::DrawModuleTimers = GetBoolFromString(val); }
-        else if (variableName == "drawresourceinfo") { Config::Debug::DrawResourceInfo = GetBoolFromString(val); }
-        else if (variableName == "drawcombatsiminfo") { Config::Debug::DrawCombatSimulationInfo = GetBoolFromString(val); }
-        else if (variableName == "drawunittargetinfo") { Config::Debug::DrawUnitTargetInfo = GetBoolFromString(val); }
-		else if (variableName == "drawunitorders") { Config::Debug::DrawUnitOrders = GetBoolFromString(val); }
-		else if (variableName == "drawmapinfo") { Config::Debug::DrawMapInfo = GetBoolFromString(val); }
-        else if (variableName == "drawmapgrid") { Config::Debug::DrawMapGrid = GetBoolFromString(val); }
-		else if (variableName == "drawmapdistances") { Config::Debug::DrawMapDistances = GetBoolFromString(val); }
-		else if (variableName == "drawbaseinfo") { Config::Debug::DrawBaseInfo = GetBoolFromString(val); }
-		else if (variableName == "drawstrategybossinfo") { Config::Debug::DrawStrategyBossInfo = GetBoolFromString(val); }
-		else if (variableName == "drawsquadinfo") { Config::Debug::DrawSquadInfo = GetBoolFromString(val); }
-        else if (variableName == "drawworkerinfo") { Config::Debug::DrawWorkerInfo = GetBoolFromString(val); }
-        else if (variableName == "drawmousecursorinfo") { Config::Debug::DrawMouseCursorInfo = GetBoolFromString(val); }
-        else if (variableName == "drawbuildinginfo") { Config::Debug::DrawBuildingInfo = GetBoolFromString(val); }
-        else if (variableName == "drawreservedbuildingtiles") { Config::Debug::DrawReservedBuildingTiles = GetBoolFromString(val); }
-		else if (variableName == "drawbossstateinfo") { Config::Debug::DrawBOSSStateInfo = GetBoolFromString(val); }
-
+        auto it = setters().find(variableName);
+        if (it != setters().end()) { it->second(val); }
         else { UAB_ASSERT_WARNING(false, "Unknown variable name for /set: %s", variableName.c_str()); }
     }
     else
@@ -652,6 +668,85 @@ bool ParseUtils::_LookUpStrategyCombo(
 	return true;
 }
 
+// Parse the openings of every race into openings.
+// Build order items repeat a lot, so each distinct item string is turned into a MacroAct only once.
+// Internal routine not for wider use.
+void ParseUtils::_ParseOpenings(const rapidjson::Value & strategies, std::vector<Strategy> & openings)
+{
+	// You can specify a count, like "6 x mutalisk". The spaces are required.
+	// Mostly useful for units, but "2 x creep colony @ natural" also works.
+	const std::regex countRegex("([0-9]+)\\s+x\\s+([a-zA-Z_ ]+(\\s+@\\s+[a-zA-Z_ ]+)?)");
+
+	std::map<std::string, MacroAct> resolved;
+
+	for (rapidjson::Value::ConstMemberIterator itr = strategies.MemberBegin(); itr != strategies.MemberEnd(); ++itr)
+	{
+		const std::string &		 name = itr->name.GetString();
+		const rapidjson::Value & val = itr->value;
+
+		BWAPI::Race strategyRace;
+		if (val.HasMember("Race") && val["Race"].IsString())
+		{
+			strategyRace = GetRace(val["Race"].GetString());
+		}
+		else
+		{
+			UAB_ASSERT_WARNING(false, "Strategy must have a Race string. Skipping %s", name.c_str());
+			continue;
+		}
+
+		std::string openingGroup("");
+		if (val.HasMember("OpeningGroup") && val["OpeningGroup"].IsString())
+		{
+			openingGroup = val["OpeningGroup"].GetString();
+		}
+
+		BuildOrder buildOrder(strategyRace);
+		if (val.HasMember("OpeningBuildOrder") && val["OpeningBuildOrder"].IsArray())
+		{
+			const rapidjson::Value & build = val["OpeningBuildOrder"];
+
+			for (size_t b(0); b < build.Size(); ++b)
+			{
+				if (build[b].IsString())
+				{
+					std::string itemName = build[b].GetString();
+
+					int unitCount = 1;    // the default count
+
+					std::smatch m;
+					if (std::regex_match(itemName, m, countRegex)) {
+						unitCount = GetIntFromString(m[1].str());
+						itemName = m[2].str();
+					}
+
+					auto it = resolved.find(itemName);
+					if (it == resolved.end())
+					{
+						it = resolved.insert(std::make_pair(itemName, MacroAct(itemName))).first;
+					}
+					const MacroAct & act = it->second;
+
+					if (act.getRace() != BWAPI::Races::None || act.isCommand())
+					{
+						for (int i = 0; i < unitCount; ++i)
+						{
+							buildOrder.add(act);
+						}
+					}
+				}
+				else
+				{
+					UAB_ASSERT_WARNING(false, "Build order item must be a string %s", name.c_str());
+					continue;
+				}
+			}
+		}
+
+		openings.push_back(Strategy(name, strategyRace, openingGroup, buildOrder));
+	}
+}
+
 bool ParseUtils::GetBoolFromString(const std::string & str)
 {
 	std::string boolStr(str);
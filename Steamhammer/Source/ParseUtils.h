@@ -5,8 +5,11 @@
 
 namespace UAlbertaBot
 {
+struct Strategy;
+
 namespace ParseUtils
 {
+    void ParseIOConfigFile(const std::string & filename);
     void ParseConfigFile(const std::string & filename);
     void ParseTextCommand(const std::string & commandLine);
     BWAPI::Race GetRace(const std::string & raceName);
@@ -29,6 +32,8 @@ namespace ParseUtils
 		std::map<std::string, double> & strategyWeightFactors
 	);
 
+	void _ParseOpenings(const rapidjson::Value & strategies, std::vector<Strategy> & openings);
+
     bool GetBoolFromString(const std::string & str);
 	int GetIntByRace(const char * name, const rapidjson::Value & item);
 	double GetDoubleByRace(const char * name, const rapidjson::Value & item);
@@ -1,6 +1,8 @@
 #include "Common.h"
 #include "PathFinding.h"
 #include "MapTools.h"
+#include "InformationManager.h"
+#include "FrameArena.h"
 
 namespace { auto & bwemMap = BWEM::Map::Instance(); }
 namespace { auto & bwebMap = BWEB::Map::Instance(); }
@@ -34,7 +36,7 @@ const BWEM::CPPath CustomChokePointPath(
     if (!startArea || !targetArea)
     {
         debug << "\nInvalid area";
-        //Log().Debug() << debug.str();
+        //LOG_DEBUG << debug.str();
         return {};
     }
 
@@ -59,7 +61,7 @@ const BWEM::CPPath CustomChokePointPath(
             : choke->GetAreas().first;
     };
 
-    const auto createPath = [](const Node& node, std::map<const BWEM::ChokePoint *, const BWEM::ChokePoint *> & parentMap) {
+    const auto createPath = [](const Node& node, FrameMap<const BWEM::ChokePoint *, const BWEM::ChokePoint *> & parentMap) {
         std::vector<const BWEM::ChokePoint *> path;
         const BWEM::ChokePoint * current = node.choke;
 
@@ -75,7 +77,7 @@ const BWEM::CPPath CustomChokePointPath(
     };
 
     auto cmp = [](Node left, Node right) { return left.dist > right.dist; };
-    std::priority_queue<Node, std::vector<Node>, decltype(cmp)> nodeQueue(cmp);
+    std::priority_queue<Node, FrameVector<Node>, decltype(cmp)> nodeQueue(cmp);
     for (auto choke : startArea->ChokePoints())
         if (validChoke(choke, unitType.width(), unitType.isWorker()))
         {
@@ -87,7 +89,7 @@ const BWEM::CPPath CustomChokePointPath(
             debug << "\nAdded " << BWAPI::TilePosition(choke->Center());
         } else debug << "\nInvalid " << BWAPI::TilePosition(choke->Center());
 
-    std::map<const BWEM::ChokePoint *, const BWEM::ChokePoint *> parentMap;
+    FrameMap<const BWEM::ChokePoint *, const BWEM::ChokePoint *> parentMap;
 
     while (!nodeQueue.empty()) {
         auto const current = nodeQueue.top();
@@ -125,7 +127,7 @@ const BWEM::CPPath CustomChokePointPath(
     }
 
     debug << "\nNo valid path";
-    //Log().Debug() << debug.str();
+    //LOG_DEBUG << debug.str();
 
     return {};
 }
@@ -216,3 +218,134 @@ BWAPI::TilePosition PathFinding::NearbyPathfindingTile(BWAPI::TilePosition start
             }
     return BWAPI::TilePositions::Invalid;
 }
+
+// Each step on the walk-tile grid costs 10 orthogonally and 14 diagonally.
+// Threat is added on top of this, scaled so a tile covered by a single cannon costs the same as a 20-tile detour.
+const int STRAIGHT_STEP_COST = 10;
+const int DIAGONAL_STEP_COST = 14;
+const int THREAT_COST_FACTOR = 10;
+
+std::vector<BWAPI::Position> PathFinding::GetSafePath(BWAPI::Position start, BWAPI::Position end, BWAPI::UnitType unitType, int maxNodes)
+{
+    const int mapWidth = BWAPI::Broodwar->mapWidth() * 4;
+    const int mapHeight = BWAPI::Broodwar->mapHeight() * 4;
+
+    BWAPI::WalkPosition startWalk(start);
+    BWAPI::WalkPosition endWalk(end);
+    if (!startWalk.isValid() || !endWalk.isValid()) return {};
+
+    bool flying = unitType.isFlyer();
+    bool cloaked = unitType.hasPermanentCloak();
+
+    auto & enemyUnitGrid = InformationManager::Instance().getEnemyUnitGrid();
+
+    const auto passable = [&](int x, int y)
+    {
+        if (x < 0 || y < 0 || x >= mapWidth || y >= mapHeight) return false;
+        return flying || bwemMap.GetMiniTile(BWAPI::WalkPosition(x, y)).Walkable();
+    };
+
+    const auto threatCost = [&](int x, int y)
+    {
+        BWAPI::WalkPosition here(x, y);
+        if (cloaked && enemyUnitGrid.getDetection(here) == 0) return 0L;
+        return THREAT_COST_FACTOR * (flying ? enemyUnitGrid.getAirThreat(here) : enemyUnitGrid.getGroundThreat(here));
+    };
+
+    if (!passable(endWalk.x, endWalk.y)) return {};
+
+    // The search grids are kept between calls so we don't need to reallocate or clear them on every query
+    // A node is only valid for the current search if its visit stamp matches the current search
+    static std::vector<int> cost;
+    static std::vector<int> parent;
+    static std::vector<unsigned int> visitStamp;
+    static unsigned int currentStamp = 0;
+    if (cost.size() != (size_t)(mapWidth * mapHeight))
+    {
+        cost.assign(mapWidth * mapHeight, 0);
+        parent.assign(mapWidth * mapHeight, -1);
+        visitStamp.assign(mapWidth * mapHeight, 0);
+        currentStamp = 0;
+    }
+    currentStamp++;
+
+    const auto heuristic = [&](int x, int y)
+    {
+        int dx = std::abs(x - endWalk.x);
+        int dy = std::abs(y - endWalk.y);
+        return STRAIGHT_STEP_COST * std::max(dx, dy) + (DIAGONAL_STEP_COST - STRAIGHT_STEP_COST) * std::min(dx, dy);
+    };
+
+    // Queue entries are (estimated total cost, grid index), ordered by lowest cost first
+    std::priority_queue<std::pair<int, int>, FrameVector<std::pair<int, int>>, std::greater<std::pair<int, int>>> nodeQueue;
+
+    int startIndex = startWalk.x + startWalk.y * mapWidth;
+    int endIndex = endWalk.x + endWalk.y * mapWidth;
+    cost[startIndex] = 0;
+    parent[startIndex] = -1;
+    visitStamp[startIndex] = currentStamp;
+    nodeQueue.emplace(heuristic(startWalk.x, startWalk.y), startIndex);
+
+    const int dx[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+    const int dy[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+
+    int expanded = 0;
+    bool found = false;
+    while (!nodeQueue.empty())
+    {
+        auto const current = nodeQueue.top();
+        nodeQueue.pop();
+
+        int index = current.second;
+        int x = index % mapWidth;
+        int y = index / mapWidth;
+
+        // Skip stale queue entries
+        if (current.first - heuristic(x, y) > cost[index]) continue;
+
+        if (index == endIndex)
+        {
+            found = true;
+            break;
+        }
+
+        if (++expanded > maxNodes) break;
+
+        for (int i = 0; i < 8; i++)
+        {
+            int nx = x + dx[i];
+            int ny = y + dy[i];
+            if (!passable(nx, ny)) continue;
+
+            // Don't cut corners on diagonal steps
+            bool diagonal = i >= 4;
+            if (diagonal && (!passable(x + dx[i], y) || !passable(x, y + dy[i]))) continue;
+
+            int nextIndex = nx + ny * mapWidth;
+            int nextCost = cost[index] + (diagonal ? DIAGONAL_STEP_COST : STRAIGHT_STEP_COST) + threatCost(nx, ny);
+            if (visitStamp[nextIndex] == currentStamp && cost[nextIndex] <= nextCost) continue;
+
+            visitStamp[nextIndex] = currentStamp;
+            cost[nextIndex] = nextCost;
+            parent[nextIndex] = index;
+            nodeQueue.emplace(nextCost + heuristic(nx, ny), nextIndex);
+        }
+    }
+
+    if (!found) return {};
+
+    // Walk back from the target, keeping only the tiles where the path changes direction
+    std::vector<BWAPI::Position> path;
+    path.push_back(end);
+    int lastDirection = -1;
+    for (int index = endIndex; parent[index] != -1; index = parent[index])
+    {
+        int direction = index - parent[index];
+        if (lastDirection != -1 && direction != lastDirection)
+            path.push_back(BWAPI::Position(BWAPI::WalkPosition(index % mapWidth, index / mapWidth)) + BWAPI::Position(4, 4));
+        lastDirection = direction;
+    }
+
+    std::reverse(path.begin(), path.end());
+    return path;
+}
@@ -37,5 +37,18 @@ namespace PathFinding
 
     // Get a tile near the given tile that is suitable for pathfinding from or to.
     BWAPI::TilePosition NearbyPathfindingTile(BWAPI::TilePosition tile);
+
+    // Gets a walk-tile resolution path between two points that avoids enemy threats.
+    // Uses A* where each step is weighted by the enemy ground or air threat grid at the step position, so the
+    // path goes around static defense and enemy army coverage when a reasonable detour exists.
+    // Cloaked unit types only consider threats that are also covered by enemy detection.
+    // The search expands at most maxNodes walk tiles; if the target is not reached within that budget, or there
+    // is no path, returns an empty path.
+    // The returned path is a list of waypoints where the path changes direction, ending at the target position.
+    std::vector<BWAPI::Position> GetSafePath(
+        BWAPI::Position start,
+        BWAPI::Position end,
+        BWAPI::UnitType unitType,
+        int maxNodes = 20000);
 };
 }
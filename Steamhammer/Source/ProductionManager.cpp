@@ -195,7 +195,7 @@ void ProductionManager::manageBuildOrderQueue()
 	// changed behind our back, release the worker and continue.
 	if (_queue.isModified() && _assignedWorkerForThisBuilding)
 	{
-		Log().Debug() << "Releasing worker as queue was modified";
+		LOG_DEBUG << "Releasing worker as queue was modified";
 		WorkerManager::Instance().finishedWithWorker(_assignedWorkerForThisBuilding);
 		_assignedWorkerForThisBuilding = nullptr;
 	}
@@ -395,7 +395,7 @@ void ProductionManager::manageBuildOrderQueue()
 		// if we can make the current item
 		if (canMake)
 		{
-			Log().Debug() << "Producing " << currentItem.macroAct;
+			LOG_DEBUG << "Producing " << currentItem.macroAct;
 
 			// create it
 			create(producer, currentItem);
@@ -896,7 +896,7 @@ void ProductionManager::predictWorkerMovement(const Building & b)
 	// tell the worker manager to move this worker
 	WorkerManager::Instance().setMoveWorker(moveWorker, mineralsRequired, gasRequired, walkToPosition);
 
-	Log().Debug() << "Moving worker " << moveWorker->getID() << " to build " << b.type << " @ " << _predictedTilePosition;
+	LOG_DEBUG << "Moving worker " << moveWorker->getID() << " to build " << b.type << " @ " << _predictedTilePosition;
 }
 
 int ProductionManager::getFreeMinerals(bool isWorkerScoutBuilding) const
@@ -0,0 +1,426 @@
+#include "Profiler.h"
+
+#include "Logger.h"
+#include "MemoryTracker.h"
+
+#include <iomanip>
+
+using namespace UAlbertaBot;
+
+namespace
+{
+	// Trace file: the magic string and format version, then one record per frame, then
+	// at the end of the game the table of nodes. All numbers are 32 bit little-endian.
+	//   frame record: 'F', frame, node count, then for each node: node, calls, microseconds
+	//   node table:   'N', node count, then for each node in order: parent (-1 for the root),
+	//                 name length, name
+	const std::string TraceMagic = "LPRF";
+	const int TraceVersion = 1;
+
+	void putInt(std::string & output, int n)
+	{
+		for (int i = 0; i < 4; ++i)
+		{
+			output.push_back(char((n >> (8 * i)) & 0xFF));
+		}
+	}
+
+	const double BucketGrowth = 1.125;
+}
+
+Profiler::Node::Node(int z, int p)
+	: zone(z)
+	, parent(p)
+	, calls(0)
+	, elapsed(Clock::duration::zero())
+	, lastCalls(0)
+	, lastMicroseconds(0)
+	, lastAllocations(0)
+	, totalCalls(0)
+	, frames(0)
+	, totalMicroseconds(0)
+	, maxMicroseconds(0)
+	, totalAllocations(0)
+	, totalAllocatedBytes(0)
+{
+	histogram.fill(0);
+}
+
+Profiler::Profiler()
+	: _current(0)
+	, _frameStart(Clock::now())
+	, _barWidth(40)
+{
+	_nodes.emplace_back(zone("Total"), -1);
+	MemoryTracker::setTag(0);
+}
+
+Profiler & Profiler::Instance()
+{
+	static Profiler instance;
+	return instance;
+}
+
+int Profiler::bucket(long long microseconds)
+{
+	if (microseconds < 1)
+	{
+		return 0;
+	}
+	const int b = 1 + int(std::log(double(microseconds)) / std::log(BucketGrowth));
+	return (std::min)(b, NumBuckets - 1);
+}
+
+double Profiler::bucketLimit(int bucket)
+{
+	return std::pow(BucketGrowth, bucket) / 1000.0;
+}
+
+int Profiler::zone(const std::string & name)
+{
+	auto it = _zoneByName.find(name);
+	if (it != _zoneByName.end())
+	{
+		return it->second;
+	}
+
+	const int id = int(_zoneNames.size());
+	_zoneNames.push_back(name);
+	_zoneByName[name] = id;
+	return id;
+}
+
+// Open the zone as a child of the innermost open zone. Return its node.
+int Profiler::enter(int zone)
+{
+	for (int child : _nodes[_current].children)
+	{
+		if (_nodes[child].zone == zone)
+		{
+			_current = child;
+			MemoryTracker::setTag(child);
+			return child;
+		}
+	}
+
+	const int child = int(_nodes.size());
+	_nodes.emplace_back(zone, _current);
+	_nodes[_current].children.push_back(child);
+	_current = child;
+	MemoryTracker::setTag(child);
+	return child;
+}
+
+void Profiler::leave(int node, Clock::duration elapsed)
+{
+	Node & n = _nodes[node];
+	if (n.calls == 0)
+	{
+		_touched.push_back(node);
+	}
+	++n.calls;
+	n.elapsed += elapsed;
+	_current = n.parent;
+	MemoryTracker::setTag(_current);
+}
+
+void Profiler::beginFrame()
+{
+	_frameStart = Clock::now();
+}
+
+// Move the node's time this frame into its last-frame and whole-game statistics.
+void Profiler::addFrameToNode(int node)
+{
+	Node & n = _nodes[node];
+
+	const long long us = std::chrono::duration_cast<std::chrono::microseconds>(n.elapsed).count();
+
+	n.lastCalls = n.calls;
+	n.lastMicroseconds = us;
+
+	n.totalCalls += n.calls;
+	++n.frames;
+	n.totalMicroseconds += us;
+	n.maxMicroseconds = (std::max)(n.maxMicroseconds, us);
+	++n.histogram[bucket(us)];
+
+	const MemoryTracker::Counts allocated = MemoryTracker::takeTagCounts(node);
+	n.lastAllocations = allocated.allocations;
+	n.totalAllocations += allocated.allocations;
+	n.totalAllocatedBytes += allocated.bytes;
+
+	n.calls = 0;
+	n.elapsed = Clock::duration::zero();
+}
+
+void Profiler::endFrame()
+{
+	Node & root = _nodes[0];
+	if (root.calls == 0)
+	{
+		_touched.push_back(0);
+	}
+	root.calls = 1;
+	root.elapsed = Clock::now() - _frameStart;
+
+	for (int node : _lastTouched)
+	{
+		_nodes[node].lastCalls = 0;
+		_nodes[node].lastMicroseconds = 0;
+		_nodes[node].lastAllocations = 0;
+	}
+	for (int node : _touched)
+	{
+		addFrameToNode(node);
+	}
+	MemoryTracker::endFrame();
+
+	if (!Config::Debug::ProfileTraceFilename.empty())
+	{
+		writeTraceFrame();
+	}
+
+	_lastTouched.swap(_touched);
+	_touched.clear();
+}
+
+void Profiler::writeTraceFrame()
+{
+	if (!_traceFile.is_open())
+	{
+		_traceFile.open(Config::Debug::ProfileTraceFilename, std::ios::binary | std::ios::trunc);
+		_trace = TraceMagic;
+		putInt(_trace, TraceVersion);
+	}
+
+	_trace.push_back('F');
+	putInt(_trace, BWAPI::Broodwar->getFrameCount());
+	putInt(_trace, int(_touched.size()));
+	for (int node : _touched)
+	{
+		putInt(_trace, node);
+		putInt(_trace, _nodes[node].lastCalls);
+		putInt(_trace, int(_nodes[node].lastMicroseconds));
+	}
+
+	// Write in large pieces, so that tracing costs little during the game.
+	if (_trace.size() >= 1 << 20)
+	{
+		flushTrace();
+	}
+}
+
+void Profiler::flushTrace()
+{
+	_traceFile.write(_trace.data(), _trace.size());
+	_trace.clear();
+}
+
+// Log the statistics and finish the trace file.
+void Profiler::onEnd()
+{
+	logSummary();
+	logAllocations();
+
+	if (_traceFile.is_open())
+	{
+		_trace.push_back('N');
+		putInt(_trace, int(_nodes.size()));
+		for (const Node & node : _nodes)
+		{
+			const std::string & name = _zoneNames[node.zone];
+			putInt(_trace, node.parent);
+			putInt(_trace, int(name.size()));
+			_trace += name;
+		}
+		flushTrace();
+		_traceFile.close();
+	}
+}
+
+double Profiler::getFrameMilliseconds() const
+{
+	return std::chrono::duration<double, std::milli>(Clock::now() - _frameStart).count();
+}
+
+double Profiler::getLastFrameMilliseconds() const
+{
+	return _nodes[0].lastMicroseconds / 1000.0;
+}
+
+double Profiler::getMaxMilliseconds() const
+{
+	return _nodes[0].maxMicroseconds / 1000.0;
+}
+
+double Profiler::getMeanMilliseconds() const
+{
+	if (_nodes[0].frames == 0)
+	{
+		return 0.0;
+	}
+	return _nodes[0].totalMicroseconds / 1000.0 / _nodes[0].frames;
+}
+
+// The time per frame in milliseconds that fraction p of the node's frames did not exceed,
+// over the frames in which the node was entered. Rounded up to the histogram bucket.
+double Profiler::percentile(int node, double p) const
+{
+	const Node & n = _nodes[node];
+	if (n.frames == 0)
+	{
+		return 0.0;
+	}
+
+	const int target = (std::max)(1, int(std::ceil(p * n.frames)));
+	int count = 0;
+	for (int b = 0; b < NumBuckets; ++b)
+	{
+		count += n.histogram[b];
+		if (count >= target)
+		{
+			return (std::min)(bucketLimit(b), n.maxMicroseconds / 1000.0);
+		}
+	}
+	return n.maxMicroseconds / 1000.0;
+}
+
+// The zone names from the root to the node, like "Combat > Ground > CombatSim".
+std::string Profiler::path(int node) const
+{
+	std::string result = _zoneNames[_nodes[node].zone];
+	for (int n = _nodes[node].parent; n > 0; n = _nodes[n].parent)
+	{
+		result = _zoneNames[_nodes[n].zone] + " > " + result;
+	}
+	return result;
+}
+
+// The child that took the most time in the last frame, or -1 if none was entered.
+int Profiler::hottestChild(int node) const
+{
+	int hottest = -1;
+	for (int child : _nodes[node].children)
+	{
+		if (_nodes[child].lastCalls > 0 &&
+			(hottest < 0 || _nodes[child].lastMicroseconds > _nodes[hottest].lastMicroseconds))
+		{
+			hottest = child;
+		}
+	}
+	return hottest;
+}
+
+// Log where the time went in the last frame, following the most expensive zone at each level.
+void Profiler::log()
+{
+	std::ostringstream msg;
+	msg << "Frame time: " << getLastFrameMilliseconds() << "ms; longest";
+
+	for (int node = hottestChild(0); node >= 0; node = hottestChild(node))
+	{
+		const Node & n = _nodes[node];
+		msg << (node == hottestChild(0) ? " " : " > ") << _zoneNames[n.zone] << ": " << n.lastMicroseconds / 1000.0 << "ms";
+		if (n.lastCalls > 1)
+		{
+			msg << " (" << n.lastCalls << " calls)";
+		}
+	}
+
+	Log().Get() << msg.str();
+}
+
+void Profiler::logSummary()
+{
+	std::ostringstream msg;
+	msg << "Profile: zone, frames, calls, mean / p50 / p95 / p99 / max ms per frame, allocations per frame";
+
+	for (size_t i = 0; i < _nodes.size(); ++i)
+	{
+		const Node & n = _nodes[i];
+		if (n.frames == 0)
+		{
+			continue;
+		}
+
+		msg << std::fixed << std::setprecision(3)
+			<< '\n' << path(i)
+			<< ", " << n.frames
+			<< ", " << n.totalCalls
+			<< ", " << n.totalMicroseconds / 1000.0 / n.frames
+			<< " / " << percentile(i, 0.50)
+			<< " / " << percentile(i, 0.95)
+			<< " / " << percentile(i, 0.99)
+			<< " / " << n.maxMicroseconds / 1000.0
+			<< ", " << std::setprecision(1) << double(n.totalAllocations) / n.frames;
+	}
+
+	Log().Get() << msg.str();
+}
+
+// The zones that allocated the most over the game, counting only allocations made while
+// the zone was the innermost one.
+void Profiler::logAllocations()
+{
+	std::vector<int> order;
+	for (size_t i = 0; i < _nodes.size(); ++i)
+	{
+		if (_nodes[i].totalAllocations > 0)
+		{
+			order.push_back(int(i));
+		}
+	}
+	std::sort(order.begin(), order.end(), [this](int a, int b)
+	{
+		return _nodes[a].totalAllocations > _nodes[b].totalAllocations;
+	});
+
+	std::ostringstream msg;
+	msg << "Allocations: zone, total, KB total, per frame";
+	for (size_t i = 0; i < order.size() && i < 10; ++i)
+	{
+		const Node & n = _nodes[order[i]];
+		msg << std::fixed << std::setprecision(1)
+			<< '\n' << path(order[i])
+			<< ", " << n.totalAllocations
+			<< ", " << n.totalAllocatedBytes / 1024
+			<< ", " << double(n.totalAllocations) / n.frames;
+	}
+
+	Log().Get() << msg.str();
+	MemoryTracker::logSummary();
+}
+
+// Draw the zones directly under the root, as the old module timers did.
+void Profiler::drawZones(int x, int y)
+{
+	if (!Config::Debug::DrawModuleTimers)
+	{
+		return;
+	}
+
+	std::vector<int> nodes = { 0 };
+	nodes.insert(nodes.end(), _nodes[0].children.begin(), _nodes[0].children.end());
+
+	BWAPI::Broodwar->drawBoxScreen(x - 5, y - 5, x + 110 + _barWidth, y + 5 + (10 * nodes.size()), BWAPI::Colors::Black, true);
+
+	int yskip = 0;
+	const double total = _nodes[0].lastMicroseconds / 1000.0;
+	for (int node : nodes)
+	{
+		const double elapsed = _nodes[node].lastMicroseconds / 1000.0;
+		const std::string & name = _zoneNames[_nodes[node].zone];
+		if (elapsed > 55)
+		{
+			BWAPI::Broodwar->printf("Timer Debug: %s %lf", name.c_str(), elapsed);
+		}
+
+		int width = (total == 0) ? 0 : int(_barWidth * (elapsed / total));
+
+		BWAPI::Broodwar->drawTextScreen(x, y + yskip - 3, "\x04 %s", name.c_str());
+		BWAPI::Broodwar->drawBoxScreen(x + 60, y + yskip, x + 60 + width + 1, y + yskip + 8, BWAPI::Colors::White);
+		BWAPI::Broodwar->drawTextScreen(x + 70 + _barWidth, y + yskip - 3, "%.4lf", elapsed);
+		yskip += 10;
+	}
+}
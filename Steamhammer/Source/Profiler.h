@@ -0,0 +1,144 @@
+#pragma once
+
+#include "Common.h"
+
+#include <chrono>
+#include <fstream>
+
+// A hierarchical profiler for the frame.
+// PROFILE_ZONE("name") times the rest of the enclosing block as a zone. Zones nest, and each
+// path of zones from the frame root is a separate node, so a zone that is entered from two
+// places is timed separately for each.
+// For each node we keep the calls and time in the current frame, and over the game the
+// number of calls, the worst frame, and a histogram of the time per frame for percentiles.
+// If Config::Debug::ProfileTraceFilename is set, the time of each node in each frame is also
+// written to a binary trace file, for flame graphs of single frames.
+// Heap allocations made while a node is the innermost open zone are counted against it,
+// through the MemoryTracker, in builds that define LOCUTUS_MEMORY_TRACKING.
+
+namespace UAlbertaBot
+{
+
+class Profiler
+{
+public:
+	typedef std::chrono::steady_clock Clock;
+
+private:
+	// Time per frame in microseconds goes in buckets that grow by 1/8 each,
+	// from 1 microsecond to over 2 minutes. Percentiles are accurate to within a bucket.
+	static const int NumBuckets = 160;
+
+	struct Node
+	{
+		int					zone;
+		int					parent;
+		std::vector<int>	children;				// there are few
+
+		// This frame so far, and the last complete frame.
+		int					calls;
+		Clock::duration		elapsed;
+		int					lastCalls;
+		long long			lastMicroseconds;
+		long long			lastAllocations;
+
+		// Over the game, counting only frames where the node was entered.
+		int					totalCalls;
+		int					frames;
+		long long			totalMicroseconds;
+		long long			maxMicroseconds;
+		long long			totalAllocations;
+		long long			totalAllocatedBytes;
+		std::array<int, NumBuckets> histogram;
+
+		Node(int z, int p);
+	};
+
+	std::vector<std::string>	_zoneNames;
+	std::map<std::string, int>	_zoneByName;
+
+	std::vector<Node>	_nodes;					// _nodes[0] is the root, the whole frame
+	int					_current;				// innermost open node
+	std::vector<int>	_touched;				// nodes entered this frame
+	std::vector<int>	_lastTouched;			// nodes entered in the last complete frame
+
+	Clock::time_point	_frameStart;
+
+	std::ofstream		_traceFile;
+	std::string			_trace;					// trace data not yet written
+
+	int					_barWidth;
+
+	Profiler();
+
+	static int bucket(long long microseconds);
+	static double bucketLimit(int bucket);		// in milliseconds
+
+	void addFrameToNode(int node);
+	void writeTraceFrame();
+	void flushTrace();
+
+	std::string path(int node) const;
+	int hottestChild(int node) const;
+
+public:
+
+	static Profiler & Instance();
+
+	// The ID of the zone with this name. Static zones look it up once; see PROFILE_ZONE.
+	int		zone(const std::string & name);
+
+	int		enter(int zone);
+	void	leave(int node, Clock::duration elapsed);
+
+	void	beginFrame();
+	void	endFrame();
+	void	onEnd();
+
+	double	getFrameMilliseconds() const;		// since the start of this frame
+	double	getLastFrameMilliseconds() const;	// all of the last frame
+	double	getMaxMilliseconds() const;			// over all frames
+	double	getMeanMilliseconds() const;		// over all frames
+
+	double	percentile(int node, double p) const;
+
+	void	log();								// the hottest path through the last frame
+	void	logSummary();						// per node statistics for the game
+	void	logAllocations();					// the zones that allocate the most
+
+	void	drawZones(int x, int y);
+};
+
+// Times its own lifetime as a zone. Use through the macros below.
+class ProfileScope
+{
+	const int					_node;
+	const Profiler::Clock::time_point	_start;
+
+public:
+	explicit ProfileScope(int zone)
+		: _node(Profiler::Instance().enter(zone))
+		, _start(Profiler::Clock::now())
+	{
+	}
+
+	~ProfileScope()
+	{
+		Profiler::Instance().leave(_node, Profiler::Clock::now() - _start);
+	}
+};
+
+}
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+
+// Time the rest of the enclosing block as the zone with the given fixed name.
+#define PROFILE_ZONE(name) \
+	static const int PROFILE_CONCAT(profileZone_, __LINE__) = UAlbertaBot::Profiler::Instance().zone(name); \
+	UAlbertaBot::ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(PROFILE_CONCAT(profileZone_, __LINE__))
+
+// Time the rest of the enclosing block as a zone whose name is only known at run time,
+// such as a squad name. The name is looked up on each call.
+#define PROFILE_ZONE_NAMED(nameString) \
+	UAlbertaBot::ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(UAlbertaBot::Profiler::Instance().zone(nameString))
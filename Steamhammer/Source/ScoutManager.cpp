@@ -151,7 +151,7 @@ void ScoutManager::update()
     if (_scoutCommand == MacroCommandType::ScoutWhileSafe &&
         OpponentModel::Instance().getEnemyPlan() == OpeningPlan::FastRush)
     {
-        Log().Debug() << "Fast rush detected, aborting scouting";
+        LOG_DEBUG << "Fast rush detected, aborting scouting";
         _scoutCommand = MacroCommandType::ScoutLocation;
     }
 
@@ -381,7 +381,7 @@ void ScoutManager::moveGroundScout(BWAPI::Unit scout)
 	{
 		// The target is valid exactly when we are still looking for the enemy base.
 		_scoutStatus = "Seeking enemy base";
-        InformationManager::Instance().getLocutusUnit(_workerScout).moveTo(BWAPI::Position(_workerScoutTarget));
+        InformationManager::Instance().getLocutusUnit(_workerScout).moveToSafely(BWAPI::Position(_workerScoutTarget));
         //Micro::Move(_workerScout, BWAPI::Position(_workerScoutTarget));
 	}
 	else
@@ -5,6 +5,7 @@
 #include "MathUtil.h"
 #include "MapGrid.h"
 #include "PathFinding.h"
+#include "Profiler.h"
 
 namespace { auto & bwemMap = BWEM::Map::Instance(); }
 namespace { auto & bwebMap = BWEB::Map::Instance(); }
@@ -25,6 +26,9 @@ Squad::Squad()
 	, _attackAtMax(false)
     , _lastRetreatSwitch(0)
     , _lastRetreatSwitchVal(false)
+    , _needToRegroup(false)
+    , _combatSimPending(false)
+    , _combatSimScore(0)
     , _priority(0)
 {
     int a = 10;   // only you can prevent linker errors
@@ -48,6 +52,9 @@ Squad::Squad(const std::string & name, SquadOrder order, size_t priority)
     , _attackAtMax(false)
 	, _lastRetreatSwitch(0)
     , _lastRetreatSwitchVal(false)
+    , _needToRegroup(false)
+    , _combatSimPending(false)
+    , _combatSimScore(0)
     , _priority(priority)
 {
 	setSquadOrder(order);
@@ -59,9 +66,13 @@ Squad::~Squad()
     clear();
 }
 
-// TODO make a proper dispatch system for different orders
-void Squad::update()
+bool Squad::prepareUpdate()
 {
+	PROFILE_ZONE_NAMED(_name);
+
+	_needToRegroup = false;
+	_combatSimPending = false;
+
 	// update all necessary unit information within this squad
 	updateUnits();
 
@@ -69,6 +80,28 @@ void Squad::update()
     for (auto& pair : bunkerAttackSquads)
         pair.second.update();
 
+	if (_units.empty() ||
+		_order.getType() == SquadOrderTypes::Load ||
+		_order.getType() == SquadOrderTypes::BlockEnemyScout)
+	{
+		return false;
+	}
+
+	_needToRegroup = needsToRegroup();
+	return _combatSimPending;
+}
+
+// Runs the combat sim set up by prepareUpdate(). Does not call BWAPI.
+void Squad::simulateCombat()
+{
+	_combatSimScore = sim.simulateCombat(_lastRetreatSwitchVal);
+}
+
+// TODO make a proper dispatch system for different orders
+void Squad::update()
+{
+	PROFILE_ZONE_NAMED(_name);
+
 	if (_units.empty())
 	{
 		return;
@@ -94,7 +127,11 @@ void Squad::update()
         return;
     }
 
-	bool needToRegroup = needsToRegroup();
+	if (_combatSimPending)
+	{
+		finishRegroup(_combatSimScore);
+	}
+	bool needToRegroup = _needToRegroup;
     
 	if (Config::Debug::DrawSquadInfo && _order.isRegroupableOrder()) 
 	{
@@ -480,18 +517,33 @@ bool Squad::needsToRegroup()
 
 	// If we most recently retreated, don't attack again until retreatDuration frames have passed.
 	const int retreatDuration = 2 * 24;
-	bool retreat = _lastRetreatSwitchVal && (BWAPI::Broodwar->getFrameCount() - _lastRetreatSwitch < retreatDuration);
-
-	if (!retreat)
+	if (_lastRetreatSwitchVal && (BWAPI::Broodwar->getFrameCount() - _lastRetreatSwitch < retreatDuration))
 	{
-        // All other checks are done. Finally do the expensive combat simulation.
-        int score = runCombatSim(_order.getPosition());
-
-		retreat = score < 0;
-		_lastRetreatSwitch = BWAPI::Broodwar->getFrameCount();
-		_lastRetreatSwitchVal = retreat;
+		_regroupStatus = std::string("Retreat");
+		return true;
 	}
-	
+
+    // All other checks are done. Finally do the expensive combat simulation.
+    // SquadData runs it after all squads are prepared; update() finishes the decision.
+    if (setUpCombatSim(_order.getPosition()))
+    {
+        _combatSimPending = true;
+        return false;
+    }
+
+    finishRegroup(1);
+    return _needToRegroup;
+}
+
+// Decide whether to regroup from the combat sim score.
+void Squad::finishRegroup(int combatSimScore)
+{
+	bool retreat = combatSimScore < 0;
+	_lastRetreatSwitch = BWAPI::Broodwar->getFrameCount();
+	_lastRetreatSwitchVal = retreat;
+	_needToRegroup = retreat;
+	_combatSimPending = false;
+
 	if (retreat)
 	{
 		_regroupStatus = std::string("Retreat");
@@ -500,8 +552,6 @@ bool Squad::needsToRegroup()
 	{
 		_regroupStatus = std::string("Attack");
 	}
-
-	return retreat;
 }
 
 bool Squad::containsUnit(BWAPI::Unit u) const
@@ -705,7 +755,7 @@ void Squad::setSquadOrder(const SquadOrder & so)
     if (so.getType() != _order.getType() ||
         so.getPosition() != _order.getPosition())
     {
-        Log().Debug() << "Order for " << _name << " changed to " << so.getCharCode() << " " << BWAPI::TilePosition(so.getPosition());
+        LOG_DEBUG << "Order for " << _name << " changed to " << so.getCharCode() << " " << BWAPI::TilePosition(so.getPosition());
     }
 
 	_order = so;
@@ -915,11 +965,22 @@ MicroBunkerAttackSquad * Squad::getBunkerRunBySquad(BWAPI::Unit unit)
     return nullptr;
 }
 
+// Run the combat sim at once, on the main thread.
 int Squad::runCombatSim(BWAPI::Position targetPosition)
+{
+    PROFILE_ZONE("CombatSim");
+
+    if (!setUpCombatSim(targetPosition)) return 1;
+    return sim.simulateCombat(_lastRetreatSwitchVal);
+}
+
+// Read the units and geography for the combat sim, if there is a fight to simulate.
+// Return false if not; the combat sim score is then 1, attack.
+bool Squad::setUpCombatSim(BWAPI::Position targetPosition)
 {
     // Get our "vanguard unit"
     BWAPI::Unit ourVanguard = unitClosestTo(targetPosition);
-    if (!ourVanguard) return 1; // We have no units
+    if (!ourVanguard) return false; // We have no units
 
     // Get the enemy "vanguard unit"
     int closestDist = INT_MAX;
@@ -939,7 +1000,7 @@ int Squad::runCombatSim(BWAPI::Position targetPosition)
             enemyVanguard = ui.second.lastPosition;
         }
     }
-    if (!enemyVanguard.isValid()) return 1; // Enemy has no units in range
+    if (!enemyVanguard.isValid()) return false; // Enemy has no units in range
 
     // Special case: ignore enemy bunkers if:
     // - Our squad is entirely ranged goons
@@ -979,7 +1040,7 @@ int Squad::runCombatSim(BWAPI::Position targetPosition)
 
                 if (unit->getType() != BWAPI::UnitTypes::Protoss_Dragoon)
                 {
-                    Log().Debug() << "Not ignoring bunker; have a non-goon";
+                    LOG_DEBUG << "Not ignoring bunker; have a non-goon";
                     ignoreBunkers = false;
                     goto breakBunkerCheck;
                 }
@@ -995,7 +1056,7 @@ int Squad::runCombatSim(BWAPI::Position targetPosition)
                             BWAPI::UnitTypes::Terran_Bunker, 
                             bunkerPosition) <= ((5 * 32) + 1))
                     {
-                        Log().Debug() << "Not ignoring bunker; have a goon entering bunker range";
+                        LOG_DEBUG << "Not ignoring bunker; have a goon entering bunker range";
 
                         ignoreBunkers = false;
                         goto breakBunkerCheck;
@@ -1010,7 +1071,7 @@ int Squad::runCombatSim(BWAPI::Position targetPosition)
     if (StrategyManager::Instance().isRushing()) radius /= 2;
 
     sim.setCombatUnits(ourVanguard->getPosition(), enemyVanguard, radius, _fightVisibleOnly, ignoreBunkers);
-    return sim.simulateCombat(_lastRetreatSwitchVal);
+    return true;
 }
 
 const bool Squad::hasCombatUnits() const
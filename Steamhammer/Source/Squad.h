@@ -40,6 +40,9 @@ class Squad
 	bool				_attackAtMax;       // turns true when we are at max supply
     int                 _lastRetreatSwitch;
     bool                _lastRetreatSwitchVal;
+    bool                _needToRegroup;     // decided in prepareUpdate()
+    bool                _combatSimPending;  // the decision waits on the combat sim
+    int                 _combatSimScore;
     size_t              _priority;
 	
 	SquadOrder          _order;
@@ -69,6 +72,8 @@ class Squad
 	
 	bool			unitNearEnemy(BWAPI::Unit unit);
 	bool			needsToRegroup();
+	void			finishRegroup(int combatSimScore);
+	bool			setUpCombatSim(BWAPI::Position targetPosition);
 
 	void			loadTransport();
 	void			stimIfNeeded();
@@ -83,6 +88,11 @@ public:
 	Squad();
     ~Squad();
 
+	// A squad updates in two steps, so that SquadData can run the combat sims of all squads
+	// together as jobs. prepareUpdate() updates the units and decides whether to regroup,
+	// and returns true if the decision needs simulateCombat(). update() gives the orders.
+	bool                prepareUpdate();
+	void                simulateCombat();
 	void                update();
 	void                addUnit(BWAPI::Unit u);
 	void                removeUnit(BWAPI::Unit u);
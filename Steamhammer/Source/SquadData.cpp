@@ -1,5 +1,8 @@
 #include "SquadData.h"
 
+#include "JobSystem.h"
+#include "Profiler.h"
+
 using namespace UAlbertaBot;
 
 SquadData::SquadData() 
@@ -69,8 +72,27 @@ void SquadData::addSquad(const Squad & squad)
 	_squads[squad.getName()] = squad;
 }
 
+// The combat sims of the squads are independent, so run them together as jobs.
 void SquadData::updateAllSquads()
 {
+	std::vector<Squad *> simulating;
+	for (auto & kv : _squads)
+	{
+		if (kv.second.prepareUpdate())
+		{
+			simulating.push_back(&kv.second);
+		}
+	}
+
+	if (!simulating.empty())
+	{
+		PROFILE_ZONE("CombatSim");
+		JobSystem::Instance().parallelFor(int(simulating.size()), [&](int i)
+		{
+			simulating[i]->simulateCombat();
+		});
+	}
+
 	for (auto & kv : _squads)
 	{
 		kv.second.update();
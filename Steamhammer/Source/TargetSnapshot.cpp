@@ -0,0 +1,187 @@
+#include "TargetSnapshot.h"
+
+#include "WorldSnapshot.h"
+
+#include <limits>
+
+using namespace UAlbertaBot;
+
+namespace
+{
+	// Same as BWAPI's getDistance() from the unit to the goal, which is INT_MAX for an invalid
+	// position. Two units are then equally close to an invalid goal, as they were before.
+	int distanceToGoal(const WorldSnapshot & world, int w, BWAPI::Position goal)
+	{
+		return goal.isValid() ? world.distance(w, goal) : std::numeric_limits<int>::max();
+	}
+
+	// What build() reads of one target, from the world snapshot or from BWAPI.
+	struct TargetView
+	{
+		BWAPI::UnitType	type;
+		int				left, top, right, bottom;
+		int				goalDistance;
+		int				hitPoints, shields, acidSpores;
+		bool			underDarkSwarm, underStorm, defenseMatrixed;
+		bool			moving, braking, sieged;
+	};
+
+	TargetView view(BWAPI::Unit target, BWAPI::Position goal)
+	{
+		const WorldSnapshot & world = WorldSnapshot::Instance();
+		const int w = world.index(target);
+
+		TargetView v;
+		if (w >= 0)
+		{
+			v.type = world.type[w];
+			v.left = world.left[w];
+			v.top = world.top[w];
+			v.right = world.right[w];
+			v.bottom = world.bottom[w];
+			v.goalDistance = distanceToGoal(world, w, goal);
+			v.hitPoints = world.hitPoints[w];
+			v.shields = world.shields[w];
+			v.acidSpores = world.acidSpores[w];
+			v.underDarkSwarm = world.is(w, WorldSnapshot::UnderDarkSwarm);
+			v.underStorm = world.is(w, WorldSnapshot::UnderStorm);
+			v.defenseMatrixed = world.is(w, WorldSnapshot::DefenseMatrixed);
+			v.moving = world.is(w, WorldSnapshot::Moving);
+			v.braking = world.is(w, WorldSnapshot::Braking);
+			v.sieged = world.is(w, WorldSnapshot::Sieged) || world.is(w, WorldSnapshot::Sieging);
+		}
+		else
+		{
+			const BWAPI::Order order = target->getOrder();
+			v.type = target->getType();
+			v.left = target->getLeft();
+			v.top = target->getTop();
+			v.right = target->getRight();
+			v.bottom = target->getBottom();
+			v.goalDistance = target->getDistance(goal);
+			v.hitPoints = target->getHitPoints();
+			v.shields = target->getShields();
+			v.acidSpores = target->getAcidSporeCount();
+			v.underDarkSwarm = target->isUnderDarkSwarm();
+			v.underStorm = target->isUnderStorm();
+			v.defenseMatrixed = target->isDefenseMatrixed();
+			v.moving = target->isMoving();
+			v.braking = target->isBraking();
+			v.sieged = target->isSieged() || order == BWAPI::Orders::Sieging || order == BWAPI::Orders::Unsieging;
+		}
+		return v;
+	}
+}
+
+void TargetSnapshot::build(const FrameVector<BWAPI::Unit> & targets, BWAPI::Position goalPosition)
+{
+	goal = goalPosition;
+
+	const size_t n = targets.size();
+	for (auto * v : { &left, &top, &right, &bottom, &goalDistance, &hurtBonus, &acidSpores })
+	{
+		v->clear();
+		v->reserve(n);
+	}
+	for (auto * v : { &underDarkSwarm, &underStorm, &defenseMatrixed, &motion })
+	{
+		v->clear();
+		v->reserve(n);
+	}
+	unit.clear();
+	unit.reserve(n);
+	type.clear();
+	type.reserve(n);
+
+	// Keep the order of the targets, so that ties are broken the same way as when scoring them directly.
+	for (const auto target : targets)
+	{
+		const TargetView v = view(target, goal);
+
+		unit.push_back(target);
+		type.push_back(v.type);
+
+		left.push_back(v.left);
+		top.push_back(v.top);
+		right.push_back(v.right);
+		bottom.push_back(v.bottom);
+
+		goalDistance.push_back(v.goalDistance);
+
+		underDarkSwarm.push_back(v.underDarkSwarm);
+		underStorm.push_back(v.underStorm);
+		defenseMatrixed.push_back(v.defenseMatrixed);
+		acidSpores.push_back(v.acidSpores);
+
+		if (!v.moving)
+		{
+			motion.push_back(v.sieged ? StillSieged : Still);
+		}
+		else
+		{
+			motion.push_back(v.braking ? Braking : Moving);
+		}
+
+		// Prefer targets that are already hurt.
+		int bonus = 0;
+		const int maxHP = v.type.maxHitPoints();
+		if (v.type.getRace() == BWAPI::Races::Protoss && v.shields <= 5)
+		{
+			bonus += 32;
+			if (v.hitPoints < maxHP / 3)
+			{
+				bonus += 24;
+			}
+		}
+		else if (v.hitPoints < maxHP)
+		{
+			bonus += 24;
+			if (v.hitPoints < maxHP / 3)
+			{
+				bonus += 24;
+			}
+		}
+		hurtBonus.push_back(bonus);
+	}
+}
+
+// Same as BWAPI's getDistance() between two units, for every target at once.
+void TargetSnapshot::distancesFrom(BWAPI::Unit ourUnit, std::vector<int> & distances) const
+{
+	int ourLeft, ourTop, ourRight, ourBottom;
+
+	const WorldSnapshot & world = WorldSnapshot::Instance();
+	const int w = world.index(ourUnit);
+	if (w >= 0)
+	{
+		ourLeft = world.left[w];
+		ourTop = world.top[w];
+		ourRight = world.right[w];
+		ourBottom = world.bottom[w];
+	}
+	else
+	{
+		ourLeft = ourUnit->getLeft();
+		ourTop = ourUnit->getTop();
+		ourRight = ourUnit->getRight();
+		ourBottom = ourUnit->getBottom();
+	}
+
+	const int n = size();
+	distances.resize(n);
+
+	// A flat loop over the target boxes, with no calls back into BWAPI.
+	for (int i = 0; i < n; ++i)
+	{
+		int xDist = (std::max)((std::max)(ourLeft - right[i] - 1, left[i] - 1 - ourRight), 0);
+		int yDist = (std::max)((std::max)(ourTop - bottom[i] - 1, top[i] - 1 - ourBottom), 0);
+		distances[i] = BWAPI::Positions::Origin.getApproxDistance(BWAPI::Position(xDist, yDist));
+	}
+}
+
+int TargetSnapshot::goalDistanceFrom(BWAPI::Unit ourUnit) const
+{
+	const WorldSnapshot & world = WorldSnapshot::Instance();
+	const int w = world.index(ourUnit);
+	return w >= 0 ? distanceToGoal(world, w, goal) : ourUnit->getDistance(goal);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Common.h"
+#include "FrameArena.h"
+
+// The attributes of a micro manager's targets that target scoring reads, copied out of the
+// WorldSnapshot into flat arrays of just those targets. Scoring each of our units against every
+// target then works on the arrays instead of calling into BWAPI for each pair.
+// A target or unit of ours that is not in the WorldSnapshot is read from BWAPI instead.
+
+namespace UAlbertaBot
+{
+
+struct TargetSnapshot
+{
+	enum Motion { Still, StillSieged, Braking, Moving };
+
+	std::vector<BWAPI::Unit>		unit;
+	std::vector<BWAPI::UnitType>	type;
+
+	// Bounding boxes, as BWAPI measures unit distances from them
+	std::vector<int>				left;
+	std::vector<int>				top;
+	std::vector<int>				right;
+	std::vector<int>				bottom;
+
+	std::vector<int>				goalDistance;		// distance to the order position, as getDistance() computes it
+	std::vector<char>				underDarkSwarm;
+	std::vector<char>				underStorm;
+	std::vector<char>				defenseMatrixed;
+	std::vector<char>				motion;
+	std::vector<int>				hurtBonus;			// score bonus for targets that are already hurt
+	std::vector<int>				acidSpores;
+
+	BWAPI::Position					goal;				// invalid if there is no goal; then every distance to it is INT_MAX
+
+	int size() const { return unit.size(); };
+
+	void build(const FrameVector<BWAPI::Unit> & targets, BWAPI::Position goalPosition);
+
+	// Distance from the unit to each target, as BWAPI's getDistance() computes it
+	void distancesFrom(BWAPI::Unit ourUnit, std::vector<int> & distances) const;
+
+	// Distance from the unit to the goal, as BWAPI's getDistance() computes it
+	int goalDistanceFrom(BWAPI::Unit ourUnit) const;
+};
+
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "BWAPI.h"
+
+// A grid of flags, one bit per tile.
+// Each row is stored as a run of 64-bit words, so rectangle tests check a whole row span with a few mask operations
+// instead of testing each tile.
+
+namespace UAlbertaBot
+{
+
+class TileBitGrid
+{
+    int _width;
+    int _height;
+    int _wordsPerRow;
+    std::vector<uint64_t> _bits;
+
+    // Mask for the bits [from, to) within a word, with 0 <= from < to <= 64
+    static uint64_t mask(int from, int to)
+    {
+        uint64_t upper = to == 64 ? ~uint64_t(0) : ((uint64_t(1) << to) - 1);
+        return upper & ~((uint64_t(1) << from) - 1);
+    }
+
+    // Calls f(word, mask) for each word covering columns [x, x + w) of row y; stops early if f returns true
+    template<class Func>
+    bool anyRowSpan(int x, int y, int w, Func f) const
+    {
+        const uint64_t * row = &_bits[y * _wordsPerRow];
+        int end = x + w;
+        while (x < end)
+        {
+            int word = x >> 6;
+            int wordEnd = (std::min)(end, (word + 1) << 6);
+            if (f(row[word], mask(x & 63, wordEnd - (word << 6)))) return true;
+            x = wordEnd;
+        }
+        return false;
+    }
+
+    // Clips the rectangle to the grid, returning false if nothing is left
+    bool clip(int & x, int & y, int & w, int & h) const
+    {
+        if (x < 0) { w += x; x = 0; }
+        if (y < 0) { h += y; y = 0; }
+        if (x + w > _width) w = _width - x;
+        if (y + h > _height) h = _height - y;
+        return w > 0 && h > 0;
+    }
+
+public:
+
+    TileBitGrid()
+        : _width(0)
+        , _height(0)
+        , _wordsPerRow(0)
+    {
+    }
+
+    TileBitGrid(int width, int height, bool value)
+        : _width(width)
+        , _height(height)
+        , _wordsPerRow((width + 63) / 64)
+        , _bits(_wordsPerRow * height, 0)
+    {
+        if (value) setRect(0, 0, width, height, true);
+    }
+
+    int width() const { return _width; };
+    int height() const { return _height; };
+
+    // Pass only tiles inside the grid to these
+    bool get(int x, int y) const { return (_bits[y * _wordsPerRow + (x >> 6)] >> (x & 63)) & 1; };
+    bool get(BWAPI::TilePosition tile) const { return get(tile.x, tile.y); };
+
+    void set(int x, int y, bool value)
+    {
+        uint64_t & word = _bits[y * _wordsPerRow + (x >> 6)];
+        uint64_t bit = uint64_t(1) << (x & 63);
+        if (value) word |= bit; else word &= ~bit;
+    }
+
+    // Sets all tiles in the rectangle; the part of the rectangle outside the grid is ignored
+    void setRect(int x, int y, int w, int h, bool value)
+    {
+        if (!clip(x, y, w, h)) return;
+
+        for (int row = y; row < y + h; row++)
+        {
+            uint64_t * bits = &_bits[row * _wordsPerRow];
+            int end = x + w;
+            for (int col = x; col < end; )
+            {
+                int word = col >> 6;
+                int wordEnd = (std::min)(end, (word + 1) << 6);
+                uint64_t m = mask(col & 63, wordEnd - (word << 6));
+                if (value) bits[word] |= m; else bits[word] &= ~m;
+                col = wordEnd;
+            }
+        }
+    }
+
+    // Whether any tile in the rectangle is set; the part of the rectangle outside the grid is ignored
+    bool anyInRect(int x, int y, int w, int h) const
+    {
+        if (!clip(x, y, w, h)) return false;
+
+        for (int row = y; row < y + h; row++)
+            if (anyRowSpan(x, row, w, [](uint64_t word, uint64_t m) { return (word & m) != 0; })) return true;
+
+        return false;
+    }
+
+    // Whether all tiles in the rectangle are set; false if any part of the rectangle is outside the grid
+    bool allInRect(int x, int y, int w, int h) const
+    {
+        if (x < 0 || y < 0 || x + w > _width || y + h > _height) return false;
+
+        for (int row = y; row < y + h; row++)
+            if (anyRowSpan(x, row, w, [](uint64_t word, uint64_t m) { return (word & m) != m; })) return false;
+
+        return true;
+    }
+};
+
+}
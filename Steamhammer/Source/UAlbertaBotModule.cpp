@@ -10,8 +10,11 @@
 
 #include "Bases.h"
 #include "Common.h"
+#include "JobSystem.h"
+#include "MapAnalysisCache.h"
 #include "OpponentModel.h"
 #include "ParseUtils.h"
+#include "Profiler.h"
 #include "UnitUtil.h"
 #include "WorkerOrderTimer.h"
 
@@ -35,15 +38,25 @@ void UAlbertaBotModule::onStart()
 
 	// Call BWTA to read the current map.
 	// Fails if we don't have the cache data.
+	// onEnd() does nothing after this, so stop the log writer thread here.
 	if (!BWTA::analyze())
 	{
 		UAB_ASSERT(false, "BWTA map analysis failed");
+		Logger::Flush();
 		gameEnded = true;
 		return;
 	}
 
+    // Start the worker threads, for map analysis and later.
+    JobSystem::Instance().initialize();
+
 	// BWEM map init
+	// Precomputed analysis from previous games on this map is loaded first so BWEM can skip it
+	// The cache lives in the configured read and write directories
+	ParseUtils::ParseIOConfigFile(Config::ConfigFile::ConfigFileLocation);
+	MapAnalysisCache::initialize();
 	bwemMap.Initialize(BWAPI::BroodwarPtr);
+	MapAnalysisCache::onBWEMInitialized();
 	bwemMap.EnableAutomaticPathAnalysis();
 	bool startingLocationsOK = bwemMap.FindBasesForStartingLocations();
 	UAB_ASSERT(startingLocationsOK, "BWEM map analysis failed");
@@ -54,11 +67,15 @@ void UAlbertaBotModule::onStart()
     // Our own map analysis.
     Bases::Instance().initialize();
 
+    // Save any map analysis that wasn't already cached
+    MapAnalysisCache::write();
+
     // Parse the bot's configuration file.
 	// Change this file path to point to your config file.
     // Any relative path name will be relative to Starcraft installation folder
 	// The config depends on the map and must be read after the map is analyzed.
     ParseUtils::ParseConfigFile(Config::ConfigFile::ConfigFileLocation);
+    JobSystem::Instance().setDeterministic(Config::Debug::DeterministicJobs);
 
     // Set our BWAPI options according to the configuration. 
 	BWAPI::Broodwar->setLocalSpeed(Config::BWAPIOptions::SetLocalSpeed);
@@ -94,6 +111,9 @@ void UAlbertaBotModule::onEnd(bool isWinner)
 
     WorkerOrderTimer::write();
 
+    JobSystem::Instance().shutdown();
+    Logger::Flush();
+
     gameEnded = true;
 }
 
@@ -137,7 +157,10 @@ void UAlbertaBotModule::onUnitDestroy(BWAPI::Unit unit)
 	else if (unit->getType().isSpecialBuilding())
 		bwemMap.OnStaticBuildingDestroyed(unit);
 
-	bwebMap.onUnitDestroy(unit);
+	{
+		PROFILE_ZONE("BWEB onUnitDestroy");
+		bwebMap.onUnitDestroy(unit);
+	}
 
 	GameCommander::Instance().onUnitDestroy(unit);
 }
@@ -146,7 +169,10 @@ void UAlbertaBotModule::onUnitMorph(BWAPI::Unit unit)
 {
     if (gameEnded) return;
 
-    bwebMap.onUnitMorph(unit);
+    {
+        PROFILE_ZONE("BWEB onUnitMorph");
+        bwebMap.onUnitMorph(unit);
+    }
 
 	GameCommander::Instance().onUnitMorph(unit);
 }
@@ -162,7 +188,10 @@ void UAlbertaBotModule::onUnitCreate(BWAPI::Unit unit)
 { 
     if (gameEnded) return;
 
-    bwebMap.onUnitDiscover(unit);
+    {
+        PROFILE_ZONE("BWEB onUnitDiscover");
+        bwebMap.onUnitDiscover(unit);
+    }
 
 	GameCommander::Instance().onUnitCreate(unit);
 }
@@ -171,6 +200,7 @@ void UAlbertaBotModule::onUnitDiscover(BWAPI::Unit unit)
 { 
     if (gameEnded) return;
 
+    PROFILE_ZONE("BWEB onUnitDiscover");
     bwebMap.onUnitDiscover(unit);
 }
 
@@ -20,6 +20,60 @@ UnitData::UnitData()
 
 	numUnits		= std::vector<int>(maxTypeID + 1, 0);
 	numDeadUnits	= std::vector<int>(maxTypeID + 1, 0);
+	unitsByType		= std::vector< std::vector<const UnitInfo *> >(maxTypeID + 1);
+
+	gridWidth		= (BWAPI::Broodwar->mapWidth() * 32 + GridCellSize - 1) / GridCellSize;
+	gridHeight		= (BWAPI::Broodwar->mapHeight() * 32 + GridCellSize - 1) / GridCellSize;
+	grid			= std::vector< std::vector<const UnitInfo *> >(gridWidth * gridHeight);
+}
+
+namespace
+{
+    void removeFrom(std::vector<const UnitInfo *> & units, const UnitInfo * ui)
+    {
+        auto it = std::find(units.begin(), units.end(), ui);
+        if (it == units.end()) return;
+
+        *it = units.back();
+        units.pop_back();
+    }
+}
+
+// The grid cell containing the position, or -1 if the position is not on the map.
+int UnitData::gridCell(BWAPI::Position pos) const
+{
+    if (!pos.isValid()) return -1;
+    return (pos.y / GridCellSize) * gridWidth + pos.x / GridCellSize;
+}
+
+void UnitData::indexByType(const UnitInfo & ui)
+{
+    if (ui.type == BWAPI::UnitTypes::None) return;
+
+    auto & units = unitsByType[ui.type.getID()];
+    if (units.empty()) knownTypes.push_back(ui.type);
+    units.push_back(&ui);
+}
+
+void UnitData::unindexByType(const UnitInfo & ui)
+{
+    if (ui.type == BWAPI::UnitTypes::None) return;
+
+    auto & units = unitsByType[ui.type.getID()];
+    removeFrom(units, &ui);
+    if (units.empty()) knownTypes.erase(std::remove(knownTypes.begin(), knownTypes.end(), ui.type), knownTypes.end());
+}
+
+void UnitData::indexByPosition(const UnitInfo & ui)
+{
+    int cell = gridCell(ui.lastPosition);
+    if (cell != -1) grid[cell].push_back(&ui);
+}
+
+void UnitData::unindexByPosition(const UnitInfo & ui)
+{
+    int cell = gridCell(ui.lastPosition);
+    if (cell != -1) removeFrom(grid[cell], &ui);
 }
 
 // An enemy unit which is not visible, but whose lastPosition can be seen, is known
@@ -65,7 +119,7 @@ void UnitData::updateGoneFromLastPosition()
                     BWAPI::UnitTypes::Terran_Siege_Tank_Siege_Mode,
                     ui.lastPosition) <= BWAPI::UnitTypes::Terran_Siege_Tank_Siege_Mode.sightRange())
                 {
-                    Log().Debug() << "Assuming tank @ " << BWAPI::TilePosition(ui.lastPosition) << " is gone from that position";
+                    LOG_DEBUG << "Assuming tank @ " << BWAPI::TilePosition(ui.lastPosition) << " is gone from that position";
                     ui.goneFromLastPosition = true;
                     InformationManager::Instance().getUnitGrid(ui.player).unitDestroyed(ui.type, ui.lastPosition, ui.completed);
                     break;
@@ -91,6 +145,10 @@ void UnitData::updateUnit(BWAPI::Unit unit)
     
 	UnitInfo & ui   = unitMap[unit];
 
+    // Remember what the indexes are keyed by, so we can tell if they need updating
+    BWAPI::UnitType previousType = ui.type;
+    int previousCell = gridCell(ui.lastPosition);
+
     // Update the grid:
     // - Units that have moved
     // - Units that were gone from their last position and have reappeared
@@ -138,7 +196,19 @@ void UnitData::updateUnit(BWAPI::Unit unit)
     }
 
 	ui.unitID       = unit->getID();
-	ui.type         = unit->getType();
+
+    if (previousType != unit->getType())
+    {
+        unindexByType(ui);
+        ui.type = unit->getType();
+        indexByType(ui);
+    }
+
+    if (previousCell != gridCell(unit->getPosition()))
+    {
+        if (previousCell != -1) removeFrom(grid[previousCell], &ui);
+        indexByPosition(ui);
+    }
 
     if (!ui.completed && unit->isCompleted())
         InformationManager::Instance().getUnitGrid(unit->getPlayer()).unitCompleted(unit->getType(), unit->getPosition());
@@ -165,7 +235,9 @@ void UnitData::removeUnit(BWAPI::Unit unit)
 	gasLost += unit->getType().gasPrice();
 	--numUnits[unit->getType().getID()];
 	++numDeadUnits[unit->getType().getID()];
-	
+
+    unindexByType(ui);
+    unindexByPosition(ui);
 	unitMap.erase(unit);
 
 	// NOTE This assert fails, so the unit counts cannot be trusted. :-(
@@ -183,6 +255,9 @@ void UnitData::removeBadUnits()
                 InformationManager::Instance().getUnitGrid(iter->second.player).unitDestroyed(iter->second.type, iter->second.lastPosition, iter->second.completed);
 
 			numUnits[iter->second.type.getID()]--;
+
+            unindexByType(iter->second);
+            unindexByPosition(iter->second);
 			iter = unitMap.erase(iter);
 		}
 		else
@@ -240,6 +315,11 @@ const std::map<BWAPI::Unit,UnitInfo> & UnitData::getUnits() const
     return unitMap; 
 }
 
+const std::vector<const UnitInfo *> & UnitData::getUnitsOfType(BWAPI::UnitType t) const
+{
+    return unitsByType[t.getID()];
+}
+
 int UnitInfo::ComputeCompletionFrame(BWAPI::Unit unit)
 {
 	if (!unit->getType().isBuilding() || unit->isCompleted()) return 0;
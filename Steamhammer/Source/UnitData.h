@@ -94,6 +94,22 @@ class UnitData
     int										mineralsLost;
     int										gasLost;
 
+    // Indexes into unitMap, kept up to date as units are added, updated and removed.
+    // The pointers stay valid because std::map never moves its elements.
+    std::vector< std::vector<const UnitInfo *> >	unitsByType;    // by last known type
+    std::vector<BWAPI::UnitType>			knownTypes;     // types with at least one unit in unitMap
+
+    static const int						GridCellSize = 256;     // in pixels
+    int										gridWidth;
+    int										gridHeight;
+    std::vector< std::vector<const UnitInfo *> >	grid;           // by cell of last known position
+
+    int		gridCell(BWAPI::Position pos) const;
+    void	indexByType(const UnitInfo & ui);
+    void	unindexByType(const UnitInfo & ui);
+    void	indexByPosition(const UnitInfo & ui);
+    void	unindexByPosition(const UnitInfo & ui);
+
 public:
 
     UnitData();
@@ -109,5 +125,29 @@ public:
     int		getNumUnits(BWAPI::UnitType t)              const;
     int		getNumDeadUnits(BWAPI::UnitType t)          const;
     const	std::map<BWAPI::Unit,UnitInfo> & getUnits() const;
+
+    // Units currently known of the given type. Unlike getNumUnits, this is exact.
+    const	std::vector<const UnitInfo *> & getUnitsOfType(BWAPI::UnitType t) const;
+    bool	hasUnitOfType(BWAPI::UnitType t) const { return !getUnitsOfType(t).empty(); };
+    const	std::vector<BWAPI::UnitType> & getKnownTypes() const { return knownTypes; };
+
+    // Calls f(const UnitInfo &) for each unit whose last position may be within radius of p.
+    // The candidates come from the grid cells covering the square around p, so f must do its own distance check.
+    // Stops and returns true as soon as f returns true.
+    template<class Func>
+    bool anyUnitNear(BWAPI::Position p, int radius, Func f) const
+    {
+        int minX = std::max(0, (p.x - radius) / GridCellSize);
+        int maxX = std::min(gridWidth - 1, (p.x + radius) / GridCellSize);
+        int minY = std::max(0, (p.y - radius) / GridCellSize);
+        int maxY = std::min(gridHeight - 1, (p.y + radius) / GridCellSize);
+
+        for (int y = minY; y <= maxY; y++)
+            for (int x = minX; x <= maxX; x++)
+                for (const UnitInfo * ui : grid[y * gridWidth + x])
+                    if (f(*ui)) return true;
+
+        return false;
+    }
 };
 }
\ No newline at end of file
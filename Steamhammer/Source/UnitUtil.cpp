@@ -3,6 +3,80 @@
 
 using namespace UAlbertaBot;
 
+namespace
+{
+	// Assume that a bunker is loaded and can shoot at air.
+	bool computeCanAttackAir(BWAPI::UnitType attacker)
+	{
+		return attacker.airWeapon() != BWAPI::WeaponTypes::None ||
+			attacker == BWAPI::UnitTypes::Terran_Bunker ||
+			attacker == BWAPI::UnitTypes::Protoss_Carrier;
+	}
+
+	// Assume that a bunker is loaded and can shoot at ground.
+	bool computeCanAttackGround(BWAPI::UnitType attacker)
+	{
+		return attacker.groundWeapon() != BWAPI::WeaponTypes::None ||
+			attacker == BWAPI::UnitTypes::Terran_Bunker ||
+			attacker == BWAPI::UnitTypes::Protoss_Carrier ||
+			attacker == BWAPI::UnitTypes::Protoss_Reaver;
+	}
+
+	// Treat workers as non-combat units (overridden in IsCombatSimUnit(unit) for some workers).
+	// The combat simulation does not support spells other than medic healing and stim,
+	// and it does not understand detectors.
+	// The combat sim treats carriers as the attack unit, not their interceptors (bftjoe).
+	bool computeCombatSimUnit(BWAPI::UnitType type)
+	{
+		if (type.isWorker())
+		{
+			return false;
+		}
+
+		if (type == BWAPI::UnitTypes::Protoss_Interceptor)
+		{
+			return false;
+		}
+
+		return
+			computeCanAttackAir(type) ||
+			computeCanAttackGround(type) ||
+			type == BWAPI::UnitTypes::Terran_Medic;
+	}
+
+	// Properties that depend only on the unit type, computed once for each type.
+	// They are asked for in the inner loops of the combat sim and micro.
+	struct TypeProperties
+	{
+		bool	canAttackAir;
+		bool	canAttackGround;
+		bool	combatSimUnit;
+		int		maxAttackRange;
+	};
+
+	const TypeProperties & Properties(BWAPI::UnitType type)
+	{
+		static const std::vector<TypeProperties> table = []()
+		{
+			std::vector<TypeProperties> result(BWAPI::UnitTypes::Enum::MAX);
+			for (int id = 0; id < BWAPI::UnitTypes::Enum::MAX; id++)
+			{
+				BWAPI::UnitType t(id);
+				result[id].canAttackAir = computeCanAttackAir(t);
+				result[id].canAttackGround = computeCanAttackGround(t);
+				result[id].combatSimUnit = computeCombatSimUnit(t);
+				result[id].maxAttackRange = (std::max)(
+					UnitUtil::GetAttackRangeAssumingUpgrades(t, BWAPI::UnitTypes::Terran_Marine),   // range vs. ground
+					UnitUtil::GetAttackRangeAssumingUpgrades(t, BWAPI::UnitTypes::Terran_Wraith)    // range vs. air
+				);
+			}
+			return result;
+		}();
+
+		return table[type.getID()];
+	}
+}
+
 // Building morphed from another, not constructed.
 bool UnitUtil::IsMorphedBuildingType(BWAPI::UnitType type)
 {
@@ -77,26 +151,9 @@ bool UnitUtil::IsCombatSimUnit(BWAPI::Unit unit)
 }
 
 // This type is a combat unit type for purposes of combat simulation.
-// Treat workers as non-combat units (overridden above for some workers).
-// The combat simulation does not support spells other than medic healing and stim,
-// and it does not understand detectors.
-// The combat sim treats carriers as the attack unit, not their interceptors (bftjoe).
 bool UnitUtil::IsCombatSimUnit(BWAPI::UnitType type)
 {
-	if (type.isWorker())
-	{
-		return false;
-	}
-
-	if (type == BWAPI::UnitTypes::Protoss_Interceptor)
-	{
-		return false;
-	}
-
-	return
-		TypeCanAttackAir(type) ||
-		TypeCanAttackGround(type) ||
-		type == BWAPI::UnitTypes::Terran_Medic;
+	return Properties(type).combatSimUnit;
 }
 
 bool UnitUtil::IsCombatUnit(BWAPI::UnitType type)
@@ -199,9 +256,7 @@ bool UnitUtil::CanAttackAir(BWAPI::Unit attacker)
 // Assume that a bunker is loaded and can shoot at air.
 bool UnitUtil::TypeCanAttackAir(BWAPI::UnitType attacker)
 {
-	return attacker.airWeapon() != BWAPI::WeaponTypes::None ||
-		attacker == BWAPI::UnitTypes::Terran_Bunker ||
-		attacker == BWAPI::UnitTypes::Protoss_Carrier;
+	return Properties(attacker).canAttackAir;
 }
 
 // NOTE surrenderMonkey() checks CanAttackGround() to see whether the enemy can destroy buildings.
@@ -215,10 +270,7 @@ bool UnitUtil::CanAttackGround(BWAPI::Unit attacker)
 // Assume that a bunker is loaded and can shoot at ground.
 bool UnitUtil::TypeCanAttackGround(BWAPI::UnitType attacker)
 {
-	return attacker.groundWeapon() != BWAPI::WeaponTypes::None ||
-		attacker == BWAPI::UnitTypes::Terran_Bunker ||
-		attacker == BWAPI::UnitTypes::Protoss_Carrier ||
-		attacker == BWAPI::UnitTypes::Protoss_Reaver;
+	return Properties(attacker).canAttackGround;
 }
 
 // NOTE Unused but potentially useful.
@@ -401,10 +453,7 @@ int UnitUtil::GetAttackRangeAssumingUpgrades(BWAPI::UnitType attacker, BWAPI::Un
 // Used in selecting enemy units for the combat sim.
 int UnitUtil::GetMaxAttackRange(BWAPI::UnitType type)
 {
-	return std::max(
-		GetAttackRangeAssumingUpgrades(type, BWAPI::UnitTypes::Terran_Marine),   // range vs. ground
-		GetAttackRangeAssumingUpgrades(type, BWAPI::UnitTypes::Terran_Wraith)    // range vs. air
-	);
+	return Properties(type).maxAttackRange;
 }
 
 // The damage the attacker's weapon will do to a worker. It's good for any small unit.
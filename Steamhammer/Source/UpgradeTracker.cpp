@@ -2,110 +2,212 @@
 
 using namespace UAlbertaBot;
 
-void UpgradeTracker::update(const UIMap & units, LocutusMapGrid & grid)
+namespace
 {
-    for (auto& weaponDamageItem : weaponDamage)
+    // Calls f(const UnitInfo &) for each known unit with the weapon that is at a known position
+    template<class Func>
+    void forEachUnitWithWeapon(const UnitData & units, BWAPI::WeaponType weapon, Func f)
     {
-        int current = _player->damage(weaponDamageItem.first);
-        if (current > weaponDamageItem.second)
+        for (BWAPI::UnitType type : units.getKnownTypes())
         {
-            // Update the grid for all known units with this weapon type
-            for (auto& ui : units)
-                if (ui.second.lastPosition.isValid() &&
-                    !ui.second.goneFromLastPosition &&
-                    (ui.second.type.groundWeapon() == weaponDamageItem.first ||
-                        ui.second.type.airWeapon() == weaponDamageItem.first))
+            if (type.groundWeapon() != weapon && type.airWeapon() != weapon) continue;
+
+            for (const auto ui : units.getUnitsOfType(type))
+            {
+                if (ui->lastPosition.isValid() && !ui->goneFromLastPosition)
                 {
-                    grid.unitWeaponDamageUpgraded(ui.second.type, ui.second.lastPosition, weaponDamageItem.first, weaponDamageItem.second, current);
+                    f(*ui);
                 }
+            }
+        }
+    }
+}
 
-            weaponDamageItem.second = current;
+UpgradeTracker::UpgradeTracker(BWAPI::Player player)
+    : _player(player)
+    , _generation(0)
+{
+    int maxWeaponID = 0;
+    for (const BWAPI::WeaponType & t : BWAPI::WeaponTypes::allWeaponTypes())
+    {
+        maxWeaponID = std::max(maxWeaponID, t.getID());
+    }
+
+    int maxUnitID = 0;
+    for (const BWAPI::UnitType & t : BWAPI::UnitTypes::allUnitTypes())
+    {
+        maxUnitID = std::max(maxUnitID, t.getID());
+    }
+
+    int maxUpgradeID = 0;
+    for (const BWAPI::UpgradeType & t : BWAPI::UpgradeTypes::allUpgradeTypes())
+    {
+        maxUpgradeID = std::max(maxUpgradeID, t.getID());
+    }
+
+    weaponDamage = std::vector<int>(maxWeaponID + 1, -1);
+    weaponRange = std::vector<int>(maxWeaponID + 1, -1);
+    unitCooldown = std::vector<int>(maxUnitID + 1, -1);
+    unitTopSpeed = std::vector<double>(maxUnitID + 1, -1.0);
+    unitArmor = std::vector<int>(maxUnitID + 1, -1);
+
+    UnitStats notComputed = {};
+    notComputed.generation = -1;
+    unitStats = std::vector<UnitStats>(maxUnitID + 1, notComputed);
+
+    upgradeLevels = std::vector<int>(maxUpgradeID + 1, 0);
+}
+
+// Every stat we track is computed by BWAPI from the player's upgrade levels,
+// so there is nothing to do unless an upgrade level has changed.
+bool UpgradeTracker::upgradeLevelsChanged()
+{
+    bool changed = false;
+    for (const BWAPI::UpgradeType & upgrade : BWAPI::UpgradeTypes::allUpgradeTypes())
+    {
+        int level = _player->getUpgradeLevel(upgrade);
+        if (level != upgradeLevels[upgrade.getID()])
+        {
+            upgradeLevels[upgrade.getID()] = level;
+            changed = true;
         }
     }
 
-    for (auto& weaponRangeItem : weaponRange)
+    return changed;
+}
+
+void UpgradeTracker::update(const UnitData & units, LocutusMapGrid & grid)
+{
+    if (!upgradeLevelsChanged()) return;
+
+    for (const BWAPI::WeaponType & weapon : BWAPI::WeaponTypes::allWeaponTypes())
     {
-        int current = _player->weaponMaxRange(weaponRangeItem.first);
-        if (current > weaponRangeItem.second)
+        int & damage = weaponDamage[weapon.getID()];
+        if (damage < 0) continue;
+
+        int current = _player->damage(weapon);
+        if (current > damage)
         {
             // Update the grid for all known units with this weapon type
-            for (auto& ui : units)
-                if (ui.second.lastPosition.isValid() &&
-                    !ui.second.goneFromLastPosition &&
-                    (ui.second.type.groundWeapon() == weaponRangeItem.first ||
-                        ui.second.type.airWeapon() == weaponRangeItem.first))
-                {
-                    grid.unitWeaponRangeUpgraded(ui.second.type, ui.second.lastPosition, weaponRangeItem.first, weaponRangeItem.second, current);
-                }
+            forEachUnitWithWeapon(units, weapon, [&](const UnitInfo & ui)
+            {
+                grid.unitWeaponDamageUpgraded(ui.type, ui.lastPosition, weapon, damage, current);
+            });
 
-            weaponRangeItem.second = current;
+            damage = current;
+            ++_generation;
         }
     }
 
-    for (auto& unitCooldownItem : unitCooldown)
+    for (const BWAPI::WeaponType & weapon : BWAPI::WeaponTypes::allWeaponTypes())
     {
-        int current = _player->weaponDamageCooldown(unitCooldownItem.first);
-        if (current > unitCooldownItem.second)
+        int & range = weaponRange[weapon.getID()];
+        if (range < 0) continue;
+
+        int current = _player->weaponMaxRange(weapon);
+        if (current > range)
         {
-            unitCooldownItem.second = current;
+            // Update the grid for all known units with this weapon type
+            forEachUnitWithWeapon(units, weapon, [&](const UnitInfo & ui)
+            {
+                grid.unitWeaponRangeUpgraded(ui.type, ui.lastPosition, weapon, range, current);
+            });
+
+            range = current;
+            ++_generation;
         }
     }
 
-    for (auto& unitTopSpeedItem : unitTopSpeed)
+    for (const BWAPI::UnitType & type : BWAPI::UnitTypes::allUnitTypes())
     {
-        int current = _player->topSpeed(unitTopSpeedItem.first);
-        if (current > unitTopSpeedItem.second)
+        int id = type.getID();
+
+        if (unitCooldown[id] >= 0)
         {
-            unitTopSpeedItem.second = current;
+            int current = _player->weaponDamageCooldown(type);
+            if (current > unitCooldown[id])
+            {
+                unitCooldown[id] = current;
+                ++_generation;
+            }
         }
-    }
 
-    for (auto& unitArmorItem : unitArmor)
-    {
-        int current = _player->armor(unitArmorItem.first);
-        if (current > unitArmorItem.second)
+        if (unitTopSpeed[id] >= 0)
+        {
+            double current = _player->topSpeed(type);
+            if (current > unitTopSpeed[id])
+            {
+                unitTopSpeed[id] = current;
+                ++_generation;
+            }
+        }
+
+        if (unitArmor[id] >= 0)
         {
-            unitArmorItem.second = current;
+            int current = _player->armor(type);
+            if (current > unitArmor[id])
+            {
+                unitArmor[id] = current;
+                ++_generation;
+            }
         }
     }
 }
 
 int UpgradeTracker::getWeaponDamage(BWAPI::WeaponType wpn)
 {
-    if (weaponDamage.find(wpn) == weaponDamage.end())
-        weaponDamage[wpn] = _player->damage(wpn);
+    int & damage = weaponDamage[wpn.getID()];
+    if (damage < 0) damage = _player->damage(wpn);
 
-    return weaponDamage[wpn];
+    return damage;
 }
 
 int UpgradeTracker::getWeaponRange(BWAPI::WeaponType wpn)
 {
-    if (weaponRange.find(wpn) == weaponRange.end())
-        weaponRange[wpn] = _player->weaponMaxRange(wpn);
+    int & range = weaponRange[wpn.getID()];
+    if (range < 0) range = _player->weaponMaxRange(wpn);
 
-    return weaponRange[wpn];
+    return range;
 }
 
 int UpgradeTracker::getUnitCooldown(BWAPI::UnitType type)
 {
-    if (unitCooldown.find(type) == unitCooldown.end())
-        unitCooldown[type] = _player->weaponDamageCooldown(type);
+    int & cooldown = unitCooldown[type.getID()];
+    if (cooldown < 0) cooldown = _player->weaponDamageCooldown(type);
 
-    return unitCooldown[type];
+    return cooldown;
 }
 
 double UpgradeTracker::getUnitTopSpeed(BWAPI::UnitType type)
 {
-    if (unitTopSpeed.find(type) == unitTopSpeed.end())
-        unitTopSpeed[type] = _player->topSpeed(type);
+    double & speed = unitTopSpeed[type.getID()];
+    if (speed < 0) speed = _player->topSpeed(type);
 
-    return unitTopSpeed[type];
+    return speed;
 }
 
 int UpgradeTracker::getUnitArmor(BWAPI::UnitType type)
 {
-    if (unitArmor.find(type) == unitArmor.end())
-        unitArmor[type] = _player->armor(type);
+    int & armor = unitArmor[type.getID()];
+    if (armor < 0) armor = _player->armor(type);
 
-    return unitArmor[type];
+    return armor;
+}
+
+// All of the upgrade-dependent stats of the unit type, for callers that need several of them.
+const UpgradeTracker::UnitStats & UpgradeTracker::getUnitStats(BWAPI::UnitType type)
+{
+    UnitStats & stats = unitStats[type.getID()];
+    if (stats.generation == _generation) return stats;
+
+    stats.groundDamage = getWeaponDamage(type.groundWeapon());
+    stats.groundRange = getWeaponRange(type.groundWeapon());
+    stats.airDamage = getWeaponDamage(type.airWeapon());
+    stats.airRange = getWeaponRange(type.airWeapon());
+    stats.cooldown = getUnitCooldown(type);
+    stats.topSpeed = getUnitTopSpeed(type);
+    stats.armor = getUnitArmor(type);
+    stats.generation = _generation;
+
+    return stats;
 }
@@ -8,24 +8,53 @@ namespace UAlbertaBot
 {
 class UpgradeTracker 
 {
+public:
+
+    // The upgrade-dependent stats of a unit type, all in one place
+    struct UnitStats
+    {
+        int     groundDamage;
+        int     groundRange;
+        int     airDamage;
+        int     airRange;
+        int     cooldown;
+        double  topSpeed;
+        int     armor;
+        int     generation;     // value of _generation when this was computed
+    };
+
+private:
+
 	BWAPI::Player	_player;
 
-    std::map<BWAPI::WeaponType, int>    weaponDamage;
-    std::map<BWAPI::WeaponType, int>    weaponRange;
-    std::map<BWAPI::UnitType, int>      unitCooldown;
-    std::map<BWAPI::UnitType, double>   unitTopSpeed;
-    std::map<BWAPI::UnitType, int>      unitArmor;
+    // Indexed by weapon or unit type ID. A negative value means we have not looked it up yet.
+    std::vector<int>        weaponDamage;
+    std::vector<int>        weaponRange;
+    std::vector<int>        unitCooldown;
+    std::vector<double>     unitTopSpeed;
+    std::vector<int>        unitArmor;
+
+    // Cached stat blocks by unit type ID, valid only if their generation is current.
+    std::vector<UnitStats>  unitStats;
+    int                     _generation;    // incremented whenever one of the stats above changes
+
+    // The upgrade levels as of the last update; the stats can only change when these do.
+    std::vector<int>        upgradeLevels;
+
+    bool    upgradeLevelsChanged();
 
 public:
 
-    UpgradeTracker(BWAPI::Player player) : _player(player) {};
+    UpgradeTracker(BWAPI::Player player);
 
-    void    update(const UIMap & units, LocutusMapGrid & grid);
+    void    update(const UnitData & units, LocutusMapGrid & grid);
 
     int     getWeaponDamage(BWAPI::WeaponType wpn);
     int     getWeaponRange(BWAPI::WeaponType wpn);
     int     getUnitCooldown(BWAPI::UnitType type);
     double  getUnitTopSpeed(BWAPI::UnitType type);
     int     getUnitArmor(BWAPI::UnitType type);
+
+    const UnitStats & getUnitStats(BWAPI::UnitType type);
 };
 }
@@ -6,13 +6,95 @@ using namespace UAlbertaBot;
 
 WorkerData::WorkerData() 
 {
-    for (const auto unit : BWAPI::Broodwar->getAllUnits())
+}
+
+void WorkerData::SlotLists::add(int slot, int key)
+{
+	if (key >= int(head.size()))
 	{
-		if ((unit->getType() == BWAPI::UnitTypes::Resource_Mineral_Field))
-		{
-            workersOnMineralPatch[unit] = 0;
-		}
+		head.resize(key + 1, -1);
+		count.resize(key + 1, 0);
+	}
+	if (slot >= int(next.size()))
+	{
+		next.resize(slot + 1, -1);
+		prev.resize(slot + 1, -1);
+		keyOf.resize(slot + 1, -1);
+	}
+
+	if (keyOf[slot] != -1) remove(slot);
+
+	next[slot] = head[key];
+	prev[slot] = -1;
+	if (head[key] != -1) prev[head[key]] = slot;
+	head[key] = slot;
+
+	keyOf[slot] = key;
+	++count[key];
+}
+
+void WorkerData::SlotLists::remove(int slot)
+{
+	if (slot >= int(keyOf.size()) || keyOf[slot] == -1) return;
+
+	int key = keyOf[slot];
+	if (prev[slot] != -1) next[prev[slot]] = next[slot];
+	else head[key] = next[slot];
+	if (next[slot] != -1) prev[next[slot]] = prev[slot];
+
+	next[slot] = prev[slot] = keyOf[slot] = -1;
+	--count[key];
+}
+
+int WorkerData::getSlot(BWAPI::Unit unit) const
+{
+	int id = unit->getID();
+	return id < int(slotByUnitID.size()) ? slotByUnitID[id] : -1;
+}
+
+int WorkerData::getOrCreateSlot(BWAPI::Unit unit)
+{
+	int slot = getSlot(unit);
+	if (slot != -1) return slot;
+
+	if (freeSlots.empty())
+	{
+		slot = slotUnit.size();
+		slotUnit.push_back(unit);
+		slotJob.push_back(Default);
+		slotDepot.push_back(nullptr);
+		slotResource.push_back(nullptr);
+		slotRepairUnit.push_back(nullptr);
+		slotBuildingType.push_back(BWAPI::UnitTypes::None);
+		slotMoveData.push_back(WorkerMoveData());
+	}
+	else
+	{
+		slot = freeSlots.back();
+		freeSlots.pop_back();
+		slotUnit[slot] = unit;
 	}
+
+	int id = unit->getID();
+	if (id >= int(slotByUnitID.size())) slotByUnitID.resize(id + 1, -1);
+	slotByUnitID[id] = slot;
+
+	slotJob[slot] = Default;
+	byJob.add(slot, Default);
+
+	return slot;
+}
+
+// The unit must have no job.
+void WorkerData::freeSlot(BWAPI::Unit unit)
+{
+	int slot = getSlot(unit);
+	if (slot == -1) return;
+
+	byJob.remove(slot);
+	slotUnit[slot] = nullptr;
+	slotByUnitID[unit->getID()] = -1;
+	freeSlots.push_back(slot);
 }
 
 void WorkerData::workerDestroyed(BWAPI::Unit unit)
@@ -20,6 +102,7 @@ void WorkerData::workerDestroyed(BWAPI::Unit unit)
 	if (!unit) { return; }
 
 	clearPreviousJob(unit);
+	freeSlot(unit);
 	workers.erase(unit);
 }
 
@@ -28,7 +111,7 @@ void WorkerData::addWorker(BWAPI::Unit unit)
 	if (!unit || !unit->exists()) { return; }
 
 	workers.insert(unit);
-	workerJobMap[unit] = Default;
+	getOrCreateSlot(unit);
 }
 
 void WorkerData::addWorker(BWAPI::Unit unit, WorkerJob job, BWAPI::Unit jobUnit)
@@ -56,7 +139,6 @@ void WorkerData::addDepot(BWAPI::Unit unit)
 
 	assert(depots.find(unit) == depots.end());
 	depots.insert(unit);
-	depotWorkerCount[unit] = 0;
 }
 
 void WorkerData::removeDepot(BWAPI::Unit unit)
@@ -64,49 +146,37 @@ void WorkerData::removeDepot(BWAPI::Unit unit)
 	if (!unit) { return; }
 
 	depots.erase(unit);
-	depotWorkerCount.erase(unit);
+	mineralAssignments.erase(unit);
 
-	// re-balance workers in here
-	for (auto & worker : workers)
+	// re-balance workers in here: idle any worker that was working at this depot
+	for (int slot = byDepot.first(unit->getID()); slot != -1; )
 	{
-		// if a worker was working at this depot
-		if (workerDepotMap[worker] == unit)
-		{
-			setWorkerJob(worker, Idle, nullptr);
-		}
+		int next = byDepot.nextSlot(slot);
+		setWorkerJob(slotUnit[slot], Idle, nullptr);
+		slot = next;
 	}
 }
 
-void WorkerData::addToMineralPatch(BWAPI::Unit unit, int num)
-{
-    if (workersOnMineralPatch.find(unit) == workersOnMineralPatch.end())
-    {
-        workersOnMineralPatch[unit] = num;
-    }
-    else
-    {
-        workersOnMineralPatch[unit] += num;
-    }
-}
-
 void WorkerData::setWorkerJob(BWAPI::Unit unit, WorkerJob job, BWAPI::Unit jobUnit)
 {
 	if (!unit || !unit->exists()) { return; }
 
 	clearPreviousJob(unit);
-	workerJobMap[unit] = job;
+
+	int slot = getOrCreateSlot(unit);
+	slotJob[slot] = job;
+	byJob.add(slot, job);
 
 	if (job == Minerals)
 	{
-		// increase the number of workers assigned to this nexus
-		depotWorkerCount[jobUnit] += 1;
+		// set the depot the worker is working at, which increases its worker count
+		slotDepot[slot] = jobUnit;
+		byDepot.add(slot, jobUnit->getID());
+		getMineralAssignment(jobUnit).setDirty();
 
 		// set the mineral the worker is working on
-		workerDepotMap[unit] = jobUnit;
-
         BWAPI::Unit mineralToMine = getMineralToMine(unit);
-        workerMineralAssignment[unit] = mineralToMine;
-        addToMineralPatch(mineralToMine, 1);
+        setPatch(slot, mineralToMine);
 
         // If we are a long way away from the depot, move towards it
         if (unit->getDistance(jobUnit) > 200)
@@ -118,11 +188,9 @@ void WorkerData::setWorkerJob(BWAPI::Unit unit, WorkerJob job, BWAPI::Unit jobUn
 	}
 	else if (job == Gas)
 	{
-		// increase the count of workers assigned to this refinery
-		refineryWorkerCount[jobUnit] += 1;
-
-		// set the refinery the worker is working on
-		workerRefineryMap[unit] = jobUnit;
+		// set the refinery the worker is working on, which increases its worker count
+		slotResource[slot] = jobUnit;
+		if (jobUnit) byResource.add(slot, jobUnit->getID());
 
 		// right click the refinery to start harvesting
 		Micro::RightClick(unit, jobUnit);
@@ -133,7 +201,7 @@ void WorkerData::setWorkerJob(BWAPI::Unit unit, WorkerJob job, BWAPI::Unit jobUn
         assert(unit->getType() == BWAPI::UnitTypes::Terran_SCV);
 
         // set the building the worker is to repair
-        workerRepairMap[unit] = jobUnit;
+        slotRepairUnit[slot] = jobUnit;
 
         // start repairing 
         if (!unit->isRepairing())
@@ -156,14 +224,16 @@ void WorkerData::setWorkerJob(BWAPI::Unit unit, WorkerJob job, BWAPI::UnitType j
 	if (!unit) { return; }
 
 	clearPreviousJob(unit);
-	workerJobMap[unit] = job;
+
+	int slot = getOrCreateSlot(unit);
+	slotJob[slot] = job;
+	byJob.add(slot, job);
 
 	if (job == Build)
 	{
-		workerBuildingTypeMap[unit] = jobUnitType;
+		slotBuildingType[slot] = jobUnitType;
 	}
-
-	if (workerJobMap[unit] != Build)
+	else
 	{
 		//BWAPI::Broodwar->printf("Something went horribly wrong");
 	}
@@ -174,14 +244,16 @@ void WorkerData::setWorkerJob(BWAPI::Unit unit, WorkerJob job, WorkerMoveData wm
 	if (!unit) { return; }
 
 	clearPreviousJob(unit);
-	workerJobMap[unit] = job;
+
+	int slot = getOrCreateSlot(unit);
+	slotJob[slot] = job;
+	byJob.add(slot, job);
 
 	if (job == Move)
 	{
-		workerMoveMap[unit] = wmd;
+		slotMoveData[slot] = wmd;
 	}
-
-	if (workerJobMap[unit] != Move)
+	else
 	{
 		//BWAPI::Broodwar->printf("Something went horribly wrong");
 	}
@@ -191,39 +263,25 @@ void WorkerData::clearPreviousJob(BWAPI::Unit unit)
 {
 	if (!unit) { return; }
 
-	WorkerJob previousJob = getWorkerJob(unit);
+	int slot = getSlot(unit);
+	if (slot == -1) { return; }
 
-	if (previousJob == Minerals)
-	{
-		depotWorkerCount[workerDepotMap[unit]] -= 1;
-
-		workerDepotMap.erase(unit);
-
-        // remove a worker from this unit's assigned mineral patch
-        addToMineralPatch(workerMineralAssignment[unit], -1);
-
-        // erase the association from the map
-        workerMineralAssignment.erase(unit);
-	}
-	else if (previousJob == Gas)
+	// Leave the depot and resource lists, which reduces their worker counts
+	if (slotDepot[slot])
 	{
-		refineryWorkerCount[workerRefineryMap[unit]] -= 1;
-		workerRefineryMap.erase(unit);
-	}
-	else if (previousJob == Build)
-	{
-		workerBuildingTypeMap.erase(unit);
-	}
-	else if (previousJob == Repair)
-	{
-		workerRepairMap.erase(unit);
-	}
-	else if (previousJob == Move)
-	{
-		workerMoveMap.erase(unit);
+		auto it = mineralAssignments.find(slotDepot[slot]);
+		if (it != mineralAssignments.end()) it->second.setDirty();
 	}
+	byDepot.remove(slot);
+	byResource.remove(slot);
+
+	slotDepot[slot] = nullptr;
+	slotResource[slot] = nullptr;
+	slotRepairUnit[slot] = nullptr;
+	slotBuildingType[slot] = BWAPI::UnitTypes::None;
 
-	workerJobMap.erase(unit);
+	slotJob[slot] = Default;
+	byJob.add(slot, Default);
 }
 
 int WorkerData::getNumWorkers() const
@@ -233,81 +291,35 @@ int WorkerData::getNumWorkers() const
 
 int WorkerData::getNumMineralWorkers() const
 {
-	size_t num = 0;
-	for (auto & unit : workers)
-	{
-		if (workerJobMap.at(unit) == WorkerData::Minerals)
-		{
-			num++;
-		}
-	}
-	return num;
+	return byJob.size(Minerals);
 }
 
 int WorkerData::getNumGasWorkers() const
 {
-	size_t num = 0;
-	for (auto & unit : workers)
-	{
-		if (workerJobMap.at(unit) == WorkerData::Gas)
-		{
-			num++;
-		}
-	}
-	return num;
+	return byJob.size(Gas);
 }
 
 int WorkerData::getNumReturnCargoWorkers() const
 {
-	size_t num = 0;
-	for (auto & unit : workers)
-	{
-		if (workerJobMap.at(unit) == WorkerData::ReturnCargo)
-		{
-			num++;
-		}
-	}
-	return num;
+	return byJob.size(ReturnCargo);
 }
 
 int WorkerData::getNumCombatWorkers() const
 {
-	size_t num = 0;
-	for (auto & unit : workers)
-	{
-		if (workerJobMap.at(unit) == WorkerData::Combat)
-		{
-			num++;
-		}
-	}
-	return num;
+	return byJob.size(Combat);
 }
 
 int WorkerData::getNumIdleWorkers() const
 {
-	size_t num = 0;
-	for (auto & unit : workers)
-	{
-		if (workerJobMap.at(unit) == WorkerData::Idle)
-		{
-			num++;
-		}
-	}
-	return num;
+	return byJob.size(Idle);
 }
 
 enum WorkerData::WorkerJob WorkerData::getWorkerJob(BWAPI::Unit unit)
 {
 	if (!unit) { return Default; }
 
-	std::map<BWAPI::Unit, enum WorkerJob>::iterator it = workerJobMap.find(unit);
-
-	if (it != workerJobMap.end())
-	{
-		return it->second;
-	}
-
-	return Default;
+	int slot = getSlot(unit);
+	return slot == -1 ? Default : slotJob[slot];
 }
 
 bool WorkerData::depotIsFull(BWAPI::Unit depot)
@@ -354,6 +366,18 @@ int WorkerData::getMineralsNearDepot(BWAPI::Unit depot)
 {
 	if (!depot) { return 0; }
 
+	// This is called for each depot whenever we look for a depot that needs workers, so cache it for the frame
+	int id = depot->getID();
+	if (id >= int(mineralsNearDepotFrame.size()))
+	{
+		mineralsNearDepotFrame.resize(id + 1, -1);
+		mineralsNearDepotCount.resize(id + 1, 0);
+	}
+	if (mineralsNearDepotFrame[id] == BWAPI::Broodwar->getFrameCount())
+	{
+		return mineralsNearDepotCount[id];
+	}
+
 	int mineralsNearDepot = 0;
 
 	for (auto & unit : BWAPI::Broodwar->getAllUnits())
@@ -364,6 +388,9 @@ int WorkerData::getMineralsNearDepot(BWAPI::Unit depot)
 		}
 	}
 
+	mineralsNearDepotFrame[id] = BWAPI::Broodwar->getFrameCount();
+	mineralsNearDepotCount[id] = mineralsNearDepot;
+
 	return mineralsNearDepot;
 }
 
@@ -371,25 +398,11 @@ BWAPI::Unit WorkerData::getWorkerResource(BWAPI::Unit unit)
 {
 	if (!unit) { return nullptr; }
 
-	// create the iterator
-	std::map<BWAPI::Unit, BWAPI::Unit>::iterator it;
-	
-	// if the worker is mining, set the iterator to the mineral map
-	if (getWorkerJob(unit) == Minerals)
+	// only mineral and gas workers have a resource
+	int slot = getSlot(unit);
+	if (slot != -1 && (slotJob[slot] == Minerals || slotJob[slot] == Gas))
 	{
-		it = workerMineralAssignment.find(unit);
-		if (it != workerMineralAssignment.end())
-		{
-			return it->second;
-		}	
-	}
-	else if (getWorkerJob(unit) == Gas)
-	{
-		it = workerRefineryMap.find(unit);
-		if (it != workerRefineryMap.end())
-		{
-			return it->second;
-		}	
+		return slotResource[slot];
 	}
 
 	return nullptr;
@@ -401,114 +414,112 @@ BWAPI::Unit WorkerData::getMineralToMine(BWAPI::Unit worker)
 
 	// get the depot associated with this unit
 	BWAPI::Unit depot = getWorkerDepot(worker);
-	BWAPI::Unit bestMineral = nullptr;
-	int bestDist = 100000;
-    int bestNumAssigned = 10000;
+	if (!depot) { return nullptr; }
+
+	// Take the patch where one more worker adds the most income.
+	// The base is re-solved as a whole in updateMineralAssignments().
+	MineralAssignment & assignment = getMineralAssignment(depot);
+	assignment.setPatches(getMineralPatchesNearDepot(depot));
+
+	return assignment.choosePatch([this](BWAPI::Unit mineral) { return byResource.size(mineral->getID()); });
+}
+
+MineralAssignment & WorkerData::getMineralAssignment(BWAPI::Unit depot)
+{
+	auto it = mineralAssignments.find(depot);
+	if (it == mineralAssignments.end())
+	{
+		it = mineralAssignments.emplace(depot, MineralAssignment(depot)).first;
+	}
+	return it->second;
+}
+
+void WorkerData::setPatch(int slot, BWAPI::Unit patch)
+{
+	slotResource[slot] = patch;
+	if (patch) byResource.add(slot, patch->getID());
+	else byResource.remove(slot);
+}
+
+// Re-solve the worker to patch assignment of each base whose workers or patches have changed.
+// Workers that get a new patch are sent there by WorkerManager's mineral locking.
+void WorkerData::updateMineralAssignments()
+{
+	std::vector<BWAPI::Unit> baseWorkers;
+	std::vector<BWAPI::Unit> patchOf;
 
-	if (depot)
+	for (const auto depot : depots)
 	{
-        BWAPI::Unitset mineralPatches = getMineralPatchesNearDepot(depot);
+		MineralAssignment & assignment = getMineralAssignment(depot);
+		if (!assignment.isDirty()) continue;
+
+		assignment.setPatches(getMineralPatchesNearDepot(depot));
 
-		for (const auto mineral : mineralPatches)
+		baseWorkers.clear();
+		patchOf.clear();
+		for (int slot = byDepot.first(depot->getID()); slot != -1; slot = byDepot.nextSlot(slot))
 		{
-				int dist = mineral->getDistance(depot);
-                int numAssigned = workersOnMineralPatch[mineral];
-
-                if (numAssigned < bestNumAssigned ||
-					numAssigned == bestNumAssigned && dist < bestDist)
-                {
-                    bestMineral = mineral;
-                    bestDist = dist;
-                    bestNumAssigned = numAssigned;
-                }
+			baseWorkers.push_back(slotUnit[slot]);
+			patchOf.push_back(slotResource[slot]);
 		}
-	}
 
-	return bestMineral;
+		assignment.solve(baseWorkers, patchOf);
+
+		for (size_t i = 0; i < baseWorkers.size(); ++i)
+		{
+			int slot = getSlot(baseWorkers[i]);
+			if (slotResource[slot] != patchOf[i])
+			{
+				setPatch(slot, patchOf[i]);
+			}
+		}
+	}
 }
 
 BWAPI::Unit WorkerData::getWorkerRepairUnit(BWAPI::Unit unit)
 {
 	if (!unit) { return nullptr; }
 
-	std::map<BWAPI::Unit, BWAPI::Unit>::iterator it = workerRepairMap.find(unit);
-
-	if (it != workerRepairMap.end())
-	{
-		return it->second;
-	}	
-
-	return nullptr;
+	int slot = getSlot(unit);
+	return slot == -1 ? nullptr : slotRepairUnit[slot];
 }
 
 BWAPI::Unit WorkerData::getWorkerDepot(BWAPI::Unit unit)
 {
 	if (!unit) { return nullptr; }
 
-	std::map<BWAPI::Unit, BWAPI::Unit>::iterator it = workerDepotMap.find(unit);
-
-	if (it != workerDepotMap.end())
-	{
-		return it->second;
-	}	
-
-	return nullptr;
+	int slot = getSlot(unit);
+	return slot == -1 ? nullptr : slotDepot[slot];
 }
 
 BWAPI::UnitType	WorkerData::getWorkerBuildingType(BWAPI::Unit unit)
 {
 	if (!unit) { return BWAPI::UnitTypes::None; }
 
-	std::map<BWAPI::Unit, BWAPI::UnitType>::iterator it = workerBuildingTypeMap.find(unit);
-
-	if (it != workerBuildingTypeMap.end())
-	{
-		return it->second;
-	}	
-
-	return BWAPI::UnitTypes::None;
+	int slot = getSlot(unit);
+	return slot == -1 ? BWAPI::UnitTypes::None : slotBuildingType[slot];
 }
 
 WorkerMoveData WorkerData::getWorkerMoveData(BWAPI::Unit unit)
 {
-	std::map<BWAPI::Unit, WorkerMoveData>::iterator it = workerMoveMap.find(unit);
+	int slot = getSlot(unit);
 
-	assert(it != workerMoveMap.end());
+	assert(slot != -1 && slotJob[slot] == Move);
 	
-	return (it->second);
+	return slotMoveData[slot];
 }
 
 int WorkerData::getNumAssignedWorkers(BWAPI::Unit unit)
 {
 	if (!unit) { return 0; }
 
-	std::map<BWAPI::Unit, int>::iterator it;
-	
-	// if the worker is mining, set the iterator to the mineral map
 	if (unit->getType().isResourceDepot())
 	{
-		it = depotWorkerCount.find(unit);
-
-		// if there is an entry, return it
-		if (it != depotWorkerCount.end())
-		{
-			return it->second;
-		}
+		return byDepot.size(unit->getID());
 	}
 	else if (unit->getType().isRefinery())
 	{
-		it = refineryWorkerCount.find(unit);
-
-		// if there is an entry, return it
-		if (it != refineryWorkerCount.end())
-		{
-			return it->second;
-		}
-		// otherwise, we are only calling this on completed refineries, so set it
-		else
-		{
-			refineryWorkerCount[unit] = 0;
-		}
+		return byResource.size(unit->getID());
 	}
 
 	// when all else fails, return 0
@@ -534,15 +545,6 @@ char WorkerData::getJobCode(BWAPI::Unit unit)
 	return 'X';
 }
 
-// Add all gas workers to the given set.
-void WorkerData::getGasWorkers(std::set<BWAPI::Unit> & mw)
-{
-	for (auto kv : workerRefineryMap)
-	{
-		mw.insert(kv.first);
-	}
-}
-
 void WorkerData::drawDepotDebugInfo()
 {
 	for (const auto depot : depots)
@@ -560,11 +562,8 @@ void WorkerData::drawDepotDebugInfo()
             int x = mineral->getPosition().x;
 		    int y = mineral->getPosition().y;
 
-            if (workersOnMineralPatch.find(mineral) != workersOnMineralPatch.end())
-            {
-                 //if (Config::Debug::DRAW_UALBERTABOT_DEBUG) BWAPI::Broodwar->drawBoxMap(x-2, y-1, x+75, y+14, BWAPI::Colors::Black, true);
-                 //if (Config::Debug::DRAW_UALBERTABOT_DEBUG) BWAPI::Broodwar->drawTextMap(x, y, "\x04 Workers: %d", workersOnMineralPatch[mineral]);
-            }
+            //if (Config::Debug::DRAW_UALBERTABOT_DEBUG) BWAPI::Broodwar->drawBoxMap(x-2, y-1, x+75, y+14, BWAPI::Colors::Black, true);
+            //if (Config::Debug::DRAW_UALBERTABOT_DEBUG) BWAPI::Broodwar->drawTextMap(x, y, "\x04 Workers: %d", byResource.size(mineral->getID()));
         }
 	}
 }
\ No newline at end of file
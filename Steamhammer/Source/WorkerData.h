@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Common.h"
+#include "MineralAssignment.h"
 
 namespace UAlbertaBot
 {
@@ -31,21 +32,54 @@ public:
 
 private:
 
+	// Intrusive doubly linked lists of worker slots, one list per key.
+	// A slot is in at most one list of each SlotLists, and counts are kept up to date.
+	class SlotLists
+	{
+		std::vector<int> head;		// by key: first slot in the list, or -1
+		std::vector<int> count;		// by key: number of slots in the list
+		std::vector<int> next;		// by slot
+		std::vector<int> prev;		// by slot
+		std::vector<int> keyOf;		// by slot: the list the slot is in, or -1
+
+	public:
+		void	add(int slot, int key);
+		void	remove(int slot);
+		int		size(int key) const { return key >= 0 && key < int(count.size()) ? count[key] : 0; };
+		int		first(int key) const { return key >= 0 && key < int(head.size()) ? head[key] : -1; };
+		int		nextSlot(int slot) const { return next[slot]; };
+	};
+
 	BWAPI::Unitset workers;
 	BWAPI::Unitset depots;
 
-	std::map<BWAPI::Unit, enum WorkerJob>	workerJobMap;           // worker -> job
-	std::map<BWAPI::Unit, BWAPI::Unit>		workerDepotMap;         // worker -> resource depot (hatchery)
-	std::map<BWAPI::Unit, BWAPI::Unit>		workerRefineryMap;      // worker -> refinery
-	std::map<BWAPI::Unit, BWAPI::Unit>		workerRepairMap;        // worker -> unit to repair
-	std::map<BWAPI::Unit, WorkerMoveData>	workerMoveMap;          // worker -> location
-	std::map<BWAPI::Unit, BWAPI::UnitType>	workerBuildingTypeMap;  // worker -> building type
+	// The worker table. Each worker has a slot, and each field is an array indexed by slot.
+	std::vector<int>				slotByUnitID;		// unit ID -> slot, or -1
+	std::vector<int>				freeSlots;
+	std::vector<BWAPI::Unit>		slotUnit;
+	std::vector<WorkerJob>			slotJob;
+	std::vector<BWAPI::Unit>		slotDepot;			// resource depot, for mineral workers
+	std::vector<BWAPI::Unit>		slotResource;		// mineral patch or refinery
+	std::vector<BWAPI::Unit>		slotRepairUnit;		// unit to repair
+	std::vector<BWAPI::UnitType>	slotBuildingType;	// building type, for builders
+	std::vector<WorkerMoveData>		slotMoveData;		// location, for move workers
+
+	SlotLists						byJob;				// key: job
+	SlotLists						byDepot;			// key: depot unit ID, for mineral workers
+	SlotLists						byResource;			// key: mineral patch or refinery unit ID
+
+	std::map<BWAPI::Unit, MineralAssignment>	mineralAssignments;		// depot -> assignment of its mineral workers to patches
+
+	// Mineral count near each depot, by depot unit ID, cached for the frame
+	std::vector<int>				mineralsNearDepotFrame;
+	std::vector<int>				mineralsNearDepotCount;
 
-	std::map<BWAPI::Unit, int>				depotWorkerCount;       // mineral workers per depot
-	std::map<BWAPI::Unit, int>				refineryWorkerCount;    // gas workers per refinery
+	int		getSlot(BWAPI::Unit unit) const;
+	int		getOrCreateSlot(BWAPI::Unit unit);
+	void	freeSlot(BWAPI::Unit unit);
 
-    std::map<BWAPI::Unit, int>				workersOnMineralPatch;  // workers per mineral patch
-    std::map<BWAPI::Unit, BWAPI::Unit>		workerMineralAssignment;// worker -> mineral patch
+	MineralAssignment &	getMineralAssignment(BWAPI::Unit depot);
+	void				setPatch(int slot, BWAPI::Unit patch);
 
 	void clearPreviousJob(BWAPI::Unit unit);
 
@@ -71,10 +105,29 @@ public:
 	int						getNumIdleWorkers() const;
 	char					getJobCode(BWAPI::Unit unit);
 
-	void					getMineralWorkers(std::set<BWAPI::Unit> & mw);
-	void					getGasWorkers(std::set<BWAPI::Unit> & mw);
-	void					getBuildingWorkers(std::set<BWAPI::Unit> & mw);
-	void					getRepairWorkers(std::set<BWAPI::Unit> & mw);
+	// Call f(worker) for each worker with the job, or assigned to the mineral patch or refinery.
+	// f may change the job of the worker it is given, but not of any other worker.
+	template<class Func>
+	void forEachWorker(WorkerJob job, Func f)
+	{
+		for (int slot = byJob.first(job); slot != -1; )
+		{
+			int next = byJob.nextSlot(slot);
+			f(slotUnit[slot]);
+			slot = next;
+		}
+	}
+
+	template<class Func>
+	void forEachWorkerOnResource(BWAPI::Unit resource, Func f)
+	{
+		for (int slot = byResource.first(resource->getID()); slot != -1; )
+		{
+			int next = byResource.nextSlot(slot);
+			f(slotUnit[slot]);
+			slot = next;
+		}
+	}
 	
 	bool					depotIsFull(BWAPI::Unit depot);
 	int						getMineralsNearDepot(BWAPI::Unit depot);
@@ -90,7 +143,7 @@ public:
 	WorkerMoveData			getWorkerMoveData(BWAPI::Unit unit);
 
     BWAPI::Unitset          getMineralPatchesNearDepot(BWAPI::Unit depot);
-    void                    addToMineralPatch(BWAPI::Unit unit, int num);
+	void					updateMineralAssignments();
 	void					drawDepotDebugInfo();
 
 	const BWAPI::Unitset & getWorkers() const { return workers; }
@@ -8,6 +8,13 @@
 
 using namespace UAlbertaBot;
 
+namespace
+{
+	// Mineral income is measured over a window of IncomeSamples samples, this many frames apart.
+	const int IncomeSampleFrames = 24;
+	const size_t IncomeSamples = 30;
+}
+
 WorkerManager::WorkerManager() 
 	: previousClosestWorker(nullptr)
 	, _collectGas(true)
@@ -37,6 +44,8 @@ void WorkerManager::update()
 	handleRepairWorkers();
 	handleMineralLocking(); // Do this last since the workers might get reassigned elsewhere first
 
+	updateMineralIncome();
+
 	drawResourceDebugInfo();
 	drawWorkerInformation(450,20);
 
@@ -197,16 +206,13 @@ void WorkerManager::handleGasWorkers()
 				else
 				{
 					// The refinery has no depot to return gas to. Remove any gas workers.
-					std::set<BWAPI::Unit> gasWorkers;
-					workerData.getGasWorkers(gasWorkers);
-					for (const auto gasWorker : gasWorkers)
+					workerData.forEachWorkerOnResource(refinery, [&](BWAPI::Unit gasWorker)
 					{
-						if (refinery == workerData.getWorkerResource(gasWorker) &&
-							gasWorker->getOrder() != BWAPI::Orders::HarvestGas)  // not inside the refinery
+						if (gasWorker->getOrder() != BWAPI::Orders::HarvestGas)  // not inside the refinery
 						{
 							workerData.setWorkerJob(gasWorker, WorkerData::Idle, nullptr);
 						}
-					}
+					});
 				}
 			}
 		}
@@ -214,9 +220,7 @@ void WorkerManager::handleGasWorkers()
 	else
 	{
 		// Don't gather gas: If workers are assigned to gas anywhere, take them off.
-		std::set<BWAPI::Unit> gasWorkers;
-		workerData.getGasWorkers(gasWorkers);
-		for (const auto gasWorker : gasWorkers)
+		workerData.forEachWorker(WorkerData::Gas, [&](BWAPI::Unit gasWorker)
 		{
 			if (gasWorker->getOrder() != BWAPI::Orders::HarvestGas)    // not inside the refinery
 			{
@@ -224,7 +228,7 @@ void WorkerManager::handleGasWorkers()
 				// An idle worker carrying gas will become a ReturnCargo worker,
 				// so gas will not be lost needlessly.
 			}
-		}
+		});
 	}
 }
 
@@ -343,6 +347,8 @@ void WorkerManager::handleRepairWorkers()
 
 void WorkerManager::handleMineralLocking()
 {
+	workerData.updateMineralAssignments();
+
 	for (const auto worker : workerData.getWorkers())
 	{
 		if (workerData.getWorkerJob(worker) != WorkerData::Minerals) continue;
@@ -375,15 +381,10 @@ void WorkerManager::handleMineralLocking()
 
 		// Check if another worker is currently mining this patch
 		BWAPI::Unit otherWorker = nullptr;
-		for (const auto other : workerData.getWorkers())
+		workerData.forEachWorkerOnResource(patch, [&](BWAPI::Unit other)
 		{
-			if (other == worker) continue;
-			if (workerData.getWorkerResource(other) == patch)
-			{
-				otherWorker = other;
-				break;
-			}
-		}
+			if (!otherWorker && other != worker) otherWorker = other;
+		});
 
 		// Resend the gather command when we expect the other worker to be finished mining in 9+LF frames
 		if (otherWorker && otherWorker->getOrder() == BWAPI::Orders::MiningMinerals &&
@@ -394,7 +395,7 @@ void WorkerManager::handleMineralLocking()
 			int dist = worker->getDistance(patch);
 			if (dist > 20 && worker->getLastCommandFrame() < (BWAPI::Broodwar->getFrameCount()-20)) continue;
 
-			// Log().Debug() << worker->getID() << ": mp=" << patch->getID() << "; resent because other worker soon to finish";
+			// LOG_DEBUG << worker->getID() << ": mp=" << patch->getID() << "; resent because other worker soon to finish";
 			Micro::RightClick(worker, patch);
 			continue;
 		}
@@ -406,7 +407,7 @@ void WorkerManager::handleMineralLocking()
 			if (worker->getOrderTarget() && worker->getOrderTarget()->getResources() && worker->getOrderTarget() != patch
 				&& worker->getLastCommandFrame() < (BWAPI::Broodwar->getFrameCount() - BWAPI::Broodwar->getLatencyFrames()))
 			{
-				// Log().Debug() << worker->getID() << ": mp=" << patch->getID() << "; resent because switched target";
+				// LOG_DEBUG << worker->getID() << ": mp=" << patch->getID() << "; resent because switched target";
 				Micro::RightClick(worker, patch);
 			}
 
@@ -414,7 +415,7 @@ void WorkerManager::handleMineralLocking()
 		}
 
 		// Otherwise for all other orders click on the mineral patch
-		// Log().Debug() << worker->getID() << ": mp=" << patch->getID() << "; sent because fell through";
+		// LOG_DEBUG << worker->getID() << ": mp=" << patch->getID() << "; sent because fell through";
 		Micro::RightClick(worker, patch);
 	}
 }
@@ -1103,6 +1104,44 @@ int WorkerManager::getNumGasWorkers() const
 	return workerData.getNumGasWorkers();
 }
 
+void WorkerManager::updateMineralIncome()
+{
+	const int now = BWAPI::Broodwar->getFrameCount();
+	if (!_incomeSamples.empty() && now - _incomeSamples.back().frame < IncomeSampleFrames)
+	{
+		return;
+	}
+
+	_incomeSamples.push_back(IncomeSample{ now, BWAPI::Broodwar->self()->gatheredMinerals(), getNumMineralWorkers() });
+	if (_incomeSamples.size() > IncomeSamples)
+	{
+		_incomeSamples.pop_front();
+	}
+}
+
+// Minerals gathered per frame for each mineral worker, over the last samples.
+// Each stretch between samples is weighted by the mineral workers at its start.
+// 0 until there is a full window to measure.
+double WorkerManager::getMineralIncomePerWorker() const
+{
+	if (_incomeSamples.size() < IncomeSamples)
+	{
+		return 0.0;
+	}
+
+	double workerFrames = 0.0;
+	for (size_t i = 0; i + 1 < _incomeSamples.size(); ++i)
+	{
+		workerFrames += double(_incomeSamples[i].mineralWorkers) * (_incomeSamples[i + 1].frame - _incomeSamples[i].frame);
+	}
+	if (workerFrames <= 0.0)
+	{
+		return 0.0;
+	}
+
+	return (_incomeSamples.back().gatheredMinerals - _incomeSamples.front().gatheredMinerals) / workerFrames;
+}
+
 int WorkerManager::getNumReturnCargoWorkers() const
 {
 	return workerData.getNumReturnCargoWorkers();
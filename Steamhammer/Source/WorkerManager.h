@@ -16,6 +16,17 @@ class WorkerManager
 	bool		_collectGas;
     BWAPI::Unit proxyBuilder;
 
+	// Samples of minerals gathered so far and mineral workers, taken every IncomeSampleFrames
+	struct IncomeSample
+	{
+		int frame;
+		int gatheredMinerals;
+		int mineralWorkers;
+	};
+	std::deque<IncomeSample> _incomeSamples;
+
+	void		updateMineralIncome();
+
 	void        setMineralWorker(BWAPI::Unit unit);
 	void        setReturnCargoWorker(BWAPI::Unit unit);
 	bool		refineryHasDepot(BWAPI::Unit refinery);
@@ -53,6 +64,7 @@ public:
 
     int         getNumMineralWorkers() const;
     int         getNumGasWorkers() const;
+	double		getMineralIncomePerWorker() const;	// measured minerals per mineral worker per frame, or 0 if unknown
 	int         getNumReturnCargoWorkers() const;
 	int			getNumCombatWorkers() const;
 	int         getNumIdleWorkers() const;
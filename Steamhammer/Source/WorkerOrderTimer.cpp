@@ -167,7 +167,7 @@ namespace WorkerOrderTimer
         //     if ((moveFrames + waitFrames) % 100 == 0) Log().Get() << "Move+wait frames: " << (moveFrames+waitFrames);
         // }
 
-        // Log().Debug() << worker->getID() << ": mp=" << resource->getID() << "; fr=" << (BWAPI::Broodwar->getFrameCount() - worker->getLastCommandFrame())
+        // LOG_DEBUG << worker->getID() << ": mp=" << resource->getID() << "; fr=" << (BWAPI::Broodwar->getFrameCount() - worker->getLastCommandFrame())
         //     << "; o=" << worker->getOrder() << "; o=" << worker->getOrderTimer() << "; dist=" << worker->getDistance(resource)
         //     << ((worker->getOrder() == BWAPI::Orders::MoveToMinerals && dist==0) ? "; MOVEWAIT" : "")
         //     << (((BWAPI::Broodwar->getFrameCount() - 10) % 150 == 0) ? "; RESET" : "");
@@ -193,7 +193,7 @@ namespace WorkerOrderTimer
                     auto result = optimalOrderPositions.erase(frameAndPos.second);
                     // if (result > 0)
                     // {
-                    //     Log().Debug() << worker->getID() << ": mp=" << resource->getID() << "; erase " << frameAndPos.second;
+                    //     LOG_DEBUG << worker->getID() << ": mp=" << resource->getID() << "; erase " << frameAndPos.second;
                     // }
                 }
 
@@ -203,7 +203,7 @@ namespace WorkerOrderTimer
                 //     std::ostringstream debug;
                 //     debug << worker->getID() << ": mp=" << resource->getID() << "; insert " << positionIt->second;
                 //     for (auto & frameAndPos : positionHistory) if (frameAndPos.first >= (frame - 2)) debug << "; " << frameAndPos.second;
-                //     Log().Debug() << debug.str();
+                //     LOG_DEBUG << debug.str();
                 // }
             }
 
@@ -218,7 +218,7 @@ namespace WorkerOrderTimer
         if (worker->getOrder() == BWAPI::Orders::MoveToMinerals &&
             optimalOrderPositions.find(currentPositionAndVelocity) != optimalOrderPositions.end())
         {
-            // Log().Debug() << worker->getID() << ": mp=" << resource->getID() << "; issuing order"; 
+            // LOG_DEBUG << worker->getID() << ": mp=" << resource->getID() << "; issuing order"; 
 
             UAlbertaBot::Micro::RightClick(worker, resource);
             positionHistory.emplace(std::make_pair(BWAPI::Broodwar->getFrameCount(), currentPositionAndVelocity));
@@ -0,0 +1,184 @@
+#include "WorldSnapshot.h"
+
+using namespace UAlbertaBot;
+
+namespace
+{
+	// Same as BWAPI's getDistance() for two unit boxes
+	int boxDistance(int left1, int top1, int right1, int bottom1, int left2, int top2, int right2, int bottom2)
+	{
+		int xDist = (std::max)((std::max)(left1 - right2 - 1, left2 - 1 - right1), 0);
+		int yDist = (std::max)((std::max)(top1 - bottom2 - 1, top2 - 1 - bottom1), 0);
+		return BWAPI::Positions::Origin.getApproxDistance(BWAPI::Position(xDist, yDist));
+	}
+}
+
+WorldSnapshot::WorldSnapshot()
+	: frame(-1)
+{
+}
+
+WorldSnapshot & WorldSnapshot::Instance()
+{
+	static WorldSnapshot instance;
+	return instance;
+}
+
+// Our units that fight: not buildings, and not workers, which micro seldom controls.
+bool WorldSnapshot::IsSnapshotUnit(BWAPI::UnitType type)
+{
+	return !type.isBuilding() && !type.isWorker();
+}
+
+void WorldSnapshot::update()
+{
+	frame = BWAPI::Broodwar->getFrameCount();
+
+	const BWAPI::Unitset & enemyUnits = BWAPI::Broodwar->enemy()->getUnits();
+	const BWAPI::Unitset & ourUnits = BWAPI::Broodwar->self()->getUnits();
+	const size_t n = enemyUnits.size() + ourUnits.size();
+
+	// clear() keeps the capacity, so after the first frames this does not allocate.
+	for (auto * v : { &id, &x, &y, &left, &top, &right, &bottom,
+		&hitPoints, &shields, &energy, &groundCooldown, &airCooldown, &acidSpores, &orderTarget })
+	{
+		v->clear();
+		v->reserve(n);
+	}
+	for (auto * v : { &velocityX, &velocityY })
+	{
+		v->clear();
+		v->reserve(n);
+	}
+	unit.clear();
+	unit.reserve(n);
+	owner.clear();
+	owner.reserve(n);
+	type.clear();
+	type.reserve(n);
+	order.clear();
+	order.reserve(n);
+	targetPosition.clear();
+	targetPosition.reserve(n);
+	flags.clear();
+	flags.reserve(n);
+
+	std::fill(_indexByID.begin(), _indexByID.end(), -1);
+
+	for (const auto u : enemyUnits)
+	{
+		add(u, Enemy);
+	}
+	for (const auto u : ourUnits)
+	{
+		if (IsSnapshotUnit(u->getType()))
+		{
+			add(u, Self);
+		}
+	}
+
+	// Order targets, now that every unit has its index.
+	for (const auto u : unit)
+	{
+		orderTarget.push_back(index(u->getOrderTarget()));
+	}
+}
+
+void WorldSnapshot::add(BWAPI::Unit u, Owner unitOwner)
+{
+	const int i = unit.size();
+	const int unitID = u->getID();
+	if (unitID >= int(_indexByID.size()))
+	{
+		_indexByID.resize(unitID + 1, -1);
+	}
+	_indexByID[unitID] = i;
+
+	const BWAPI::UnitType unitType = u->getType();
+	const BWAPI::Position pos = u->getPosition();
+
+	unit.push_back(u);
+	id.push_back(unitID);
+	type.push_back(unitType);
+	owner.push_back(unitOwner);
+
+	x.push_back(pos.x);
+	y.push_back(pos.y);
+	left.push_back(pos.x - unitType.dimensionLeft());
+	top.push_back(pos.y - unitType.dimensionUp());
+	right.push_back(pos.x + unitType.dimensionRight());
+	bottom.push_back(pos.y + unitType.dimensionDown());
+
+	velocityX.push_back(float(u->getVelocityX()));
+	velocityY.push_back(float(u->getVelocityY()));
+
+	hitPoints.push_back(u->getHitPoints());
+	shields.push_back(u->getShields());
+	energy.push_back(u->getEnergy());
+	groundCooldown.push_back(u->getGroundWeaponCooldown());
+	airCooldown.push_back(u->getAirWeaponCooldown());
+	acidSpores.push_back(u->getAcidSporeCount());
+
+	const BWAPI::Order unitOrder = u->getOrder();
+	order.push_back(unitOrder);
+	targetPosition.push_back(u->getTargetPosition());
+
+	unsigned int f = 0;
+	if (u->isCompleted())			f |= Completed;
+	if (u->isFlying())				f |= Flying;
+	if (u->isVisible())				f |= Visible;
+	if (u->isDetected())			f |= Detected;
+	if (u->isCloaked())				f |= Cloaked;
+	if (u->isBurrowed())			f |= Burrowed;
+	if (u->isMoving())				f |= Moving;
+	if (u->isBraking())				f |= Braking;
+	if (u->isSieged())				f |= Sieged;
+	if (unitOrder == BWAPI::Orders::Sieging ||
+		unitOrder == BWAPI::Orders::Unsieging)	f |= Sieging;
+	if (u->isAttacking())			f |= Attacking;
+	if (u->isAttackFrame())			f |= AttackFrame;
+	if (u->isIdle())				f |= Idle;
+	if (u->isLifted())				f |= Lifted;
+	if (u->isPowered())				f |= Powered;
+	if (u->isUnderAttack())			f |= UnderAttack;
+	if (u->isUnderDarkSwarm())		f |= UnderDarkSwarm;
+	if (u->isUnderStorm())			f |= UnderStorm;
+	if (u->isDefenseMatrixed())		f |= DefenseMatrixed;
+	if (u->isStasised())			f |= Stasised;
+	if (u->isLockedDown())			f |= LockedDown;
+	if (u->isIrradiated())			f |= Irradiated;
+	if (u->isPlagued())				f |= Plagued;
+	if (u->isEnsnared())			f |= Ensnared;
+	if (u->isStimmed())				f |= Stimmed;
+	flags.push_back(f);
+}
+
+int WorldSnapshot::index(BWAPI::Unit u) const
+{
+	if (!u)
+	{
+		return -1;
+	}
+	const int unitID = u->getID();
+	return unitID >= 0 && unitID < int(_indexByID.size()) ? _indexByID[unitID] : -1;
+}
+
+int WorldSnapshot::distance(int i, int j) const
+{
+	return boxDistance(left[i], top[i], right[i], bottom[i], left[j], top[j], right[j], bottom[j]);
+}
+
+int WorldSnapshot::distance(int i, BWAPI::Position point) const
+{
+	int xDist = left[i] - point.x;
+	if (xDist < 0)
+	{
+		xDist = (std::max)(0, point.x - (right[i] + 1));
+	}
+	int yDist = top[i] - point.y;
+	if (yDist < 0)
+	{
+		yDist = (std::max)(0, point.y - (bottom[i] + 1));
+	}
+	return BWAPI::Positions::Origin.getApproxDistance(BWAPI::Position(xDist, yDist));
+}
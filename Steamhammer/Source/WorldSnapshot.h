@@ -0,0 +1,113 @@
+#pragma once
+
+#include "Common.h"
+
+// The units that micro looks at, read once at the start of the frame into flat arrays, one
+// array per field: every enemy unit that BWAPI shows us, and our own combat units. Neutral,
+// allied, worker and building units are left out; code that needs them calls BWAPI. Code that
+// looks at many units each frame reads the snapshot instead of calling into BWAPI unit by unit.
+// The snapshot is rebuilt only in update(), on the main thread, and does not change for the
+// rest of the frame. Jobs (see JobSystem) may read it freely, since they must not call BWAPI.
+// Units are by index; the index of a unit is good only for the current frame.
+
+namespace UAlbertaBot
+{
+
+class WorldSnapshot
+{
+public:
+	enum Owner { Self, Enemy };
+
+	enum Flag
+	{
+		Completed		= 1 << 0,
+		Flying			= 1 << 1,
+		Visible			= 1 << 2,
+		Detected		= 1 << 3,
+		Cloaked			= 1 << 4,
+		Burrowed		= 1 << 5,
+		Moving			= 1 << 6,
+		Braking			= 1 << 7,
+		Sieged			= 1 << 8,
+		Sieging			= 1 << 9,		// sieging or unsieging
+		Attacking		= 1 << 10,
+		AttackFrame		= 1 << 11,
+		Idle			= 1 << 12,
+		Lifted			= 1 << 13,
+		Powered			= 1 << 14,
+		UnderAttack		= 1 << 15,
+		UnderDarkSwarm	= 1 << 16,
+		UnderStorm		= 1 << 17,
+		DefenseMatrixed	= 1 << 18,
+		Stasised		= 1 << 19,
+		LockedDown		= 1 << 20,
+		Irradiated		= 1 << 21,
+		Plagued			= 1 << 22,
+		Ensnared		= 1 << 23,
+		Stimmed			= 1 << 24,
+	};
+
+private:
+	std::vector<int>		_indexByID;		// unit ID -> index, or -1
+
+	WorldSnapshot();
+
+	void add(BWAPI::Unit u, Owner unitOwner);
+
+public:
+
+	static WorldSnapshot & Instance();
+
+	// Whether the snapshot takes a unit of ours of this type.
+	static bool IsSnapshotUnit(BWAPI::UnitType type);
+
+	// Main thread only.
+	void update();
+
+	int	frame;
+
+	std::vector<BWAPI::Unit>		unit;
+	std::vector<int>				id;
+	std::vector<BWAPI::UnitType>	type;
+	std::vector<char>				owner;
+
+	std::vector<int>				x;
+	std::vector<int>				y;
+
+	// Bounding boxes, as BWAPI measures unit distances from them
+	std::vector<int>				left;
+	std::vector<int>				top;
+	std::vector<int>				right;
+	std::vector<int>				bottom;
+
+	std::vector<float>				velocityX;
+	std::vector<float>				velocityY;
+
+	std::vector<int>				hitPoints;
+	std::vector<int>				shields;
+	std::vector<int>				energy;
+	std::vector<int>				groundCooldown;
+	std::vector<int>				airCooldown;
+	std::vector<int>				acidSpores;
+
+	std::vector<BWAPI::Order>		order;
+	std::vector<int>				orderTarget;		// index of the order target, or -1 if not in the snapshot
+	std::vector<BWAPI::Position>	targetPosition;
+
+	std::vector<unsigned int>		flags;
+
+	int size() const { return unit.size(); };
+
+	// -1 if the unit is not in the snapshot.
+	int index(BWAPI::Unit u) const;
+
+	bool is(int i, Flag flag) const { return (flags[i] & flag) != 0; };
+
+	BWAPI::Position position(int i) const { return BWAPI::Position(x[i], y[i]); };
+
+	// Same as BWAPI's getDistance() between two units, and between a unit and a point.
+	int distance(int i, int j) const;
+	int distance(int i, BWAPI::Position point) const;
+};
+
+}
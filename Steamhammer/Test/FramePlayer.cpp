@@ -0,0 +1,527 @@
+#include "FramePlayer.h"
+
+#include "GameRecord.h"
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+using namespace UAlbertaBot;
+
+namespace
+{
+	// Read lengths of runs of alternating values, starting with false, up to the given total.
+	std::vector<bool> getRuns(const char *& data, const char * end, size_t total)
+	{
+		std::vector<bool> values;
+		bool value = false;
+		while (values.size() < total)
+		{
+			const size_t run = size_t(GameRecord::getNumber(data, end));
+			if (values.size() + run > total)
+			{
+				throw game_record_read_error();
+			}
+			values.insert(values.end(), run, value);
+			value = !value;
+		}
+		return values;
+	}
+
+	// Read the indexes of the values that changed.
+	std::vector<int> getFlips(const char *& data, const char * end, int size)
+	{
+		const int n = GameRecord::getNumber(data, end);
+		std::vector<int> flips;
+		int index = -1;
+		for (int i = 0; i < n; ++i)
+		{
+			index += GameRecord::getNumber(data, end) + 1;
+			if (index >= size)
+			{
+				throw game_record_read_error();
+			}
+			flips.push_back(index);
+		}
+		return flips;
+	}
+}
+
+FramePlayer::FramePlayer()
+	: _data(nullptr)
+	, _end(nullptr)
+	, _selfID(0)
+{
+}
+
+int FramePlayer::playerID(int recordedID) const
+{
+	const auto it = _players.find(recordedID);
+	return it == _players.end() ? _game->neutral()->getID() : it->second->getID();
+}
+
+int FramePlayer::unitID(int recordedID) const
+{
+	const auto it = _units.find(recordedID);
+	return it == _units.end() ? -1 : it->second->getID();
+}
+
+bool FramePlayer::open(const std::string & filename)
+{
+	std::ifstream file(filename, std::ios::binary);
+	if (!file.good())
+	{
+		return false;
+	}
+	std::ostringstream contents;
+	contents << file.rdbuf();
+	_input = contents.str();
+	_data = _input.data();
+	_end = _data + _input.size();
+
+	try
+	{
+		readHeader();
+	}
+	catch (const game_record_read_error &)
+	{
+		Log().Get() << "Frame record " << filename << " is bad";
+		_game.reset();
+		return false;
+	}
+	return true;
+}
+
+void FramePlayer::readHeader()
+{
+	if (_input.compare(0, FrameRecord::Magic.size(), FrameRecord::Magic) != 0)
+	{
+		throw game_record_read_error();
+	}
+	_data += FrameRecord::Magic.size();
+	if (GameRecord::getNumber(_data, _end) != FrameRecord::Version)
+	{
+		throw game_record_read_error();
+	}
+
+	const int width = GameRecord::getNumber(_data, _end);
+	const int height = GameRecord::getNumber(_data, _end);
+	std::string mapName = FrameRecord::getString(_data, _end);
+	if ((mapName.size() > 4 && mapName.compare(mapName.size() - 4, 4, ".scx") == 0) ||
+		(mapName.size() > 4 && mapName.compare(mapName.size() - 4, 4, ".scm") == 0))
+	{
+		mapName.resize(mapName.size() - 4);
+	}
+	_game.reset(new HeadlessGame(width, height, mapName));
+	_game->useRecordedVision();
+
+	const std::vector<bool> walkable = getRuns(_data, _end, size_t(16 * width * height));
+	for (int y = 0; y < 4 * height; ++y)
+	{
+		for (int x = 0; x < 4 * width; ++x)
+		{
+			_game->setWalkable(x, y, walkable[y * 4 * width + x]);
+		}
+	}
+
+	const std::vector<bool> buildable = getRuns(_data, _end, size_t(width * height));
+	for (int y = 0; y < height; ++y)
+	{
+		for (int x = 0; x < width; ++x)
+		{
+			_game->setBuildable(x, y, buildable[y * width + x]);
+		}
+	}
+
+	for (int i = 0; i < width * height; )
+	{
+		const int groundHeight = GameRecord::getNumber(_data, _end);
+		const int run = GameRecord::getNumber(_data, _end);
+		if (i + run > width * height)
+		{
+			throw game_record_read_error();
+		}
+		for (int end = i + run; i < end; ++i)
+		{
+			_game->setGroundHeight(i % width, i / width, groundHeight);
+		}
+	}
+
+	const int nStarts = GameRecord::getNumber(_data, _end);
+	for (int i = 0; i < nStarts; ++i)
+	{
+		const int x = GameRecord::getNumber(_data, _end);
+		const int y = GameRecord::getNumber(_data, _end);
+		_game->addStartLocation(BWAPI::TilePosition(x, y));
+	}
+
+	for (int i = 0; i < 2; ++i)
+	{
+		const int id = GameRecord::getNumber(_data, _end);
+		const std::string name = FrameRecord::getString(_data, _end);
+		const BWAPI::Race race(GameRecord::getNumber(_data, _end));
+		const int x = FrameRecord::getSigned(_data, _end);
+		const int y = FrameRecord::getSigned(_data, _end);
+		HeadlessPlayer * player = _game->addPlayer(name, race, BWAPI::TilePosition(x, y));
+		_players[id] = player;
+		_recordedPlayers.push_back(player);
+	}
+	_players[GameRecord::getNumber(_data, _end)] = _game->getHeadlessPlayer(_game->neutral());
+	_selfID = _game->self()->getID();
+
+	FrameRecord::PlayerFields zeros;
+	zeros.fill(0);
+	_playerFields.assign(_recordedPlayers.size(), zeros);
+
+	const int nStatics = GameRecord::getNumber(_data, _end);
+	for (int i = 0; i < nStatics; ++i)
+	{
+		const int id = GameRecord::getNumber(_data, _end);
+		const BWAPI::UnitType type(GameRecord::getNumber(_data, _end));
+		const int x = GameRecord::getNumber(_data, _end);
+		const int y = GameRecord::getNumber(_data, _end);
+		HeadlessUnit * unit = _game->addUnit(type, _game->neutral(), BWAPI::Position(x, y));
+		unit->data().resources = GameRecord::getNumber(_data, _end);
+		_units[id] = unit;
+	}
+}
+
+// Read the next frame into the game. False at the end of the recording.
+bool FramePlayer::readFrame()
+{
+	if (_data == _end)
+	{
+		return false;
+	}
+	if (GameRecord::getNumber(_data, _end) != 'F')
+	{
+		throw game_record_read_error();
+	}
+	_game->setFrameCount(GameRecord::getNumber(_data, _end));
+
+	readPlayers();
+	readTiles();
+	readUnits();
+	readBullets();
+	return true;
+}
+
+void FramePlayer::readPlayers()
+{
+	for (size_t p = 0; p < _recordedPlayers.size(); ++p)
+	{
+		FrameRecord::PlayerFields & fields = _playerFields[p];
+		const int mask = GameRecord::getNumber(_data, _end);
+		for (int i = 0; i < FrameRecord::NumPlayerFields; ++i)
+		{
+			if (mask & (1 << i))
+			{
+				fields[i] += FrameRecord::getSigned(_data, _end);
+			}
+		}
+
+		BWAPI::PlayerData & data = _recordedPlayers[p]->data();
+		data.minerals = fields[FrameRecord::Minerals];
+		data.gas = fields[FrameRecord::Gas];
+		data.gatheredMinerals = fields[FrameRecord::GatheredMinerals];
+		data.gatheredGas = fields[FrameRecord::GatheredGas];
+
+		const int nUpgrades = GameRecord::getNumber(_data, _end);
+		for (int i = 0; i < nUpgrades; ++i)
+		{
+			const int upgrade = GameRecord::getNumber(_data, _end);
+			const int value = GameRecord::getNumber(_data, _end);
+			if (upgrade >= BWAPI::UpgradeTypes::Enum::MAX)
+			{
+				throw game_record_read_error();
+			}
+			data.upgradeLevel[upgrade] = value / 2;
+			data.isUpgrading[upgrade] = (value & 1) != 0;
+		}
+
+		const int nTechs = GameRecord::getNumber(_data, _end);
+		for (int i = 0; i < nTechs; ++i)
+		{
+			const int tech = GameRecord::getNumber(_data, _end);
+			const int value = GameRecord::getNumber(_data, _end);
+			if (tech >= BWAPI::TechTypes::Enum::MAX)
+			{
+				throw game_record_read_error();
+			}
+			data.hasResearched[tech] = value / 2 != 0;
+			data.isResearching[tech] = (value & 1) != 0;
+		}
+	}
+}
+
+void FramePlayer::readTiles()
+{
+	const int width = _game->mapWidth();
+	const int size = width * _game->mapHeight();
+
+	for (int i : getFlips(_data, _end, size))
+	{
+		_game->setVisible(i % width, i / width, !_game->isVisible(i % width, i / width));
+	}
+	for (int i : getFlips(_data, _end, size))
+	{
+		_game->setCreep(i % width, i / width, !_game->hasCreep(i % width, i / width));
+	}
+}
+
+void FramePlayer::readUnits()
+{
+	FrameRecord::UnitFields zeros;
+	zeros.fill(0);
+
+	const int nChanged = GameRecord::getNumber(_data, _end);
+	int id = -1;
+	for (int n = 0; n < nChanged; ++n)
+	{
+		id += GameRecord::getNumber(_data, _end) + 1;
+		int masks[2];
+		masks[0] = GameRecord::getNumber(_data, _end);
+		masks[1] = GameRecord::getNumber(_data, _end);
+
+		auto it = _unitFields.find(id);
+		if (it == _unitFields.end())
+		{
+			it = _unitFields.insert(std::make_pair(id, zeros)).first;
+		}
+		FrameRecord::UnitFields & fields = it->second;
+
+		for (int i = 0; i < FrameRecord::NumUnitFields; ++i)
+		{
+			if (masks[i / FrameRecord::MaskBits] & (1 << (i % FrameRecord::MaskBits)))
+			{
+				if (i == FrameRecord::Flags)
+				{
+					fields[i] = GameRecord::getNumber(_data, _end);
+				}
+				else
+				{
+					fields[i] += FrameRecord::getSigned(_data, _end);
+				}
+			}
+		}
+
+		if (_units.find(id) == _units.end())
+		{
+			_units[id] = _game->addUnit(
+				BWAPI::UnitType(fields[FrameRecord::Type]),
+				_game->getPlayer(playerID(fields[FrameRecord::Player])),
+				BWAPI::Position(fields[FrameRecord::PositionX], fields[FrameRecord::PositionY]));
+		}
+	}
+
+	const int nLost = GameRecord::getNumber(_data, _end);
+	id = -1;
+	for (int n = 0; n < nLost; ++n)
+	{
+		id += GameRecord::getNumber(_data, _end) + 1;
+		const bool destroyed = GameRecord::getNumber(_data, _end) != 0;
+
+		_unitFields.erase(id);
+		const auto it = _units.find(id);
+		if (it != _units.end())
+		{
+			BWAPI::UnitData & data = it->second->data();
+			if (destroyed)
+			{
+				data.exists = false;
+			}
+			data.isVisible[_selfID] = false;
+		}
+	}
+
+	// Apply every unit, not only those that changed, so that references to units that
+	// came into the game later are filled in.
+	for (const auto & idFields : _unitFields)
+	{
+		applyUnit(_units[idFields.first], idFields.second);
+	}
+}
+
+void FramePlayer::applyUnit(HeadlessUnit * unit, const FrameRecord::UnitFields & fields)
+{
+	using namespace FrameRecord;
+
+	BWAPI::UnitData & data = unit->data();
+
+	data.exists = true;
+	data.type = fields[Type];
+	data.player = playerID(fields[Player]);
+	data.positionX = fields[PositionX];
+	data.positionY = fields[PositionY];
+	data.angle = fields[Angle] / Scale;
+	data.velocityX = fields[VelocityX] / Scale;
+	data.velocityY = fields[VelocityY] / Scale;
+	data.hitPoints = fields[HitPoints];
+	data.shields = fields[Shields];
+	data.energy = fields[Energy];
+	data.resources = fields[Resources];
+	data.resourceGroup = fields[ResourceGroup];
+	data.groundWeaponCooldown = fields[GroundWeaponCooldown];
+	data.airWeaponCooldown = fields[AirWeaponCooldown];
+	data.spellCooldown = fields[SpellCooldown];
+	data.order = fields[Order];
+	data.orderTarget = unitID(fields[OrderTarget]);
+	data.orderTargetPositionX = fields[OrderTargetPositionX];
+	data.orderTargetPositionY = fields[OrderTargetPositionY];
+	data.secondaryOrder = fields[SecondaryOrder];
+	data.target = unitID(fields[Target]);
+	data.targetPositionX = fields[TargetPositionX];
+	data.targetPositionY = fields[TargetPositionY];
+	data.buildType = fields[BuildType];
+	data.buildUnit = unitID(fields[BuildUnit]);
+	data.trainingQueueCount = (std::min)(fields[TrainingQueueCount], 5);
+	for (int i = 0; i < data.trainingQueueCount; ++i)
+	{
+		data.trainingQueue[i] = fields[TrainingQueueFront];
+	}
+	data.remainingBuildTime = fields[RemainingBuildTime];
+	data.remainingTrainTime = fields[RemainingTrainTime];
+	data.remainingResearchTime = fields[RemainingResearchTime];
+	data.remainingUpgradeTime = fields[RemainingUpgradeTime];
+	data.tech = fields[Tech];
+	data.upgrade = fields[Upgrade];
+	data.transport = unitID(fields[Transport]);
+	data.carrier = unitID(fields[Carrier]);
+	data.hatchery = unitID(fields[Hatchery]);
+	data.addon = unitID(fields[Addon]);
+	data.interceptorCount = fields[InterceptorCount];
+	data.scarabCount = fields[ScarabCount];
+	data.spiderMineCount = fields[SpiderMineCount];
+	data.killCount = fields[KillCount];
+	data.carryResourceType = fields[CarryResourceType];
+	data.stimTimer = fields[StimTimer];
+	data.lockdownTimer = fields[LockdownTimer];
+	data.stasisTimer = fields[StasisTimer];
+	data.maelstromTimer = fields[MaelstromTimer];
+	data.ensnareTimer = fields[EnsnareTimer];
+	data.irradiateTimer = fields[IrradiateTimer];
+	data.plagueTimer = fields[PlagueTimer];
+	data.defenseMatrixPoints = fields[DefenseMatrixPoints];
+	data.acidSporeCount = fields[AcidSporeCount];
+	data.rallyPositionX = fields[RallyPositionX];
+	data.rallyPositionY = fields[RallyPositionY];
+	data.rallyUnit = unitID(fields[RallyUnit]);
+
+	const int flags = fields[Flags];
+	auto flag = [flags](UnitFlag f) { return (flags & (1 << f)) != 0; };
+	data.isCompleted = flag(Completed);
+	data.isMorphing = flag(Morphing);
+	data.isConstructing = flag(Constructing);
+	data.isIdle = flag(Idle);
+	data.isMoving = flag(Moving);
+	data.isAttacking = flag(Attacking);
+	data.isAttackFrame = flag(AttackFrame);
+	data.isStartingAttack = flag(StartingAttack);
+	data.isGathering = flag(Gathering);
+	data.isBeingGathered = flag(BeingGathered);
+	data.isBurrowed = flag(Burrowed);
+	data.isCloaked = flag(Cloaked);
+	data.isDetected = flag(Detected);
+	data.isLifted = flag(Lifted);
+	data.isTraining = flag(Training);
+	data.recentlyAttacked = flag(UnderAttack);
+	data.isPowered = flag(Powered);
+	data.isStuck = flag(Stuck);
+	data.isInterruptible = flag(Interruptible);
+	data.isInvincible = flag(Invincible);
+	data.isHallucination = flag(Hallucination);
+	data.isBlind = flag(Blind);
+	data.isParasited = flag(Parasited);
+	data.isUnderStorm = flag(UnderStorm);
+	data.isUnderDarkSwarm = flag(UnderDarkSwarm);
+	data.isUnderDWeb = flag(UnderDisruptionWeb);
+	data.isBraking = flag(Braking);
+	data.isAccelerating = flag(Accelerating);
+	data.hasNuke = flag(HasNuke);
+	data.isVisible[_selfID] = flag(Visible);
+}
+
+void FramePlayer::readBullets()
+{
+	for (const auto & idBullet : _bullets)
+	{
+		idBullet.second->data().exists = false;
+	}
+
+	const int n = GameRecord::getNumber(_data, _end);
+	for (int i = 0; i < n; ++i)
+	{
+		const int id = FrameRecord::getSigned(_data, _end);
+		const BWAPI::BulletType type(FrameRecord::getSigned(_data, _end));
+		const int player = FrameRecord::getSigned(_data, _end);
+
+		auto it = _bullets.find(id);
+		if (it == _bullets.end())
+		{
+			it = _bullets.insert(std::make_pair(id, _game->addBullet(type, nullptr, BWAPI::Positions::None))).first;
+		}
+		BWAPI::BulletData & data = it->second->data();
+
+		data.exists = true;
+		data.type = type;
+		data.player = player < 0 ? -1 : playerID(player);
+		data.source = unitID(FrameRecord::getSigned(_data, _end));
+		data.target = unitID(FrameRecord::getSigned(_data, _end));
+		data.positionX = FrameRecord::getSigned(_data, _end);
+		data.positionY = FrameRecord::getSigned(_data, _end);
+		data.targetPositionX = FrameRecord::getSigned(_data, _end);
+		data.targetPositionY = FrameRecord::getSigned(_data, _end);
+		data.removeTimer = FrameRecord::getSigned(_data, _end);
+		data.isVisible[_selfID] = GameRecord::getNumber(_data, _end) != 0;
+	}
+}
+
+void FramePlayer::run(BWAPI::AIModule & module)
+{
+	typedef std::chrono::steady_clock Clock;
+
+	try
+	{
+		while (readFrame())
+		{
+			const Clock::time_point start = Clock::now();
+			if (_frameMilliseconds.empty())
+			{
+				_game->start(module);
+			}
+			else
+			{
+				_game->step();
+			}
+			_frameMilliseconds.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+		}
+	}
+	catch (const game_record_read_error &)
+	{
+		Log().Get() << "Frame record is bad after " << _frameMilliseconds.size() << " frames";
+	}
+}
+
+std::string FramePlayer::summary() const
+{
+	if (_frameMilliseconds.empty())
+	{
+		return "Playback: no frames";
+	}
+
+	std::vector<double> sorted(_frameMilliseconds);
+	std::sort(sorted.begin(), sorted.end());
+	double total = 0.0;
+	for (double ms : sorted)
+	{
+		total += ms;
+	}
+
+	std::ostringstream msg;
+	msg << std::fixed << std::setprecision(3)
+		<< "Playback: " << sorted.size() << " frames"
+		<< ", mean / p95 / max ms per frame " << total / sorted.size()
+		<< " / " << sorted[size_t(0.95 * (sorted.size() - 1))]
+		<< " / " << sorted.back();
+	return msg.str();
+}
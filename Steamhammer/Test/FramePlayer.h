@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Common.h"
+
+#include "FrameRecorder.h"
+#include "HeadlessGame.h"
+
+#include <memory>
+
+// Plays back a game recorded by FrameRecorder through a HeadlessGame, as a benchmark.
+// Each frame the recorded state is put into the game, then the bot runs the frame and is
+// timed. The bot's commands have no effect on the game, so a playback always runs the
+// bot on the same states, though the bot itself may make different decisions.
+// The game is not ended, so that the bot does not write its opponent model.
+
+namespace UAlbertaBot
+{
+
+class FramePlayer
+{
+	std::string				_input;
+	const char *			_data;
+	const char *			_end;
+
+	std::unique_ptr<HeadlessGame>	_game;
+	int						_selfID;					// in the game, not the recording
+
+	// Recorded IDs to the headless game's objects.
+	std::map<int, HeadlessPlayer *>		_players;
+	std::map<int, HeadlessUnit *>		_units;
+	std::map<int, HeadlessBullet *>		_bullets;
+
+	std::vector<HeadlessPlayer *>		_recordedPlayers;	// us and the enemy
+	std::vector<FrameRecord::PlayerFields>	_playerFields;
+	std::map<int, FrameRecord::UnitFields>	_unitFields;	// units we see, as of this frame
+
+	std::vector<double>		_frameMilliseconds;
+
+	void readHeader();
+	bool readFrame();
+	void readPlayers();
+	void readTiles();
+	void readUnits();
+	void readBullets();
+	void applyUnit(HeadlessUnit * unit, const FrameRecord::UnitFields & fields);
+
+	int playerID(int recordedID) const;
+	int unitID(int recordedID) const;
+
+public:
+
+	FramePlayer();
+
+	// Read the recording and set up the game. False if the file is missing or bad.
+	bool open(const std::string & filename);
+
+	// Run the bot on each recorded frame in turn.
+	void run(BWAPI::AIModule & module);
+
+	int frames() const { return int(_frameMilliseconds.size()); };
+
+	// The number of frames played and how long the bot took over them.
+	std::string summary() const;
+
+	HeadlessGame & game() { return *_game; };
+};
+
+}
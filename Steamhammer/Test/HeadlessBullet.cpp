@@ -0,0 +1,47 @@
+#include "HeadlessBullet.h"
+
+#include "HeadlessGame.h"
+
+#include <cstring>
+
+using namespace UAlbertaBot;
+
+HeadlessBullet::HeadlessBullet(HeadlessGame & game, int id, BWAPI::BulletType type, BWAPI::Player player, BWAPI::Position position)
+	: _game(game)
+{
+	std::memset(&_data, 0, sizeof(_data));
+
+	_data.id = id;
+	_data.player = player ? player->getID() : -1;
+	_data.type = type;
+	_data.source = -1;
+	_data.positionX = position.x;
+	_data.positionY = position.y;
+	_data.target = -1;
+	_data.targetPositionX = position.x;
+	_data.targetPositionY = position.y;
+	_data.exists = true;
+	if (player && player->getID() < 9)
+	{
+		_data.isVisible[player->getID()] = true;
+	}
+}
+
+int HeadlessBullet::getID() const { return _data.id; }
+bool HeadlessBullet::exists() const { return _data.exists; }
+BWAPI::Player HeadlessBullet::getPlayer() const { return _game.getPlayer(_data.player); }
+BWAPI::BulletType HeadlessBullet::getType() const { return BWAPI::BulletType(_data.type); }
+BWAPI::Unit HeadlessBullet::getSource() const { return _game.getUnit(_data.source); }
+BWAPI::Position HeadlessBullet::getPosition() const { return BWAPI::Position(_data.positionX, _data.positionY); }
+double HeadlessBullet::getAngle() const { return _data.angle; }
+double HeadlessBullet::getVelocityX() const { return _data.velocityX; }
+double HeadlessBullet::getVelocityY() const { return _data.velocityY; }
+BWAPI::Unit HeadlessBullet::getTarget() const { return _game.getUnit(_data.target); }
+BWAPI::Position HeadlessBullet::getTargetPosition() const { return BWAPI::Position(_data.targetPositionX, _data.targetPositionY); }
+int HeadlessBullet::getRemoveTimer() const { return _data.removeTimer; }
+
+bool HeadlessBullet::isVisible(BWAPI::Player player) const
+{
+	const int id = player ? player->getID() : _game.self()->getID();
+	return id >= 0 && id < 9 && _data.isVisible[id];
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Common.h"
+
+#include <BWAPI/Client/BulletData.h>
+
+// A bullet of a HeadlessGame, kept in BWAPI's own BulletData layout like HeadlessUnit.
+// A bullet is removed by setting its exists flag to false.
+
+namespace UAlbertaBot
+{
+
+class HeadlessGame;
+
+class HeadlessBullet : public BWAPI::BulletInterface
+{
+	HeadlessGame &		_game;
+	BWAPI::BulletData	_data;
+
+public:
+
+	HeadlessBullet(HeadlessGame & game, int id, BWAPI::BulletType type, BWAPI::Player player, BWAPI::Position position);
+
+	BWAPI::BulletData & data() { return _data; };
+
+	int getID() const override;
+	bool exists() const override;
+	BWAPI::Player getPlayer() const override;
+	BWAPI::BulletType getType() const override;
+	BWAPI::Unit getSource() const override;
+	BWAPI::Position getPosition() const override;
+	double getAngle() const override;
+	double getVelocityX() const override;
+	double getVelocityY() const override;
+	BWAPI::Unit getTarget() const override;
+	BWAPI::Position getTargetPosition() const override;
+	int getRemoveTimer() const override;
+	bool isVisible(BWAPI::Player player = nullptr) const override;
+};
+
+}
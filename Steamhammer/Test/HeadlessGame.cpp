@@ -0,0 +1,969 @@
+#include "HeadlessGame.h"
+
+#include <climits>
+#include <cstdarg>
+#include <cstdio>
+#include <functional>
+
+using namespace UAlbertaBot;
+
+namespace
+{
+	// The shape of a pylon's power field, in tiles around the pylon. As in BWAPI.
+	const bool PsiFieldMask[10][16] =
+	{
+		{ 0,0,0,0,0,1,1,1,1,1,1,0,0,0,0,0 },
+		{ 0,0,1,1,1,1,1,1,1,1,1,1,1,1,0,0 },
+		{ 0,1,1,1,1,1,1,1,1,1,1,1,1,1,1,0 },
+		{ 1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1 },
+		{ 1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1 },
+		{ 1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1 },
+		{ 1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1 },
+		{ 0,1,1,1,1,1,1,1,1,1,1,1,1,1,1,0 },
+		{ 0,0,1,1,1,1,1,1,1,1,1,1,1,1,0,0 },
+		{ 0,0,0,0,0,1,1,1,1,1,1,0,0,0,0,0 }
+	};
+}
+
+HeadlessGame::HeadlessGame(int mapWidth, int mapHeight, const std::string & mapName)
+	: _module(nullptr)
+	, _frameCount(0)
+	, _inGame(false)
+	, _revealAll(false)
+	, _recordedVision(false)
+	, _lastError(BWAPI::Errors::None)
+	, _mapWidth(mapWidth)
+	, _mapHeight(mapHeight)
+	, _mapName(mapName)
+	, _walkable(mapWidth * mapHeight * 16, true)
+	, _groundHeight(mapWidth * mapHeight, 2)
+	, _buildable(mapWidth * mapHeight, true)
+	, _visible(mapWidth * mapHeight, false)
+	, _explored(mapWidth * mapHeight, false)
+	, _creep(mapWidth * mapHeight, false)
+	, _self(nullptr)
+	, _enemy(nullptr)
+{
+	_flags.fill(false);
+
+	_players[NeutralPlayerID].reset(new HeadlessPlayer(NeutralPlayerID, "Neutral", BWAPI::Races::None, BWAPI::PlayerTypes::Neutral));
+	_playerSet.insert(_players[NeutralPlayerID].get());
+}
+
+HeadlessGame::~HeadlessGame()
+{
+	if (BWAPI::BroodwarPtr == this)
+	{
+		BWAPI::BroodwarPtr = nullptr;
+	}
+}
+
+void HeadlessGame::setWalkable(int walkX, int walkY, bool walkable)
+{
+	if (walkX >= 0 && walkY >= 0 && walkX < 4 * _mapWidth && walkY < 4 * _mapHeight)
+	{
+		_walkable[walkY * 4 * _mapWidth + walkX] = walkable;
+	}
+}
+
+void HeadlessGame::setBuildable(int tileX, int tileY, bool buildable)
+{
+	if (validTile(tileX, tileY))
+	{
+		_buildable[tileIndex(tileX, tileY)] = buildable;
+	}
+}
+
+void HeadlessGame::setGroundHeight(int tileX, int tileY, int height)
+{
+	if (validTile(tileX, tileY))
+	{
+		_groundHeight[tileIndex(tileX, tileY)] = height;
+	}
+}
+
+void HeadlessGame::setCreep(int tileX, int tileY, bool creep)
+{
+	if (validTile(tileX, tileY))
+	{
+		_creep[tileIndex(tileX, tileY)] = creep;
+	}
+}
+
+void HeadlessGame::setVisible(int tileX, int tileY, bool visible)
+{
+	if (validTile(tileX, tileY))
+	{
+		_visible[tileIndex(tileX, tileY)] = visible;
+	}
+}
+
+void HeadlessGame::addStartLocation(BWAPI::TilePosition tile)
+{
+	if (std::find(_startLocations.begin(), _startLocations.end(), tile) == _startLocations.end())
+	{
+		_startLocations.push_back(tile);
+	}
+}
+
+HeadlessPlayer * HeadlessGame::addPlayer(const std::string & name, BWAPI::Race race, BWAPI::TilePosition startLocation)
+{
+	int id = 0;
+	while (id < NeutralPlayerID && _players[id])
+	{
+		++id;
+	}
+	UAB_ASSERT(id < 8, "too many players");
+
+	HeadlessPlayer * player = new HeadlessPlayer(id, name, race, BWAPI::PlayerTypes::Player);
+	_players[id].reset(player);
+	_playerSet.insert(player);
+
+	player->_data.startLocationX = startLocation.x;
+	player->_data.startLocationY = startLocation.y;
+	player->_data.minerals = 50;
+	player->_data.gatheredMinerals = 50;
+	player->_data.color = id == 0 ? BWAPI::Colors::Red : BWAPI::Colors::Blue;
+	addStartLocation(startLocation);
+
+	// Everyone is against everyone.
+	for (BWAPI::Player other : _playerSet)
+	{
+		if (other != player && !other->isNeutral())
+		{
+			player->_data.isEnemy[other->getID()] = true;
+			getHeadlessPlayer(other)->_data.isEnemy[id] = true;
+		}
+	}
+	player->_data.isAlly[id] = true;
+
+	if (!_self)
+	{
+		_self = player;
+	}
+	else
+	{
+		_enemies.insert(player);
+		if (!_enemy)
+		{
+			_enemy = player;
+		}
+	}
+
+	return player;
+}
+
+HeadlessPlayer * HeadlessGame::getHeadlessPlayer(BWAPI::Player player) const
+{
+	return player ? _players[player->getID()].get() : nullptr;
+}
+
+HeadlessUnit * HeadlessGame::addUnit(BWAPI::UnitType type, BWAPI::Player player, BWAPI::Position position)
+{
+	HeadlessUnit * unit = new HeadlessUnit(*this, int(_units.size()), type, player, position);
+	_units.emplace_back(unit);
+	_history.push_back(UnitHistory{ false, false, false, false, BWAPI::UnitTypes::None, -1 });
+	return unit;
+}
+
+HeadlessUnit * HeadlessGame::getHeadlessUnit(int unitID) const
+{
+	return unitID >= 0 && unitID < int(_units.size()) ? _units[unitID].get() : nullptr;
+}
+
+HeadlessBullet * HeadlessGame::addBullet(BWAPI::BulletType type, BWAPI::Player player, BWAPI::Position position)
+{
+	HeadlessBullet * bullet = new HeadlessBullet(*this, int(_headlessBullets.size()), type, player, position);
+	_headlessBullets.emplace_back(bullet);
+	return bullet;
+}
+
+HeadlessBullet * HeadlessGame::getHeadlessBullet(int bulletID) const
+{
+	return bulletID >= 0 && bulletID < int(_headlessBullets.size()) ? _headlessBullets[bulletID].get() : nullptr;
+}
+
+void HeadlessGame::start(BWAPI::AIModule & module)
+{
+	UAB_ASSERT(_self && _enemy, "the game needs us and an enemy");
+
+	_module = &module;
+	_inGame = true;
+	BWAPI::BroodwarPtr = this;
+
+	for (const auto & unit : _units)
+	{
+		unit->saveInitialState();
+		if (unit->_data.exists && unit->getPlayer()->isNeutral())
+		{
+			_staticNeutralUnits.insert(unit.get());
+			if (unit->getType().isMineralField())
+			{
+				_staticMinerals.insert(unit.get());
+			}
+			else if (unit->getType() == BWAPI::UnitTypes::Resource_Vespene_Geyser)
+			{
+				_staticGeysers.insert(unit.get());
+			}
+		}
+	}
+
+	_queuedEvents.push_back(BWAPI::Event::MatchStart());
+	step();
+}
+
+void HeadlessGame::step()
+{
+	_commands.clear();
+
+	_events.clear();
+	_events.splice(_events.end(), _queuedEvents);
+
+	updateVision();
+	updateUnits();
+	updateCounts();
+
+	_bullets.clear();
+	for (const auto & bullet : _headlessBullets)
+	{
+		if (bullet->exists())
+		{
+			_bullets.insert(bullet.get());
+		}
+	}
+
+	_events.push_back(BWAPI::Event::MatchFrame());
+
+	for (const BWAPI::Event & e : _events)
+	{
+		dispatch(e);
+	}
+
+	++_frameCount;
+}
+
+void HeadlessGame::end(bool isWinner)
+{
+	_self->_data.isVictorious = isWinner;
+	_self->_data.isDefeated = !isWinner;
+
+	_events.clear();
+	_events.push_back(BWAPI::Event::MatchEnd(isWinner));
+	dispatch(_events.back());
+
+	_inGame = false;
+}
+
+void HeadlessGame::recordCommand(const BWAPI::UnitCommand & command)
+{
+	_commands.push_back(command);
+}
+
+// Call the AIModule for the event, as BWAPI does.
+void HeadlessGame::dispatch(const BWAPI::Event & e)
+{
+	switch (e.getType())
+	{
+	case BWAPI::EventType::MatchStart:		_module->onStart(); break;
+	case BWAPI::EventType::MatchEnd:		_module->onEnd(e.isWinner()); break;
+	case BWAPI::EventType::MatchFrame:		_module->onFrame(); break;
+	case BWAPI::EventType::SendText:		_module->onSendText(e.getText()); break;
+	case BWAPI::EventType::ReceiveText:		_module->onReceiveText(e.getPlayer(), e.getText()); break;
+	case BWAPI::EventType::PlayerLeft:		_module->onPlayerLeft(e.getPlayer()); break;
+	case BWAPI::EventType::NukeDetect:		_module->onNukeDetect(e.getPosition()); break;
+	case BWAPI::EventType::UnitDiscover:	_module->onUnitDiscover(e.getUnit()); break;
+	case BWAPI::EventType::UnitEvade:		_module->onUnitEvade(e.getUnit()); break;
+	case BWAPI::EventType::UnitShow:		_module->onUnitShow(e.getUnit()); break;
+	case BWAPI::EventType::UnitHide:		_module->onUnitHide(e.getUnit()); break;
+	case BWAPI::EventType::UnitCreate:		_module->onUnitCreate(e.getUnit()); break;
+	case BWAPI::EventType::UnitDestroy:		_module->onUnitDestroy(e.getUnit()); break;
+	case BWAPI::EventType::UnitMorph:		_module->onUnitMorph(e.getUnit()); break;
+	case BWAPI::EventType::UnitRenegade:	_module->onUnitRenegade(e.getUnit()); break;
+	case BWAPI::EventType::SaveGame:		_module->onSaveGame(e.getText()); break;
+	case BWAPI::EventType::UnitComplete:	_module->onUnitComplete(e.getUnit()); break;
+	default: break;
+	}
+}
+
+// Whether the player has a completed pylon powering the given point.
+bool HeadlessGame::hasPower(const BWAPI::Player player, int x, int y) const
+{
+	for (BWAPI::Unit pylon : player->getUnits())
+	{
+		if (pylon->getType() != BWAPI::UnitTypes::Protoss_Pylon || !pylon->isCompleted())
+		{
+			continue;
+		}
+		const int offsetX = x - pylon->getPosition().x + 256;
+		const int offsetY = y - pylon->getPosition().y + 160;
+		if (offsetX >= 0 && offsetY >= 0 && offsetX < 512 && offsetY < 320 && PsiFieldMask[offsetY / 32][offsetX / 32])
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+// We see the tiles in sight range of our units, unless the script says what we see.
+void HeadlessGame::updateVision()
+{
+	if (!_recordedVision)
+	{
+		std::fill(_visible.begin(), _visible.end(), _revealAll);
+
+		for (const auto & unit : _units)
+		{
+			if (unit->_data.exists && unit->_data.player == _self->getID())
+			{
+				addSight(unit->getPosition(), _self->sightRange(unit->getType()));
+			}
+		}
+	}
+
+	for (size_t i = 0; i < _visible.size(); ++i)
+	{
+		if (_visible[i])
+		{
+			_explored[i] = true;
+		}
+	}
+}
+
+void HeadlessGame::addSight(BWAPI::Position position, int range)
+{
+	const int x0 = (std::max)(0, (position.x - range) / 32);
+	const int y0 = (std::max)(0, (position.y - range) / 32);
+	const int x1 = (std::min)(_mapWidth - 1, (position.x + range) / 32);
+	const int y1 = (std::min)(_mapHeight - 1, (position.y + range) / 32);
+	for (int y = y0; y <= y1; ++y)
+	{
+		for (int x = x0; x <= x1; ++x)
+		{
+			const int dx = x * 32 + 16 - position.x;
+			const int dy = y * 32 + 16 - position.y;
+			if (dx * dx + dy * dy <= range * range)
+			{
+				_visible[tileIndex(x, y)] = true;
+			}
+		}
+	}
+}
+
+// Work out which units we can see, and the events for the changes since the last frame.
+void HeadlessGame::updateUnits()
+{
+	const int self = _self->getID();
+
+	_accessibleUnits.clear();
+	_minerals.clear();
+	_geysers.clear();
+	_neutralUnits.clear();
+	for (BWAPI::Player player : _playerSet)
+	{
+		getHeadlessPlayer(player)->_units.clear();
+	}
+
+	for (size_t id = 0; id < _units.size(); ++id)
+	{
+		HeadlessUnit * unit = _units[id].get();
+		BWAPI::UnitData & data = unit->_data;
+		UnitHistory & history = _history[id];
+
+		const BWAPI::TilePosition tile(unit->getPosition());
+		const bool hidden = (data.isCloaked || data.isBurrowed) && !data.isDetected;
+		if (data.player < 9)
+		{
+			data.isVisible[data.player] = data.exists;
+		}
+		if (data.player != self && !_recordedVision)
+		{
+			data.isVisible[self] = data.exists &&
+				(_revealAll || (validTile(tile.x, tile.y) && _visible[tileIndex(tile.x, tile.y)] && !hidden));
+		}
+
+		const bool visible = data.isVisible[self];
+		const bool accessible = data.exists && (data.player == self || visible);
+
+		if (accessible)
+		{
+			if (!history.accessible)
+			{
+				if (!history.exists)
+				{
+					_events.push_back(BWAPI::Event::UnitCreate(unit));
+				}
+				_events.push_back(BWAPI::Event::UnitDiscover(unit));
+				if (visible)
+				{
+					_events.push_back(BWAPI::Event::UnitShow(unit));
+				}
+			}
+			else
+			{
+				if (data.type != history.type)
+				{
+					_events.push_back(BWAPI::Event::UnitMorph(unit));
+				}
+				if (data.player != history.player)
+				{
+					_events.push_back(BWAPI::Event::UnitRenegade(unit));
+				}
+				if (visible && !history.visible)
+				{
+					_events.push_back(BWAPI::Event::UnitShow(unit));
+				}
+				else if (!visible && history.visible)
+				{
+					_events.push_back(BWAPI::Event::UnitHide(unit));
+				}
+			}
+			if (data.isCompleted && !history.completed)
+			{
+				_events.push_back(BWAPI::Event::UnitComplete(unit));
+			}
+
+			_accessibleUnits.insert(unit);
+			getHeadlessPlayer(unit->getPlayer())->_units.insert(unit);
+			if (unit->getPlayer()->isNeutral())
+			{
+				_neutralUnits.insert(unit);
+				if (unit->getType().isMineralField())
+				{
+					_minerals.insert(unit);
+				}
+				else if (unit->getType() == BWAPI::UnitTypes::Resource_Vespene_Geyser)
+				{
+					_geysers.insert(unit);
+				}
+			}
+		}
+		else if (history.accessible)
+		{
+			if (data.exists)
+			{
+				if (history.visible)
+				{
+					_events.push_back(BWAPI::Event::UnitHide(unit));
+				}
+				_events.push_back(BWAPI::Event::UnitEvade(unit));
+			}
+			else
+			{
+				_events.push_back(BWAPI::Event::UnitDestroy(unit));
+			}
+		}
+
+		if (history.exists && !data.exists)
+		{
+			++getHeadlessPlayer(unit->getPlayer())->_data.deadUnitCount[data.type];
+		}
+
+		history.exists = data.exists;
+		history.accessible = accessible;
+		history.visible = visible;
+		if (accessible)
+		{
+			history.completed = data.isCompleted;
+		}
+		history.type = data.type;
+		history.player = data.player;
+	}
+
+	for (BWAPI::Unit unit : _self->getUnits())
+	{
+		if (unit->getType().requiresPsi())
+		{
+			getHeadlessUnit(unit->getID())->_data.isPowered = hasPower(_self, unit->getPosition().x, unit->getPosition().y);
+		}
+	}
+}
+
+// Count each player's units and supply, from the units that exist.
+void HeadlessGame::updateCounts()
+{
+	for (BWAPI::Player p : _playerSet)
+	{
+		BWAPI::PlayerData & data = getHeadlessPlayer(p)->_data;
+		std::fill(std::begin(data.allUnitCount), std::end(data.allUnitCount), 0);
+		std::fill(std::begin(data.visibleUnitCount), std::end(data.visibleUnitCount), 0);
+		std::fill(std::begin(data.completedUnitCount), std::end(data.completedUnitCount), 0);
+		std::fill(std::begin(data.supplyTotal), std::end(data.supplyTotal), 0);
+		std::fill(std::begin(data.supplyUsed), std::end(data.supplyUsed), 0);
+	}
+
+	for (const auto & unit : _units)
+	{
+		const BWAPI::UnitData & u = unit->_data;
+		if (!u.exists)
+		{
+			continue;
+		}
+
+		BWAPI::PlayerData & data = _players[u.player]->_data;
+		const BWAPI::UnitType type = unit->getType();
+		++data.allUnitCount[u.type];
+		if (u.isCompleted)
+		{
+			++data.completedUnitCount[u.type];
+		}
+		if (u.isVisible[_self->getID()])
+		{
+			++data.visibleUnitCount[u.type];
+		}
+
+		const int race = type.getRace().getID();
+		if (race < 3)
+		{
+			if (u.isCompleted)
+			{
+				data.supplyTotal[race] += type.supplyProvided();
+			}
+			const BWAPI::UnitType supplyType = type == BWAPI::UnitTypes::Zerg_Egg ? BWAPI::UnitType(u.buildType) : type;
+			data.supplyUsed[race] += supplyType.supplyRequired();
+		}
+	}
+
+	for (BWAPI::Player p : _playerSet)
+	{
+		BWAPI::PlayerData & data = getHeadlessPlayer(p)->_data;
+		for (int & total : data.supplyTotal)
+		{
+			total = (std::min)(total, 400);
+		}
+	}
+}
+
+const BWAPI::Forceset & HeadlessGame::getForces() const { return _forces; }
+const BWAPI::Playerset & HeadlessGame::getPlayers() const { return _playerSet; }
+const BWAPI::Unitset & HeadlessGame::getAllUnits() const { return _accessibleUnits; }
+const BWAPI::Unitset & HeadlessGame::getMinerals() const { return _minerals; }
+const BWAPI::Unitset & HeadlessGame::getGeysers() const { return _geysers; }
+const BWAPI::Unitset & HeadlessGame::getNeutralUnits() const { return _neutralUnits; }
+const BWAPI::Unitset & HeadlessGame::getStaticMinerals() const { return _staticMinerals; }
+const BWAPI::Unitset & HeadlessGame::getStaticGeysers() const { return _staticGeysers; }
+const BWAPI::Unitset & HeadlessGame::getStaticNeutralUnits() const { return _staticNeutralUnits; }
+const BWAPI::Bulletset & HeadlessGame::getBullets() const { return _bullets; }
+const BWAPI::Position::list & HeadlessGame::getNukeDots() const { return _nukeDots; }
+const std::list<BWAPI::Event> & HeadlessGame::getEvents() const { return _events; }
+
+BWAPI::Force HeadlessGame::getForce(int forceID) const { return nullptr; }
+
+BWAPI::Player HeadlessGame::getPlayer(int playerID) const
+{
+	return playerID >= 0 && playerID < MaxPlayers ? _players[playerID].get() : nullptr;
+}
+
+BWAPI::Unit HeadlessGame::getUnit(int unitID) const { return getHeadlessUnit(unitID); }
+BWAPI::Unit HeadlessGame::indexToUnit(int unitIndex) const { return nullptr; }
+BWAPI::Region HeadlessGame::getRegion(int regionID) const { return nullptr; }
+BWAPI::GameType HeadlessGame::getGameType() const { return BWAPI::GameTypes::Melee; }
+int HeadlessGame::getLatency() const { return BWAPI::Latency::LanLow; }
+int HeadlessGame::getFrameCount() const { return _frameCount; }
+int HeadlessGame::getReplayFrameCount() const { return 0; }
+int HeadlessGame::getFPS() const { return 0; }
+double HeadlessGame::getAverageFPS() const { return 0.0; }
+BWAPI::Position HeadlessGame::getMousePosition() const { return BWAPI::Positions::Origin; }
+bool HeadlessGame::getMouseState(BWAPI::MouseButton button) const { return false; }
+bool HeadlessGame::getKeyState(BWAPI::Key key) const { return false; }
+BWAPI::Position HeadlessGame::getScreenPosition() const { return BWAPI::Positions::Origin; }
+void HeadlessGame::setScreenPosition(int x, int y) {}
+void HeadlessGame::pingMinimap(int x, int y) {}
+
+bool HeadlessGame::isFlagEnabled(int flag) const
+{
+	return flag >= 0 && flag < BWAPI::Flag::Max && _flags[flag];
+}
+
+void HeadlessGame::enableFlag(int flag)
+{
+	if (flag >= 0 && flag < BWAPI::Flag::Max)
+	{
+		_flags[flag] = true;
+	}
+}
+
+// Units whose bounds overlap the rectangle, as in BWAPI.
+BWAPI::Unitset HeadlessGame::getUnitsInRectangle(int left, int top, int right, int bottom, const BWAPI::UnitFilter & pred) const
+{
+	BWAPI::Unitset units;
+	for (BWAPI::Unit unit : _accessibleUnits)
+	{
+		if (unit->getLeft() <= right && unit->getRight() >= left &&
+			unit->getTop() <= bottom && unit->getBottom() >= top &&
+			(!pred.isValid() || pred(unit)))
+		{
+			units.insert(unit);
+		}
+	}
+	return units;
+}
+
+BWAPI::Unit HeadlessGame::getClosestUnitInRectangle(BWAPI::Position center, const BWAPI::UnitFilter & pred, int left, int top, int right, int bottom) const
+{
+	BWAPI::Unit closest = nullptr;
+	int closestDistance = INT_MAX;
+	for (BWAPI::Unit unit : getUnitsInRectangle(left, top, right, bottom, pred))
+	{
+		const int distance = unit->getDistance(center);
+		if (distance < closestDistance)
+		{
+			closest = unit;
+			closestDistance = distance;
+		}
+	}
+	return closest;
+}
+
+BWAPI::Unit HeadlessGame::getBestUnit(const BWAPI::BestUnitFilter & best, const BWAPI::UnitFilter & pred, BWAPI::Position center, int radius) const
+{
+	BWAPI::Unit bestUnit = nullptr;
+	for (BWAPI::Unit unit : getUnitsInRadius(center, radius, pred))
+	{
+		bestUnit = bestUnit ? best(bestUnit, unit) : unit;
+	}
+	return bestUnit;
+}
+
+BWAPI::Error HeadlessGame::getLastError() const { return _lastError; }
+
+bool HeadlessGame::setLastError(BWAPI::Error e) const
+{
+	_lastError = e;
+	return e == BWAPI::Errors::None;
+}
+
+int HeadlessGame::mapWidth() const { return _mapWidth; }
+int HeadlessGame::mapHeight() const { return _mapHeight; }
+std::string HeadlessGame::mapFileName() const { return _mapName + ".scx"; }
+std::string HeadlessGame::mapPathName() const { return "maps/" + mapFileName(); }
+std::string HeadlessGame::mapName() const { return _mapName; }
+
+// Not the hash of any real map, but different for different map names.
+std::string HeadlessGame::mapHash() const
+{
+	std::ostringstream hash;
+	hash << std::hex << std::hash<std::string>()(_mapName);
+	return hash.str();
+}
+
+bool HeadlessGame::isWalkable(int walkX, int walkY) const
+{
+	return walkX >= 0 && walkY >= 0 && walkX < 4 * _mapWidth && walkY < 4 * _mapHeight &&
+		_walkable[walkY * 4 * _mapWidth + walkX];
+}
+
+int HeadlessGame::getGroundHeight(int tileX, int tileY) const
+{
+	return validTile(tileX, tileY) ? _groundHeight[tileIndex(tileX, tileY)] : 0;
+}
+
+bool HeadlessGame::isBuildable(int tileX, int tileY, bool includeBuildings) const
+{
+	if (!validTile(tileX, tileY) || !_buildable[tileIndex(tileX, tileY)])
+	{
+		return false;
+	}
+	if (includeBuildings)
+	{
+		for (const auto & unit : _units)
+		{
+			if (unit->_data.exists && unit->getType().isBuilding() && !unit->_data.isLifted)
+			{
+				const BWAPI::TilePosition tile = unit->getTilePosition();
+				if (tileX >= tile.x && tileY >= tile.y &&
+					tileX < tile.x + unit->getType().tileWidth() && tileY < tile.y + unit->getType().tileHeight())
+				{
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+bool HeadlessGame::isVisible(int tileX, int tileY) const
+{
+	return validTile(tileX, tileY) && _visible[tileIndex(tileX, tileY)];
+}
+
+bool HeadlessGame::isExplored(int tileX, int tileY) const
+{
+	return validTile(tileX, tileY) && _explored[tileIndex(tileX, tileY)];
+}
+
+bool HeadlessGame::hasCreep(int tileX, int tileY) const
+{
+	return validTile(tileX, tileY) && _creep[tileIndex(tileX, tileY)];
+}
+
+bool HeadlessGame::hasPowerPrecise(int x, int y, BWAPI::UnitType unitType) const
+{
+	if (unitType != BWAPI::UnitTypes::None && !unitType.requiresPsi())
+	{
+		return true;
+	}
+	return hasPower(_self, x, y);
+}
+
+// The main placement rules: open buildable ground, creep, power, and resource depots
+// not too close to resources.
+bool HeadlessGame::canBuildHere(BWAPI::TilePosition position, BWAPI::UnitType type, BWAPI::Unit builder, bool checkExplored)
+{
+	const BWAPI::TilePosition end = position + type.tileSize();
+	if (!validTile(position.x, position.y) || !validTile(end.x - 1, end.y - 1))
+	{
+		return setLastError(BWAPI::Errors::Invalid_Tile_Position);
+	}
+
+	if (type.isRefinery())
+	{
+		for (BWAPI::Unit geyser : getGeysers())
+		{
+			if (geyser->getTilePosition() == position)
+			{
+				return setLastError();
+			}
+		}
+		return setLastError(BWAPI::Errors::Unbuildable_Location);
+	}
+
+	for (int x = position.x; x < end.x; ++x)
+	{
+		for (int y = position.y; y < end.y; ++y)
+		{
+			if (!isBuildable(x, y) ||
+				(checkExplored && !isExplored(x, y)) ||
+				(type.requiresCreep() && !hasCreep(x, y)) ||
+				(!type.requiresCreep() && type != BWAPI::UnitTypes::Zerg_Hatchery && hasCreep(x, y)))
+			{
+				return setLastError(BWAPI::Errors::Unbuildable_Location);
+			}
+		}
+	}
+
+	const BWAPI::Unitset blockers = getUnitsInRectangle(
+		position.x * 32, position.y * 32, end.x * 32 - 1, end.y * 32 - 1,
+		[builder](BWAPI::Unit unit) { return unit != builder && !unit->isFlying() && !unit->isLifted(); });
+	if (!blockers.empty())
+	{
+		return setLastError(BWAPI::Errors::Unbuildable_Location);
+	}
+
+	if (type.requiresPsi() && !hasPowerPrecise(position.x * 32 + type.tileWidth() * 16, position.y * 32 + type.tileHeight() * 16, type))
+	{
+		return setLastError(BWAPI::Errors::Unbuildable_Location);
+	}
+
+	if (type.isResourceDepot())
+	{
+		for (BWAPI::Unit resource : getStaticNeutralUnits())
+		{
+			if (!resource->getType().isResourceContainer())
+			{
+				continue;
+			}
+			const BWAPI::TilePosition tile = resource->getInitialTilePosition();
+			const BWAPI::TilePosition size = resource->getInitialType().tileSize();
+			if (tile.x - 3 < end.x && tile.x + size.x + 3 > position.x &&
+				tile.y - 3 < end.y && tile.y + size.y + 3 > position.y)
+			{
+				return setLastError(BWAPI::Errors::Unbuildable_Location);
+			}
+		}
+	}
+
+	return setLastError();
+}
+
+bool HeadlessGame::canMake(BWAPI::UnitType type, BWAPI::Unit builder) const
+{
+	if (builder && (builder->getPlayer() != _self || builder->getType() != type.whatBuilds().first))
+	{
+		return setLastError(BWAPI::Errors::Incompatible_UnitType);
+	}
+	if (_self->minerals() < type.mineralPrice())
+	{
+		return setLastError(BWAPI::Errors::Insufficient_Minerals);
+	}
+	if (_self->gas() < type.gasPrice())
+	{
+		return setLastError(BWAPI::Errors::Insufficient_Gas);
+	}
+	if (type.supplyRequired() > 0 &&
+		_self->supplyUsed(type.getRace()) + type.supplyRequired() > _self->supplyTotal(type.getRace()))
+	{
+		return setLastError(BWAPI::Errors::Insufficient_Supply);
+	}
+	for (const auto & required : type.requiredUnits())
+	{
+		if (!_self->hasUnitTypeRequirement(required.first, required.second))
+		{
+			return setLastError(BWAPI::Errors::Insufficient_Tech);
+		}
+	}
+	if (type.requiredTech() != BWAPI::TechTypes::None && !_self->hasResearched(type.requiredTech()))
+	{
+		return setLastError(BWAPI::Errors::Insufficient_Tech);
+	}
+	return setLastError();
+}
+
+bool HeadlessGame::canResearch(BWAPI::TechType type, BWAPI::Unit unit, bool checkCanIssueCommandType)
+{
+	if (unit && (unit->getPlayer() != _self || unit->getType() != type.whatResearches()))
+	{
+		return setLastError(BWAPI::Errors::Incompatible_UnitType);
+	}
+	if (!_self->isResearchAvailable(type) || _self->hasResearched(type) || _self->isResearching(type))
+	{
+		return setLastError(BWAPI::Errors::Already_Researched);
+	}
+	if (_self->minerals() < type.mineralPrice())
+	{
+		return setLastError(BWAPI::Errors::Insufficient_Minerals);
+	}
+	if (_self->gas() < type.gasPrice())
+	{
+		return setLastError(BWAPI::Errors::Insufficient_Gas);
+	}
+	if (!_self->hasUnitTypeRequirement(type.requiredUnit()))
+	{
+		return setLastError(BWAPI::Errors::Insufficient_Tech);
+	}
+	return setLastError();
+}
+
+bool HeadlessGame::canUpgrade(BWAPI::UpgradeType type, BWAPI::Unit unit, bool checkCanIssueCommandType)
+{
+	if (unit && (unit->getPlayer() != _self || unit->getType() != type.whatUpgrades()))
+	{
+		return setLastError(BWAPI::Errors::Incompatible_UnitType);
+	}
+	const int nextLevel = _self->getUpgradeLevel(type) + 1;
+	if (nextLevel > _self->getMaxUpgradeLevel(type) || _self->isUpgrading(type))
+	{
+		return setLastError(BWAPI::Errors::Fully_Upgraded);
+	}
+	if (_self->minerals() < type.mineralPrice(nextLevel))
+	{
+		return setLastError(BWAPI::Errors::Insufficient_Minerals);
+	}
+	if (_self->gas() < type.gasPrice(nextLevel))
+	{
+		return setLastError(BWAPI::Errors::Insufficient_Gas);
+	}
+	if (!_self->hasUnitTypeRequirement(type.whatsRequired(nextLevel)))
+	{
+		return setLastError(BWAPI::Errors::Insufficient_Tech);
+	}
+	return setLastError();
+}
+
+const BWAPI::TilePosition::list & HeadlessGame::getStartLocations() const { return _startLocations; }
+
+// Messages to the screen go to the debug log instead.
+void HeadlessGame::vPrintf(const char * format, va_list args)
+{
+	char buffer[512];
+	vsnprintf(buffer, sizeof(buffer), format, args);
+	LOG_DEBUG << "Printf: " << buffer;
+}
+
+void HeadlessGame::vSendTextEx(bool toAllies, const char * format, va_list args)
+{
+	char buffer[512];
+	vsnprintf(buffer, sizeof(buffer), format, args);
+	LOG_DEBUG << "Send text: " << buffer;
+}
+
+bool HeadlessGame::isInGame() const { return _inGame; }
+bool HeadlessGame::isMultiplayer() const { return false; }
+bool HeadlessGame::isBattleNet() const { return false; }
+bool HeadlessGame::isPaused() const { return false; }
+bool HeadlessGame::isReplay() const { return false; }
+void HeadlessGame::pauseGame() {}
+void HeadlessGame::resumeGame() {}
+void HeadlessGame::leaveGame() { _inGame = false; }
+void HeadlessGame::restartGame() {}
+void HeadlessGame::setLocalSpeed(int speed) {}
+
+bool HeadlessGame::issueCommand(const BWAPI::Unitset & units, BWAPI::UnitCommand command)
+{
+	bool issued = false;
+	for (BWAPI::Unit unit : units)
+	{
+		command.unit = unit;
+		issued = unit->issueCommand(command) || issued;
+	}
+	return issued;
+}
+
+const BWAPI::Unitset & HeadlessGame::getSelectedUnits() const { return _selectedUnits; }
+BWAPI::Player HeadlessGame::self() const { return _self; }
+BWAPI::Player HeadlessGame::enemy() const { return _enemy; }
+BWAPI::Player HeadlessGame::neutral() const { return _players[NeutralPlayerID].get(); }
+BWAPI::Playerset & HeadlessGame::allies() { return _allies; }
+BWAPI::Playerset & HeadlessGame::enemies() { return _enemies; }
+BWAPI::Playerset & HeadlessGame::observers() { return _observers; }
+
+void HeadlessGame::setTextSize(BWAPI::Text::Size::Enum size) {}
+void HeadlessGame::vDrawText(BWAPI::CoordinateType::Enum ctype, int x, int y, const char * format, va_list arg) {}
+void HeadlessGame::drawBox(BWAPI::CoordinateType::Enum ctype, int left, int top, int right, int bottom, BWAPI::Color color, bool isSolid) {}
+void HeadlessGame::drawTriangle(BWAPI::CoordinateType::Enum ctype, int ax, int ay, int bx, int by, int cx, int cy, BWAPI::Color color, bool isSolid) {}
+void HeadlessGame::drawCircle(BWAPI::CoordinateType::Enum ctype, int x, int y, int radius, BWAPI::Color color, bool isSolid) {}
+void HeadlessGame::drawEllipse(BWAPI::CoordinateType::Enum ctype, int x, int y, int xrad, int yrad, BWAPI::Color color, bool isSolid) {}
+void HeadlessGame::drawDot(BWAPI::CoordinateType::Enum ctype, int x, int y, BWAPI::Color color) {}
+void HeadlessGame::drawLine(BWAPI::CoordinateType::Enum ctype, int x1, int y1, int x2, int y2, BWAPI::Color color) {}
+
+int HeadlessGame::getLatencyFrames() const { return 2; }
+int HeadlessGame::getLatencyTime() const { return 2 * 42; }
+int HeadlessGame::getRemainingLatencyFrames() const { return 2; }
+int HeadlessGame::getRemainingLatencyTime() const { return 2 * 42; }
+int HeadlessGame::getRevision() const { return 0; }
+int HeadlessGame::getClientVersion() const { return 0; }
+bool HeadlessGame::isDebug() const { return false; }
+bool HeadlessGame::isLatComEnabled() const { return true; }
+void HeadlessGame::setLatCom(bool isEnabled) {}
+bool HeadlessGame::isGUIEnabled() const { return false; }
+void HeadlessGame::setGUI(bool enabled) {}
+int HeadlessGame::getInstanceNumber() const { return 0; }
+int HeadlessGame::getAPM(bool includeSelects) const { return 0; }
+bool HeadlessGame::setMap(const char * mapFileName) { return setLastError(BWAPI::Errors::Invalid_Parameter); }
+void HeadlessGame::setFrameSkip(int frameSkip) {}
+
+bool HeadlessGame::setAlliance(BWAPI::Player player, bool allied, bool alliedVictory)
+{
+	if (!player || player == _self)
+	{
+		return setLastError(BWAPI::Errors::Invalid_Parameter);
+	}
+	_self->_data.isAlly[player->getID()] = allied;
+	_self->_data.isEnemy[player->getID()] = !allied;
+	if (allied)
+	{
+		_allies.insert(player);
+		_enemies.erase(player);
+	}
+	else
+	{
+		_allies.erase(player);
+		_enemies.insert(player);
+	}
+	return setLastError();
+}
+
+bool HeadlessGame::setVision(BWAPI::Player player, bool enabled) { return setLastError(); }
+int HeadlessGame::elapsedTime() const { return _frameCount * 42 / 1000; }
+void HeadlessGame::setCommandOptimizationLevel(int level) {}
+int HeadlessGame::countdownTimer() const { return 0; }
+const BWAPI::Regionset & HeadlessGame::getAllRegions() const { return _regions; }
+BWAPI::Region HeadlessGame::getRegionAt(int x, int y) const { return nullptr; }
+int HeadlessGame::getLastEventTime() const { return 0; }
+
+bool HeadlessGame::setRevealAll(bool reveal)
+{
+	_revealAll = reveal;
+	return setLastError();
+}
+
+unsigned HeadlessGame::getRandomSeed() const { return 0; }
@@ -0,0 +1,259 @@
+#pragma once
+
+#include "Common.h"
+
+#include "HeadlessBullet.h"
+#include "HeadlessPlayer.h"
+#include "HeadlessUnit.h"
+
+#include <memory>
+
+// A stand-in for the game, so that the bot can run without Starcraft, as for benchmarks.
+// A script sets up the map, players and units, then runs the bot frame by frame, changing
+// the state of the units between frames through HeadlessUnit::data(). A unit is removed
+// by setting its exists flag to false.
+// Each frame the game works out from the unit states what BWAPI would: our vision, which
+// units we can see, the unit sets, unit counts and supply, and the unit events. It then
+// calls the bot's AIModule the way BWAPI does. Commands from the bot are recorded, and
+// update the orders of the units, but the game does not carry them out. Drawing is ignored.
+// Map size is in tiles. A new map is all walkable and buildable high ground.
+// To replay a recorded game, call useRecordedVision(). Then the script says which tiles
+// and units we can see, instead of the game working it out.
+
+namespace UAlbertaBot
+{
+
+class HeadlessGame : public BWAPI::Game
+{
+	// What the bot knew about a unit after the last frame, to work out the unit events.
+	struct UnitHistory
+	{
+		bool	exists;
+		bool	accessible;
+		bool	visible;
+		bool	completed;
+		int		type;
+		int		player;
+	};
+
+	static const int MaxPlayers = 12;
+	static const int NeutralPlayerID = 11;
+
+	BWAPI::AIModule *			_module;
+	int							_frameCount;
+	bool						_inGame;
+	bool						_revealAll;
+	bool						_recordedVision;
+	std::array<bool, BWAPI::Flag::Max>	_flags;
+	mutable BWAPI::Error		_lastError;
+
+	int							_mapWidth;
+	int							_mapHeight;
+	std::string					_mapName;
+	std::vector<bool>			_walkable;		// walk tiles
+	std::vector<int>			_groundHeight;	// build tiles from here on
+	std::vector<bool>			_buildable;
+	std::vector<bool>			_visible;
+	std::vector<bool>			_explored;
+	std::vector<bool>			_creep;
+	BWAPI::TilePosition::list	_startLocations;
+
+	std::array<std::unique_ptr<HeadlessPlayer>, MaxPlayers>	_players;
+	BWAPI::Playerset			_playerSet;
+	HeadlessPlayer *			_self;
+	HeadlessPlayer *			_enemy;
+	BWAPI::Playerset			_allies;
+	BWAPI::Playerset			_enemies;
+	BWAPI::Playerset			_observers;
+
+	std::vector<std::unique_ptr<HeadlessUnit>>	_units;		// indexed by unit ID
+	std::vector<UnitHistory>	_history;					// also by unit ID
+	BWAPI::Unitset				_accessibleUnits;
+	BWAPI::Unitset				_minerals;
+	BWAPI::Unitset				_geysers;
+	BWAPI::Unitset				_neutralUnits;
+	BWAPI::Unitset				_staticMinerals;
+	BWAPI::Unitset				_staticGeysers;
+	BWAPI::Unitset				_staticNeutralUnits;
+
+	std::vector<std::unique_ptr<HeadlessBullet>>	_headlessBullets;	// indexed by bullet ID
+	BWAPI::Bulletset			_bullets;		// those that exist
+
+	std::list<BWAPI::Event>		_events;		// this frame's
+	std::list<BWAPI::Event>		_queuedEvents;	// for the next frame
+	std::vector<BWAPI::UnitCommand>	_commands;	// issued by the bot this frame
+
+	// Always empty.
+	BWAPI::Forceset				_forces;
+	BWAPI::Position::list		_nukeDots;
+	BWAPI::Unitset				_selectedUnits;
+	BWAPI::Regionset			_regions;
+
+	int tileIndex(int tileX, int tileY) const { return tileY * _mapWidth + tileX; };
+	bool validTile(int tileX, int tileY) const { return tileX >= 0 && tileY >= 0 && tileX < _mapWidth && tileY < _mapHeight; };
+
+	bool hasPower(const BWAPI::Player player, int x, int y) const;
+	void updateVision();
+	void addSight(BWAPI::Position position, int range);
+	void updateUnits();
+	void updateCounts();
+	void dispatch(const BWAPI::Event & e);
+
+public:
+
+	HeadlessGame(int mapWidth, int mapHeight, const std::string & mapName);
+	~HeadlessGame();
+
+	// Setting up the map, before start().
+	void setWalkable(int walkX, int walkY, bool walkable);
+	void setBuildable(int tileX, int tileY, bool buildable);
+	void setGroundHeight(int tileX, int tileY, int height);
+	void setCreep(int tileX, int tileY, bool creep);
+	void addStartLocation(BWAPI::TilePosition tile);
+
+	void useRecordedVision() { _recordedVision = true; };
+	void setVisible(int tileX, int tileY, bool visible);
+	void setFrameCount(int frame) { _frameCount = frame; };
+
+	// The first player added is us and the second the enemy. There is always a neutral player.
+	HeadlessPlayer * addPlayer(const std::string & name, BWAPI::Race race, BWAPI::TilePosition startLocation);
+	HeadlessPlayer * getHeadlessPlayer(BWAPI::Player player) const;
+
+	// The unit is complete. For a unit in progress, clear its isCompleted flag and set its progress.
+	HeadlessUnit * addUnit(BWAPI::UnitType type, BWAPI::Player player, BWAPI::Position position);
+	HeadlessUnit * getHeadlessUnit(int unitID) const;
+
+	HeadlessBullet * addBullet(BWAPI::BulletType type, BWAPI::Player player, BWAPI::Position position);
+	HeadlessBullet * getHeadlessBullet(int bulletID) const;
+
+	// Run the game. start() runs the first frame, and each step() the next one.
+	void start(BWAPI::AIModule & module);
+	void step();
+	void end(bool isWinner);
+
+	void recordCommand(const BWAPI::UnitCommand & command);
+	const std::vector<BWAPI::UnitCommand> & getCommands() const { return _commands; };
+
+	// The base class overloads of these are hidden by the overrides.
+	using BWAPI::Game::setScreenPosition;
+	using BWAPI::Game::pingMinimap;
+	using BWAPI::Game::getUnitsInRectangle;
+	using BWAPI::Game::isWalkable;
+	using BWAPI::Game::getGroundHeight;
+	using BWAPI::Game::isBuildable;
+	using BWAPI::Game::isVisible;
+	using BWAPI::Game::isExplored;
+	using BWAPI::Game::hasCreep;
+	using BWAPI::Game::hasPowerPrecise;
+	using BWAPI::Game::getRegionAt;
+
+	const BWAPI::Forceset& getForces() const override;
+	const BWAPI::Playerset& getPlayers() const override;
+	const BWAPI::Unitset& getAllUnits() const override;
+	const BWAPI::Unitset& getMinerals() const override;
+	const BWAPI::Unitset& getGeysers() const override;
+	const BWAPI::Unitset& getNeutralUnits() const override;
+	const BWAPI::Unitset& getStaticMinerals() const override;
+	const BWAPI::Unitset& getStaticGeysers() const override;
+	const BWAPI::Unitset& getStaticNeutralUnits() const override;
+	const BWAPI::Bulletset& getBullets() const override;
+	const BWAPI::Position::list& getNukeDots() const override;
+	const std::list< BWAPI::Event >& getEvents() const override;
+	BWAPI::Force getForce(int forceID) const override;
+	BWAPI::Player getPlayer(int playerID) const override;
+	BWAPI::Unit getUnit(int unitID) const override;
+	BWAPI::Unit indexToUnit(int unitIndex) const override;
+	BWAPI::Region getRegion(int regionID) const override;
+	BWAPI::GameType getGameType() const override;
+	int getLatency() const override;
+	int getFrameCount() const override;
+	int getReplayFrameCount() const override;
+	int getFPS() const override;
+	double getAverageFPS() const override;
+	BWAPI::Position getMousePosition() const override;
+	bool getMouseState(BWAPI::MouseButton button) const override;
+	bool getKeyState(BWAPI::Key key) const override;
+	BWAPI::Position getScreenPosition() const override;
+	void setScreenPosition(int x, int y) override;
+	void pingMinimap(int x, int y) override;
+	bool isFlagEnabled(int flag) const override;
+	void enableFlag(int flag) override;
+	BWAPI::Unitset getUnitsInRectangle(int left, int top, int right, int bottom, const BWAPI::UnitFilter &pred = nullptr) const override;
+	BWAPI::Unit getClosestUnitInRectangle(BWAPI::Position center, const BWAPI::UnitFilter &pred = nullptr, int left = 0, int top = 0, int right = 999999, int bottom = 999999) const override;
+	BWAPI::Unit getBestUnit(const BWAPI::BestUnitFilter &best, const BWAPI::UnitFilter &pred, BWAPI::Position center = BWAPI::Positions::Origin, int radius = 999999) const override;
+	BWAPI::Error getLastError() const override;
+	bool setLastError(BWAPI::Error e = BWAPI::Errors::None) const override;
+	int mapWidth() const override;
+	int mapHeight() const override;
+	std::string mapFileName() const override;
+	std::string mapPathName() const override;
+	std::string mapName() const override;
+	std::string mapHash() const override;
+	bool isWalkable(int walkX, int walkY) const override;
+	int  getGroundHeight(int tileX, int tileY) const override;
+	bool isBuildable(int tileX, int tileY, bool includeBuildings = false) const override;
+	bool isVisible(int tileX, int tileY) const override;
+	bool isExplored(int tileX, int tileY) const override;
+	bool hasCreep(int tileX, int tileY) const override;
+	bool hasPowerPrecise(int x, int y, BWAPI::UnitType unitType = BWAPI::UnitTypes::None ) const override;
+	bool canBuildHere(BWAPI::TilePosition position, BWAPI::UnitType type, BWAPI::Unit builder = nullptr, bool checkExplored = false) override;
+	bool canMake(BWAPI::UnitType type, BWAPI::Unit builder = nullptr) const override;
+	bool canResearch(BWAPI::TechType type, BWAPI::Unit unit = nullptr, bool checkCanIssueCommandType = true) override;
+	bool canUpgrade(BWAPI::UpgradeType type, BWAPI::Unit unit = nullptr, bool checkCanIssueCommandType = true) override;
+	const BWAPI::TilePosition::list& getStartLocations() const override;
+	void vPrintf(const char *format, va_list args) override;
+	void vSendTextEx(bool toAllies, const char *format, va_list args) override;
+	bool isInGame() const override;
+	bool isMultiplayer() const override;
+	bool isBattleNet() const override;
+	bool isPaused() const override;
+	bool isReplay() const override;
+	void pauseGame() override;
+	void resumeGame() override;
+	void leaveGame() override;
+	void restartGame() override;
+	void setLocalSpeed(int speed) override;
+	bool issueCommand(const BWAPI::Unitset& units, BWAPI::UnitCommand command) override;
+	const BWAPI::Unitset& getSelectedUnits() const override;
+	BWAPI::Player self() const override;
+	BWAPI::Player enemy() const override;
+	BWAPI::Player neutral() const override;
+	BWAPI::Playerset& allies() override;
+	BWAPI::Playerset& enemies() override;
+	BWAPI::Playerset& observers() override;
+	void setTextSize(BWAPI::Text::Size::Enum size = BWAPI::Text::Size::Default) override;
+	void vDrawText(BWAPI::CoordinateType::Enum ctype, int x, int y, const char *format, va_list arg) override;
+	void drawBox(BWAPI::CoordinateType::Enum ctype, int left, int top, int right, int bottom, BWAPI::Color color, bool isSolid = false) override;
+	void drawTriangle(BWAPI::CoordinateType::Enum ctype, int ax, int ay, int bx, int by, int cx, int cy, BWAPI::Color color, bool isSolid = false) override;
+	void drawCircle(BWAPI::CoordinateType::Enum ctype, int x, int y, int radius, BWAPI::Color color, bool isSolid = false) override;
+	void drawEllipse(BWAPI::CoordinateType::Enum ctype, int x, int y, int xrad, int yrad, BWAPI::Color color, bool isSolid = false) override;
+	void drawDot(BWAPI::CoordinateType::Enum ctype, int x, int y, BWAPI::Color color) override;
+	void drawLine(BWAPI::CoordinateType::Enum ctype, int x1, int y1, int x2, int y2, BWAPI::Color color) override;
+	int getLatencyFrames() const override;
+	int getLatencyTime() const override;
+	int getRemainingLatencyFrames() const override;
+	int getRemainingLatencyTime() const override;
+	int getRevision() const override;
+	int getClientVersion() const override;
+	bool isDebug() const override;
+	bool isLatComEnabled() const override;
+	void setLatCom(bool isEnabled) override;
+	bool isGUIEnabled() const override;
+	void setGUI(bool enabled) override;
+	int getInstanceNumber() const override;
+	int getAPM(bool includeSelects = false) const override;
+	bool setMap(const char *mapFileName) override;
+	void setFrameSkip(int frameSkip) override;
+	bool setAlliance(BWAPI::Player player, bool allied = true, bool alliedVictory = true) override;
+	bool setVision(BWAPI::Player player, bool enabled = true) override;
+	int elapsedTime() const override;
+	void setCommandOptimizationLevel(int level) override;
+	int countdownTimer() const override;
+	const BWAPI::Regionset &getAllRegions() const override;
+	BWAPI::Region getRegionAt(int x, int y) const override;
+	int getLastEventTime() const override;
+	bool setRevealAll(bool reveal = true) override;
+	unsigned getRandomSeed() const override;
+};
+
+}
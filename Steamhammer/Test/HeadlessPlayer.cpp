@@ -0,0 +1,157 @@
+#include "HeadlessPlayer.h"
+
+#include <cstring>
+
+using namespace UAlbertaBot;
+
+HeadlessPlayer::HeadlessPlayer(int id, const std::string & name, BWAPI::Race race, BWAPI::PlayerType type)
+	: _id(id)
+{
+	std::memset(&_data, 0, sizeof(_data));
+
+	std::strncpy(_data.name, name.c_str(), sizeof(_data.name) - 1);
+	_data.race = race.getID();
+	_data.type = type.getID();
+	_data.isNeutral = type == BWAPI::PlayerTypes::Neutral;
+	_data.isParticipating = !_data.isNeutral;
+	_data.startLocationX = BWAPI::TilePositions::None.x;
+	_data.startLocationY = BWAPI::TilePositions::None.y;
+	_data.color = BWAPI::Colors::Grey;
+
+	for (BWAPI::UpgradeType upgrade : BWAPI::UpgradeTypes::allUpgradeTypes())
+	{
+		_data.maxUpgradeLevel[upgrade.getID()] = upgrade.maxRepeats();
+	}
+	for (bool & available : _data.isResearchAvailable)
+	{
+		available = true;
+	}
+	for (bool & available : _data.isUnitAvailable)
+	{
+		available = true;
+	}
+}
+
+// Whether a unit of the given type is counted in the given group, as BWAPI counts them.
+bool HeadlessPlayer::countsAs(BWAPI::UnitType type, BWAPI::UnitType group)
+{
+	switch (group)
+	{
+	case BWAPI::UnitTypes::Enum::AllUnits:
+		return true;
+	case BWAPI::UnitTypes::Enum::Men:
+		return !type.isBuilding();
+	case BWAPI::UnitTypes::Enum::Buildings:
+		return type.isBuilding();
+	case BWAPI::UnitTypes::Enum::Factories:
+		return type.isBuilding() && type.canProduce();
+	default:
+		return type == group;
+	}
+}
+
+int HeadlessPlayer::sumCounts(const int counts[], BWAPI::UnitType group) const
+{
+	if (group.getID() < BWAPI::UnitTypes::Enum::None)
+	{
+		return counts[group.getID()];
+	}
+
+	int total = 0;
+	for (int i = 0; i < BWAPI::UnitTypes::Enum::None; ++i)
+	{
+		if (countsAs(BWAPI::UnitType(i), group))
+		{
+			total += counts[i];
+		}
+	}
+	return total;
+}
+
+int HeadlessPlayer::getID() const { return _id; }
+std::string HeadlessPlayer::getName() const { return _data.name; }
+const BWAPI::Unitset & HeadlessPlayer::getUnits() const { return _units; }
+BWAPI::Race HeadlessPlayer::getRace() const { return BWAPI::Race(_data.race); }
+BWAPI::PlayerType HeadlessPlayer::getType() const { return BWAPI::PlayerType(_data.type); }
+BWAPI::Force HeadlessPlayer::getForce() const { return nullptr; }
+
+bool HeadlessPlayer::isAlly(const BWAPI::Player player) const
+{
+	return player && _data.isAlly[player->getID()];
+}
+
+bool HeadlessPlayer::isEnemy(const BWAPI::Player player) const
+{
+	return player && _data.isEnemy[player->getID()];
+}
+
+bool HeadlessPlayer::isNeutral() const { return _data.isNeutral; }
+
+BWAPI::TilePosition HeadlessPlayer::getStartLocation() const
+{
+	return BWAPI::TilePosition(_data.startLocationX, _data.startLocationY);
+}
+
+bool HeadlessPlayer::isVictorious() const { return _data.isVictorious; }
+bool HeadlessPlayer::isDefeated() const { return _data.isDefeated; }
+bool HeadlessPlayer::leftGame() const { return _data.leftGame; }
+
+int HeadlessPlayer::minerals() const { return _data.minerals; }
+int HeadlessPlayer::gas() const { return _data.gas; }
+int HeadlessPlayer::gatheredMinerals() const { return _data.gatheredMinerals; }
+int HeadlessPlayer::gatheredGas() const { return _data.gatheredGas; }
+int HeadlessPlayer::repairedMinerals() const { return _data.repairedMinerals; }
+int HeadlessPlayer::repairedGas() const { return _data.repairedGas; }
+int HeadlessPlayer::refundedMinerals() const { return _data.refundedMinerals; }
+int HeadlessPlayer::refundedGas() const { return _data.refundedGas; }
+
+int HeadlessPlayer::spentMinerals() const
+{
+	return _data.gatheredMinerals + _data.refundedMinerals - _data.minerals - _data.repairedMinerals;
+}
+
+int HeadlessPlayer::spentGas() const
+{
+	return _data.gatheredGas + _data.refundedGas - _data.gas - _data.repairedGas;
+}
+
+int HeadlessPlayer::supplyTotal(BWAPI::Race race) const
+{
+	if (race == BWAPI::Races::None)
+	{
+		race = getRace();
+	}
+	return race.getID() < 3 ? _data.supplyTotal[race.getID()] : 0;
+}
+
+int HeadlessPlayer::supplyUsed(BWAPI::Race race) const
+{
+	if (race == BWAPI::Races::None)
+	{
+		race = getRace();
+	}
+	return race.getID() < 3 ? _data.supplyUsed[race.getID()] : 0;
+}
+
+int HeadlessPlayer::allUnitCount(BWAPI::UnitType unit) const { return sumCounts(_data.allUnitCount, unit); }
+int HeadlessPlayer::visibleUnitCount(BWAPI::UnitType unit) const { return sumCounts(_data.visibleUnitCount, unit); }
+int HeadlessPlayer::completedUnitCount(BWAPI::UnitType unit) const { return sumCounts(_data.completedUnitCount, unit); }
+int HeadlessPlayer::deadUnitCount(BWAPI::UnitType unit) const { return sumCounts(_data.deadUnitCount, unit); }
+int HeadlessPlayer::killedUnitCount(BWAPI::UnitType unit) const { return sumCounts(_data.killedUnitCount, unit); }
+
+int HeadlessPlayer::getUpgradeLevel(BWAPI::UpgradeType upgrade) const { return _data.upgradeLevel[upgrade.getID()]; }
+bool HeadlessPlayer::hasResearched(BWAPI::TechType tech) const { return _data.hasResearched[tech.getID()]; }
+bool HeadlessPlayer::isResearching(BWAPI::TechType tech) const { return _data.isResearching[tech.getID()]; }
+bool HeadlessPlayer::isUpgrading(BWAPI::UpgradeType upgrade) const { return _data.isUpgrading[upgrade.getID()]; }
+
+BWAPI::Color HeadlessPlayer::getColor() const { return BWAPI::Color(_data.color); }
+int HeadlessPlayer::getUnitScore() const { return _data.totalUnitScore; }
+int HeadlessPlayer::getKillScore() const { return _data.totalKillScore; }
+int HeadlessPlayer::getBuildingScore() const { return _data.totalBuildingScore; }
+int HeadlessPlayer::getRazingScore() const { return _data.totalRazingScore; }
+int HeadlessPlayer::getCustomScore() const { return _data.customScore; }
+bool HeadlessPlayer::isObserver() const { return !_data.isParticipating; }
+
+int HeadlessPlayer::getMaxUpgradeLevel(BWAPI::UpgradeType upgrade) const { return _data.maxUpgradeLevel[upgrade.getID()]; }
+bool HeadlessPlayer::isResearchAvailable(BWAPI::TechType tech) const { return _data.isResearchAvailable[tech.getID()]; }
+bool HeadlessPlayer::isUnitAvailable(BWAPI::UnitType unit) const { return _data.isUnitAvailable[unit.getID()]; }
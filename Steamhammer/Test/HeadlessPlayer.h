@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Common.h"
+
+#include <BWAPI/Client/PlayerData.h>
+
+// A player of a HeadlessGame.
+// The state is kept in BWAPI's own PlayerData layout, so that a script or a recording can
+// set any of it directly. The unit counts and supply are kept up to date by the game.
+
+namespace UAlbertaBot
+{
+
+class HeadlessPlayer : public BWAPI::PlayerInterface
+{
+	friend class HeadlessGame;
+
+	int						_id;
+	BWAPI::PlayerData		_data;
+	BWAPI::Unitset			_units;			// accessible units, set by the game each frame
+
+	static bool countsAs(BWAPI::UnitType type, BWAPI::UnitType group);
+	int sumCounts(const int counts[], BWAPI::UnitType group) const;
+
+public:
+
+	HeadlessPlayer(int id, const std::string & name, BWAPI::Race race, BWAPI::PlayerType type);
+
+	BWAPI::PlayerData & data() { return _data; };
+
+	int getID() const override;
+	std::string getName() const override;
+	const BWAPI::Unitset & getUnits() const override;
+	BWAPI::Race getRace() const override;
+	BWAPI::PlayerType getType() const override;
+	BWAPI::Force getForce() const override;
+	bool isAlly(const BWAPI::Player player) const override;
+	bool isEnemy(const BWAPI::Player player) const override;
+	bool isNeutral() const override;
+	BWAPI::TilePosition getStartLocation() const override;
+	bool isVictorious() const override;
+	bool isDefeated() const override;
+	bool leftGame() const override;
+
+	int minerals() const override;
+	int gas() const override;
+	int gatheredMinerals() const override;
+	int gatheredGas() const override;
+	int repairedMinerals() const override;
+	int repairedGas() const override;
+	int refundedMinerals() const override;
+	int refundedGas() const override;
+	int spentMinerals() const override;
+	int spentGas() const override;
+	int supplyTotal(BWAPI::Race race = BWAPI::Races::None) const override;
+	int supplyUsed(BWAPI::Race race = BWAPI::Races::None) const override;
+
+	int allUnitCount(BWAPI::UnitType unit = BWAPI::UnitTypes::AllUnits) const override;
+	int visibleUnitCount(BWAPI::UnitType unit = BWAPI::UnitTypes::AllUnits) const override;
+	int completedUnitCount(BWAPI::UnitType unit = BWAPI::UnitTypes::AllUnits) const override;
+	int deadUnitCount(BWAPI::UnitType unit = BWAPI::UnitTypes::AllUnits) const override;
+	int killedUnitCount(BWAPI::UnitType unit = BWAPI::UnitTypes::AllUnits) const override;
+
+	int getUpgradeLevel(BWAPI::UpgradeType upgrade) const override;
+	bool hasResearched(BWAPI::TechType tech) const override;
+	bool isResearching(BWAPI::TechType tech) const override;
+	bool isUpgrading(BWAPI::UpgradeType upgrade) const override;
+
+	BWAPI::Color getColor() const override;
+	int getUnitScore() const override;
+	int getKillScore() const override;
+	int getBuildingScore() const override;
+	int getRazingScore() const override;
+	int getCustomScore() const override;
+	bool isObserver() const override;
+
+	int getMaxUpgradeLevel(BWAPI::UpgradeType upgrade) const override;
+	bool isResearchAvailable(BWAPI::TechType tech) const override;
+	bool isUnitAvailable(BWAPI::UnitType unit) const override;
+};
+
+}
@@ -0,0 +1,493 @@
+#include "HeadlessUnit.h"
+
+#include "HeadlessGame.h"
+
+#include <cstring>
+
+using namespace UAlbertaBot;
+
+HeadlessUnit::HeadlessUnit(HeadlessGame & game, int id, BWAPI::UnitType type, BWAPI::Player player, BWAPI::Position position)
+	: _game(game)
+	, _id(id)
+	, _lastCommandFrame(0)
+{
+	std::memset(&_data, 0, sizeof(_data));
+
+	_data.clearanceLevel = 3;
+	_data.id = id;
+	_data.replayID = id;
+	_data.player = player->getID();
+	_data.type = type.getID();
+	_data.positionX = position.x;
+	_data.positionY = position.y;
+	_data.hitPoints = type.maxHitPoints();
+	_data.lastHitPoints = _data.hitPoints;
+	_data.shields = type.maxShields();
+	_data.energy = (std::min)(50, type.maxEnergy());
+	_data.resources =
+		type.isMineralField() ? 1500 :
+		type == BWAPI::UnitTypes::Resource_Vespene_Geyser || type.isRefinery() ? 5000 :
+		0;
+
+	_data.buildType = BWAPI::UnitTypes::None;
+	_data.tech = BWAPI::TechTypes::None;
+	_data.upgrade = BWAPI::UpgradeTypes::None;
+	_data.buildUnit = -1;
+	_data.target = -1;
+	_data.targetPositionX = position.x;
+	_data.targetPositionY = position.y;
+	_data.order = player->isNeutral() ? BWAPI::Orders::Nothing : BWAPI::Orders::PlayerGuard;
+	_data.orderTarget = -1;
+	_data.orderTargetPositionX = BWAPI::Positions::None.x;
+	_data.orderTargetPositionY = BWAPI::Positions::None.y;
+	_data.secondaryOrder = BWAPI::Orders::Nothing;
+	_data.rallyPositionX = BWAPI::Positions::None.x;
+	_data.rallyPositionY = BWAPI::Positions::None.y;
+	_data.rallyUnit = -1;
+	_data.addon = -1;
+	_data.nydusExit = -1;
+	_data.powerUp = -1;
+	_data.transport = -1;
+	_data.carrier = -1;
+	_data.hatchery = -1;
+	_data.lastAttackerPlayer = -1;
+
+	_data.exists = true;
+	_data.isCompleted = true;
+	_data.isDetected = true;
+	_data.isIdle = true;
+	_data.isInterruptible = true;
+	_data.isPowered = true;
+
+	saveInitialState();
+}
+
+void HeadlessUnit::saveInitialState()
+{
+	_initialType = getType();
+	_initialPosition = getPosition();
+	_initialHitPoints = _data.hitPoints;
+	_initialResources = _data.resources;
+}
+
+bool HeadlessUnit::commandable() const
+{
+	return _data.exists && _data.isCompleted && _data.player == _game.self()->getID();
+}
+
+bool HeadlessUnit::orderIs(std::initializer_list<BWAPI::Order> orders) const
+{
+	for (BWAPI::Order order : orders)
+	{
+		if (_data.order == order.getID())
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+int HeadlessUnit::getID() const { return _id; }
+bool HeadlessUnit::exists() const { return _data.exists; }
+int HeadlessUnit::getReplayID() const { return _data.replayID; }
+BWAPI::Player HeadlessUnit::getPlayer() const { return _game.getPlayer(_data.player); }
+BWAPI::UnitType HeadlessUnit::getType() const { return BWAPI::UnitType(_data.type); }
+BWAPI::Position HeadlessUnit::getPosition() const { return BWAPI::Position(_data.positionX, _data.positionY); }
+double HeadlessUnit::getAngle() const { return _data.angle; }
+double HeadlessUnit::getVelocityX() const { return _data.velocityX; }
+double HeadlessUnit::getVelocityY() const { return _data.velocityY; }
+int HeadlessUnit::getHitPoints() const { return _data.hitPoints; }
+int HeadlessUnit::getShields() const { return _data.shields; }
+int HeadlessUnit::getEnergy() const { return _data.energy; }
+int HeadlessUnit::getResources() const { return _data.resources; }
+int HeadlessUnit::getResourceGroup() const { return _data.resourceGroup; }
+
+int HeadlessUnit::getLastCommandFrame() const { return _lastCommandFrame; }
+BWAPI::UnitCommand HeadlessUnit::getLastCommand() const { return _lastCommand; }
+BWAPI::Player HeadlessUnit::getLastAttackingPlayer() const { return _game.getPlayer(_data.lastAttackerPlayer); }
+
+BWAPI::UnitType HeadlessUnit::getInitialType() const { return _initialType; }
+BWAPI::Position HeadlessUnit::getInitialPosition() const { return _initialPosition; }
+BWAPI::TilePosition HeadlessUnit::getInitialTilePosition() const
+{
+	return BWAPI::TilePosition(_initialPosition - BWAPI::Position(_initialType.tileSize()) / 2);
+}
+int HeadlessUnit::getInitialHitPoints() const { return _initialHitPoints; }
+int HeadlessUnit::getInitialResources() const { return _initialResources; }
+
+int HeadlessUnit::getKillCount() const { return _data.killCount; }
+int HeadlessUnit::getAcidSporeCount() const { return _data.acidSporeCount; }
+int HeadlessUnit::getInterceptorCount() const { return _data.interceptorCount; }
+int HeadlessUnit::getScarabCount() const { return _data.scarabCount; }
+int HeadlessUnit::getSpiderMineCount() const { return _data.spiderMineCount; }
+int HeadlessUnit::getGroundWeaponCooldown() const { return _data.groundWeaponCooldown; }
+int HeadlessUnit::getAirWeaponCooldown() const { return _data.airWeaponCooldown; }
+int HeadlessUnit::getSpellCooldown() const { return _data.spellCooldown; }
+int HeadlessUnit::getDefenseMatrixPoints() const { return _data.defenseMatrixPoints; }
+int HeadlessUnit::getDefenseMatrixTimer() const { return _data.defenseMatrixTimer; }
+int HeadlessUnit::getEnsnareTimer() const { return _data.ensnareTimer; }
+int HeadlessUnit::getIrradiateTimer() const { return _data.irradiateTimer; }
+int HeadlessUnit::getLockdownTimer() const { return _data.lockdownTimer; }
+int HeadlessUnit::getMaelstromTimer() const { return _data.maelstromTimer; }
+int HeadlessUnit::getOrderTimer() const { return _data.orderTimer; }
+int HeadlessUnit::getPlagueTimer() const { return _data.plagueTimer; }
+int HeadlessUnit::getRemoveTimer() const { return _data.removeTimer; }
+int HeadlessUnit::getStasisTimer() const { return _data.stasisTimer; }
+int HeadlessUnit::getStimTimer() const { return _data.stimTimer; }
+
+BWAPI::UnitType HeadlessUnit::getBuildType() const { return BWAPI::UnitType(_data.buildType); }
+
+BWAPI::UnitType::list HeadlessUnit::getTrainingQueue() const
+{
+	BWAPI::UnitType::list queue;
+	for (int i = 0; i < _data.trainingQueueCount; ++i)
+	{
+		queue.push_back(BWAPI::UnitType(_data.trainingQueue[i]));
+	}
+	return queue;
+}
+
+BWAPI::TechType HeadlessUnit::getTech() const { return BWAPI::TechType(_data.tech); }
+BWAPI::UpgradeType HeadlessUnit::getUpgrade() const { return BWAPI::UpgradeType(_data.upgrade); }
+int HeadlessUnit::getRemainingBuildTime() const { return _data.remainingBuildTime; }
+int HeadlessUnit::getRemainingTrainTime() const { return _data.remainingTrainTime; }
+int HeadlessUnit::getRemainingResearchTime() const { return _data.remainingResearchTime; }
+int HeadlessUnit::getRemainingUpgradeTime() const { return _data.remainingUpgradeTime; }
+BWAPI::Unit HeadlessUnit::getBuildUnit() const { return _game.getUnit(_data.buildUnit); }
+
+BWAPI::Unit HeadlessUnit::getTarget() const { return _game.getUnit(_data.target); }
+BWAPI::Position HeadlessUnit::getTargetPosition() const { return BWAPI::Position(_data.targetPositionX, _data.targetPositionY); }
+BWAPI::Order HeadlessUnit::getOrder() const { return BWAPI::Order(_data.order); }
+BWAPI::Order HeadlessUnit::getSecondaryOrder() const { return BWAPI::Order(_data.secondaryOrder); }
+BWAPI::Unit HeadlessUnit::getOrderTarget() const { return _game.getUnit(_data.orderTarget); }
+BWAPI::Position HeadlessUnit::getOrderTargetPosition() const { return BWAPI::Position(_data.orderTargetPositionX, _data.orderTargetPositionY); }
+BWAPI::Position HeadlessUnit::getRallyPosition() const { return BWAPI::Position(_data.rallyPositionX, _data.rallyPositionY); }
+BWAPI::Unit HeadlessUnit::getRallyUnit() const { return _game.getUnit(_data.rallyUnit); }
+BWAPI::Unit HeadlessUnit::getAddon() const { return _game.getUnit(_data.addon); }
+BWAPI::Unit HeadlessUnit::getNydusExit() const { return _game.getUnit(_data.nydusExit); }
+BWAPI::Unit HeadlessUnit::getPowerUp() const { return _game.getUnit(_data.powerUp); }
+BWAPI::Unit HeadlessUnit::getTransport() const { return _game.getUnit(_data.transport); }
+
+BWAPI::Unitset HeadlessUnit::getLoadedUnits() const
+{
+	BWAPI::Unitset loaded;
+	for (BWAPI::Unit unit : _game.getAllUnits())
+	{
+		if (unit->getTransport() == this)
+		{
+			loaded.insert(unit);
+		}
+	}
+	return loaded;
+}
+
+BWAPI::Unit HeadlessUnit::getCarrier() const { return _game.getUnit(_data.carrier); }
+
+BWAPI::Unitset HeadlessUnit::getInterceptors() const
+{
+	BWAPI::Unitset interceptors;
+	for (BWAPI::Unit unit : _game.getAllUnits())
+	{
+		if (unit->getCarrier() == this)
+		{
+			interceptors.insert(unit);
+		}
+	}
+	return interceptors;
+}
+
+BWAPI::Unit HeadlessUnit::getHatchery() const { return _game.getUnit(_data.hatchery); }
+
+BWAPI::Unitset HeadlessUnit::getLarva() const
+{
+	BWAPI::Unitset larva;
+	for (BWAPI::Unit unit : _game.getAllUnits())
+	{
+		if (unit->getHatchery() == this && unit->getType() == BWAPI::UnitTypes::Zerg_Larva)
+		{
+			larva.insert(unit);
+		}
+	}
+	return larva;
+}
+
+bool HeadlessUnit::hasNuke() const { return _data.hasNuke; }
+bool HeadlessUnit::isAccelerating() const { return _data.isAccelerating; }
+bool HeadlessUnit::isAttacking() const { return _data.isAttacking; }
+bool HeadlessUnit::isAttackFrame() const { return _data.isAttackFrame; }
+bool HeadlessUnit::isBeingGathered() const { return _data.isBeingGathered; }
+
+bool HeadlessUnit::isBeingHealed() const
+{
+	return getType().getRace() == BWAPI::Races::Terran && _data.isCompleted && _data.hitPoints > _data.lastHitPoints;
+}
+
+bool HeadlessUnit::isBlind() const { return _data.isBlind; }
+bool HeadlessUnit::isBraking() const { return _data.isBraking; }
+bool HeadlessUnit::isBurrowed() const { return _data.isBurrowed; }
+bool HeadlessUnit::isCarryingGas() const { return _data.carryResourceType == 1; }
+bool HeadlessUnit::isCarryingMinerals() const { return _data.carryResourceType == 2; }
+bool HeadlessUnit::isCloaked() const { return _data.isCloaked; }
+bool HeadlessUnit::isCompleted() const { return _data.isCompleted; }
+bool HeadlessUnit::isConstructing() const { return _data.isConstructing; }
+bool HeadlessUnit::isDetected() const { return _data.isDetected; }
+
+bool HeadlessUnit::isGatheringGas() const
+{
+	return _data.isGathering &&
+		(isCarryingGas() || orderIs({ BWAPI::Orders::MoveToGas, BWAPI::Orders::WaitForGas, BWAPI::Orders::HarvestGas, BWAPI::Orders::ReturnGas }));
+}
+
+bool HeadlessUnit::isGatheringMinerals() const
+{
+	return _data.isGathering &&
+		(isCarryingMinerals() || orderIs({ BWAPI::Orders::MoveToMinerals, BWAPI::Orders::WaitForMinerals, BWAPI::Orders::MiningMinerals, BWAPI::Orders::ReturnMinerals }));
+}
+
+bool HeadlessUnit::isHallucination() const { return _data.isHallucination; }
+bool HeadlessUnit::isIdle() const { return _data.isIdle; }
+bool HeadlessUnit::isInterruptible() const { return _data.isInterruptible; }
+bool HeadlessUnit::isInvincible() const { return _data.isInvincible; }
+bool HeadlessUnit::isLifted() const { return _data.isLifted; }
+bool HeadlessUnit::isMorphing() const { return _data.isMorphing; }
+bool HeadlessUnit::isMoving() const { return _data.isMoving; }
+bool HeadlessUnit::isParasited() const { return _data.isParasited; }
+bool HeadlessUnit::isSelected() const { return _data.isSelected; }
+bool HeadlessUnit::isStartingAttack() const { return _data.isStartingAttack; }
+bool HeadlessUnit::isStuck() const { return _data.isStuck; }
+bool HeadlessUnit::isTraining() const { return _data.isTraining; }
+bool HeadlessUnit::isUnderAttack() const { return _data.recentlyAttacked; }
+bool HeadlessUnit::isUnderDarkSwarm() const { return _data.isUnderDarkSwarm; }
+bool HeadlessUnit::isUnderDisruptionWeb() const { return _data.isUnderDWeb; }
+bool HeadlessUnit::isUnderStorm() const { return _data.isUnderStorm; }
+bool HeadlessUnit::isPowered() const { return _data.isPowered; }
+
+bool HeadlessUnit::isVisible(BWAPI::Player player) const
+{
+	const int id = player ? player->getID() : _game.self()->getID();
+	return id >= 0 && id < 9 && _data.isVisible[id];
+}
+
+bool HeadlessUnit::isTargetable() const
+{
+	if (!_data.exists)
+	{
+		return false;
+	}
+	const BWAPI::UnitType type = getType();
+	if (!_data.isCompleted && !type.isBuilding() && !_data.isMorphing &&
+		type != BWAPI::UnitTypes::Protoss_Archon && type != BWAPI::UnitTypes::Protoss_Dark_Archon)
+	{
+		return false;
+	}
+	return
+		type != BWAPI::UnitTypes::Spell_Scanner_Sweep &&
+		type != BWAPI::UnitTypes::Spell_Dark_Swarm &&
+		type != BWAPI::UnitTypes::Spell_Disruption_Web &&
+		type != BWAPI::UnitTypes::Special_Map_Revealer;
+}
+
+bool HeadlessUnit::issueCommand(BWAPI::UnitCommand command)
+{
+	if (!canIssueCommand(command))
+	{
+		return false;
+	}
+
+	command.unit = this;
+	_lastCommand = command;
+	_lastCommandFrame = _game.getFrameCount();
+	applyCommand(command);
+	_game.recordCommand(command);
+	return true;
+}
+
+// Set the order and targets that the command gives the unit, for the commands the bot
+// checks the effect of. The unit does not carry out the order.
+void HeadlessUnit::applyCommand(const BWAPI::UnitCommand & command)
+{
+	const BWAPI::Unit target = command.getTarget();
+	const BWAPI::Position targetPosition = command.getTargetPosition();
+
+	auto setOrder = [&](BWAPI::Order order)
+	{
+		_data.order = order;
+		_data.orderTarget = target ? target->getID() : -1;
+		_data.target = _data.orderTarget;
+		if (target)
+		{
+			_data.targetPositionX = target->getPosition().x;
+			_data.targetPositionY = target->getPosition().y;
+		}
+		else if (targetPosition.isValid())
+		{
+			_data.targetPositionX = targetPosition.x;
+			_data.targetPositionY = targetPosition.y;
+		}
+		_data.orderTargetPositionX = _data.targetPositionX;
+		_data.orderTargetPositionY = _data.targetPositionY;
+		_data.isIdle = false;
+	};
+
+	switch (command.getType())
+	{
+	case BWAPI::UnitCommandTypes::Enum::Move:
+	case BWAPI::UnitCommandTypes::Enum::Right_Click_Position:
+		setOrder(BWAPI::Orders::Move);
+		break;
+	case BWAPI::UnitCommandTypes::Enum::Attack_Move:
+		setOrder(BWAPI::Orders::AttackMove);
+		break;
+	case BWAPI::UnitCommandTypes::Enum::Attack_Unit:
+		setOrder(BWAPI::Orders::AttackUnit);
+		break;
+	case BWAPI::UnitCommandTypes::Enum::Right_Click_Unit:
+		setOrder(
+			target->getType().isResourceContainer() ? BWAPI::Orders::Harvest1 :
+			getPlayer()->isEnemy(target->getPlayer()) ? BWAPI::Orders::AttackUnit :
+			BWAPI::Orders::Follow);
+		break;
+	case BWAPI::UnitCommandTypes::Enum::Follow:
+		setOrder(BWAPI::Orders::Follow);
+		break;
+	case BWAPI::UnitCommandTypes::Enum::Patrol:
+		setOrder(BWAPI::Orders::Patrol);
+		break;
+	case BWAPI::UnitCommandTypes::Enum::Gather:
+		setOrder(target->getType().isMineralField() ? BWAPI::Orders::MoveToMinerals : BWAPI::Orders::MoveToGas);
+		_data.isGathering = true;
+		break;
+	case BWAPI::UnitCommandTypes::Enum::Return_Cargo:
+		setOrder(isCarryingGas() ? BWAPI::Orders::ReturnGas : BWAPI::Orders::ReturnMinerals);
+		break;
+	case BWAPI::UnitCommandTypes::Enum::Repair:
+		setOrder(BWAPI::Orders::Repair);
+		break;
+	case BWAPI::UnitCommandTypes::Enum::Build:
+		setOrder(BWAPI::Orders::PlaceBuilding);
+		_data.buildType = command.getUnitType();
+		_data.targetPositionX = command.getTargetTilePosition().x * 32 + command.getUnitType().tileWidth() * 16;
+		_data.targetPositionY = command.getTargetTilePosition().y * 32 + command.getUnitType().tileHeight() * 16;
+		break;
+	case BWAPI::UnitCommandTypes::Enum::Train:
+		if (_data.trainingQueueCount < 5)
+		{
+			_data.trainingQueue[_data.trainingQueueCount++] = command.getUnitType();
+			_data.isTraining = true;
+			_data.isIdle = false;
+		}
+		break;
+	case BWAPI::UnitCommandTypes::Enum::Hold_Position:
+		setOrder(BWAPI::Orders::HoldPosition);
+		break;
+	case BWAPI::UnitCommandTypes::Enum::Stop:
+		setOrder(BWAPI::Orders::PlayerGuard);
+		_data.isIdle = true;
+		_data.isGathering = false;
+		break;
+	default:
+		break;
+	}
+}
+
+bool HeadlessUnit::canCommand() const { return commandable(); }
+bool HeadlessUnit::canIssueCommand(BWAPI::UnitCommand command, bool checkCanUseTechPositionOnPositions, bool checkCanUseTechUnitOnUnits, bool checkCanBuildUnitType, bool checkCanTargetUnit, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canIssueCommandGrouped(BWAPI::UnitCommand command, bool checkCanUseTechPositionOnPositions, bool checkCanUseTechUnitOnUnits, bool checkCanTargetUnit, bool checkCanIssueCommandType, bool checkCommandibilityGrouped, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canCommandGrouped(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canIssueCommandType(BWAPI::UnitCommandType ct, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canIssueCommandTypeGrouped(BWAPI::UnitCommandType ct, bool checkCommandibilityGrouped, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canTargetUnit(BWAPI::Unit targetUnit, bool checkCommandibility) const { return targetUnit && targetUnit->exists() && commandable(); }
+bool HeadlessUnit::canAttack(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canAttack(BWAPI::Position target, bool checkCanTargetUnit, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canAttack(BWAPI::Unit target, bool checkCanTargetUnit, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canAttackGrouped(bool checkCommandibilityGrouped, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canAttackGrouped(BWAPI::Position target, bool checkCanTargetUnit, bool checkCanIssueCommandType, bool checkCommandibilityGrouped, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canAttackGrouped(BWAPI::Unit target, bool checkCanTargetUnit, bool checkCanIssueCommandType, bool checkCommandibilityGrouped, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canAttackMove(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canAttackMoveGrouped(bool checkCommandibilityGrouped, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canAttackUnit(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canAttackUnit(BWAPI::Unit targetUnit, bool checkCanTargetUnit, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canAttackUnitGrouped(bool checkCommandibilityGrouped, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canAttackUnitGrouped(BWAPI::Unit targetUnit, bool checkCanTargetUnit, bool checkCanIssueCommandType, bool checkCommandibilityGrouped, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canBuild(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canBuild(BWAPI::UnitType uType, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canBuild(BWAPI::UnitType uType, BWAPI::TilePosition tilePos, bool checkTargetUnitType, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canBuildAddon(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canBuildAddon(BWAPI::UnitType uType, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canTrain(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canTrain(BWAPI::UnitType uType, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canMorph(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canMorph(BWAPI::UnitType uType, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canResearch(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canResearch(BWAPI::TechType type, bool checkCanIssueCommandType) const { return commandable(); }
+bool HeadlessUnit::canUpgrade(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canUpgrade(BWAPI::UpgradeType type, bool checkCanIssueCommandType) const { return commandable(); }
+bool HeadlessUnit::canSetRallyPoint(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canSetRallyPoint(BWAPI::Position target, bool checkCanTargetUnit, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canSetRallyPoint(BWAPI::Unit target, bool checkCanTargetUnit, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canSetRallyPosition(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canSetRallyUnit(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canSetRallyUnit(BWAPI::Unit targetUnit, bool checkCanTargetUnit, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canMove(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canMoveGrouped(bool checkCommandibilityGrouped, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canPatrol(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canPatrolGrouped(bool checkCommandibilityGrouped, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canFollow(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canFollow(BWAPI::Unit targetUnit, bool checkCanTargetUnit, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canGather(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canGather(BWAPI::Unit targetUnit, bool checkCanTargetUnit, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canReturnCargo(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canHoldPosition(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canStop(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canRepair(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canRepair(BWAPI::Unit targetUnit, bool checkCanTargetUnit, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canBurrow(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canUnburrow(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canCloak(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canDecloak(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canSiege(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canUnsiege(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canLift(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canLand(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canLand(BWAPI::TilePosition target, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canLoad(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canLoad(BWAPI::Unit targetUnit, bool checkCanTargetUnit, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canUnloadWithOrWithoutTarget(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canUnloadAtPosition(BWAPI::Position targDropPos, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canUnload(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canUnload(BWAPI::Unit targetUnit, bool checkCanTargetUnit, bool checkPosition, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canUnloadAll(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canUnloadAllPosition(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canUnloadAllPosition(BWAPI::Position targDropPos, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canRightClick(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canRightClick(BWAPI::Position target, bool checkCanTargetUnit, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canRightClick(BWAPI::Unit target, bool checkCanTargetUnit, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canRightClickGrouped(bool checkCommandibilityGrouped, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canRightClickGrouped(BWAPI::Position target, bool checkCanTargetUnit, bool checkCanIssueCommandType, bool checkCommandibilityGrouped, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canRightClickGrouped(BWAPI::Unit target, bool checkCanTargetUnit, bool checkCanIssueCommandType, bool checkCommandibilityGrouped, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canRightClickPosition(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canRightClickPositionGrouped(bool checkCommandibilityGrouped, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canRightClickUnit(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canRightClickUnit(BWAPI::Unit targetUnit, bool checkCanTargetUnit, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canRightClickUnitGrouped(bool checkCommandibilityGrouped, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canRightClickUnitGrouped(BWAPI::Unit targetUnit, bool checkCanTargetUnit, bool checkCanIssueCommandType, bool checkCommandibilityGrouped, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canHaltConstruction(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canCancelConstruction(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canCancelAddon(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canCancelTrain(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canCancelTrainSlot(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canCancelTrainSlot(int slot, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canCancelMorph(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canCancelResearch(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canCancelUpgrade(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canUseTechWithOrWithoutTarget(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canUseTechWithOrWithoutTarget(BWAPI::TechType tech, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canUseTech(BWAPI::TechType tech, BWAPI::Position target, bool checkCanTargetUnit, bool checkTargetsType, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canUseTech(BWAPI::TechType tech, BWAPI::Unit target, bool checkCanTargetUnit, bool checkTargetsType, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canUseTechWithoutTarget(BWAPI::TechType tech, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canUseTechUnit(BWAPI::TechType tech, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canUseTechUnit(BWAPI::TechType tech, BWAPI::Unit targetUnit, bool checkCanTargetUnit, bool checkTargetsUnits, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canUseTechPosition(BWAPI::TechType tech, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canUseTechPosition(BWAPI::TechType tech, BWAPI::Position target, bool checkTargetsPositions, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canPlaceCOP(bool checkCommandibility) const { return commandable(); }
+bool HeadlessUnit::canPlaceCOP(BWAPI::TilePosition target, bool checkCanIssueCommandType, bool checkCommandibility) const { return commandable(); }
@@ -0,0 +1,256 @@
+#pragma once
+
+#include "Common.h"
+
+#include <BWAPI/Client/UnitData.h>
+
+// A unit of a HeadlessGame.
+// The state is kept in BWAPI's own UnitData layout, so that a script or a recording can
+// set any of it directly, and the getters read it the way BWAPI's client does.
+// Commands are recorded by the game and update the unit's order and targets, so that the
+// bot sees the effect of its own commands. Nothing else is simulated.
+
+namespace UAlbertaBot
+{
+
+class HeadlessGame;
+
+class HeadlessUnit : public BWAPI::UnitInterface
+{
+	friend class HeadlessGame;
+
+	HeadlessGame &		_game;
+	int					_id;
+	BWAPI::UnitData		_data;
+
+	BWAPI::UnitType		_initialType;
+	BWAPI::Position		_initialPosition;
+	int					_initialHitPoints;
+	int					_initialResources;
+
+	int					_lastCommandFrame;
+	BWAPI::UnitCommand	_lastCommand;
+
+	void saveInitialState();
+	void applyCommand(const BWAPI::UnitCommand & command);
+	bool commandable() const;
+	bool orderIs(std::initializer_list<BWAPI::Order> orders) const;
+
+public:
+
+	HeadlessUnit(HeadlessGame & game, int id, BWAPI::UnitType type, BWAPI::Player player, BWAPI::Position position);
+
+	BWAPI::UnitData & data() { return _data; };
+
+	int getID() const override;
+	bool exists() const override;
+	int getReplayID() const override;
+	BWAPI::Player getPlayer() const override;
+	BWAPI::UnitType getType() const override;
+	BWAPI::Position getPosition() const override;
+	double getAngle() const override;
+	double getVelocityX() const override;
+	double getVelocityY() const override;
+	int getHitPoints() const override;
+	int getShields() const override;
+	int getEnergy() const override;
+	int getResources() const override;
+	int getResourceGroup() const override;
+	int getLastCommandFrame() const override;
+	BWAPI::UnitCommand getLastCommand() const override;
+	BWAPI::Player getLastAttackingPlayer() const override;
+	BWAPI::UnitType getInitialType() const override;
+	BWAPI::Position getInitialPosition() const override;
+	BWAPI::TilePosition getInitialTilePosition() const override;
+	int getInitialHitPoints() const override;
+	int getInitialResources() const override;
+	int getKillCount() const override;
+	int getAcidSporeCount() const override;
+	int getInterceptorCount() const override;
+	int getScarabCount() const override;
+	int getSpiderMineCount() const override;
+	int getGroundWeaponCooldown() const override;
+	int getAirWeaponCooldown() const override;
+	int getSpellCooldown() const override;
+	int getDefenseMatrixPoints() const override;
+	int getDefenseMatrixTimer() const override;
+	int getEnsnareTimer() const override;
+	int getIrradiateTimer() const override;
+	int getLockdownTimer() const override;
+	int getMaelstromTimer() const override;
+	int getOrderTimer() const override;
+	int getPlagueTimer() const override;
+	int getRemoveTimer() const override;
+	int getStasisTimer() const override;
+	int getStimTimer() const override;
+	BWAPI::UnitType getBuildType() const override;
+	BWAPI::UnitType::list getTrainingQueue() const override;
+	BWAPI::TechType getTech() const override;
+	BWAPI::UpgradeType getUpgrade() const override;
+	int getRemainingBuildTime() const override;
+	int getRemainingTrainTime() const override;
+	int getRemainingResearchTime() const override;
+	int getRemainingUpgradeTime() const override;
+	BWAPI::Unit getBuildUnit() const override;
+	BWAPI::Unit getTarget() const override;
+	BWAPI::Position getTargetPosition() const override;
+	BWAPI::Order getOrder() const override;
+	BWAPI::Order getSecondaryOrder() const override;
+	BWAPI::Unit getOrderTarget() const override;
+	BWAPI::Position getOrderTargetPosition() const override;
+	BWAPI::Position getRallyPosition() const override;
+	BWAPI::Unit getRallyUnit() const override;
+	BWAPI::Unit getAddon() const override;
+	BWAPI::Unit getNydusExit() const override;
+	BWAPI::Unit getPowerUp() const override;
+	BWAPI::Unit getTransport() const override;
+	BWAPI::Unitset getLoadedUnits() const override;
+	BWAPI::Unit getCarrier() const override;
+	BWAPI::Unitset getInterceptors() const override;
+	BWAPI::Unit getHatchery() const override;
+	BWAPI::Unitset getLarva() const override;
+	bool hasNuke() const override;
+	bool isAccelerating() const override;
+	bool isAttacking() const override;
+	bool isAttackFrame() const override;
+	bool isBeingGathered() const override;
+	bool isBeingHealed() const override;
+	bool isBlind() const override;
+	bool isBraking() const override;
+	bool isBurrowed() const override;
+	bool isCarryingGas() const override;
+	bool isCarryingMinerals() const override;
+	bool isCloaked() const override;
+	bool isCompleted() const override;
+	bool isConstructing() const override;
+	bool isDetected() const override;
+	bool isGatheringGas() const override;
+	bool isGatheringMinerals() const override;
+	bool isHallucination() const override;
+	bool isIdle() const override;
+	bool isInterruptible() const override;
+	bool isInvincible() const override;
+	bool isLifted() const override;
+	bool isMorphing() const override;
+	bool isMoving() const override;
+	bool isParasited() const override;
+	bool isSelected() const override;
+	bool isStartingAttack() const override;
+	bool isStuck() const override;
+	bool isTraining() const override;
+	bool isUnderAttack() const override;
+	bool isUnderDarkSwarm() const override;
+	bool isUnderDisruptionWeb() const override;
+	bool isUnderStorm() const override;
+	bool isPowered() const override;
+	bool isVisible(BWAPI::Player player = nullptr) const override;
+	bool isTargetable() const override;
+
+	bool issueCommand(BWAPI::UnitCommand command) override;
+
+	// There are no game rules behind the command checks. Any of our own completed units
+	// can be given any command, and it is up to the script to make sense of it.
+	bool canIssueCommand(BWAPI::UnitCommand command, bool checkCanUseTechPositionOnPositions = true, bool checkCanUseTechUnitOnUnits = true, bool checkCanBuildUnitType = true, bool checkCanTargetUnit = true, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canIssueCommandGrouped(BWAPI::UnitCommand command, bool checkCanUseTechPositionOnPositions = true, bool checkCanUseTechUnitOnUnits = true, bool checkCanTargetUnit = true, bool checkCanIssueCommandType = true, bool checkCommandibilityGrouped = true, bool checkCommandibility = true) const override;
+	bool canCommand() const override;
+	bool canCommandGrouped(bool checkCommandibility = true) const override;
+	bool canIssueCommandType(BWAPI::UnitCommandType ct, bool checkCommandibility = true) const override;
+	bool canIssueCommandTypeGrouped(BWAPI::UnitCommandType ct, bool checkCommandibilityGrouped = true, bool checkCommandibility = true) const override;
+	bool canTargetUnit(BWAPI::Unit targetUnit, bool checkCommandibility = true) const override;
+	bool canAttack(bool checkCommandibility = true) const override;
+	bool canAttack(BWAPI::Position target, bool checkCanTargetUnit = true, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canAttack(BWAPI::Unit target, bool checkCanTargetUnit = true, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canAttackGrouped(bool checkCommandibilityGrouped = true, bool checkCommandibility = true) const override;
+	bool canAttackGrouped(BWAPI::Position target, bool checkCanTargetUnit = true, bool checkCanIssueCommandType = true, bool checkCommandibilityGrouped = true, bool checkCommandibility = true) const override;
+	bool canAttackGrouped(BWAPI::Unit target, bool checkCanTargetUnit = true, bool checkCanIssueCommandType = true, bool checkCommandibilityGrouped = true, bool checkCommandibility = true) const override;
+	bool canAttackMove(bool checkCommandibility = true) const override;
+	bool canAttackMoveGrouped(bool checkCommandibilityGrouped = true, bool checkCommandibility = true) const override;
+	bool canAttackUnit(bool checkCommandibility = true) const override;
+	bool canAttackUnit(BWAPI::Unit targetUnit, bool checkCanTargetUnit = true, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canAttackUnitGrouped(bool checkCommandibilityGrouped = true, bool checkCommandibility = true) const override;
+	bool canAttackUnitGrouped(BWAPI::Unit targetUnit, bool checkCanTargetUnit = true, bool checkCanIssueCommandType = true, bool checkCommandibilityGrouped = true, bool checkCommandibility = true) const override;
+	bool canBuild(bool checkCommandibility = true) const override;
+	bool canBuild(BWAPI::UnitType uType, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canBuild(BWAPI::UnitType uType, BWAPI::TilePosition tilePos, bool checkTargetUnitType = true, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canBuildAddon(bool checkCommandibility = true) const override;
+	bool canBuildAddon(BWAPI::UnitType uType, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canTrain(bool checkCommandibility = true) const override;
+	bool canTrain(BWAPI::UnitType uType, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canMorph(bool checkCommandibility = true) const override;
+	bool canMorph(BWAPI::UnitType uType, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canResearch(bool checkCommandibility = true) const override;
+	bool canResearch(BWAPI::TechType type, bool checkCanIssueCommandType = true) const override;
+	bool canUpgrade(bool checkCommandibility = true) const override;
+	bool canUpgrade(BWAPI::UpgradeType type, bool checkCanIssueCommandType = true) const override;
+	bool canSetRallyPoint(bool checkCommandibility = true) const override;
+	bool canSetRallyPoint(BWAPI::Position target, bool checkCanTargetUnit = true, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canSetRallyPoint(BWAPI::Unit target, bool checkCanTargetUnit = true, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canSetRallyPosition(bool checkCommandibility = true) const override;
+	bool canSetRallyUnit(bool checkCommandibility = true) const override;
+	bool canSetRallyUnit(BWAPI::Unit targetUnit, bool checkCanTargetUnit = true, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canMove(bool checkCommandibility = true) const override;
+	bool canMoveGrouped(bool checkCommandibilityGrouped = true, bool checkCommandibility = true) const override;
+	bool canPatrol(bool checkCommandibility = true) const override;
+	bool canPatrolGrouped(bool checkCommandibilityGrouped = true, bool checkCommandibility = true) const override;
+	bool canFollow(bool checkCommandibility = true) const override;
+	bool canFollow(BWAPI::Unit targetUnit, bool checkCanTargetUnit = true, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canGather(bool checkCommandibility = true) const override;
+	bool canGather(BWAPI::Unit targetUnit, bool checkCanTargetUnit = true, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canReturnCargo(bool checkCommandibility = true) const override;
+	bool canHoldPosition(bool checkCommandibility = true) const override;
+	bool canStop(bool checkCommandibility = true) const override;
+	bool canRepair(bool checkCommandibility = true) const override;
+	bool canRepair(BWAPI::Unit targetUnit, bool checkCanTargetUnit = true, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canBurrow(bool checkCommandibility = true) const override;
+	bool canUnburrow(bool checkCommandibility = true) const override;
+	bool canCloak(bool checkCommandibility = true) const override;
+	bool canDecloak(bool checkCommandibility = true) const override;
+	bool canSiege(bool checkCommandibility = true) const override;
+	bool canUnsiege(bool checkCommandibility = true) const override;
+	bool canLift(bool checkCommandibility = true) const override;
+	bool canLand(bool checkCommandibility = true) const override;
+	bool canLand(BWAPI::TilePosition target, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canLoad(bool checkCommandibility = true) const override;
+	bool canLoad(BWAPI::Unit targetUnit, bool checkCanTargetUnit = true, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canUnloadWithOrWithoutTarget(bool checkCommandibility = true) const override;
+	bool canUnloadAtPosition(BWAPI::Position targDropPos, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canUnload(bool checkCommandibility = true) const override;
+	bool canUnload(BWAPI::Unit targetUnit, bool checkCanTargetUnit = true, bool checkPosition = true, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canUnloadAll(bool checkCommandibility = true) const override;
+	bool canUnloadAllPosition(bool checkCommandibility = true) const override;
+	bool canUnloadAllPosition(BWAPI::Position targDropPos, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canRightClick(bool checkCommandibility = true) const override;
+	bool canRightClick(BWAPI::Position target, bool checkCanTargetUnit = true, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canRightClick(BWAPI::Unit target, bool checkCanTargetUnit = true, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canRightClickGrouped(bool checkCommandibilityGrouped = true, bool checkCommandibility = true) const override;
+	bool canRightClickGrouped(BWAPI::Position target, bool checkCanTargetUnit = true, bool checkCanIssueCommandType = true, bool checkCommandibilityGrouped = true, bool checkCommandibility = true) const override;
+	bool canRightClickGrouped(BWAPI::Unit target, bool checkCanTargetUnit = true, bool checkCanIssueCommandType = true, bool checkCommandibilityGrouped = true, bool checkCommandibility = true) const override;
+	bool canRightClickPosition(bool checkCommandibility = true) const override;
+	bool canRightClickPositionGrouped(bool checkCommandibilityGrouped = true, bool checkCommandibility = true) const override;
+	bool canRightClickUnit(bool checkCommandibility = true) const override;
+	bool canRightClickUnit(BWAPI::Unit targetUnit, bool checkCanTargetUnit = true, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canRightClickUnitGrouped(bool checkCommandibilityGrouped = true, bool checkCommandibility = true) const override;
+	bool canRightClickUnitGrouped(BWAPI::Unit targetUnit, bool checkCanTargetUnit = true, bool checkCanIssueCommandType = true, bool checkCommandibilityGrouped = true, bool checkCommandibility = true) const override;
+	bool canHaltConstruction(bool checkCommandibility = true) const override;
+	bool canCancelConstruction(bool checkCommandibility = true) const override;
+	bool canCancelAddon(bool checkCommandibility = true) const override;
+	bool canCancelTrain(bool checkCommandibility = true) const override;
+	bool canCancelTrainSlot(bool checkCommandibility = true) const override;
+	bool canCancelTrainSlot(int slot, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canCancelMorph(bool checkCommandibility = true) const override;
+	bool canCancelResearch(bool checkCommandibility = true) const override;
+	bool canCancelUpgrade(bool checkCommandibility = true) const override;
+	bool canUseTechWithOrWithoutTarget(bool checkCommandibility = true) const override;
+	bool canUseTechWithOrWithoutTarget(BWAPI::TechType tech, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canUseTech(BWAPI::TechType tech, BWAPI::Position target, bool checkCanTargetUnit = true, bool checkTargetsType = true, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canUseTech(BWAPI::TechType tech, BWAPI::Unit target = nullptr, bool checkCanTargetUnit = true, bool checkTargetsType = true, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canUseTechWithoutTarget(BWAPI::TechType tech, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canUseTechUnit(BWAPI::TechType tech, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canUseTechUnit(BWAPI::TechType tech, BWAPI::Unit targetUnit, bool checkCanTargetUnit = true, bool checkTargetsUnits = true, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canUseTechPosition(BWAPI::TechType tech, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canUseTechPosition(BWAPI::TechType tech, BWAPI::Position target, bool checkTargetsPositions = true, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+	bool canPlaceCOP(bool checkCommandibility = true) const override;
+	bool canPlaceCOP(BWAPI::TilePosition target, bool checkCanIssueCommandType = true, bool checkCommandibility = true) const override;
+};
+
+}
@@ -0,0 +1,60 @@
+#include "Tests.h"
+
+#include "FramePlayer.h"
+#include "UAlbertaBotModule.h"
+
+#include <iostream>
+
+// LocutusTest runs the bot's code outside of Starcraft, on a HeadlessGame.
+// Usage:
+//   LocutusTest [filter]
+//     Runs the tests whose names contain the filter, or all of them. The exit code is the
+//     number of tests that failed.
+//   LocutusTest -replay <file>
+//     Plays back a game recorded with Config::Debug::FrameRecordFilename and times the bot
+//     on each frame, as a benchmark. Run it from the Starcraft directory, so that the bot
+//     finds its configuration and read directory as it does in a game.
+//   LocutusTest -bench
+//     Times the unit type tables of MathUtil and UnitUtil against the BWAPI calls they replace.
+
+namespace
+{
+	int replay(const std::string & filename)
+	{
+		UAlbertaBot::FramePlayer player;
+		if (!player.open(filename))
+		{
+			std::cerr << "Cannot play back " << filename << std::endl;
+			return 1;
+		}
+
+		UAlbertaBot::UAlbertaBotModule bot;
+		player.run(bot);
+
+		const std::string summary = player.summary();
+		std::cout << summary << std::endl;
+		Log().Get() << summary;
+		return 0;
+	}
+}
+
+int main(int argc, char * argv[])
+{
+	if (argc > 1 && std::string(argv[1]) == "-replay")
+	{
+		if (argc != 3)
+		{
+			std::cerr << "Usage: LocutusTest -replay <file>" << std::endl;
+			return 1;
+		}
+		return replay(argv[2]);
+	}
+
+	if (argc > 1 && std::string(argv[1]) == "-bench")
+	{
+		UAlbertaBot::Test::TypeTableBenchmark();
+		return 0;
+	}
+
+	return UAlbertaBot::Test::RunAll(argc > 1 ? argv[1] : "");
+}
@@ -0,0 +1,118 @@
+#include "Tests.h"
+
+#include "FramePlayer.h"
+#include "FrameRecorder.h"
+#include "Skirmish.h"
+
+#include <cstdio>
+#include <tuple>
+
+using namespace UAlbertaBot;
+
+namespace
+{
+	const std::string RecordFilename = "LocutusTest_frames.bin";
+
+	// What the bot sees of a unit, without its ID, which playback does not keep.
+	typedef std::tuple<int, int, int, int, int, int, int, bool, bool> UnitView;
+
+	// What the bot sees in one frame.
+	struct FrameView
+	{
+		int						frame;
+		int						minerals;
+		int						visibleTiles;
+		std::vector<UnitView>	units;
+	};
+
+	FrameView look()
+	{
+		FrameView view;
+		view.frame = BWAPI::Broodwar->getFrameCount();
+		view.minerals = BWAPI::Broodwar->self()->minerals();
+
+		view.visibleTiles = 0;
+		for (int y = 0; y < BWAPI::Broodwar->mapHeight(); ++y)
+		{
+			for (int x = 0; x < BWAPI::Broodwar->mapWidth(); ++x)
+			{
+				view.visibleTiles += BWAPI::Broodwar->isVisible(x, y) ? 1 : 0;
+			}
+		}
+
+		for (const BWAPI::Unit unit : BWAPI::Broodwar->getAllUnits())
+		{
+			const int owner =
+				unit->getPlayer() == BWAPI::Broodwar->self() ? 0 :
+				unit->getPlayer() == BWAPI::Broodwar->enemy() ? 1 : 2;
+			view.units.push_back(UnitView(
+				unit->getType().getID(), owner,
+				unit->getPosition().x, unit->getPosition().y,
+				unit->getHitPoints(), unit->getShields(), unit->getOrder().getID(),
+				unit->isMoving(), unit->isCompleted()));
+		}
+		std::sort(view.units.begin(), view.units.end());
+
+		return view;
+	}
+}
+
+// Record a game with FrameRecorder and play it back with FramePlayer. In every frame the
+// bot sees the same things in the playback as in the game.
+void Test::RecordingPlaysBack()
+{
+	std::vector<FrameView> recorded;
+	{
+		Skirmish skirmish;
+		skirmish.game.setFrameCount(100);
+
+		Config::Debug::FrameRecordFilename = RecordFilename;
+		FrameModule module([&]
+		{
+			FrameRecorder::Instance().update();
+			recorded.push_back(look());
+		});
+
+		skirmish.game.start(module);
+
+		skirmish.advance();
+		skirmish.game.getHeadlessPlayer(skirmish.game.self())->data().minerals += 8;
+		skirmish.game.step();
+
+		skirmish.hurtMarine->data().exists = false;
+		skirmish.zealot->data().shields -= 10;
+		skirmish.game.step();
+
+		// The dragoon walks away, so that we lose sight of the tank.
+		skirmish.dragoon->data().positionX -= 200;
+		skirmish.zealot->data().positionX -= 200;
+		skirmish.game.step();
+
+		FrameRecorder::Instance().onEnd();
+		Config::Debug::FrameRecordFilename = "";
+	}
+
+	std::vector<FrameView> played;
+	{
+		FramePlayer player;
+		TEST_CHECK(player.open(RecordFilename));
+
+		FrameModule module([&]
+		{
+			played.push_back(look());
+		});
+		player.run(module);
+		TEST_CHECK(player.frames() == int(recorded.size()));
+	}
+	std::remove(RecordFilename.c_str());
+
+	TEST_CHECK(recorded.size() == 4);
+	TEST_CHECK(played.size() == recorded.size());
+	for (size_t i = 0; i < recorded.size() && i < played.size(); ++i)
+	{
+		TEST_CHECK(played[i].frame == recorded[i].frame);
+		TEST_CHECK(played[i].minerals == recorded[i].minerals);
+		TEST_CHECK(played[i].visibleTiles == recorded[i].visibleTiles);
+		TEST_CHECK(played[i].units == recorded[i].units);
+	}
+}
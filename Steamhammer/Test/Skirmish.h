@@ -0,0 +1,52 @@
+#pragma once
+
+#include "HeadlessGame.h"
+
+namespace UAlbertaBot
+{
+namespace Test
+{
+
+// A small fight: two of our units and a worker, three enemy units in sight and one out of sight,
+// and a mineral patch.
+struct Skirmish
+{
+	HeadlessGame	game;
+	HeadlessUnit *	zealot;
+	HeadlessUnit *	dragoon;
+	HeadlessUnit *	probe;
+	HeadlessUnit *	marine;
+	HeadlessUnit *	hurtMarine;
+	HeadlessUnit *	tank;
+	HeadlessUnit *	farMarine;
+	HeadlessUnit *	mineral;
+
+	Skirmish()
+		: game(64, 64, "Skirmish")
+	{
+		HeadlessPlayer * us = game.addPlayer("Locutus", BWAPI::Races::Protoss, BWAPI::TilePosition(8, 8));
+		HeadlessPlayer * them = game.addPlayer("Enemy", BWAPI::Races::Terran, BWAPI::TilePosition(56, 56));
+
+		zealot = game.addUnit(BWAPI::UnitTypes::Protoss_Zealot, us, BWAPI::Position(640, 640));
+		dragoon = game.addUnit(BWAPI::UnitTypes::Protoss_Dragoon, us, BWAPI::Position(600, 700));
+		probe = game.addUnit(BWAPI::UnitTypes::Protoss_Probe, us, BWAPI::Position(520, 600));
+		marine = game.addUnit(BWAPI::UnitTypes::Terran_Marine, them, BWAPI::Position(760, 620));
+		hurtMarine = game.addUnit(BWAPI::UnitTypes::Terran_Marine, them, BWAPI::Position(700, 560));
+		hurtMarine->data().hitPoints = 20;
+		tank = game.addUnit(BWAPI::UnitTypes::Terran_Siege_Tank_Siege_Mode, them, BWAPI::Position(820, 700));
+		farMarine = game.addUnit(BWAPI::UnitTypes::Terran_Marine, them, BWAPI::Position(1800, 1800));
+		mineral = game.addUnit(BWAPI::UnitTypes::Resource_Mineral_Field, game.neutral(), BWAPI::Position(560, 640));
+	}
+
+	// The marine runs toward our units.
+	void advance()
+	{
+		marine->data().positionX -= 24;
+		marine->data().positionY += 8;
+		marine->data().isMoving = true;
+		marine->data().isIdle = false;
+	}
+};
+
+}
+}
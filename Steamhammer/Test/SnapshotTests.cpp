@@ -0,0 +1,149 @@
+#include "Tests.h"
+
+#include "Skirmish.h"
+#include "TargetSnapshot.h"
+#include "WorldSnapshot.h"
+
+#include <limits>
+
+using namespace UAlbertaBot;
+
+// The snapshot holds the enemy units BWAPI gives us and our own combat units, with the values
+// BWAPI gives, and it measures distances the same way BWAPI does.
+void Test::WorldSnapshotMatchesGame()
+{
+	Skirmish skirmish;
+	const BWAPI::Position goal(900, 400);
+	int frames = 0;
+
+	FrameModule module([&]
+	{
+		++frames;
+		WorldSnapshot & world = WorldSnapshot::Instance();
+		world.update();
+
+		TEST_CHECK(world.frame == BWAPI::Broodwar->getFrameCount());
+		TEST_CHECK(world.size() == 5);
+		TEST_CHECK(world.index(skirmish.farMarine) == -1);
+		TEST_CHECK(world.index(skirmish.probe) == -1);
+		TEST_CHECK(world.index(skirmish.mineral) == -1);
+		TEST_CHECK(world.index(nullptr) == -1);
+
+		for (const BWAPI::Unit unit : BWAPI::Broodwar->getAllUnits())
+		{
+			const bool ours = unit->getPlayer() == BWAPI::Broodwar->self();
+			const bool enemy = unit->getPlayer() == BWAPI::Broodwar->enemy();
+			const int i = world.index(unit);
+			TEST_CHECK((i >= 0) == (enemy || (ours && WorldSnapshot::IsSnapshotUnit(unit->getType()))));
+			if (i < 0)
+			{
+				continue;
+			}
+
+			TEST_CHECK(world.unit[i] == unit);
+			TEST_CHECK(world.type[i] == unit->getType());
+			TEST_CHECK(world.owner[i] == (ours ? WorldSnapshot::Self : WorldSnapshot::Enemy));
+			TEST_CHECK(world.position(i) == unit->getPosition());
+			TEST_CHECK(world.hitPoints[i] == unit->getHitPoints());
+			TEST_CHECK(world.shields[i] == unit->getShields());
+			TEST_CHECK(world.is(i, WorldSnapshot::Moving) == unit->isMoving());
+			TEST_CHECK(world.is(i, WorldSnapshot::Sieged) == unit->isSieged());
+			TEST_CHECK(world.distance(i, goal) == unit->getDistance(goal));
+
+			for (int j = 0; j < world.size(); ++j)
+			{
+				TEST_CHECK(world.distance(i, j) == unit->getDistance(world.unit[j]));
+			}
+		}
+	});
+
+	skirmish.game.start(module);
+	skirmish.advance();
+	skirmish.game.step();
+
+	TEST_CHECK(frames == 2);
+}
+
+// The target snapshot holds the targets in the order given, with the distances and
+// target attributes that scoring would otherwise read from BWAPI. A target that is not in
+// the world snapshot, here the mineral patch, is read from BWAPI.
+void Test::TargetSnapshotMatchesGame()
+{
+	Skirmish skirmish;
+	const BWAPI::Position goal(900, 400);
+	int frames = 0;
+
+	FrameModule module([&]
+	{
+		++frames;
+		WorldSnapshot::Instance().update();
+
+		FrameVector<BWAPI::Unit> targets;
+		for (const BWAPI::Unit unit : BWAPI::Broodwar->enemy()->getUnits())
+		{
+			targets.push_back(unit);
+		}
+		TEST_CHECK(targets.size() == 3);
+		targets.push_back(skirmish.mineral);
+
+		TargetSnapshot snapshot;
+		snapshot.build(targets, goal);
+		TEST_CHECK(snapshot.size() == int(targets.size()));
+
+		for (const BWAPI::Unit ourUnit : { BWAPI::Unit(skirmish.zealot), BWAPI::Unit(skirmish.dragoon), BWAPI::Unit(skirmish.probe) })
+		{
+			std::vector<int> distances;
+			snapshot.distancesFrom(ourUnit, distances);
+			TEST_CHECK(distances.size() == targets.size());
+			for (size_t i = 0; i < targets.size() && i < distances.size(); ++i)
+			{
+				TEST_CHECK(distances[i] == ourUnit->getDistance(targets[i]));
+			}
+			TEST_CHECK(snapshot.goalDistanceFrom(ourUnit) == ourUnit->getDistance(goal));
+		}
+
+		for (int i = 0; i < snapshot.size(); ++i)
+		{
+			const BWAPI::Unit target = targets[i];
+			TEST_CHECK(snapshot.unit[i] == target);
+			TEST_CHECK(snapshot.type[i] == target->getType());
+			TEST_CHECK(snapshot.goalDistance[i] == target->getDistance(goal));
+
+			const int motion =
+				target == skirmish.tank ? TargetSnapshot::StillSieged :
+				target->isMoving() ? TargetSnapshot::Moving : TargetSnapshot::Still;
+			TEST_CHECK(snapshot.motion[i] == motion);
+
+			TEST_CHECK(snapshot.hurtBonus[i] == (target == skirmish.hurtMarine ? 24 : 0));
+		}
+
+		// With no goal, or one off the map, distances to it are what getDistance() gives, so that
+		// closerToGoal in target scoring is the same as when it called getDistance() itself.
+		// The top left corner is a goal like any other.
+		const BWAPI::Position offMap(BWAPI::Broodwar->mapWidth() * 32 + 64, 400);
+		for (const BWAPI::Position badGoal : { BWAPI::Positions::Invalid, BWAPI::Positions::None, offMap })
+		{
+			snapshot.build(targets, badGoal);
+			for (const BWAPI::Unit ourUnit : { BWAPI::Unit(skirmish.zealot), BWAPI::Unit(skirmish.probe) })
+			{
+				TEST_CHECK(snapshot.goalDistanceFrom(ourUnit) == ourUnit->getDistance(badGoal));
+				for (int i = 0; i < snapshot.size(); ++i)
+				{
+					TEST_CHECK(snapshot.goalDistance[i] == targets[i]->getDistance(badGoal));
+					TEST_CHECK(snapshot.goalDistanceFrom(ourUnit) - snapshot.goalDistance[i] ==
+						ourUnit->getDistance(badGoal) - targets[i]->getDistance(badGoal));
+				}
+			}
+		}
+		TEST_CHECK(snapshot.goalDistance[0] == std::numeric_limits<int>::max());
+
+		snapshot.build(targets, BWAPI::Positions::Origin);
+		TEST_CHECK(snapshot.goalDistance[0] == targets[0]->getDistance(BWAPI::Positions::Origin));
+	});
+
+	skirmish.game.start(module);
+	skirmish.advance();
+	skirmish.game.step();
+
+	TEST_CHECK(frames == 2);
+}
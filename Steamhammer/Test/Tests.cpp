@@ -0,0 +1,58 @@
+#include "Tests.h"
+
+#include <functional>
+#include <iostream>
+#include <vector>
+
+using namespace UAlbertaBot;
+
+namespace
+{
+	struct TestCase
+	{
+		std::string				name;
+		std::function<void()>	run;
+	};
+
+	const std::vector<TestCase> Tests =
+	{
+		{ "WorldSnapshotMatchesGame", Test::WorldSnapshotMatchesGame },
+		{ "TargetSnapshotMatchesGame", Test::TargetSnapshotMatchesGame },
+		{ "RecordingPlaysBack", Test::RecordingPlaysBack },
+		{ "TypeTablesMatchBWAPI", Test::TypeTablesMatchBWAPI },
+	};
+
+	int failedChecks = 0;
+}
+
+void Test::Fail(const char * file, int line, const std::string & what)
+{
+	++failedChecks;
+	std::cout << "  " << file << ':' << line << ": failed " << what << std::endl;
+}
+
+int Test::RunAll(const std::string & filter)
+{
+	int run = 0;
+	int failed = 0;
+
+	for (const TestCase & test : Tests)
+	{
+		if (test.name.find(filter) == std::string::npos)
+		{
+			continue;
+		}
+
+		std::cout << test.name << std::endl;
+		const int before = failedChecks;
+		test.run();
+		++run;
+		if (failedChecks > before)
+		{
+			++failed;
+		}
+	}
+
+	std::cout << run - failed << " of " << run << " tests passed" << std::endl;
+	return failed;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <BWAPI.h>
+
+#include <functional>
+#include <string>
+
+// The tests of LocutusTest. Each test sets up a HeadlessGame, runs bot code on it, and
+// reports what it finds wrong through TEST_CHECK. A test passes if no check fails.
+
+namespace UAlbertaBot
+{
+namespace Test
+{
+	void Fail(const char * file, int line, const std::string & what);
+
+	// Calls the given function every frame, for tests that run bot code inside the game loop.
+	class FrameModule : public BWAPI::AIModule
+	{
+		std::function<void()>	_onFrame;
+
+	public:
+		explicit FrameModule(std::function<void()> onFrame) : _onFrame(onFrame) {};
+
+		void onFrame() override { _onFrame(); };
+	};
+
+	// Run every test, or only those whose name contains the filter. Return the number that failed.
+	int RunAll(const std::string & filter);
+
+	// The tests.
+	void WorldSnapshotMatchesGame();
+	void TargetSnapshotMatchesGame();
+	void RecordingPlaysBack();
+	void TypeTablesMatchBWAPI();
+
+	// Benchmarks, run by LocutusTest -bench.
+	void TypeTableBenchmark();
+}
+}
+
+#define TEST_CHECK(condition) \
+	do { if (!(condition)) UAlbertaBot::Test::Fail(__FILE__, __LINE__, #condition); } while (false)
@@ -0,0 +1,215 @@
+#include "Tests.h"
+
+#include "MathUtil.h"
+#include "UnitUtil.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+using namespace UAlbertaBot;
+
+// MathUtil and UnitUtil read unit type dimensions and attack properties from tables built once
+// from BWAPI. These are the versions that called the UnitType accessors every time, kept here to
+// check the tables against and to time them against.
+namespace
+{
+	namespace BWAPICalls
+	{
+		int EdgeToEdgeDistance(BWAPI::UnitType firstType, BWAPI::Position firstCenter, BWAPI::UnitType secondType, BWAPI::Position secondCenter)
+		{
+			BWAPI::Position firstTopLeft = firstCenter + BWAPI::Position(-firstType.dimensionLeft(), -firstType.dimensionUp());
+			BWAPI::Position firstBottomRight = firstCenter + BWAPI::Position(firstType.dimensionRight(), firstType.dimensionDown());
+			BWAPI::Position secondTopLeft = secondCenter + BWAPI::Position(-secondType.dimensionLeft(), -secondType.dimensionUp());
+			BWAPI::Position secondBottomRight = secondCenter + BWAPI::Position(secondType.dimensionRight(), secondType.dimensionDown());
+
+			int xDist = (std::max)({ firstTopLeft.x - secondBottomRight.x - 1, secondTopLeft.x - firstBottomRight.x - 1, 0 });
+			int yDist = (std::max)({ firstTopLeft.y - secondBottomRight.y - 1, secondTopLeft.y - firstBottomRight.y - 1, 0 });
+
+			return BWAPI::Positions::Origin.getApproxDistance(BWAPI::Position(xDist, yDist));
+		}
+
+		int EdgeToPointDistance(BWAPI::UnitType type, BWAPI::Position center, BWAPI::Position point)
+		{
+			BWAPI::Position topLeft = center + BWAPI::Position(-type.dimensionLeft(), -type.dimensionUp());
+			BWAPI::Position bottomRight = center + BWAPI::Position(type.dimensionRight(), type.dimensionDown());
+
+			int xDist = (std::max)({ topLeft.x - point.x - 1, point.x - bottomRight.x - 1, 0 });
+			int yDist = (std::max)({ topLeft.y - point.y - 1, point.y - bottomRight.y - 1, 0 });
+
+			return BWAPI::Positions::Origin.getApproxDistance(BWAPI::Position(xDist, yDist));
+		}
+
+		bool Overlaps(BWAPI::UnitType firstType, BWAPI::Position firstCenter, BWAPI::UnitType secondType, BWAPI::Position secondCenter)
+		{
+			BWAPI::Position firstTopLeft = firstCenter + BWAPI::Position(-firstType.dimensionLeft(), -firstType.dimensionUp());
+			BWAPI::Position firstBottomRight = firstCenter + BWAPI::Position(firstType.dimensionRight(), firstType.dimensionDown());
+			BWAPI::Position secondTopLeft = secondCenter + BWAPI::Position(-secondType.dimensionLeft(), -secondType.dimensionUp());
+			BWAPI::Position secondBottomRight = secondCenter + BWAPI::Position(secondType.dimensionRight(), secondType.dimensionDown());
+
+			return firstBottomRight.x >= secondTopLeft.x && secondBottomRight.x >= firstTopLeft.x &&
+				firstBottomRight.y >= secondTopLeft.y && secondBottomRight.y >= firstTopLeft.y;
+		}
+
+		bool TypeCanAttackAir(BWAPI::UnitType attacker)
+		{
+			return attacker.airWeapon() != BWAPI::WeaponTypes::None ||
+				attacker == BWAPI::UnitTypes::Terran_Bunker ||
+				attacker == BWAPI::UnitTypes::Protoss_Carrier;
+		}
+
+		bool TypeCanAttackGround(BWAPI::UnitType attacker)
+		{
+			return attacker.groundWeapon() != BWAPI::WeaponTypes::None ||
+				attacker == BWAPI::UnitTypes::Terran_Bunker ||
+				attacker == BWAPI::UnitTypes::Protoss_Carrier ||
+				attacker == BWAPI::UnitTypes::Protoss_Reaver;
+		}
+
+		bool IsCombatSimUnit(BWAPI::UnitType type)
+		{
+			if (type.isWorker() || type == BWAPI::UnitTypes::Protoss_Interceptor)
+			{
+				return false;
+			}
+
+			return TypeCanAttackAir(type) || TypeCanAttackGround(type) || type == BWAPI::UnitTypes::Terran_Medic;
+		}
+
+		int GetMaxAttackRange(BWAPI::UnitType type)
+		{
+			return (std::max)(
+				UnitUtil::GetAttackRangeAssumingUpgrades(type, BWAPI::UnitTypes::Terran_Marine),
+				UnitUtil::GetAttackRangeAssumingUpgrades(type, BWAPI::UnitTypes::Terran_Wraith));
+		}
+	}
+
+	// Every real unit type, without None and Unknown.
+	std::vector<BWAPI::UnitType> allTypes()
+	{
+		std::vector<BWAPI::UnitType> types;
+		for (int id = 0; id < BWAPI::UnitTypes::Enum::None; ++id)
+		{
+			types.push_back(BWAPI::UnitType(id));
+		}
+		return types;
+	}
+
+	// A pair of units near each other, as the combat sim and micro see them.
+	struct Placement
+	{
+		BWAPI::UnitType	first;
+		BWAPI::Position	firstCenter;
+		BWAPI::UnitType	second;
+		BWAPI::Position	secondCenter;
+	};
+
+	std::vector<Placement> placements(int count)
+	{
+		const std::vector<BWAPI::UnitType> types = allTypes();
+		std::mt19937 random(1);
+		std::uniform_int_distribution<size_t> type(0, types.size() - 1);
+		std::uniform_int_distribution<int> coordinate(0, 12 * 32);
+
+		std::vector<Placement> result;
+		for (int i = 0; i < count; ++i)
+		{
+			result.push_back(Placement{
+				types[type(random)], BWAPI::Position(coordinate(random), coordinate(random)),
+				types[type(random)], BWAPI::Position(coordinate(random), coordinate(random)) });
+		}
+		return result;
+	}
+
+	// Time f over the inputs, repeated, and return nanoseconds per call.
+	// f returns an int that is summed, so that the compiler keeps the calls.
+	template <class T, class F>
+	double nanosecondsPerCall(const std::vector<T> & inputs, int repeats, F f, long long & sum)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		for (int r = 0; r < repeats; ++r)
+		{
+			for (const T & input : inputs)
+			{
+				sum += f(input);
+			}
+		}
+		const auto end = std::chrono::steady_clock::now();
+		return std::chrono::duration<double, std::nano>(end - start).count() / (double(repeats) * inputs.size());
+	}
+}
+
+// The table versions give the same answers as the BWAPI calls for every unit type.
+void Test::TypeTablesMatchBWAPI()
+{
+	for (const BWAPI::UnitType type : allTypes())
+	{
+		TEST_CHECK(UnitUtil::TypeCanAttackAir(type) == BWAPICalls::TypeCanAttackAir(type));
+		TEST_CHECK(UnitUtil::TypeCanAttackGround(type) == BWAPICalls::TypeCanAttackGround(type));
+		TEST_CHECK(UnitUtil::IsCombatSimUnit(type) == BWAPICalls::IsCombatSimUnit(type));
+		TEST_CHECK(UnitUtil::GetMaxAttackRange(type) == BWAPICalls::GetMaxAttackRange(type));
+	}
+
+	for (const Placement & p : placements(20000))
+	{
+		TEST_CHECK(MathUtil::EdgeToEdgeDistance(p.first, p.firstCenter, p.second, p.secondCenter) ==
+			BWAPICalls::EdgeToEdgeDistance(p.first, p.firstCenter, p.second, p.secondCenter));
+		TEST_CHECK(MathUtil::EdgeToPointDistance(p.first, p.firstCenter, p.secondCenter) ==
+			BWAPICalls::EdgeToPointDistance(p.first, p.firstCenter, p.secondCenter));
+		TEST_CHECK(MathUtil::Overlaps(p.first, p.firstCenter, p.second, p.secondCenter) ==
+			BWAPICalls::Overlaps(p.first, p.firstCenter, p.second, p.secondCenter));
+	}
+}
+
+// Time the table versions against the BWAPI calls and print nanoseconds per call.
+void Test::TypeTableBenchmark()
+{
+	const std::vector<Placement> pairs = placements(4096);
+	const std::vector<BWAPI::UnitType> types = allTypes();
+	const int repeats = 2000;
+	const int typeRepeats = 20000;
+	long long sum = 0;
+
+	struct Row
+	{
+		const char *	name;
+		double			bwapi;
+		double			table;
+	};
+
+	const std::vector<Row> rows =
+	{
+		{ "EdgeToEdgeDistance",
+			nanosecondsPerCall(pairs, repeats, [](const Placement & p) { return BWAPICalls::EdgeToEdgeDistance(p.first, p.firstCenter, p.second, p.secondCenter); }, sum),
+			nanosecondsPerCall(pairs, repeats, [](const Placement & p) { return MathUtil::EdgeToEdgeDistance(p.first, p.firstCenter, p.second, p.secondCenter); }, sum) },
+		{ "EdgeToPointDistance",
+			nanosecondsPerCall(pairs, repeats, [](const Placement & p) { return BWAPICalls::EdgeToPointDistance(p.first, p.firstCenter, p.secondCenter); }, sum),
+			nanosecondsPerCall(pairs, repeats, [](const Placement & p) { return MathUtil::EdgeToPointDistance(p.first, p.firstCenter, p.secondCenter); }, sum) },
+		{ "Overlaps",
+			nanosecondsPerCall(pairs, repeats, [](const Placement & p) { return int(BWAPICalls::Overlaps(p.first, p.firstCenter, p.second, p.secondCenter)); }, sum),
+			nanosecondsPerCall(pairs, repeats, [](const Placement & p) { return int(MathUtil::Overlaps(p.first, p.firstCenter, p.second, p.secondCenter)); }, sum) },
+		{ "TypeCanAttackAir",
+			nanosecondsPerCall(types, typeRepeats, [](BWAPI::UnitType type) { return int(BWAPICalls::TypeCanAttackAir(type)); }, sum),
+			nanosecondsPerCall(types, typeRepeats, [](BWAPI::UnitType type) { return int(UnitUtil::TypeCanAttackAir(type)); }, sum) },
+		{ "TypeCanAttackGround",
+			nanosecondsPerCall(types, typeRepeats, [](BWAPI::UnitType type) { return int(BWAPICalls::TypeCanAttackGround(type)); }, sum),
+			nanosecondsPerCall(types, typeRepeats, [](BWAPI::UnitType type) { return int(UnitUtil::TypeCanAttackGround(type)); }, sum) },
+		{ "IsCombatSimUnit",
+			nanosecondsPerCall(types, typeRepeats, [](BWAPI::UnitType type) { return int(BWAPICalls::IsCombatSimUnit(type)); }, sum),
+			nanosecondsPerCall(types, typeRepeats, [](BWAPI::UnitType type) { return int(UnitUtil::IsCombatSimUnit(type)); }, sum) },
+		{ "GetMaxAttackRange",
+			nanosecondsPerCall(types, typeRepeats, [](BWAPI::UnitType type) { return BWAPICalls::GetMaxAttackRange(type); }, sum),
+			nanosecondsPerCall(types, typeRepeats, [](BWAPI::UnitType type) { return UnitUtil::GetMaxAttackRange(type); }, sum) },
+	};
+
+	std::cout << std::left << std::setw(22) << "ns per call" << std::right << std::setw(10) << "BWAPI" << std::setw(10) << "table" << std::endl;
+	std::cout << std::fixed << std::setprecision(2);
+	for (const Row & row : rows)
+	{
+		std::cout << std::left << std::setw(22) << row.name << std::right << std::setw(10) << row.bwapi << std::setw(10) << row.table << std::endl;
+	}
+
+	// Print the checksum so that none of the timed calls can be optimized away.
+	std::cout << "checksum " << sum << std::endl;
+}